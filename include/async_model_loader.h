@@ -0,0 +1,115 @@
+#ifndef ASYNC_MODEL_LOADER_H
+#define ASYNC_MODEL_LOADER_H
+
+#include "model_manager.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 异步读取结果
+ */
+struct LoadedModel {
+    std::string path;
+    std::shared_ptr<ModelManager> manager; // 读取失败时为nullptr
+    std::string error;
+    size_t bytes;          // 文件字节数
+    double read_seconds;   // 文件读取耗时
+    double parse_seconds;  // 解析与模型构建耗时
+    
+    LoadedModel() : bytes(0), read_seconds(0.0), parse_seconds(0.0) {}
+    
+    bool ok() const { return manager != nullptr; }
+};
+
+/**
+ * @brief 异步读取选项
+ */
+struct AsyncLoadOptions {
+    unsigned io_threads;      // 文件读取线程数（决定同时在途的读请求数）
+    unsigned parse_threads;   // 解析线程数，0表示使用ParallelUtils::threadCount()
+    size_t max_pending_bytes; // 已读取但尚未解析的数据上限（字节）
+    
+    AsyncLoadOptions() : io_threads(4), parse_threads(0), max_pending_bytes(256u << 20) {}
+};
+
+/**
+ * @brief 异步模型读取器
+ * 
+ * 两级流水线：读取线程预取后续文件内容，解析线程同时解析已读到的文件并构建模型，
+ * 使磁盘读取与解析相互重叠。已读未解析的数据量受max_pending_bytes约束，
+ * 解析跟不上时读取线程暂停预取。提交顺序即读取顺序，结果通过future返回
+ */
+class AsyncModelLoader {
+public:
+    typedef std::function<void(const LoadedModel&)> LoadCallback;
+    
+    /**
+     * @brief 构造函数，启动读取与解析线程
+     * 
+     * @param options 读取选项
+     */
+    explicit AsyncModelLoader(const AsyncLoadOptions& options = AsyncLoadOptions());
+    
+    /**
+     * @brief 析构函数，完成已提交的任务后停止线程
+     */
+    ~AsyncModelLoader();
+    
+    AsyncModelLoader(const AsyncModelLoader&) = delete;
+    AsyncModelLoader& operator=(const AsyncModelLoader&) = delete;
+    
+    /**
+     * @brief 提交一个文件读取任务
+     * 
+     * @param path 文件路径（OBJ或.cadm）
+     * @return std::future<LoadedModel> 读取结果
+     */
+    std::future<LoadedModel> submit(const std::string& path);
+    
+    /**
+     * @brief 批量读取，按完成顺序回调
+     * 
+     * @param paths 文件路径列表
+     * @param on_loaded 可选的逐文件回调（在解析线程中串行调用）
+     * @return std::vector<LoadedModel> 按输入顺序排列的结果
+     * @throws 回调抛出的第一个异常（等待全部文件处理完成后抛出）
+     */
+    std::vector<LoadedModel> loadAll(const std::vector<std::string>& paths,
+                                     const LoadCallback& on_loaded = LoadCallback());
+    
+    /**
+     * @brief 列出目录中的模型文件（.obj与.cadm），按文件名排序
+     * 
+     * @param directory 目录路径
+     * @param files 输出文件路径
+     * @return bool 目录是否可读
+     */
+    static bool listModelFiles(const std::string& directory, std::vector<std::string>& files);
+    
+private:
+    struct Task;
+    
+    void readLoop();
+    void parseLoop();
+    
+    AsyncLoadOptions options;
+    std::mutex mutex;
+    std::condition_variable read_ready;  // 有可领取的读取任务（且未超在途上限）或停止
+    std::condition_variable parse_ready; // 有待解析任务或读取全部结束
+    std::deque<std::shared_ptr<Task>> read_queue;
+    std::deque<std::shared_ptr<Task>> parse_queue;
+    size_t pending_bytes;
+    bool stopping;       // 不再接受新任务，读取线程读完队列后退出
+    bool reads_finished; // 读取线程均已退出，解析线程处理完队列后退出
+    std::vector<std::thread> read_threads;
+    std::vector<std::thread> parse_threads;
+};
+
+#endif // ASYNC_MODEL_LOADER_H
@@ -0,0 +1,142 @@
+#ifndef BATCH_VALIDATOR_H
+#define BATCH_VALIDATOR_H
+
+#include "model_manager.h"
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 批量检测选项
+ */
+struct BatchValidationOptions {
+    unsigned workers;          // 工作线程数，0表示使用ParallelUtils::threadCount()
+    double timeout_seconds;    // 单个零件的检测时限（秒），0表示不限
+    size_t memory_limit_bytes; // 单个零件的内存上限（字节），0表示不限
+    
+    BatchValidationOptions() : workers(0), timeout_seconds(0.0), memory_limit_bytes(0) {}
+};
+
+/**
+ * @brief 单个零件的检测状态
+ */
+enum class ValidationStatus {
+    Passed,      // 无拓扑错误
+    Failed,      // 存在拓扑错误
+    LoadError,   // 文件读取或解析失败
+    Timeout,     // 超出检测时限
+    MemoryLimit  // 超出内存上限
+};
+
+/**
+ * @brief 单个零件的紧凑检测结果
+ */
+struct ValidationResult {
+    std::string name;            // 零件名称（文件路径或调用方给定的名称）
+    ValidationStatus status;
+    size_t vertex_count;
+    size_t edge_count;
+    size_t face_count;
+    size_t duplicate_edges;      // 重复边数量
+    size_t duplicate_faces;      // 重复面数量
+    size_t inconsistent_normals; // 法向不一致的面数量
+    size_t memory_bytes;         // 估算内存占用
+    double elapsed_seconds;      // 读取与检测耗时
+    std::string message;         // 失败原因
+    
+    ValidationResult()
+        : status(ValidationStatus::Passed), vertex_count(0), edge_count(0), face_count(0),
+          duplicate_edges(0), duplicate_faces(0), inconsistent_normals(0),
+          memory_bytes(0), elapsed_seconds(0.0) {}
+};
+
+/**
+ * @brief 多模型批量拓扑检测服务
+ * 
+ * 以有界工作线程池并发读取与检测大量零件：每个工作线程依次领取零件，
+ * 完成后立即通过回调输出紧凑结果，适合流式写出上万个零件的检测报告。
+ * 时限为协作式检查，在读取、各项检测阶段之间判断是否超时；
+ * 内存上限在读取前按文件大小、读取后按模型估算占用进行判断
+ */
+class BatchValidator {
+public:
+    /**
+     * @brief 结果回调，在工作线程中串行调用（按完成顺序）
+     * 
+     * 回调抛出异常时停止分发剩余任务，汇合全部工作线程后由validateFiles/validateModels重新抛出
+     */
+    typedef std::function<void(const ValidationResult&)> ResultCallback;
+    
+    /**
+     * @brief 构造函数
+     * 
+     * @param options 检测选项
+     */
+    explicit BatchValidator(const BatchValidationOptions& options = BatchValidationOptions());
+    
+    /**
+     * @brief 批量检测模型文件（OBJ或原生二进制格式）
+     * 
+     * @param paths 文件路径列表
+     * @param on_result 可选的逐零件结果回调
+     * @return std::vector<ValidationResult> 按输入顺序排列的结果
+     */
+    std::vector<ValidationResult> validateFiles(const std::vector<std::string>& paths,
+                                                const ResultCallback& on_result = ResultCallback()) const;
+    
+    /**
+     * @brief 批量检测内存中的模型
+     * 
+     * @param names 零件名称列表
+     * @param models 模型列表（与名称一一对应）
+     * @param on_result 可选的逐零件结果回调
+     * @return std::vector<ValidationResult> 按输入顺序排列的结果
+     */
+    std::vector<ValidationResult> validateModels(const std::vector<std::string>& names,
+                                                 const std::vector<std::shared_ptr<const ModelManager>>& models,
+                                                 const ResultCallback& on_result = ResultCallback()) const;
+    
+    /**
+     * @brief 获取状态名称
+     * 
+     * @param status 检测状态
+     * @return const char* 状态名称（小写英文，供机器读取）
+     */
+    static const char* statusName(ValidationStatus status);
+    
+    /**
+     * @brief 以单行JSON写出一个结果（适合流式输出）
+     * 
+     * @param out 输出流
+     * @param result 检测结果
+     */
+    static void writeJSONLine(std::ostream& out, const ValidationResult& result);
+    
+    /**
+     * @brief 写出JSON汇总报告（汇总统计及逐零件结果）
+     * 
+     * @param out 输出流
+     * @param results 检测结果
+     */
+    static void writeJSON(std::ostream& out, const std::vector<ValidationResult>& results);
+    
+    /**
+     * @brief 写出CSV报告（表头加逐零件一行）
+     * 
+     * @param out 输出流
+     * @param results 检测结果
+     */
+    static void writeCSV(std::ostream& out, const std::vector<ValidationResult>& results);
+    
+private:
+    template <typename Task>
+    std::vector<ValidationResult> run(size_t count, Task task, const ResultCallback& on_result) const;
+    
+    void checkModel(const ModelManager& manager, ValidationResult& result, double deadline) const;
+    
+    BatchValidationOptions options;
+};
+
+#endif // BATCH_VALIDATOR_H
@@ -0,0 +1,303 @@
+#ifndef COLLISION_DETECTOR_H
+#define COLLISION_DETECTOR_H
+
+#include "model_manager.h"
+#include "rigid_registration.h"
+#include "triangle_bvh.h"
+#include "winding_number.h"
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 碰撞检测参数
+ */
+struct CollisionOptions {
+    double tolerance;        // 穿透容差（模型单位），三角形越过对方平面不超过该值视为接触而非干涉
+    bool all_triangle_pairs; // 统计全部相交三角形对；为false时每对实例找到首个即停止
+    bool check_containment;  // 表面不相交时检测一个零件是否完全包含在另一个内部
+
+    CollisionOptions() : tolerance(1e-6), all_triangle_pairs(false), check_containment(true) {}
+};
+
+/**
+ * @brief 干涉实例对
+ */
+struct CollisionPair {
+    int instance_a;     // 实例索引（instance_a < instance_b）
+    int instance_b;
+    int face_a;         // 首个相交三角形对在各自零件中的面索引，仅包含关系时为-1
+    int face_b;
+    size_t triangle_pairs; // 相交三角形对数量（all_triangle_pairs为false时至多为1）
+    bool contained;     // 表面不相交而一个实例完全位于另一个内部
+
+    CollisionPair() : instance_a(-1), instance_b(-1), face_a(-1), face_b(-1), triangle_pairs(0), contained(false) {}
+};
+
+/**
+ * @brief 刚体运动：在起止两个位姿之间插值
+ *
+ * 以零件包围盒中心为参考点：中心沿直线匀速移动，姿态绕固定轴匀角速度转动
+ * （R(t) = exp(t·ω)·R0，exp(ω) = R1·R0ᵀ），零件上任一点的速度不超过
+ * |中心位移| + |ω|·包围球半径，供连续碰撞检测做保守推进
+ */
+struct RigidMotion {
+    RigidTransform start; // t = 0 时的位姿
+    RigidTransform end;   // t = 1 时的位姿
+
+    RigidMotion() {}
+    RigidMotion(const RigidTransform& start, const RigidTransform& end) : start(start), end(end) {}
+
+    /**
+     * @brief 插值位姿
+     *
+     * @param t 时间参数[0, 1]
+     * @param center 零件局部坐标中的参考点
+     * @return RigidTransform t时刻的位姿
+     */
+    RigidTransform at(double t, const double* center) const;
+
+    /**
+     * @brief 参考点位移长度与转角
+     *
+     * @param center 零件局部坐标中的参考点
+     * @param displacement 输出参考点位移长度
+     * @param angle 输出转角
+     */
+    void extent(const double* center, double& displacement, double& angle) const;
+};
+
+/**
+ * @brief 连续碰撞检测参数
+ */
+struct ContinuousCollisionOptions {
+    double contact_distance; // 距离不超过该值即视为接触
+    int max_iterations;      // 保守推进最大迭代次数，超过时按接触处理
+
+    ContinuousCollisionOptions() : contact_distance(1e-4), max_iterations(200) {}
+};
+
+/**
+ * @brief 连续碰撞检测结果
+ */
+struct ContinuousCollisionResult {
+    bool hit;        // 运动区间内是否接触
+    double time;     // 首次接触时间（[0, 1]内），未接触为1
+    double distance; // 接触时（或终点处已求得）的距离下界
+    int iterations;  // 推进迭代次数（即距离查询次数）
+    int face_a;      // 接触时最近三角形对的面索引，未接触为-1
+    int face_b;
+
+    ContinuousCollisionResult() : hit(false), time(1.0), distance(0.0), iterations(0), face_a(-1), face_b(-1) {}
+};
+
+/**
+ * @brief 装配体碰撞检测类
+ *
+ * 零件（网格）只保存一份BVH，装配中的每个实例引用零件并带有刚体变换。检测分两级：
+ * - 粗检测：按实例世界包围盒做扫掠裁剪（sweep-and-prune），沿包围盒中心分布最广的轴排序，
+ *   并行扫描得到包围盒重叠的实例对
+ * - 精检测：在实例A的局部坐标系中同时遍历两个零件的BVH，B的节点包围盒经相对变换后
+ *   取轴对齐包围盒做重叠剔除，叶节点逐对做三角形相交测试
+ *
+ * 共面接触与点、边接触不视为干涉，适用于螺栓、垫圈贴合板件等装配校核。
+ *
+ * 连续碰撞检测采用保守推进（conservative advancement）：在当前时刻求两实例的网格距离d，
+ * 按两者点速度上界之和μ推进 d/μ，期间不可能发生接触；重复至距离小于接触距离或越过区间终点。
+ * 距离查询复用同一套BVH同时遍历，只需少量查询即可得到精确的首次接触时间
+ */
+class CollisionDetector {
+public:
+    CollisionDetector() {}
+
+    /**
+     * @brief 添加零件
+     *
+     * @param manager 模型管理器
+     * @return int 零件索引
+     */
+    int addPart(const ModelManager& manager);
+
+    /**
+     * @brief 添加零件，复用已构建的BVH
+     *
+     * @param bvh 三角形BVH
+     * @return int 零件索引
+     */
+    int addPart(std::shared_ptr<const TriangleBVH> bvh);
+
+    /**
+     * @brief 添加实例
+     *
+     * @param part 零件索引
+     * @param transform 零件局部坐标到世界坐标的变换
+     * @return int 实例索引
+     */
+    int addInstance(int part, const RigidTransform& transform);
+
+    /**
+     * @brief 更新实例变换
+     *
+     * @param instance 实例索引
+     * @param transform 新变换
+     */
+    void setTransform(int instance, const RigidTransform& transform);
+
+    /**
+     * @brief 获取实例变换
+     */
+    const RigidTransform& transform(int instance) const { return instances[instance].transform; }
+
+    /**
+     * @brief 获取实例引用的零件索引
+     */
+    int instancePart(int instance) const { return instances[instance].part; }
+
+    /**
+     * @brief 获取零件BVH
+     */
+    const TriangleBVH& partBVH(int part) const { return *parts[part].bvh; }
+
+    /**
+     * @brief 零件数量
+     */
+    size_t partCount() const { return parts.size(); }
+
+    /**
+     * @brief 实例数量
+     */
+    size_t instanceCount() const { return instances.size(); }
+
+    /**
+     * @brief 计算实例的世界包围盒
+     *
+     * @param instance 实例索引
+     * @param bounds_min 输出最小点
+     * @param bounds_max 输出最大点
+     * @return bool 零件是否非空
+     */
+    bool worldBounds(int instance, double bounds_min[3], double bounds_max[3]) const;
+
+    /**
+     * @brief 粗检测：世界包围盒重叠的实例对（多线程）
+     *
+     * @return std::vector<std::pair<int, int>> 实例对，first < second，按字典序排列
+     */
+    std::vector<std::pair<int, int>> broadPhase() const;
+
+    /**
+     * @brief 检测全部干涉实例对（多线程）
+     *
+     * @param options 检测参数
+     * @return std::vector<CollisionPair> 干涉实例对，按实例索引排列
+     */
+    std::vector<CollisionPair> detect(const CollisionOptions& options = CollisionOptions()) const;
+
+    /**
+     * @brief 精检测一对实例
+     *
+     * @param instance_a 实例A
+     * @param instance_b 实例B
+     * @param options 检测参数
+     * @param result 输出干涉信息
+     * @return bool 是否干涉
+     */
+    bool testPair(int instance_a, int instance_b, const CollisionOptions& options, CollisionPair& result) const;
+
+    /**
+     * @brief 按当前位姿计算两实例的网格最小距离
+     *
+     * @param instance_a 实例A
+     * @param instance_b 实例B
+     * @param max_distance 最大搜索距离，超过时返回该值
+     * @return double 最小距离（表面相交时为0）
+     */
+    double distance(int instance_a, int instance_b,
+                    double max_distance = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * @brief 连续碰撞检测：两实例沿各自运动的首次接触时间
+     *
+     * 实例当前位姿不参与计算，由两个运动给出
+     *
+     * @param instance_a 实例A
+     * @param motion_a 实例A的运动
+     * @param instance_b 实例B
+     * @param motion_b 实例B的运动
+     * @param options 检测参数
+     * @return ContinuousCollisionResult 检测结果
+     */
+    ContinuousCollisionResult timeOfImpact(int instance_a, const RigidMotion& motion_a, int instance_b,
+                                           const RigidMotion& motion_b,
+                                           const ContinuousCollisionOptions& options = ContinuousCollisionOptions()) const;
+
+    /**
+     * @brief 沿位姿序列分段做连续碰撞检测（多线程）
+     *
+     * 相邻两个位姿构成一段运动，各段独立并行求解；首个hit为true的段即为首次接触所在段
+     *
+     * @param instance_a 实例A
+     * @param path_a 实例A的位姿序列
+     * @param instance_b 实例B
+     * @param path_b 实例B的位姿序列（长度与path_a相同）
+     * @param options 检测参数
+     * @return std::vector<ContinuousCollisionResult> 每段的检测结果（共path_a.size() - 1段）
+     */
+    std::vector<ContinuousCollisionResult> timeOfImpact(int instance_a, const std::vector<RigidTransform>& path_a,
+                                                        int instance_b, const std::vector<RigidTransform>& path_b,
+                                                        const ContinuousCollisionOptions& options =
+                                                            ContinuousCollisionOptions()) const;
+
+    /**
+     * @brief 三角形相交测试（Möller区间法）
+     *
+     * 两个三角形都须严格跨越对方平面（两侧距离均超过容差），且两条交线段
+     * 在公共交线上的重叠长度超过容差才判为相交
+     *
+     * @param t1 三角形1的9个顶点坐标分量
+     * @param t2 三角形2的9个顶点坐标分量
+     * @param tolerance 容差
+     * @return bool 是否相交
+     */
+    static bool trianglesIntersect(const double* t1, const double* t2, double tolerance);
+
+    /**
+     * @brief 两个三角形之间的最小距离
+     *
+     * 相交时为0，否则为6个顶点到对方三角形与9对边之间距离的最小值
+     *
+     * @param t1 三角形1的9个顶点坐标分量
+     * @param t2 三角形2的9个顶点坐标分量
+     * @return double 最小距离
+     */
+    static double triangleDistance(const double* t1, const double* t2);
+
+private:
+    struct Part {
+        std::shared_ptr<const TriangleBVH> bvh;
+        std::shared_ptr<const WindingNumber> winding; // 包含关系判断
+        double center[3];  // 局部包围盒中心
+        double extent[3];  // 局部包围盒半边长
+        double radius;     // 以包围盒中心为球心的包围球半径
+        bool empty;
+    };
+
+    struct Instance {
+        int part;
+        RigidTransform transform;
+    };
+
+    size_t intersectMeshes(const Part& a, const Part& b, const RigidTransform& b_to_a,
+                           const CollisionOptions& options, int& face_a, int& face_b) const;
+    double meshDistance(const Part& a, const Part& b, const RigidTransform& b_to_a, double max_distance,
+                        int& face_a, int& face_b) const;
+    double pairDistance(int instance_a, const RigidTransform& transform_a, int instance_b,
+                        const RigidTransform& transform_b, double max_distance, int& face_a, int& face_b) const;
+    bool contains(const Part& outer, const Part& inner, const RigidTransform& inner_to_outer) const;
+
+    std::vector<Part> parts;         // 零件
+    std::vector<Instance> instances; // 实例
+};
+
+#endif // COLLISION_DETECTOR_H
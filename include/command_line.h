@@ -0,0 +1,40 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <ostream>
+
+/**
+ * @brief 命令行工具
+ * 
+ * 提供面向运维与CI的子命令，无需编写C++即可处理实际模型文件：
+ * - import   读取模型并输出规模与耗时
+ * - check    批量拓扑检测
+ * - convert  格式转换（OBJ与原生二进制格式.cadm）
+ * - stats    几何与拓扑统计
+ * - bench    加速结构与查询性能测试
+ * - generate 按公差生成解析基本体
+ * - dedup    按几何指纹查找重复零件
+ * - serve    常驻模型的本地服务器，query向其发送请求
+ * 
+ * 通用选项：--threads N 设置线程数，--format text|json|csv 设置输出格式
+ */
+class CommandLine {
+public:
+    /**
+     * @brief 执行命令行
+     * 
+     * @param argc 参数个数
+     * @param argv 参数列表（argv[1]为子命令）
+     * @return int 进程退出码：0成功，1参数或读写错误，2检测发现问题
+     */
+    static int run(int argc, char** argv);
+    
+    /**
+     * @brief 输出用法说明
+     * 
+     * @param out 输出流
+     */
+    static void printUsage(std::ostream& out);
+};
+
+#endif // COMMAND_LINE_H
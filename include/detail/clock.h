@@ -0,0 +1,17 @@
+#ifndef DETAIL_CLOCK_H
+#define DETAIL_CLOCK_H
+
+#include <chrono>
+
+namespace detail {
+
+/**
+ * @brief 单调时钟秒数
+ */
+inline double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace detail
+
+#endif // DETAIL_CLOCK_H
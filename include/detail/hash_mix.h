@@ -0,0 +1,22 @@
+#ifndef DETAIL_HASH_MIX_H
+#define DETAIL_HASH_MIX_H
+
+#include <cstdint>
+
+namespace detail {
+
+/**
+ * @brief splitmix64终混函数
+ *
+ * 指纹、采样随机数流与哈希表槽位共用，输入相近的整数也能得到均匀分布的64位结果
+ */
+inline uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace detail
+
+#endif // DETAIL_HASH_MIX_H
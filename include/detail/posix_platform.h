@@ -0,0 +1,25 @@
+#ifndef DETAIL_POSIX_PLATFORM_H
+#define DETAIL_POSIX_PLATFORM_H
+
+/**
+ * 平台能力检测：
+ * - CAD_HAVE_POSIX_IPC：Unix域套接字与POSIX共享内存
+ * - CAD_HAVE_MMAP：文件内存映射
+ * 两者均可用时引入对应系统头文件，否则相关功能退化为普通文件读写或直接返回失败
+ */
+#if defined(__unix__) || defined(__APPLE__)
+#define CAD_HAVE_POSIX_IPC 1
+#define CAD_HAVE_MMAP 1
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#else
+#define CAD_HAVE_POSIX_IPC 0
+#define CAD_HAVE_MMAP 0
+#endif
+
+#endif // DETAIL_POSIX_PLATFORM_H
@@ -0,0 +1,70 @@
+#ifndef DETAIL_TEXT_OUTPUT_H
+#define DETAIL_TEXT_OUTPUT_H
+
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+namespace detail {
+
+/**
+ * @brief 追加JSON字符串（含引号与转义，控制字符写为\uXXXX）
+ */
+inline void appendJSONString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char ch : text) {
+        switch (ch) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(ch));
+                out += buffer;
+            } else {
+                out += ch;
+            }
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief JSON字符串（含引号与转义）
+ */
+inline std::string jsonString(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() + 2);
+    appendJSONString(out, text);
+    return out;
+}
+
+/**
+ * @brief 写出JSON字符串（含引号与转义）
+ */
+inline void writeJSONString(std::ostream& out, const std::string& text) {
+    out << jsonString(text);
+}
+
+/**
+ * @brief 写出CSV字段（含逗号、引号或换行时加引号，引号加倍）
+ */
+inline void writeCSVField(std::ostream& out, const std::string& text) {
+    if (text.find_first_of(",\"\n\r") == std::string::npos) {
+        out << text;
+        return;
+    }
+    out << '"';
+    for (char ch : text) {
+        if (ch == '"') out << '"';
+        out << ch;
+    }
+    out << '"';
+}
+
+} // namespace detail
+
+#endif // DETAIL_TEXT_OUTPUT_H
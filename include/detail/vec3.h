@@ -0,0 +1,27 @@
+#ifndef DETAIL_VEC3_H
+#define DETAIL_VEC3_H
+
+namespace detail {
+
+/**
+ * @brief 三维向量点积
+ */
+inline double dot3(const double* a, const double* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * @brief 三维向量叉积（out可与a、b相同）
+ */
+inline void cross3(const double* a, const double* b, double* out) {
+    double x = a[1] * b[2] - a[2] * b[1];
+    double y = a[2] * b[0] - a[0] * b[2];
+    double z = a[0] * b[1] - a[1] * b[0];
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+}
+
+} // namespace detail
+
+#endif // DETAIL_VEC3_H
@@ -0,0 +1,164 @@
+#ifndef DEVIATION_ANALYZER_H
+#define DEVIATION_ANALYZER_H
+
+#include "model_manager.h"
+#include "rigid_registration.h"
+#include "triangle_bvh.h"
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 偏差分析参数
+ */
+struct DeviationOptions {
+    double max_distance;    // 最大搜索距离，超出的点记为未匹配
+    double tolerance;       // 公差带半宽，|偏差|不超过该值视为合格
+    double histogram_range; // 直方图范围[-range, range]，超出范围的点计入两端溢出计数
+    int histogram_bins;     // 直方图分箱数
+    size_t chunk_size;      // 流式读取的分块点数
+    RigidTransform transform; // 分析前施加到点上的变换（通常为ICP配准结果）
+
+    DeviationOptions()
+        : max_distance(std::numeric_limits<double>::max()),
+          tolerance(0.1),
+          histogram_range(0.5),
+          histogram_bins(50),
+          chunk_size(1 << 20) {}
+};
+
+/**
+ * @brief 偏差统计
+ *
+ * 偏差为点到名义曲面的有向距离，位于曲面外侧为正
+ */
+struct DeviationStats {
+    size_t count;             // 已匹配点数
+    size_t unmatched;         // 超出最大搜索距离的点数
+    size_t within_tolerance;  // 公差带内的点数
+    double min;               // 最小偏差
+    double max;               // 最大偏差
+    double mean;              // 平均偏差
+    double rms;               // 均方根偏差
+    double std_dev;           // 标准差
+    double histogram_range;   // 直方图范围
+    std::vector<size_t> histogram; // 各分箱点数
+    size_t below_range;       // 低于直方图范围的点数
+    size_t above_range;       // 高于直方图范围的点数
+
+    DeviationStats()
+        : count(0), unmatched(0), within_tolerance(0), min(0.0), max(0.0), mean(0.0), rms(0.0),
+          std_dev(0.0), histogram_range(0.0), below_range(0), above_range(0) {}
+
+    /**
+     * @brief 由直方图估计偏差分位数
+     *
+     * @param fraction 分位（0~1）
+     * @return double 分位数（分箱内线性插值）
+     */
+    double percentile(double fraction) const;
+};
+
+/**
+ * @brief 点云分块读取函数
+ *
+ * 向xs/ys/zs写入最多capacity个点，返回实际写入数量，返回0表示读取结束
+ */
+typedef std::function<size_t(double* xs, double* ys, double* zs, size_t capacity)> PointChunkSource;
+
+/**
+ * @brief 逐点偏差输出函数
+ *
+ * 每个分块处理完后按输入顺序调用一次；first为分块首点在整个点流中的序号，
+ * 坐标为施加变换后的坐标，未匹配点的偏差为NaN
+ */
+typedef std::function<void(size_t first, size_t count, const double* xs, const double* ys, const double* zs,
+                           const double* deviations)> DeviationSink;
+
+/**
+ * @brief 偏差分析类
+ *
+ * 基于BVH最近点查询计算扫描点到名义模型的有向偏差。
+ * 符号取最近点所在特征（面、边或顶点）的角度加权伪法向，
+ * 对封闭且方向一致的模型，点位于尖锐边或顶点附近时符号同样可靠。
+ *
+ * 点云以分块方式流式读入：当前分块在线程间并行查询的同时由后台线程读取下一块，
+ * 内存占用只与分块大小有关，可处理超出内存容量的点云
+ */
+class DeviationAnalyzer {
+public:
+    /**
+     * @brief 从名义模型构建
+     *
+     * @param nominal 名义模型
+     */
+    explicit DeviationAnalyzer(const ModelManager& nominal);
+
+    /**
+     * @brief 复用已构建的BVH
+     *
+     * @param bvh 名义模型的三角形BVH
+     */
+    explicit DeviationAnalyzer(std::shared_ptr<const TriangleBVH> bvh);
+
+    /**
+     * @brief 单点有向偏差
+     *
+     * @param x x坐标
+     * @param y y坐标
+     * @param z z坐标
+     * @param max_distance 最大搜索距离
+     * @return double 有向偏差，未找到时为NaN
+     */
+    double deviation(double x, double y, double z,
+                     double max_distance = std::numeric_limits<double>::max()) const;
+
+    /**
+     * @brief 流式分析点云
+     *
+     * @param source 点云分块读取函数
+     * @param options 分析参数
+     * @param sink 逐点偏差输出函数（可为空）
+     * @return DeviationStats 偏差统计
+     */
+    DeviationStats analyze(const PointChunkSource& source, const DeviationOptions& options = DeviationOptions(),
+                           const DeviationSink& sink = DeviationSink()) const;
+
+    /**
+     * @brief 分析内存中的点云（SoA）
+     *
+     * @param xs x坐标
+     * @param ys y坐标
+     * @param zs z坐标
+     * @param count 点数量
+     * @param options 分析参数
+     * @param sink 逐点偏差输出函数（可为空）
+     * @return DeviationStats 偏差统计
+     */
+    DeviationStats analyze(const double* xs, const double* ys, const double* zs, size_t count,
+                           const DeviationOptions& options = DeviationOptions(),
+                           const DeviationSink& sink = DeviationSink()) const;
+
+    /**
+     * @brief 偏差色图
+     *
+     * 公差带内为绿色，向负方向经青色渐变为蓝色、向正方向经黄色渐变为红色，
+     * 在直方图范围处饱和；NaN（未匹配）为灰色
+     *
+     * @param deviation 有向偏差
+     * @param options 分析参数（使用tolerance与histogram_range）
+     * @param rgb 输出颜色
+     */
+    static void colorMap(double deviation, const DeviationOptions& options, unsigned char rgb[3]);
+
+private:
+    void buildPseudoNormals();
+
+    std::shared_ptr<const TriangleBVH> bvh_ptr;
+    // 每个三角形（BVH顺序）21个分量：面法向，三个顶点伪法向，三条边（01、12、20）伪法向
+    std::vector<double> pseudo_normals;
+};
+
+#endif // DEVIATION_ANALYZER_H
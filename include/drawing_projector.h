@@ -0,0 +1,132 @@
+#ifndef DRAWING_PROJECTOR_H
+#define DRAWING_PROJECTOR_H
+
+#include "model_manager.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 标准视图
+ */
+enum class StandardView {
+    Front,     // 主视图：沿+y方向观察
+    Back,      // 后视图：沿−y方向观察
+    Top,       // 俯视图：沿−z方向观察
+    Bottom,    // 仰视图：沿+z方向观察
+    Left,      // 左视图：沿+x方向观察
+    Right,     // 右视图：沿−x方向观察
+    Isometric  // 正等轴测图：从(1, −1, 1)方向观察
+};
+
+/**
+ * @brief 投影线段
+ */
+struct DrawingLine {
+    double start[2]; // 起点（视图坐标）
+    double end[2];   // 终点（视图坐标）
+    int edge;        // 来源网格边（MeshTopology中的无向边索引）
+    bool visible;    // 可见线（否则为虚线表示的隐藏线）
+    bool silhouette; // 轮廓线（否则为特征边）
+};
+
+/**
+ * @brief 投影参数
+ */
+struct DrawingOptions {
+    int resolution;      // 深度缓冲分辨率（长边像素数）
+    bool include_hidden; // 是否输出隐藏线
+    double depth_offset; // 面片深度偏移（深度沿x、y每像素变化量之和的倍数），避免边被所在面遮挡
+
+    DrawingOptions() : resolution(512), include_hidden(true), depth_offset(1.5) {}
+};
+
+/**
+ * @brief 单个视图的投影结果
+ *
+ * 视图坐标 x = p·right，y = p·up，观察方向为direction（指向远离观察者）
+ */
+struct DrawingView {
+    double direction[3]; // 观察方向
+    double right[3];     // 视图x轴
+    double up[3];        // 视图y轴
+    std::vector<DrawingLine> lines;
+
+    /**
+     * @brief 可见线数量
+     */
+    size_t visibleCount() const;
+};
+
+/**
+ * @brief 工程视图投影类
+ *
+ * 正交投影生成二维视图的特征边与轮廓线，并做消隐：
+ * - 特征边：边界边、非流形边及相邻面法向夹角超过特征角的边，与视向无关，构造时确定
+ * - 轮廓线：相邻两面一个朝向观察者、一个背离观察者的边，每个视图单独判定，
+ *   用于圆柱等光滑曲面的外形线
+ * - 消隐：将三角剖分结果光栅化到深度缓冲（按深度斜率偏移面片，类似多边形偏移），
+ *   边按像素步长采样比较深度，拆分为可见段与隐藏段
+ *
+ * 每个视图使用独立的深度缓冲，批量接口在视图间并行
+ */
+class DrawingProjector {
+public:
+    /**
+     * @brief 从模型构建
+     *
+     * @param manager 模型管理器
+     * @param feature_angle 特征角（度）
+     */
+    explicit DrawingProjector(const ModelManager& manager, double feature_angle = 30.0);
+
+    /**
+     * @brief 特征边数量
+     */
+    size_t featureEdgeCount() const { return feature_edges.size(); }
+
+    /**
+     * @brief 投影单个视图
+     *
+     * @param direction 观察方向（无需归一化）
+     * @param options 投影参数
+     * @return DrawingView 投影结果
+     */
+    DrawingView project(const double* direction, const DrawingOptions& options = DrawingOptions()) const;
+
+    /**
+     * @brief 投影标准视图
+     */
+    DrawingView project(StandardView view, const DrawingOptions& options = DrawingOptions()) const;
+
+    /**
+     * @brief 批量投影（多线程）
+     *
+     * @param directions 观察方向数组，每个方向3个分量
+     * @param count 视图数量
+     * @param options 投影参数
+     * @return std::vector<DrawingView> 投影结果
+     */
+    std::vector<DrawingView> project(const double* directions, size_t count,
+                                     const DrawingOptions& options = DrawingOptions()) const;
+
+    /**
+     * @brief 标准视图的观察方向
+     *
+     * @param view 标准视图
+     * @param direction 输出观察方向
+     */
+    static void viewDirection(StandardView view, double* direction);
+
+private:
+    std::vector<double> positions;      // 顶点坐标（每个顶点3个分量）
+    std::vector<int> triangle_vertices; // 三角剖分顶点索引
+    std::vector<int> triangle_faces;    // 三角形所属面
+    std::vector<int> edge_vertices;     // 无向边端点
+    std::vector<int> edge_faces;        // 每条边的两个相邻面，边界边第二个为-1
+    std::vector<double> face_normals;   // 面法向（Newell法，每个面3个分量）
+    std::vector<int> feature_edges;     // 特征边索引
+    std::vector<char> feature_flags;    // 每条边是否为特征边
+    bool closed;                        // 封闭流形网格（可剔除背面）
+};
+
+#endif // DRAWING_PROJECTOR_H
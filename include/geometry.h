@@ -70,4 +70,40 @@ struct Face {
     }
 };
 
+/**
+ * @brief 顶点法向权重方式
+ */
+enum class NormalWeighting {
+    Angle, // 按顶点处面内角加权
+    Area   // 按面面积加权
+};
+
+/**
+ * @brief 顶点法向数据
+ * 
+ * 存储面法向、顶点平滑法向以及按折角拆分后的角点法向，
+ * 角点顺序与MeshTopology::face_vertices一致
+ */
+struct VertexNormals {
+    std::vector<double> face_normals;   // 面单位法向，每面3个分量
+    std::vector<double> face_areas;     // 面面积
+    std::vector<double> vertex_normals; // 顶点平滑法向（不拆分），每顶点3个分量
+    std::vector<double> corner_normals; // 角点法向（按折角拆分），每角点3个分量
+    NormalWeighting weighting;          // 权重方式
+    double crease_angle;                // 折角阈值（弧度）
+    
+    VertexNormals() : weighting(NormalWeighting::Angle), crease_angle(0.0) {}
+};
+
+/**
+ * @brief 属性通道所属的几何域
+ * 
+ * 边域的索引对应MeshTopology中的无向边
+ */
+enum class AttributeDomain {
+    Vertex,
+    Edge,
+    Face
+};
+
 #endif // GEOMETRY_H
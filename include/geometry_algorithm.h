@@ -3,9 +3,35 @@
 
 #include "geometry.h"
 #include "model_manager.h"
+#include "mesh_topology.h"
+#include "profile2d.h"
+#include "ray_caster.h"
+#include <array>
 #include <vector>
 #include <memory>
 
+/**
+ * @brief 边倒角类型
+ */
+enum class EdgeBlendType {
+    Sharp,   // 保持尖边
+    Chamfer, // 等距倒角
+    Fillet   // 圆角
+};
+
+/**
+ * @brief 拉伸端面棱边的倒角/圆角参数
+ */
+struct EdgeBlend {
+    EdgeBlendType type;     // 倒角类型
+    double size;            // 倒角距离或圆角半径
+    int segments;           // 圆角分段数
+    std::vector<int> edges; // 参与倒角的轮廓边（边i为清理后轮廓的顶点i→i+1），为空时为整圈
+
+    EdgeBlend() : type(EdgeBlendType::Sharp), size(0.0), segments(4) {}
+    EdgeBlend(EdgeBlendType type, double size, int segments = 4) : type(type), size(size), segments(segments) {}
+};
+
 /**
  * @brief 几何算法类
  * 
@@ -33,14 +59,53 @@ public:
      */
     static Point3D projectPointToFace(const Point3D& point, const Face& face, const ModelManager& manager);
     
+    /**
+     * @brief 批量计算点到模型表面的投影（最近点）
+     * 
+     * 点以结构数组（SoA）传入，可直接使用PointCloud的分块视图；按点并行查询BVH。
+     * 输出数组可与输入数组相同（原地投影）
+     * 
+     * @param bvh 模型的三角形BVH
+     * @param xs 点x坐标
+     * @param ys 点y坐标
+     * @param zs 点z坐标
+     * @param count 点数量
+     * @param out_x 输出投影点x坐标
+     * @param out_y 输出投影点y坐标
+     * @param out_z 输出投影点z坐标
+     * @param distances 可选的输出距离
+     */
+    static void projectPointsToSurface(const TriangleBVH& bvh, const double* xs, const double* ys, const double* zs,
+                                       size_t count, double* out_x, double* out_y, double* out_z,
+                                       double* distances = nullptr);
+    
     /**
      * @brief 计算面的法向量
      * 
+     * 按值返回，可在多线程中并发调用
+     * 
      * @param face 面
      * @param manager 模型管理器
-     * @return double* 法向量数组 [x, y, z]
+     * @return std::array<double, 3> 单位法向量 [x, y, z]
+     */
+    static std::array<double, 3> calculateFaceNormal(const Face& face, const ModelManager& manager);
+    
+    /**
+     * @brief 计算顶点法向（按折角拆分）
+     * 
+     * 先并行计算面法向与面积，再对每个顶点沿顶点→面邻接收集（无散射写入）
+     * 相邻面法向：角点法向只累加与所在面法向夹角不超过折角阈值的面，
+     * 因此六角头棱边等尖锐边两侧得到各自的法向。
+     * 一般通过ModelManager::getVertexNormals获取缓存结果
+     * 
+     * @param manager 模型管理器
+     * @param topology 网格拓扑邻接结构
+     * @param weighting 权重方式
+     * @param crease_angle 折角阈值（弧度）
+     * @return VertexNormals 顶点法向数据
      */
-    static double* calculateFaceNormal(const Face& face, const ModelManager& manager);
+    static VertexNormals calculateVertexNormals(const ModelManager& manager, const MeshTopology& topology,
+                                                NormalWeighting weighting, double crease_angle);
     
     /**
      * @brief 平移变换
@@ -84,15 +149,87 @@ public:
     /**
      * @brief 旋转特征建模
      * 
+     * 轮廓顶点绕过axis_point、方向为axis_direction（无需单位化）的轴按右手定则旋转；
+     * 旋转一整圈（|angle| = 2π）时生成首尾相接的闭合回转体，不生成端面
+     * 
      * @param manager 模型管理器
      * @param profile_vertices 轮廓顶点
      * @param axis_point 旋转轴点
      * @param axis_direction 旋转轴方向
      * @param angle 旋转角度（弧度）
-     * @return bool 是否成功
+     * @return bool 是否成功，轮廓为空、轴方向为零或超过一整圈时返回false
      */
     static bool revolve(ModelManager& manager, const std::vector<Point3D>& profile_vertices, 
                        const Point3D& axis_point, const double* axis_direction, double angle);
+    
+    /**
+     * @brief 以二维轮廓拉伸
+     * 
+     * 轮廓（xy平面，位于z=0）先按容差清理：去除重合点与共线点、检查自相交、统一为逆时针
+     * 
+     * @param manager 模型管理器
+     * @param profile 轮廓
+     * @param distance 拉伸距离
+     * @param tolerance 清理容差
+     * @return bool 是否成功
+     * @throws std::invalid_argument 轮廓无效
+     */
+    static bool extrude(ModelManager& manager, const Profile2D& profile, double distance, double tolerance = 1e-9);
+    
+    /**
+     * @brief 以二维截面旋转
+     * 
+     * 截面位于过旋转轴的半平面内：轮廓x为到旋转轴的距离、y为沿轴方向的坐标，
+     * 即三维坐标 axis_point + x·u + y·a（a为单位轴方向，u为世界x轴在轴法平面内的单位投影，
+     * 轴接近x轴时改用y轴；绕过原点的Z轴时截面即xz平面）。先按容差清理，并要求截面不跨越旋转轴
+     * 
+     * @param manager 模型管理器
+     * @param profile 截面
+     * @param axis_point 旋转轴点
+     * @param axis_direction 旋转轴方向
+     * @param angle 旋转角度（弧度）
+     * @param tolerance 清理容差
+     * @return bool 是否成功
+     * @throws std::invalid_argument 截面无效、跨越旋转轴或轴方向为零
+     */
+    static bool revolve(ModelManager& manager, const Profile2D& profile, const Point3D& axis_point,
+                        const double* axis_direction, double angle, double tolerance = 1e-9);
+    
+    /**
+     * @brief 带端面倒角/圆角的拉伸
+     * 
+     * 与旋转特征相同按截面环生成：端面棱边的倒角/圆角沿高度离散为若干内缩环，
+     * 每个轮廓顶点预先求出选中边内缩单位距离时的位移向量（相邻边偏置线的交点），
+     * 各环坐标只是对轮廓坐标与位移向量的一次线性组合，相邻环之间用四边形缝合。
+     * 未选中的边保持竖直，其端点沿该边滑动，使倒角面在选中边两端正确收口。
+     * 侧棱（竖直边）的倒角/圆角请先对轮廓调用Profile2D::chamfered或filleted
+     * 
+     * @param manager 模型管理器
+     * @param profile 轮廓（xy平面，位于z=0）
+     * @param distance 拉伸距离
+     * @param bottom 起始端面（z=0）棱边倒角
+     * @param top 终止端面棱边倒角
+     * @param tolerance 清理容差
+     * @return bool 是否成功
+     * @throws std::invalid_argument 轮廓无效、两端倒角尺寸之和超过拉伸高度或内缩后轮廓自相交
+     */
+    static bool extrude(ModelManager& manager, const Profile2D& profile, double distance, const EdgeBlend& bottom,
+                        const EdgeBlend& top, double tolerance = 1e-9);
+    
+    /**
+     * @brief 曲面加厚（偏置抽壳）
+     * 
+     * 将曲面顶点沿平滑法向偏置得到另一侧壳体，并沿边界边用四边形缝合，
+     * 直接生成实体，无需布尔运算。每个顶点的偏置距离会被限制：
+     * 不超过凹侧局部曲率半径，也不超过沿偏置方向到曲面自身距离的一半，
+     * 以避免偏置面自相交
+     * 
+     * @param manager 输出模型管理器（应为空）
+     * @param surface 输入曲面模型
+     * @param thickness 厚度，正值沿法向、负值逆法向加厚
+     * @return bool 是否成功
+     */
+    static bool thicken(ModelManager& manager, const ModelManager& surface, double thickness);
 };
 
 #endif // GEOMETRY_ALGORITHM_H
@@ -0,0 +1,128 @@
+#ifndef GEOMETRY_CACHE_H
+#define GEOMETRY_CACHE_H
+
+#include "model_manager.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 特征几何缓存统计
+ */
+struct GeometryCacheStats {
+    size_t memory_hits; // 内存层命中
+    size_t disk_hits;   // 磁盘层命中
+    size_t misses;      // 未命中（重新生成）
+    size_t entries;     // 内存层条目数
+    size_t bytes;       // 内存层占用字节数
+    
+    GeometryCacheStats() : memory_hits(0), disk_hits(0), misses(0), entries(0), bytes(0) {}
+};
+
+/**
+ * @brief 内容寻址的特征几何缓存
+ * 
+ * 以（特征类型、轮廓坐标、特征参数）的SHA-256摘要为键，缓存特征生成的几何，
+ * 相同参数的重复建模（如标准M8螺栓头）直接命中。几何以原生二进制格式（.cadm）存储：
+ * - 内存层：按字节容量淘汰的LRU
+ * - 磁盘层（可选）：目录下以摘要命名的.cadm文件，命中时映射文件并在空模型中校验，
+ *   损坏的文件被删除并按未命中处理
+ * 
+ * 无论命中与否，特征均在空模型中生成后追加到目标模型，
+ * 顶点ID从目标模型的nextVertexId()起依次编号，两种路径结果一致。
+ * 线程安全，可在多个建模线程间共享
+ */
+class GeometryCache {
+public:
+    /**
+     * @brief 构造函数
+     * 
+     * @param memory_capacity 内存层容量（字节）
+     * @param directory 磁盘层目录，为空表示不使用磁盘层（目录需已存在）
+     */
+    explicit GeometryCache(size_t memory_capacity = 64u << 20, const std::string& directory = std::string());
+    
+    /**
+     * @brief 计算特征缓存键
+     * 
+     * 负零按正零处理，使数值相等的参数得到相同的键
+     * 
+     * @param feature 特征类型名称
+     * @param profile 轮廓顶点（仅坐标参与计算）
+     * @param parameters 特征参数
+     * @return std::string 64个字符的十六进制摘要
+     */
+    static std::string makeKey(const std::string& feature, const std::vector<Point3D>& profile,
+                               const std::vector<double>& parameters);
+    
+    /**
+     * @brief 带缓存的拉伸特征建模
+     * 
+     * 参数同GeometryAlgorithm::extrude
+     */
+    bool extrude(ModelManager& manager, const std::vector<Point3D>& profile_vertices, double distance);
+    
+    /**
+     * @brief 带缓存的旋转特征建模
+     * 
+     * 参数同GeometryAlgorithm::revolve
+     */
+    bool revolve(ModelManager& manager, const std::vector<Point3D>& profile_vertices,
+                 const Point3D& axis_point, const double* axis_direction, double angle);
+    
+    /**
+     * @brief 查找缓存并追加到模型
+     * 
+     * @param key 缓存键
+     * @param manager 目标模型
+     * @return bool 是否命中
+     */
+    bool lookup(const std::string& key, ModelManager& manager);
+    
+    /**
+     * @brief 存入缓存（内存层与磁盘层）
+     * 
+     * @param key 缓存键
+     * @param model 特征几何
+     */
+    void store(const std::string& key, const ModelManager& model);
+    
+    /**
+     * @brief 清空内存层
+     */
+    void clear();
+    
+    /**
+     * @brief 获取统计信息
+     */
+    GeometryCacheStats stats() const;
+    
+private:
+    typedef std::shared_ptr<const std::string> Blob;
+    
+    template <typename Build>
+    bool cached(const std::string& key, ModelManager& manager, Build build);
+    
+    Blob findInMemory(const std::string& key);
+    void insertInMemory(const std::string& key, const Blob& blob);
+    bool readFromDisk(const std::string& key, Blob& blob);
+    void writeToDisk(const std::string& key, const std::string& blob);
+    static bool append(const char* data, size_t size, ModelManager& manager);
+    
+    size_t capacity;
+    std::string directory;
+    
+    mutable std::mutex mutex;
+    std::list<std::string> lru; // 最近使用的键在前
+    struct Entry {
+        Blob blob;
+        std::list<std::string>::iterator position;
+    };
+    std::unordered_map<std::string, Entry> entries;
+    GeometryCacheStats counters;
+};
+
+#endif // GEOMETRY_CACHE_H
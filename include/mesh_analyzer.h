@@ -0,0 +1,66 @@
+#ifndef MESH_ANALYZER_H
+#define MESH_ANALYZER_H
+
+#include "model_manager.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief 曲面区域类型
+ */
+enum class SurfaceClass {
+    Planar = 0,      // 平面
+    Cylindrical = 1, // 柱面（单方向弯曲，高斯曲率为零）
+    Curved = 2,      // 双向弯曲曲面
+    Sharp = 3        // 位于特征边上的尖锐区域
+};
+
+/**
+ * @brief 曲率分析参数
+ */
+struct CurvatureOptions {
+    double feature_angle; // 特征边二面角阈值（弧度），超过即视为尖锐边
+    double flat_angle;    // 视为平坦的二面角/角亏阈值（弧度）
+    
+    CurvatureOptions() : feature_angle(M_PI / 6), flat_angle(1e-3) {}
+};
+
+/**
+ * @brief 曲率分析结果
+ * 
+ * 顶点、边、面索引与MeshTopology一致
+ */
+struct CurvatureData {
+    std::vector<double> mean_curvature;       // 顶点平均曲率（外凸为正）
+    std::vector<double> gaussian_curvature;   // 顶点高斯曲率（角亏/混合面积）
+    std::vector<double> dihedral_angles;      // 边有向二面角（外凸为正，边界边为0）
+    std::vector<int> feature_edges;           // 特征边索引（含边界边与非流形边）
+    std::vector<SurfaceClass> vertex_classes; // 顶点区域类型
+    std::vector<SurfaceClass> face_classes;   // 面区域类型（Planar/Cylindrical/Curved）
+};
+
+/**
+ * @brief 网格分析类
+ * 
+ * 提供离散曲率估计、特征边检测与曲面区域分类，
+ * 可在无外部工具的情况下区分revolve生成零件与导入多面体的平面、柱面和尖锐区域
+ */
+class MeshAnalyzer {
+public:
+    /**
+     * @brief 曲率估计与特征边检测
+     * 
+     * 沿边→面邻接并行计算每条边的有向二面角，再沿顶点邻接收集
+     * 平均曲率（Σ|e|θ/4A）与高斯曲率（角亏/A）。
+     * 结果同时写入模型的属性通道：
+     * 顶点域 "mean_curvature"、"gaussian_curvature"、"surface_class"；
+     * 边域 "dihedral_angle"、"feature_edge"；面域 "surface_class"
+     * 
+     * @param manager 模型管理器
+     * @param options 分析参数
+     * @return CurvatureData 曲率分析结果
+     */
+    static CurvatureData analyzeCurvature(ModelManager& manager, const CurvatureOptions& options = CurvatureOptions());
+};
+
+#endif // MESH_ANALYZER_H
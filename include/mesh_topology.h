@@ -0,0 +1,98 @@
+#ifndef MESH_TOPOLOGY_H
+#define MESH_TOPOLOGY_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class ModelManager;
+
+/**
+ * @brief 网格拓扑邻接结构
+ *
+ * 由ModelManager的顶点/边/面构建的只读邻接数据，采用CSR（压缩行）存储：
+ * - 面顶点环：每个面按边首尾相接得到的有序顶点环，且相邻面方向一致
+ * - 顶点→面邻接：每个顶点关联的面及其在面顶点环中的角点位置
+ * - 边→面邻接：由面顶点环导出的无向边及其关联面
+ * - 三角剖分：凸面扇形三角化，凹面耳切，供加速结构使用
+ *
+ * 顶点索引与ModelManager::getVertices()中的位置一致，
+ * 面索引与ModelManager::getFaces()中的位置一致。
+ * 封闭分量的朝向由有向体积决定，三角剖分也依赖面的形状，
+ * 因此坐标变化后同样需要重建（ModelManager按几何版本号缓存）
+ */
+class MeshTopology {
+public:
+    /**
+     * @brief 从模型管理器构建拓扑
+     *
+     * @param manager 模型管理器
+     */
+    explicit MeshTopology(const ModelManager& manager);
+
+    /**
+     * @brief 顶点数量
+     */
+    size_t vertexCount() const { return vertex_face_offsets.size() - 1; }
+
+    /**
+     * @brief 面数量
+     */
+    size_t faceCount() const { return face_offsets.size() - 1; }
+
+    /**
+     * @brief 无向边数量
+     */
+    size_t edgeCount() const { return edge_vertices.size() / 2; }
+
+    /**
+     * @brief 三角形数量
+     */
+    size_t triangleCount() const { return triangle_faces.size(); }
+
+    /**
+     * @brief 通过顶点ID获取顶点索引
+     *
+     * @param vertex_id 顶点ID
+     * @return int 顶点索引，不存在时返回-1
+     */
+    int vertexIndex(int vertex_id) const;
+
+    // 面顶点环（CSR）：面f的顶点为face_vertices[face_offsets[f] .. face_offsets[f+1])
+    std::vector<int> face_offsets;
+    std::vector<int> face_vertices;
+    // 面顶点环是否由边首尾相接闭合得到（否则为按出现顺序收集的近似环）
+    std::vector<char> face_closed;
+    // 统一方向时面顶点环是否相对边顺序给出的环做了翻转
+    std::vector<char> face_flipped;
+    // 面所在的连通分量（经流形边相连）
+    std::vector<int> face_components;
+
+    // 顶点→面邻接（CSR）：vertex_face_corners为对应的角点在face_vertices中的全局位置
+    std::vector<int> vertex_face_offsets;
+    std::vector<int> vertex_faces;
+    std::vector<int> vertex_face_corners;
+
+    // 无向边：edge_vertices[2e], edge_vertices[2e+1]为端点（小索引在前）
+    std::vector<int> edge_vertices;
+    // 边→面邻接（CSR）
+    std::vector<int> edge_face_offsets;
+    std::vector<int> edge_faces;
+    // 角点→无向边：face_vertices[c]到环中下一个顶点的边
+    std::vector<int> corner_edges;
+
+    // 三角剖分：triangle_vertices[3t..3t+2]为顶点索引，triangle_faces[t]为所属面
+    std::vector<int> triangle_vertices;
+    std::vector<int> triangle_faces;
+
+private:
+    void buildFaceLoops(const ModelManager& manager);
+    void buildEdges();
+    void orientFaces(const ModelManager& manager);
+    void buildVertexFaces();
+    void buildTriangles(const ModelManager& manager);
+
+    std::unordered_map<int, int> vertex_index; // 顶点ID到顶点索引的映射
+};
+
+#endif // MESH_TOPOLOGY_H
@@ -0,0 +1,89 @@
+#ifndef MODEL_FINGERPRINT_H
+#define MODEL_FINGERPRINT_H
+
+#include "model_manager.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 模型几何指纹
+ * 
+ * 128位哈希与元素数量，相等即视为几何相同（哈希碰撞概率可忽略）
+ */
+struct Fingerprint {
+    uint64_t hash[2];
+    uint64_t vertex_count;
+    uint64_t face_count;
+    
+    Fingerprint() : vertex_count(0), face_count(0) {
+        hash[0] = 0;
+        hash[1] = 0;
+    }
+    
+    bool operator==(const Fingerprint& other) const {
+        return hash[0] == other.hash[0] && hash[1] == other.hash[1] &&
+               vertex_count == other.vertex_count && face_count == other.face_count;
+    }
+    
+    bool operator!=(const Fingerprint& other) const { return !(*this == other); }
+    
+    /**
+     * @brief 32个字符的十六进制表示（仅哈希部分）
+     */
+    std::string hex() const;
+};
+
+/**
+ * @brief 指纹哈希函数对象，供std::unordered_map等使用
+ */
+struct FingerprintHasher {
+    size_t operator()(const Fingerprint& fingerprint) const {
+        return static_cast<size_t>(fingerprint.hash[0] ^ (fingerprint.hash[1] * 0x9e3779b97f4a7c15ULL));
+    }
+};
+
+/**
+ * @brief 模型几何指纹计算类
+ * 
+ * 指纹只依赖几何与连接关系，与顶点/边/面ID编号、面的存储顺序、
+ * 面顶点环的起点与走向均无关：每个面按顶点坐标哈希得到规范化的面哈希，
+ * 模型指纹为各面哈希混合后的模2^64求和（可交换），可在线程间分块累加后合并。
+ * 
+ * 容差大于0时先将坐标按容差量化到网格，近似重复的零件得到相同指纹；
+ * 恰好跨越量化网格边界的坐标仍会得到不同指纹，因此容差应远大于坐标噪声
+ */
+class ModelFingerprint {
+public:
+    /**
+     * @brief 计算模型指纹
+     * 
+     * @param manager 模型管理器
+     * @param tolerance 量化容差，0表示按精确坐标计算
+     * @param parallel 是否按面并行（已在模型间并行时应关闭，避免嵌套创建线程）
+     * @return Fingerprint 模型指纹
+     */
+    static Fingerprint compute(const ModelManager& manager, double tolerance = 0.0, bool parallel = true);
+    
+    /**
+     * @brief 查找重复模型（按模型并行计算指纹后以哈希表分组）
+     * 
+     * @param models 模型列表
+     * @param tolerance 量化容差，0表示精确比较
+     * @return std::vector<std::vector<size_t>> 重复组（每组至少两个模型索引，按索引升序）
+     */
+    static std::vector<std::vector<size_t>> findDuplicates(const std::vector<std::shared_ptr<const ModelManager>>& models,
+                                                           double tolerance = 0.0);
+    
+    /**
+     * @brief 按已计算的指纹分组
+     * 
+     * @param fingerprints 指纹列表
+     * @return std::vector<std::vector<size_t>> 重复组
+     */
+    static std::vector<std::vector<size_t>> groupDuplicates(const std::vector<Fingerprint>& fingerprints);
+};
+
+#endif // MODEL_FINGERPRINT_H
@@ -0,0 +1,130 @@
+#ifndef MODEL_IO_H
+#define MODEL_IO_H
+
+#include "model_manager.h"
+#include <string>
+
+/**
+ * @brief 模型文件读写类
+ * 
+ * 支持Wavefront OBJ文本格式的顶点与多边形面，
+ * 导入时顶点ID取OBJ中的顶点序号（从1开始），边由面顶点环自动生成。
+ * 
+ * 另提供原生二进制格式（扩展名.cadm，按本机字节序），布局为：
+ * 32字节文件头（魔数"CADM"、版本、顶点数、面数、面顶点索引总数），
+ * 随后依次为x[n]、y[n]、z[n]坐标（double）、顶点ID（int32）、
+ * 面偏移（uint32，共面数+1个）与面顶点索引（uint32），各段均自然对齐，
+ * 可直接映射到内存后读取
+ */
+class ModelIO {
+public:
+    /**
+     * @brief 从内存缓冲区解析OBJ
+     * 
+     * @param data 文件内容
+     * @param size 内容字节数
+     * @param manager 模型管理器（追加写入，解析失败时保持不变）
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    static bool parseOBJ(const char* data, size_t size, ModelManager& manager, std::string* error = nullptr);
+    
+    /**
+     * @brief 读取OBJ文件
+     * 
+     * @param path 文件路径
+     * @param manager 模型管理器（追加写入）
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    static bool loadOBJ(const std::string& path, ModelManager& manager, std::string* error = nullptr);
+    
+    /**
+     * @brief 写出OBJ文件
+     * 
+     * 面按MeshTopology中方向一致的顶点环写出
+     * 
+     * @param path 文件路径
+     * @param manager 模型管理器
+     * @return bool 是否成功
+     */
+    static bool saveOBJ(const std::string& path, const ModelManager& manager);
+    
+    /**
+     * @brief 从内存缓冲区解析原生二进制格式
+     * 
+     * 整个缓冲区校验通过后才写入模型，失败时模型保持不变
+     * 
+     * @param data 文件内容
+     * @param size 内容字节数
+     * @param manager 模型管理器（追加写入）
+     * @param error 可选的错误信息输出
+     * @param keep_vertex_ids 是否保留文件中的顶点ID；默认与parseOBJ相同从nextVertexId()起重新编号，
+     *                        保留时ID重复或与已有顶点冲突视为失败
+     * @return bool 是否成功
+     */
+    static bool parseBinary(const char* data, size_t size, ModelManager& manager, std::string* error = nullptr,
+                            bool keep_vertex_ids = false);
+    
+    /**
+     * @brief 读取原生二进制文件
+     * 
+     * @param path 文件路径
+     * @param manager 模型管理器（追加写入）
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    static bool loadBinary(const std::string& path, ModelManager& manager, std::string* error = nullptr);
+    
+    /**
+     * @brief 将模型编码为原生二进制格式
+     * 
+     * @param manager 模型管理器
+     * @param buffer 输出编码结果
+     */
+    static void encodeBinary(const ModelManager& manager, std::string& buffer);
+    
+    /**
+     * @brief 写出原生二进制文件
+     * 
+     * @param path 文件路径
+     * @param manager 模型管理器
+     * @return bool 是否成功
+     */
+    static bool saveBinary(const std::string& path, const ModelManager& manager);
+    
+    /**
+     * @brief 按扩展名读取模型（.cadm为二进制，其余按OBJ）
+     * 
+     * @param path 文件路径
+     * @param manager 模型管理器（追加写入）
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    static bool load(const std::string& path, ModelManager& manager, std::string* error = nullptr);
+    
+    /**
+     * @brief 按扩展名写出模型（.cadm为二进制，其余按OBJ）
+     * 
+     * @param path 文件路径
+     * @param manager 模型管理器
+     * @return bool 是否成功
+     */
+    static bool save(const std::string& path, const ModelManager& manager);
+    
+    /**
+     * @brief 判断路径是否为原生二进制格式（扩展名.cadm）
+     */
+    static bool isBinaryPath(const std::string& path);
+    
+    /**
+     * @brief 读取整个文件到字符串
+     * 
+     * @param path 文件路径
+     * @param content 输出文件内容
+     * @return bool 是否成功
+     */
+    static bool readFile(const std::string& path, std::string& content);
+};
+
+#endif // MODEL_IO_H
@@ -3,8 +3,14 @@
 
 #include "geometry.h"
 #include <unordered_map>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
+#include <cstdint>
+
+class MeshTopology;
 
 /**
  * @brief CAD模型管理器
@@ -25,6 +31,19 @@ public:
      */
     ~ModelManager();
     
+    /**
+     * @brief 拷贝构造函数
+     * 
+     * 顶点、边、面对象做深拷贝，修改副本不影响原模型；
+     * 只读缓存（拓扑、法向、属性通道）直接共享
+     */
+    ModelManager(const ModelManager& other);
+    
+    /**
+     * @brief 拷贝赋值
+     */
+    ModelManager& operator=(const ModelManager& other);
+    
     /**
      * @brief 添加顶点
      * 
@@ -55,6 +74,41 @@ public:
      */
     std::shared_ptr<Face> addFace(int id, const std::vector<int>& edge_ids);
     
+    /**
+     * @brief 按顶点ID环添加面
+     * 
+     * 相邻顶点间的边已存在时复用，否则以新的边ID创建
+     * 
+     * @param id 面ID
+     * @param vertex_ids 按面方向排列的顶点ID环
+     * @return std::shared_ptr<Face> 添加的面智能指针，顶点不存在时返回nullptr
+     */
+    std::shared_ptr<Face> addFaceFromVertices(int id, const std::vector<int>& vertex_ids);
+    
+    /**
+     * @brief 查找连接两个顶点的边
+     * 
+     * @param vertex_a 顶点ID
+     * @param vertex_b 顶点ID
+     * @return int 边ID（与方向无关），不存在时返回-1
+     */
+    int findEdge(int vertex_a, int vertex_b) const;
+    
+    /**
+     * @brief 获取下一个未使用的顶点ID（当前最大ID加1）
+     */
+    int nextVertexId() const { return max_vertex_id + 1; }
+    
+    /**
+     * @brief 获取下一个未使用的边ID（当前最大ID加1）
+     */
+    int nextEdgeId() const { return max_edge_id + 1; }
+    
+    /**
+     * @brief 获取下一个未使用的面ID（当前最大ID加1）
+     */
+    int nextFaceId() const { return max_face_id + 1; }
+    
     /**
      * @brief 通过ID获取顶点
      * 
@@ -121,13 +175,115 @@ public:
      */
     void reserveFaces(size_t size);
     
+    /**
+     * @brief 估算模型占用的内存字节数
+     * 
+     * 按顶点、边、面对象及其索引映射的典型开销估算，不含缓存
+     * 
+     * @return size_t 估算字节数
+     */
+    size_t estimateMemoryUsage() const;
+    
+    /**
+     * @brief 修改顶点坐标
+     * 
+     * 坐标修改应通过该接口进行，以便使法向等几何缓存失效
+     * 
+     * @param id 顶点ID
+     * @param x x坐标
+     * @param y y坐标
+     * @param z z坐标
+     * @return bool 顶点是否存在
+     */
+    bool setVertexPosition(int id, double x, double y, double z);
+    
+    /**
+     * @brief 标记几何已修改
+     * 
+     * 通过顶点智能指针直接修改坐标后需调用，使几何缓存失效
+     */
+    void markGeometryModified();
+    
+    /**
+     * @brief 获取拓扑版本号（增删顶点、边、面时递增）
+     */
+    uint64_t getTopologyVersion() const { return topology_version; }
+    
+    /**
+     * @brief 获取几何版本号（拓扑或坐标变化时递增）
+     */
+    uint64_t getGeometryVersion() const { return geometry_version; }
+    
+    /**
+     * @brief 获取网格拓扑邻接结构
+     * 
+     * 结果按模型缓存，拓扑或坐标变化后自动重建
+     * 
+     * @return std::shared_ptr<const MeshTopology> 拓扑邻接结构
+     */
+    std::shared_ptr<const MeshTopology> getMeshTopology() const;
+    
+    /**
+     * @brief 获取顶点法向
+     * 
+     * 结果按模型缓存，坐标或拓扑变化、参数变化后重新计算
+     * 
+     * @param weighting 权重方式
+     * @param crease_angle 折角阈值（弧度），相邻面法向夹角超过该值时拆分
+     * @return std::shared_ptr<const VertexNormals> 顶点法向数据
+     */
+    std::shared_ptr<const VertexNormals> getVertexNormals(NormalWeighting weighting, double crease_angle) const;
+    
+    /**
+     * @brief 设置属性通道
+     * 
+     * 属性通道按域和名称存储逐元素数值（如曲率、特征边标记），
+     * 与当前几何版本绑定，几何或拓扑变化后自动失效
+     * 
+     * @param domain 属性所属几何域
+     * @param name 通道名称
+     * @param values 逐元素数值
+     */
+    void setAttributeChannel(AttributeDomain domain, const std::string& name, std::vector<double> values);
+    
+    /**
+     * @brief 获取属性通道
+     * 
+     * @param domain 属性所属几何域
+     * @param name 通道名称
+     * @return std::shared_ptr<const std::vector<double>> 通道数值，不存在或已失效时返回nullptr
+     */
+    std::shared_ptr<const std::vector<double>> getAttributeChannel(AttributeDomain domain, const std::string& name) const;
+    
 private:
+    void copyFrom(const ModelManager& other);
+    
     std::unordered_map<int, std::shared_ptr<Point3D>> vertex_map; // 顶点ID到顶点对象的映射
     std::unordered_map<int, std::shared_ptr<Edge>> edge_map;     // 边ID到边对象的映射
     std::unordered_map<int, std::shared_ptr<Face>> face_map;     // 面ID到面对象的映射
     std::vector<std::shared_ptr<Point3D>> vertices; // 批量顶点存储
     std::vector<std::shared_ptr<Edge>> edges;      // 批量边存储
     std::vector<std::shared_ptr<Face>> faces;      // 批量面存储
+    
+    std::unordered_map<uint64_t, int> edge_lookup; // 顶点ID对到边ID的映射
+    int max_vertex_id; // 最大顶点ID
+    int max_edge_id;   // 最大边ID
+    int max_face_id;   // 最大面ID
+    
+    uint64_t topology_version; // 拓扑版本号
+    uint64_t geometry_version; // 几何版本号
+    
+    mutable std::mutex cache_mutex; // 缓存互斥锁
+    mutable std::shared_ptr<const MeshTopology> topology_cache; // 拓扑缓存
+    mutable uint64_t topology_cache_version;
+    mutable std::shared_ptr<const VertexNormals> normals_cache; // 法向缓存
+    mutable uint64_t normals_cache_version;
+    
+    struct AttributeChannel {
+        std::shared_ptr<const std::vector<double>> values;
+        uint64_t geometry_version;
+    };
+    std::map<std::pair<int, std::string>, AttributeChannel> attribute_channels; // 属性通道
 };
 
 #endif // MODEL_MANAGER_H
@@ -0,0 +1,187 @@
+#ifndef MODEL_SERVER_H
+#define MODEL_SERVER_H
+
+#include "model_manager.h"
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 本地模型服务器
+ * 
+ * 在进程内常驻若干模型，通过Unix域套接字为本机其他进程（查看器、网格划分、检测等）
+ * 提供查询，避免各进程重复读取同一零件。协议为逐行文本请求、单行JSON响应：
+ * - PING / LIST
+ * - LOAD <名称> <路径>、UNLOAD <名称>
+ * - BBOX <名称>
+ * - CLOSEST <名称> <x> <y> <z> [最大距离]
+ * - TOPOLOGY <名称>
+ * - EXPORT <名称>：将模型发布到SharedModelRegion共享内存区域，返回区域名称，
+ *   客户端只读映射后直接读取，大块几何数据无需经套接字序列化
+ * - SHUTDOWN
+ * 
+ * 请求行超过64KiB时返回错误并关闭连接。仅在POSIX平台可用，其他平台上start()返回false
+ */
+class ModelServer {
+public:
+    /**
+     * @brief 构造函数
+     * 
+     * @param socket_path Unix域套接字路径
+     */
+    explicit ModelServer(const std::string& socket_path);
+    
+    /**
+     * @brief 析构函数，停止服务并释放共享内存
+     */
+    ~ModelServer();
+    
+    ModelServer(const ModelServer&) = delete;
+    ModelServer& operator=(const ModelServer&) = delete;
+    
+    /**
+     * @brief 添加常驻模型
+     * 
+     * @param name 模型名称（不含空白字符）
+     * @param model 模型
+     * @return bool 是否成功（名称已存在时失败）
+     */
+    bool addModel(const std::string& name, std::shared_ptr<const ModelManager> model);
+    
+    /**
+     * @brief 读取模型文件并常驻
+     * 
+     * @param name 模型名称
+     * @param path 文件路径（OBJ或.cadm）
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool loadModel(const std::string& name, const std::string& path, std::string* error = nullptr);
+    
+    /**
+     * @brief 移除常驻模型及其共享内存
+     * 
+     * @param name 模型名称
+     * @return bool 模型是否存在
+     */
+    bool removeModel(const std::string& name);
+    
+    /**
+     * @brief 开始监听并在后台线程中服务
+     * 
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool start(std::string* error = nullptr);
+    
+    /**
+     * @brief 停止服务，等待所有连接线程结束
+     */
+    void stop();
+    
+    /**
+     * @brief 阻塞直到收到SHUTDOWN请求或调用stop()，然后停止服务
+     */
+    void wait();
+    
+    /**
+     * @brief 是否正在服务
+     */
+    bool isRunning() const { return running; }
+    
+    /**
+     * @brief 处理单条请求
+     * 
+     * @param line 请求行（不含换行）
+     * @return std::string 响应行（JSON，不含换行）
+     */
+    std::string handleRequest(const std::string& line);
+    
+    /**
+     * @brief 获取套接字路径
+     */
+    const std::string& socketPath() const { return socket_path; }
+    
+private:
+    struct ResidentModel;
+    
+    std::shared_ptr<ResidentModel> findModel(const std::string& name) const;
+    void acceptLoop();
+    void serveConnection(int fd, std::shared_ptr<std::atomic<bool>> done);
+    void releaseModel(ResidentModel& model);
+    
+    std::string socket_path;
+    int listen_fd;
+    std::atomic<bool> running;
+    std::thread accept_thread;
+    
+    struct Connection {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+    std::mutex connections_mutex;
+    std::vector<Connection> connections;
+    
+    mutable std::mutex models_mutex;
+    std::map<std::string, std::shared_ptr<ResidentModel>> models;
+    std::atomic<unsigned> export_counter;
+    
+    std::mutex state_mutex;
+    std::condition_variable state_changed;
+};
+
+/**
+ * @brief 本地模型服务器客户端
+ */
+class ModelClient {
+public:
+    ModelClient();
+    ~ModelClient();
+    
+    ModelClient(const ModelClient&) = delete;
+    ModelClient& operator=(const ModelClient&) = delete;
+    
+    /**
+     * @brief 连接服务器
+     * 
+     * @param socket_path Unix域套接字路径
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool connect(const std::string& socket_path, std::string* error = nullptr);
+    
+    /**
+     * @brief 断开连接
+     */
+    void close();
+    
+    /**
+     * @brief 发送请求并等待响应
+     * 
+     * @param line 请求行（不含换行）
+     * @param response 输出响应行
+     * @return bool 是否成功（响应行超过64MiB时断开连接并返回false）
+     */
+    bool request(const std::string& line, std::string& response);
+    
+    /**
+     * @brief 从服务器发布的共享内存读取模型
+     * 
+     * @param shm_name EXPORT响应中的共享内存名称
+     * @param manager 模型管理器（追加写入）
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    static bool importShared(const std::string& shm_name, ModelManager& manager, std::string* error = nullptr);
+    
+private:
+    int fd;
+    std::string pending; // 已接收但尚未返回的数据
+};
+
+#endif // MODEL_SERVER_H
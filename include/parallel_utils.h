@@ -0,0 +1,136 @@
+#ifndef PARALLEL_UTILS_H
+#define PARALLEL_UTILS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 并行工具类
+ *
+ * 提供基于std::thread的简单并行循环，按固定粒度动态分块调度，
+ * 供几何算法对顶点、面等批量数据做并行处理
+ */
+class ParallelUtils {
+public:
+    /**
+     * @brief 获取并行线程数
+     *
+     * @return unsigned 线程数（至少为1）
+     */
+    static unsigned threadCount() {
+        unsigned count = threadCountSetting();
+        if (count == 0) {
+            count = std::thread::hardware_concurrency();
+        }
+        return count == 0 ? 1 : count;
+    }
+
+    /**
+     * @brief 设置并行线程数
+     *
+     * @param count 线程数，0表示使用硬件线程数
+     */
+    static void setThreadCount(unsigned count) {
+        threadCountSetting() = count;
+    }
+
+    /**
+     * @brief 并行循环（带工作线程编号）
+     *
+     * 将[0, count)按grain大小分块，由工作线程动态领取。
+     * func签名为 func(size_t begin, size_t end, unsigned worker)，
+     * worker取值范围为[0, threadCount())，可用于线程局部累加。
+     * func抛出的第一个异常在所有线程结束后于调用线程重新抛出，尚未领取的块不再执行
+     *
+     * @param count 元素数量
+     * @param grain 每块元素数量
+     * @param func 块处理函数
+     */
+    template <typename Func>
+    static void parallelForWithWorker(size_t count, size_t grain, Func func) {
+        if (count == 0) {
+            return;
+        }
+        if (grain == 0) {
+            grain = 1;
+        }
+        size_t chunk_count = (count + grain - 1) / grain;
+        unsigned workers = static_cast<unsigned>(std::min<size_t>(threadCount(), chunk_count));
+        if (workers <= 1) {
+            func(static_cast<size_t>(0), count, 0u);
+            return;
+        }
+
+        // 任一块抛出异常时记录第一个异常并停止分发剩余块，全部线程汇合后在调用线程重新抛出
+        std::atomic<size_t> next_chunk(0);
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        auto fail = [&]() {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next_chunk.store(chunk_count);
+        };
+        auto worker_loop = [&](unsigned worker) {
+            try {
+                for (;;) {
+                    size_t chunk = next_chunk.fetch_add(1);
+                    if (chunk >= chunk_count) {
+                        break;
+                    }
+                    size_t begin = chunk * grain;
+                    size_t end = std::min(count, begin + grain);
+                    func(begin, end, worker);
+                }
+            } catch (...) {
+                fail();
+            }
+        };
+        std::vector<std::thread> threads;
+        try {
+            threads.reserve(workers - 1);
+            for (unsigned w = 1; w < workers; ++w) {
+                threads.push_back(std::thread(worker_loop, w));
+            }
+        } catch (...) {
+            // 线程创建失败不算错误：已创建的线程与调用线程继续领取剩余块
+        }
+        worker_loop(0);
+        for (auto& t : threads) {
+            t.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief 并行循环
+     *
+     * func签名为 func(size_t begin, size_t end)
+     *
+     * @param count 元素数量
+     * @param grain 每块元素数量
+     * @param func 块处理函数
+     */
+    template <typename Func>
+    static void parallelFor(size_t count, size_t grain, Func func) {
+        parallelForWithWorker(count, grain, [&func](size_t begin, size_t end, unsigned) {
+            func(begin, end);
+        });
+    }
+
+private:
+    static unsigned& threadCountSetting() {
+        static unsigned setting = 0;
+        return setting;
+    }
+};
+
+#endif // PARALLEL_UTILS_H
@@ -0,0 +1,240 @@
+#ifndef POINT_CLOUD_H
+#define POINT_CLOUD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 原生点云文件（.cadp）文件头
+ *
+ * 随后为各分块数据，每块依次为x[chunk_size]、y[chunk_size]、z[chunk_size]（double，本机字节序），
+ * 末块同样按chunk_size占位，因此任一分块均可按固定偏移直接映射访问
+ */
+struct PointCloudFileHeader {
+    char magic[4];        // "CADP"
+    uint32_t version;     // 格式版本
+    uint64_t point_count; // 点数量
+    uint64_t chunk_size;  // 每块点数
+    uint64_t reserved;    // 保留
+};
+
+/**
+ * @brief 点云分块视图
+ */
+struct PointChunkView {
+    const double* x;
+    const double* y;
+    const double* z;
+    size_t count;
+
+    PointChunkView() : x(nullptr), y(nullptr), z(nullptr), count(0) {}
+};
+
+/**
+ * @brief 点云容器
+ *
+ * 与ModelManager并列的扫描点存储：不带ID与拓扑，每点只占24字节。
+ * 点按固定大小分块、块内为结构数组（SoA），追加时无需整体搬移，
+ * 分块视图可直接交给偏差分析、配准、绕数等批量接口。
+ *
+ * 可从原生点云文件按只读方式映射到内存（映射模式下不可追加），
+ * 数据按需由操作系统换页，适合远超物理内存的点云
+ */
+class PointCloud {
+public:
+    static const size_t kDefaultChunkSize = 1 << 16; // 默认每块点数
+    static const uint32_t kFileVersion = 1;          // 原生点云文件版本
+
+    PointCloud();
+    ~PointCloud();
+
+    PointCloud(const PointCloud&) = delete;
+    PointCloud& operator=(const PointCloud&) = delete;
+
+    /**
+     * @brief 追加一个点
+     *
+     * @return bool 映射模式下返回false
+     */
+    bool append(double x, double y, double z);
+
+    /**
+     * @brief 批量追加点（SoA）
+     *
+     * @return bool 映射模式下返回false
+     */
+    bool append(const double* xs, const double* ys, const double* zs, size_t count);
+
+    /**
+     * @brief 预留容量
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief 清空点云（同时解除映射）
+     */
+    void clear();
+
+    /**
+     * @brief 点数量
+     */
+    size_t size() const { return point_count; }
+
+    /**
+     * @brief 是否为空
+     */
+    bool empty() const { return point_count == 0; }
+
+    /**
+     * @brief 每块点数
+     */
+    size_t chunkSize() const { return chunk_size; }
+
+    /**
+     * @brief 分块数量
+     */
+    size_t chunkCount() const { return (point_count + chunk_size - 1) / chunk_size; }
+
+    /**
+     * @brief 获取分块视图
+     *
+     * @param index 分块序号
+     * @return PointChunkView 分块视图
+     */
+    PointChunkView chunk(size_t index) const;
+
+    /**
+     * @brief 获取第i个点的坐标
+     *
+     * @param index 点序号
+     * @param point 输出坐标
+     */
+    void point(size_t index, double* point) const {
+        const double* block = chunk_data[index / chunk_size];
+        size_t offset = index % chunk_size;
+        point[0] = block[offset];
+        point[1] = block[chunk_size + offset];
+        point[2] = block[2 * chunk_size + offset];
+    }
+
+    /**
+     * @brief 获取包围盒
+     *
+     * @param bounds_min 输出最小点
+     * @param bounds_max 输出最大点
+     * @return bool 是否非空
+     */
+    bool getBounds(double bounds_min[3], double bounds_max[3]) const;
+
+    /**
+     * @brief 堆上占用的字节数（映射模式为0）
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * @brief 是否为映射模式
+     */
+    bool isMapped() const { return mapping != nullptr; }
+
+    /**
+     * @brief 写出原生点云文件
+     *
+     * @param path 文件路径
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool save(const std::string& path, std::string* error = nullptr) const;
+
+    /**
+     * @brief 以只读映射方式打开原生点云文件
+     *
+     * 不支持内存映射的平台退化为整体读入
+     *
+     * @param path 文件路径
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool openMapped(const std::string& path, std::string* error = nullptr);
+
+private:
+    double* appendChunk();
+
+    size_t chunk_size;                             // 每块点数
+    size_t point_count;                            // 点数量
+    std::vector<double*> chunk_data;               // 各块数据：x、y、z三段连续存放
+    std::vector<std::unique_ptr<double[]>> owned;  // 堆模式下拥有的分块
+    void* mapping;                                 // 映射区域
+    size_t mapping_bytes;                          // 映射字节数
+};
+
+/**
+ * @brief 点云均匀网格索引
+ *
+ * 点按所在网格单元以CSR方式排列，单元数约为点数的1/8，
+ * 每点只额外占用4字节索引（点数上限为2^32）。
+ * 索引引用点云而不复制坐标，点云在索引使用期间不可修改
+ */
+class PointCloudIndex {
+public:
+    /**
+     * @brief 构建索引
+     *
+     * @param cloud 点云
+     * @param cell_size 网格边长，不大于0时按点密度自动选取
+     */
+    explicit PointCloudIndex(const PointCloud& cloud, double cell_size = 0.0);
+
+    /**
+     * @brief 最近点查询
+     *
+     * 由查询点所在单元向外逐层扩展，已找到的点比未访问层更近时停止
+     *
+     * @param x 查询点x坐标
+     * @param y 查询点y坐标
+     * @param z 查询点z坐标
+     * @param max_distance 最大搜索距离
+     * @param index 输出最近点序号
+     * @param distance 输出距离
+     * @return bool 在最大搜索距离内是否找到
+     */
+    bool nearest(double x, double y, double z, double max_distance, size_t& index, double& distance) const;
+
+    /**
+     * @brief 半径查询
+     *
+     * @param x 查询点x坐标
+     * @param y 查询点y坐标
+     * @param z 查询点z坐标
+     * @param radius 查询半径
+     * @param indices 输出点序号（追加，顺序不定）
+     */
+    void radiusSearch(double x, double y, double z, double radius, std::vector<size_t>& indices) const;
+
+    /**
+     * @brief 网格边长
+     */
+    double cellSize() const { return cell; }
+
+    /**
+     * @brief 索引占用的字节数
+     */
+    size_t memoryBytes() const;
+
+private:
+    int cellCoordinate(double value, int axis) const;
+    size_t cellIndex(int i, int j, int k) const {
+        return (static_cast<size_t>(k) * dims[1] + j) * dims[0] + i;
+    }
+
+    const PointCloud& cloud;
+    double origin[3];                  // 网格原点
+    double cell;                       // 网格边长
+    int dims[3];                       // 各方向单元数
+    std::vector<uint32_t> cell_offsets; // 单元→点（CSR）
+    std::vector<uint32_t> cell_points;
+};
+
+#endif // POINT_CLOUD_H
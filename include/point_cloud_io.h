@@ -0,0 +1,150 @@
+#ifndef POINT_CLOUD_IO_H
+#define POINT_CLOUD_IO_H
+
+#include "point_cloud.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 流式点云读取器
+ *
+ * 以固定大小缓冲区分段读取文件，内存占用与文件大小无关。支持格式（按扩展名识别）：
+ * - .xyz/.txt/.pts/.csv：每行 x y z [其他列]，分隔符为空白、逗号或分号，
+ *   非数字开头的行（表头、注释）被跳过；.pts文件开头只有一个整数的点数行也被跳过
+ * - .ply：ascii、binary_little_endian、binary_big_endian，
+ *   取vertex元素的x/y/z属性（任意数值类型与顺序），顶点之后的面等元素被忽略
+ * - .cadp：原生点云文件
+ *
+ * read的签名与PointChunkSource一致，可直接用于偏差分析的流式输入
+ */
+class PointCloudReader {
+public:
+    PointCloudReader();
+    ~PointCloudReader();
+
+    PointCloudReader(const PointCloudReader&) = delete;
+    PointCloudReader& operator=(const PointCloudReader&) = delete;
+
+    /**
+     * @brief 打开文件并解析文件头
+     *
+     * @param path 文件路径
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool open(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief 读取下一批点
+     *
+     * @param xs 输出x坐标
+     * @param ys 输出y坐标
+     * @param zs 输出z坐标
+     * @param capacity 最多读取的点数
+     * @return size_t 实际读取的点数，0表示结束或出错（用failed区分）
+     */
+    size_t read(double* xs, double* ys, double* zs, size_t capacity);
+
+    /**
+     * @brief 关闭文件
+     */
+    void close();
+
+    /**
+     * @brief 读取过程中是否出错
+     */
+    bool failed() const { return !error_message.empty(); }
+
+    /**
+     * @brief 错误信息
+     */
+    const std::string& error() const { return error_message; }
+
+    /**
+     * @brief 文件声明的点数（PLY与原生格式），未知时为0
+     */
+    size_t declaredCount() const { return declared_count; }
+
+private:
+    enum class Format { XYZ, PLYAscii, PLYBinary, Native };
+
+    bool fill(size_t minimum);
+    bool nextLine(char*& line, char*& line_end);
+    bool parseHeaderPLY();
+    size_t readXYZ(double* xs, double* ys, double* zs, size_t capacity);
+    size_t readPLYAscii(double* xs, double* ys, double* zs, size_t capacity);
+    size_t readPLYBinary(double* xs, double* ys, double* zs, size_t capacity);
+    size_t readNative(double* xs, double* ys, double* zs, size_t capacity);
+
+    FILE* file;
+    Format format;
+    std::vector<char> buffer;   // 读缓冲区（末尾保留一个'\0'）
+    size_t buffer_begin;        // 未消费数据起点
+    size_t buffer_end;          // 有效数据终点
+    bool end_of_file;
+    size_t line_number;
+    std::string error_message;
+    size_t declared_count;      // 声明的点数
+    size_t points_read;         // 已读点数
+
+    // PLY顶点记录布局
+    int property_count;         // 每个顶点的属性数（ASCII）
+    size_t record_size;         // 每个顶点的字节数（二进制）
+    int coordinate_property[3]; // x/y/z所在属性序号
+    size_t coordinate_offset[3]; // x/y/z在记录中的字节偏移（二进制）
+    int coordinate_type[3];     // x/y/z的数值类型
+    bool swap_bytes;            // 文件字节序与本机不同
+    bool count_line_pending;    // .pts文件尚未读到首个数据行（可能是点数行）
+
+    // 原生格式的当前分块
+    std::vector<double> native_chunk;
+    size_t native_chunk_size;
+    size_t native_chunk_count;  // 当前分块的点数
+    size_t native_chunk_pos;    // 当前分块已消费的点数
+};
+
+/**
+ * @brief 点云文件读写类
+ */
+class PointCloudIO {
+public:
+    /**
+     * @brief 读取点云文件（按扩展名识别格式），追加到点云
+     *
+     * @param path 文件路径
+     * @param cloud 点云
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    static bool load(const std::string& path, PointCloud& cloud, std::string* error = nullptr);
+
+    /**
+     * @brief 写出XYZ文本文件
+     *
+     * @param path 文件路径
+     * @param cloud 点云
+     * @return bool 是否成功
+     */
+    static bool saveXYZ(const std::string& path, const PointCloud& cloud);
+
+    /**
+     * @brief 流式转换点云文件
+     *
+     * 逐块读取并写出，不在内存中保留整个点云；输出扩展名为.cadp时写原生格式，否则写XYZ文本。
+     * 转换为原生格式后可用PointCloud::openMapped映射打开
+     *
+     * @param input 输入文件路径
+     * @param output 输出文件路径
+     * @param error 可选的错误信息输出
+     * @return size_t 转换的点数，失败时为0
+     */
+    static size_t convert(const std::string& input, const std::string& output, std::string* error = nullptr);
+
+    /**
+     * @brief 判断路径是否为点云文件（按扩展名）
+     */
+    static bool isPointCloudPath(const std::string& path);
+};
+
+#endif // POINT_CLOUD_IO_H
@@ -0,0 +1,91 @@
+#ifndef PRIMITIVE_BUILDER_H
+#define PRIMITIVE_BUILDER_H
+
+#include "model_manager.h"
+
+/**
+ * @brief 解析基本体构建类
+ * 
+ * 按弦高误差（弦与圆弧的最大偏差）自动确定圆周分段数，
+ * 生成圆柱（含空心管）、圆锥（含圆台）、球、圆环和六角棱柱，
+ * 使紧固件库以一致的精度和可预期的规模批量生成。
+ * 坐标先按环批量写入连续数组，再一次性追加到模型管理器，
+ * 顶点、边、面ID从模型当前最大ID之后分配，可在同一模型中组合多个基本体。
+ * 所有基本体的轴线均平行于Z轴
+ */
+class PrimitiveBuilder {
+public:
+    /**
+     * @brief 由弦高误差计算圆周分段数
+     * 
+     * @param radius 半径
+     * @param tolerance 允许的最大弦高误差
+     * @return int 分段数（至少为3）
+     */
+    static int segmentsForTolerance(double radius, double tolerance);
+    
+    /**
+     * @brief 圆柱或空心圆管
+     * 
+     * @param manager 模型管理器
+     * @param center 底面圆心
+     * @param radius 外半径
+     * @param height 高度
+     * @param tolerance 弦高误差
+     * @param inner_radius 内半径，大于0时生成空心圆管（如垫片）
+     * @return bool 是否成功
+     */
+    static bool cylinder(ModelManager& manager, const Point3D& center, double radius, double height,
+                         double tolerance, double inner_radius = 0.0);
+    
+    /**
+     * @brief 圆锥或圆台
+     * 
+     * @param manager 模型管理器
+     * @param center 底面圆心
+     * @param bottom_radius 底面半径
+     * @param top_radius 顶面半径，为0时生成尖顶圆锥
+     * @param height 高度
+     * @param tolerance 弦高误差
+     * @return bool 是否成功
+     */
+    static bool cone(ModelManager& manager, const Point3D& center, double bottom_radius, double top_radius,
+                     double height, double tolerance);
+    
+    /**
+     * @brief 球
+     * 
+     * @param manager 模型管理器
+     * @param center 球心
+     * @param radius 半径
+     * @param tolerance 弦高误差
+     * @return bool 是否成功
+     */
+    static bool sphere(ModelManager& manager, const Point3D& center, double radius, double tolerance);
+    
+    /**
+     * @brief 圆环
+     * 
+     * @param manager 模型管理器
+     * @param center 圆环中心
+     * @param major_radius 中心圆半径
+     * @param minor_radius 截面圆半径
+     * @param tolerance 弦高误差
+     * @return bool 是否成功
+     */
+    static bool torus(ModelManager& manager, const Point3D& center, double major_radius, double minor_radius,
+                      double tolerance);
+    
+    /**
+     * @brief 六角棱柱（螺栓头、螺母）
+     * 
+     * @param manager 模型管理器
+     * @param center 底面中心
+     * @param across_flats 对边距离
+     * @param height 高度
+     * @return bool 是否成功
+     */
+    static bool hexPrism(ModelManager& manager, const Point3D& center, double across_flats, double height);
+};
+
+#endif // PRIMITIVE_BUILDER_H
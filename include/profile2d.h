@@ -0,0 +1,213 @@
+#ifndef PROFILE2D_H
+#define PROFILE2D_H
+
+#include "geometry.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 轮廓所在平面
+ */
+enum class ProfilePlane {
+    XY, // 拉伸轮廓：(x, y) → (x, y, elevation)
+    XZ  // 旋转截面：(x, y) → (x, elevation, y)，x为到旋转轴（z轴）的距离
+};
+
+/**
+ * @brief 二维闭合轮廓
+ *
+ * 拉伸、旋转特征的草图轮廓，顶点坐标按结构数组（SoA）存放，首点不重复。
+ * 生成特征前先调用clean做一次清理：去除重合点与共线点、检查自相交、
+ * 统一为逆时针方向，避免退化边和反向面进入实体。
+ *
+ * 批量操作：
+ * - 方向：鞋带公式求有向面积，按需整体反转
+ * - 简化：Douglas–Peucker，以离首点最远的顶点把闭合轮廓拆成两条折线，显式栈迭代
+ * - 自相交：按边的x区间扫描，活动边表中只保留与扫描线相交的边，
+ *   仅对y区间重叠的边对做线段距离测试
+ * - 偏置：相邻边偏置线求交（斜接），尖角斜接长度超过限制时改为两点倒角
+ * - 倒角/圆角：选中顶点替换为相邻边上的两点或相切圆弧，对应拉伸体的侧棱
+ */
+class Profile2D {
+public:
+    Profile2D() {}
+
+    /**
+     * @brief 从三维点构建（忽略点ID）
+     *
+     * @param points 轮廓顶点
+     * @param plane 轮廓所在平面，决定取哪两个坐标分量
+     * @return Profile2D 轮廓
+     */
+    static Profile2D fromPoints(const std::vector<Point3D>& points, ProfilePlane plane = ProfilePlane::XY);
+
+    /**
+     * @brief 转换为三维点
+     *
+     * @param plane 轮廓所在平面
+     * @param elevation 平面外坐标
+     * @return std::vector<Point3D> 顶点，ID从1开始依次编号
+     */
+    std::vector<Point3D> toPoints(ProfilePlane plane = ProfilePlane::XY, double elevation = 0.0) const;
+
+    /**
+     * @brief 追加顶点
+     */
+    void append(double x, double y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+
+    /**
+     * @brief 预留容量
+     */
+    void reserve(size_t count) {
+        xs.reserve(count);
+        ys.reserve(count);
+    }
+
+    /**
+     * @brief 顶点数量
+     */
+    size_t size() const { return xs.size(); }
+
+    /**
+     * @brief 是否为空
+     */
+    bool empty() const { return xs.empty(); }
+
+    /**
+     * @brief 第i个顶点的x坐标
+     */
+    double x(size_t index) const { return xs[index]; }
+
+    /**
+     * @brief 第i个顶点的y坐标
+     */
+    double y(size_t index) const { return ys[index]; }
+
+    /**
+     * @brief x坐标数组
+     */
+    const double* xData() const { return xs.data(); }
+
+    /**
+     * @brief y坐标数组
+     */
+    const double* yData() const { return ys.data(); }
+
+    /**
+     * @brief 有向面积（逆时针为正）
+     */
+    double signedArea() const;
+
+    /**
+     * @brief 周长
+     */
+    double perimeter() const;
+
+    /**
+     * @brief 是否为逆时针方向
+     */
+    bool isCounterClockwise() const { return signedArea() > 0.0; }
+
+    /**
+     * @brief 反转顶点顺序
+     */
+    void reverse();
+
+    /**
+     * @brief 统一方向
+     *
+     * @param counter_clockwise 目标方向为逆时针
+     * @return bool 是否做了反转
+     */
+    bool normalizeOrientation(bool counter_clockwise = true);
+
+    /**
+     * @brief 去除重合点与共线点
+     *
+     * 与前一个保留点距离不超过容差的点视为重合；共线点按容差做Douglas–Peucker去除，
+     * 去除的点到所在新边的距离不超过容差（折返的尖刺不会被去除，由自相交检查报告）
+     *
+     * @param tolerance 距离容差
+     * @return size_t 去除的顶点数
+     */
+    size_t removeDegenerate(double tolerance);
+
+    /**
+     * @brief Douglas–Peucker简化
+     *
+     * 保留点与原轮廓的偏差不超过容差；简化可能引入自相交，必要时再做检查
+     *
+     * @param tolerance 距离容差
+     * @return Profile2D 简化后的轮廓（至少保留3个顶点）
+     */
+    Profile2D simplified(double tolerance) const;
+
+    /**
+     * @brief 自相交检查
+     *
+     * 不相邻的边距离不超过容差即视为相交；相邻边在公共顶点处折返重叠也视为相交
+     *
+     * @param tolerance 距离容差
+     * @return bool 是否自相交
+     */
+    bool selfIntersects(double tolerance = 0.0) const;
+
+    /**
+     * @brief 偏置
+     *
+     * 偏置量超过局部特征尺寸时结果可能自相交，可用selfIntersects检查
+     *
+     * @param distance 偏置距离，正值向外扩大、负值向内收缩（与轮廓方向无关）
+     * @param miter_limit 斜接长度与偏置距离之比的上限，超过时以两点倒角代替尖角
+     * @return Profile2D 偏置后的轮廓，方向与原轮廓相同
+     */
+    Profile2D offset(double distance, double miter_limit = 2.0) const;
+
+    /**
+     * @brief 顶点倒角
+     *
+     * 每个选中顶点替换为两条相邻边上距顶点distance的两个点
+     *
+     * @param distance 倒角距离
+     * @param corners 选中的顶点序号，为空时为全部顶点
+     * @return Profile2D 倒角后的轮廓
+     * @throws std::invalid_argument 某条边两端的倒角距离之和超过边长
+     */
+    Profile2D chamfered(double distance, const std::vector<size_t>& corners = std::vector<size_t>()) const;
+
+    /**
+     * @brief 顶点圆角
+     *
+     * 每个选中顶点替换为与两条相邻边相切的圆弧，切点到顶点的距离为 r·tan(φ/2)，φ为转角
+     *
+     * @param radius 圆角半径
+     * @param segments 每段圆弧的分段数
+     * @param corners 选中的顶点序号，为空时为全部顶点
+     * @return Profile2D 圆角后的轮廓
+     * @throws std::invalid_argument 某条边两端的切点距离之和超过边长
+     */
+    Profile2D filleted(double radius, int segments = 4,
+                       const std::vector<size_t>& corners = std::vector<size_t>()) const;
+
+    /**
+     * @brief 清理轮廓，供特征建模使用
+     *
+     * 依次去除重合点与共线点、检查有效顶点数与面积、检查自相交，最后统一为逆时针方向
+     *
+     * @param tolerance 距离容差
+     * @return size_t 去除的顶点数
+     * @throws std::invalid_argument 有效顶点不足3个、面积为零或自相交
+     */
+    size_t clean(double tolerance = 1e-9);
+
+private:
+    Profile2D blendCorners(double amount, int segments, bool fillet, const std::vector<size_t>& corners) const;
+
+    std::vector<double> xs; // 顶点x坐标
+    std::vector<double> ys; // 顶点y坐标
+};
+
+#endif // PROFILE2D_H
@@ -0,0 +1,111 @@
+#ifndef RAY_CASTER_H
+#define RAY_CASTER_H
+
+#include "model_manager.h"
+#include "triangle_bvh.h"
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 射线
+ * 
+ * 参数范围[tmin, tmax]内的点为 origin + t * direction
+ */
+struct Ray {
+    double origin[3];    // 起点
+    double direction[3]; // 方向（无需归一化）
+    double tmin;         // 最小参数
+    double tmax;         // 最大参数
+    
+    Ray(double ox = 0.0, double oy = 0.0, double oz = 0.0,
+        double dx = 0.0, double dy = 0.0, double dz = 1.0,
+        double tmin = 0.0, double tmax = std::numeric_limits<double>::infinity())
+        : tmin(tmin), tmax(tmax) {
+        origin[0] = ox;
+        origin[1] = oy;
+        origin[2] = oz;
+        direction[0] = dx;
+        direction[1] = dy;
+        direction[2] = dz;
+    }
+};
+
+/**
+ * @brief 射线求交结果
+ */
+struct RayHit {
+    double t;     // 交点参数
+    double u;     // 重心坐标（三角形第二个顶点权重）
+    double v;     // 重心坐标（三角形第三个顶点权重）
+    int triangle; // BVH顺序中的三角形位置，未命中为-1
+    int face;     // 面索引（ModelManager::getFaces()中的位置），未命中为-1
+    
+    RayHit() : t(std::numeric_limits<double>::infinity()), u(0.0), v(0.0), triangle(-1), face(-1) {}
+    
+    bool hit() const { return face >= 0; }
+};
+
+/**
+ * @brief 射线查询模式
+ */
+enum class RayQueryMode {
+    Nearest, // 最近交点
+    Any      // 任意交点（可见性/遮挡判断，命中即停止）
+};
+
+/**
+ * @brief 射线投射类
+ * 
+ * 基于BVH的射线与模型求交，用于拾取、可见性与视线判断。
+ * 三角形求交采用无缝（watertight）算法，射线穿过共享边或顶点时不会漏判；
+ * 批量接口将射线按4/8条分组成包同时遍历BVH，并在线程间并行
+ */
+class RayCaster {
+public:
+    /**
+     * @brief 从模型管理器构建
+     * 
+     * @param manager 模型管理器
+     */
+    explicit RayCaster(const ModelManager& manager);
+    
+    /**
+     * @brief 复用已构建的BVH
+     * 
+     * @param bvh 三角形BVH
+     */
+    explicit RayCaster(std::shared_ptr<const TriangleBVH> bvh);
+    
+    /**
+     * @brief 单条射线求交
+     * 
+     * @param ray 射线
+     * @param mode 查询模式
+     * @return RayHit 求交结果
+     */
+    RayHit intersect(const Ray& ray, RayQueryMode mode = RayQueryMode::Nearest) const;
+    
+    /**
+     * @brief 批量射线求交
+     * 
+     * 相邻射线组成射线包，方向相近的射线放在一起效果最好
+     * 
+     * @param rays 射线集合
+     * @param hits 输出求交结果，与rays一一对应
+     * @param mode 查询模式
+     * @param packet_width 射线包宽度（4或8）
+     */
+    void intersect(const std::vector<Ray>& rays, std::vector<RayHit>& hits,
+                   RayQueryMode mode = RayQueryMode::Nearest, int packet_width = 8) const;
+    
+    /**
+     * @brief 获取BVH
+     */
+    const TriangleBVH& bvh() const { return *bvh_ptr; }
+    
+private:
+    std::shared_ptr<const TriangleBVH> bvh_ptr; // 三角形BVH
+};
+
+#endif // RAY_CASTER_H
@@ -0,0 +1,136 @@
+#ifndef RIGID_REGISTRATION_H
+#define RIGID_REGISTRATION_H
+
+#include "model_manager.h"
+#include "triangle_bvh.h"
+#include <cstddef>
+#include <limits>
+
+/**
+ * @brief 刚体变换 p' = R·p + t
+ *
+ * 旋转矩阵按行主序存储
+ */
+struct RigidTransform {
+    double rotation[9];   // 旋转矩阵（行主序）
+    double translation[3]; // 平移
+
+    RigidTransform() {
+        for (int i = 0; i < 9; ++i) {
+            rotation[i] = (i % 4 == 0) ? 1.0 : 0.0;
+        }
+        translation[0] = translation[1] = translation[2] = 0.0;
+    }
+
+    /**
+     * @brief 变换一个点
+     *
+     * @param p 输入点
+     * @param out 输出点（可与p相同）
+     */
+    void apply(const double* p, double* out) const {
+        double x = rotation[0] * p[0] + rotation[1] * p[1] + rotation[2] * p[2] + translation[0];
+        double y = rotation[3] * p[0] + rotation[4] * p[1] + rotation[5] * p[2] + translation[1];
+        double z = rotation[6] * p[0] + rotation[7] * p[1] + rotation[8] * p[2] + translation[2];
+        out[0] = x;
+        out[1] = y;
+        out[2] = z;
+    }
+
+    /**
+     * @brief 复合变换：先应用other再应用本变换
+     */
+    RigidTransform compose(const RigidTransform& other) const;
+
+    /**
+     * @brief 逆变换
+     */
+    RigidTransform inverse() const;
+
+    /**
+     * @brief 由旋转向量（轴×角度，Rodrigues公式）与平移构造
+     */
+    static RigidTransform fromRotationVector(const double* omega, const double* t);
+
+    /**
+     * @brief 旋转部分对应的旋转向量（fromRotationVector的逆，角度取[0, π]）
+     */
+    void rotationVector(double* omega) const;
+};
+
+/**
+ * @brief 配准参数
+ */
+struct RegistrationOptions {
+    int max_iterations;                 // 最大迭代次数
+    double max_correspondence_distance; // 对应点最大距离，超出的点视为离群点不参与求解
+    double rotation_tolerance;          // 单步旋转量（弧度）低于该值视为收敛
+    double translation_tolerance;       // 单步平移量低于该值视为收敛
+
+    RegistrationOptions()
+        : max_iterations(50),
+          max_correspondence_distance(std::numeric_limits<double>::max()),
+          rotation_tolerance(1e-8),
+          translation_tolerance(1e-8) {}
+};
+
+/**
+ * @brief 配准结果
+ */
+struct RegistrationResult {
+    RigidTransform transform;   // 将扫描点变换到名义模型坐标系的刚体变换
+    double rms;                 // 最终变换下内点到名义曲面的均方根偏差
+    double max_deviation;       // 最终变换下内点的最大偏差
+    size_t correspondences;     // 最终变换下的内点数量
+    int iterations;             // 求解迭代次数
+    bool converged;             // 是否在最大迭代次数内收敛
+
+    RegistrationResult()
+        : rms(0.0), max_deviation(0.0), correspondences(0), iterations(0), converged(false) {}
+};
+
+/**
+ * @brief 刚体配准类
+ *
+ * 点到面ICP：每次迭代用BVH最近点查询为每个扫描点寻找名义曲面上的对应点，
+ * 以对应三角形法向线性化残差 (R·p + t − q)·n，按点并行累加6×6法方程，
+ * Cholesky求解小角度增量后用Rodrigues公式还原为精确旋转。
+ * 每个分块先在局部变量中累加法方程的21个上三角分量，分块结束再并入工作线程累加器，
+ * 内层循环为定长数组运算，便于编译器向量化且避免线程间伪共享
+ */
+class RigidRegistration {
+public:
+    /**
+     * @brief 将扫描点对齐到名义模型
+     *
+     * 扫描点以结构数组（SoA）形式传入
+     *
+     * @param target 名义模型的BVH
+     * @param xs 扫描点x坐标
+     * @param ys 扫描点y坐标
+     * @param zs 扫描点z坐标
+     * @param count 扫描点数量
+     * @param options 配准参数
+     * @param initial 初始变换
+     * @return RegistrationResult 配准结果
+     */
+    static RegistrationResult alignPointToPlane(const TriangleBVH& target, const double* xs, const double* ys,
+                                                const double* zs, size_t count,
+                                                const RegistrationOptions& options = RegistrationOptions(),
+                                                const RigidTransform& initial = RigidTransform());
+
+    /**
+     * @brief 将源模型的顶点对齐到名义模型
+     *
+     * @param target 名义模型
+     * @param source 源模型（如导入的扫描网格）
+     * @param options 配准参数
+     * @param initial 初始变换
+     * @return RegistrationResult 配准结果
+     */
+    static RegistrationResult alignPointToPlane(const ModelManager& target, const ModelManager& source,
+                                                const RegistrationOptions& options = RegistrationOptions(),
+                                                const RigidTransform& initial = RigidTransform());
+};
+
+#endif // RIGID_REGISTRATION_H
@@ -0,0 +1,46 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief SHA-256摘要计算
+ * 
+ * 按FIPS 180-4实现，可分多次追加数据，用于内容寻址的缓存键等需要强哈希的场合
+ */
+class Sha256 {
+public:
+    Sha256();
+    
+    /**
+     * @brief 追加数据
+     * 
+     * @param data 数据
+     * @param size 字节数
+     */
+    void update(const void* data, size_t size);
+    
+    /**
+     * @brief 结束计算并输出32字节摘要
+     * 
+     * @param digest 输出摘要
+     */
+    void finish(uint8_t* digest);
+    
+    /**
+     * @brief 结束计算并输出64个字符的十六进制摘要
+     */
+    std::string finishHex();
+    
+private:
+    void transform(const uint8_t* block);
+    
+    uint32_t state[8];
+    uint8_t buffer[64];
+    size_t buffer_size;
+    uint64_t total_bytes;
+};
+
+#endif // SHA256_H
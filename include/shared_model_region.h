@@ -0,0 +1,163 @@
+#ifndef SHARED_MODEL_REGION_H
+#define SHARED_MODEL_REGION_H
+
+#include "model_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 共享内存模型区域
+ * 
+ * 将模型的SoA坐标与CSR拓扑发布到命名POSIX共享内存中，供其他进程零拷贝读取。
+ * 区域内所有引用均为相对区域起始地址的字节偏移（而非指针），可映射到任意地址。
+ * 
+ * 区域头部包含序列锁：写者发布前将序列号置为奇数、写完后置为下一个偶数；
+ * 读者在读取前后比较序列号，一致且为偶数即表示读到的是完整的同一版本。
+ * 读者以只读方式映射，无法修改区域内容。
+ * 
+ * 区域布局：头部之后依次为x[n]、y[n]、z[n]（double）、顶点ID（int32）、
+ * 面偏移（uint32，面数+1个）、面顶点索引（uint32）与无向边端点（uint32，每边2个），
+ * 各段按8字节对齐。仅在POSIX平台可用
+ */
+class SharedModelRegion {
+public:
+    /**
+     * @brief 一次读取的快照
+     * 
+     * 指针直接指向共享内存，读取完毕后须调用validate()确认期间未被改写
+     */
+    struct Snapshot {
+        uint64_t sequence;         // 读取开始时的序列号
+        uint64_t topology_version; // 发布时模型的拓扑版本号
+        uint64_t geometry_version; // 发布时模型的几何版本号
+        size_t vertex_count;
+        size_t face_count;
+        size_t index_count;        // 面顶点索引总数
+        size_t edge_count;
+        const double* xs;
+        const double* ys;
+        const double* zs;
+        const int32_t* vertex_ids;
+        const uint32_t* face_offsets;
+        const uint32_t* face_vertices;
+        const uint32_t* edge_vertices;
+    };
+    
+    SharedModelRegion();
+    ~SharedModelRegion();
+    
+    SharedModelRegion(const SharedModelRegion&) = delete;
+    SharedModelRegion& operator=(const SharedModelRegion&) = delete;
+    
+    /**
+     * @brief 创建（或覆盖）命名区域并以写者身份映射
+     * 
+     * @param name 共享内存名称（以'/'开头）
+     * @param capacity 数据区容量（字节），可由requiredBytes()估算
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool create(const std::string& name, size_t capacity, std::string* error = nullptr);
+    
+    /**
+     * @brief 以只读方式映射已存在的区域
+     * 
+     * @param name 共享内存名称
+     * @param error 可选的错误信息输出
+     * @return bool 是否成功
+     */
+    bool attach(const std::string& name, std::string* error = nullptr);
+    
+    /**
+     * @brief 解除映射（不删除共享内存对象）
+     */
+    void close();
+    
+    /**
+     * @brief 删除共享内存对象名称，已映射的进程仍可继续读取
+     * 
+     * @return bool 是否成功
+     */
+    bool unlink();
+    
+    /**
+     * @brief 发布模型（仅写者）
+     * 
+     * @param manager 模型管理器
+     * @return bool 是否成功（容量不足或非写者时失败）
+     */
+    bool publish(const ModelManager& manager);
+    
+    /**
+     * @brief 开始一次读取
+     * 
+     * @param snapshot 输出快照
+     * @return bool 是否读到可用快照（写者正在发布或尚未发布时返回false）
+     */
+    bool beginRead(Snapshot& snapshot) const;
+    
+    /**
+     * @brief 确认快照在读取期间未被改写
+     * 
+     * @param snapshot beginRead()得到的快照
+     * @return bool 快照是否仍然一致
+     */
+    bool validate(const Snapshot& snapshot) const;
+    
+    /**
+     * @brief 读取一致版本的模型副本
+     * 
+     * 确认版本一致并校验结构后才写入模型，失败时模型保持不变；顶点从nextVertexId()起重新编号
+     * 
+     * @param manager 模型管理器（追加写入）
+     * @param max_retries 与写者冲突时的最大重试次数
+     * @return bool 是否成功
+     */
+    bool readModel(ModelManager& manager, int max_retries = 100) const;
+    
+    /**
+     * @brief 当前序列号（偶数表示稳定，0表示尚未发布）
+     */
+    uint64_t sequence() const;
+    
+    /**
+     * @brief 发布模型所需的数据区容量
+     * 
+     * @param manager 模型管理器
+     * @return size_t 字节数
+     */
+    static size_t requiredBytes(const ModelManager& manager);
+    
+    /**
+     * @brief 是否已映射
+     */
+    bool isOpen() const { return base != nullptr; }
+    
+    /**
+     * @brief 是否为写者
+     */
+    bool isWriter() const { return writer; }
+    
+    /**
+     * @brief 共享内存名称
+     */
+    const std::string& name() const { return region_name; }
+    
+    /**
+     * @brief 映射总字节数
+     */
+    size_t mappedBytes() const { return mapped_bytes; }
+    
+private:
+    struct Header;
+    
+    Header* header() const;
+    
+    std::string region_name;
+    void* base;          // 映射起始地址
+    size_t mapped_bytes; // 映射总字节数
+    bool writer;
+};
+
+#endif // SHARED_MODEL_REGION_H
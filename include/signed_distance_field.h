@@ -0,0 +1,87 @@
+#ifndef SIGNED_DISTANCE_FIELD_H
+#define SIGNED_DISTANCE_FIELD_H
+
+#include "model_manager.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 窄带有向距离场
+ * 
+ * 在规则网格节点上存储模型的有向距离（内部为负），仅表面附近的窄带
+ * 按8x8x8节点块分配，块索引表为稠密数组、块数据紧凑连续存放。
+ * 构建时窄带节点用BVH最近点求距离、广义绕数定符号，
+ * 窄带边缘未覆盖的节点再用快速扫描法（fast sweeping）求解程函方程补齐。
+ * 窄带外的查询返回带符号的窄带宽度
+ */
+class SignedDistanceField {
+public:
+    static const int kBlockSize = 8; // 块边长（节点数）
+    
+    /**
+     * @brief 构建距离场
+     * 
+     * @param manager 模型管理器（需封闭且方向一致）
+     * @param cell_size 网格间距
+     * @param band_cells 窄带半宽（网格数）
+     */
+    SignedDistanceField(const ModelManager& manager, double cell_size, int band_cells = 3);
+    
+    /**
+     * @brief 三线性插值查询任意点的有向距离
+     * 
+     * @param x x坐标
+     * @param y y坐标
+     * @param z z坐标
+     * @return double 有向距离（内部为负）
+     */
+    double sample(double x, double y, double z) const;
+    
+    /**
+     * @brief 获取网格节点的有向距离
+     * 
+     * @param i x方向节点索引
+     * @param j y方向节点索引
+     * @param k z方向节点索引
+     * @return double 有向距离
+     */
+    double value(int i, int j, int k) const;
+    
+    /**
+     * @brief 已分配的块数量
+     */
+    size_t allocatedBlocks() const { return values.size() / (kBlockSize * kBlockSize * kBlockSize); }
+    
+    /**
+     * @brief 距离场占用的内存字节数
+     */
+    size_t memoryBytes() const;
+    
+    /**
+     * @brief 节点数量
+     */
+    int sizeX() const { return dims[0]; }
+    int sizeY() const { return dims[1]; }
+    int sizeZ() const { return dims[2]; }
+    
+    /**
+     * @brief 网格间距
+     */
+    double cellSize() const { return cell; }
+    
+private:
+    int blockOf(int i, int j, int k) const {
+        return ((k / kBlockSize) * block_dims[1] + (j / kBlockSize)) * block_dims[0] + (i / kBlockSize);
+    }
+    
+    double origin[3];              // 网格原点
+    double cell;                   // 网格间距
+    double band;                   // 窄带半宽
+    int dims[3];                   // 节点数
+    int block_dims[3];             // 块数
+    std::vector<int32_t> block_offsets; // 块索引表，-1表示未分配
+    std::vector<char> block_inside;     // 未分配块是否位于内部
+    std::vector<float> values;          // 已分配块的节点距离
+};
+
+#endif // SIGNED_DISTANCE_FIELD_H
@@ -0,0 +1,135 @@
+#ifndef SLICER_H
+#define SLICER_H
+
+#include "model_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 截面轮廓（截平面内二维坐标）
+ *
+ * 闭合轮廓首点不重复；实体外轮廓为逆时针（面积为正），孔洞为顺时针
+ */
+struct SliceContour {
+    std::vector<double> x; // 截平面基向量u方向坐标
+    std::vector<double> y; // 截平面基向量v方向坐标
+    bool closed;           // 是否闭合（开放网格或非流形处可能断开）
+
+    SliceContour() : closed(false) {}
+
+    size_t size() const { return x.size(); }
+};
+
+/**
+ * @brief 单个截平面的截面
+ */
+struct Slice {
+    double offset;                      // 截平面位置（沿法向的有符号距离）
+    std::vector<SliceContour> contours; // 截面轮廓
+};
+
+/**
+ * @brief 平面截面类
+ *
+ * 对模型面的三角剖分结果求平行平面截面，用于出图剖视与增材制造分层：
+ * - 顶点按法向高度h预先计算，h不小于截平面位置视为在平面上方（符号扰动），
+ *   恰好落在平面上的顶点不会产生退化线段
+ * - 多个截平面一次扫描：三角形高度区间与排序后的截平面位置二分比较，
+ *   按截平面分桶（CSR）后在截平面间并行处理
+ * - 每个跨越平面的三角形产生一条有向线段，端点以所在网格边的顶点对为键；
+ *   同一条边的交点在两侧三角形中按相同方向插值，坐标完全一致。
+ *   线段按起点键哈希，首尾相接串成轮廓
+ *
+ * 二维坐标基(u, v)满足 u × v = 法向，三维坐标为 offset·n + x·u + y·v
+ */
+class Slicer {
+public:
+    /**
+     * @brief 从模型构建
+     *
+     * @param manager 模型管理器
+     * @param nx 截平面法向x分量
+     * @param ny 截平面法向y分量
+     * @param nz 截平面法向z分量（默认沿z轴分层）
+     */
+    explicit Slicer(const ModelManager& manager, double nx = 0.0, double ny = 0.0, double nz = 1.0);
+
+    /**
+     * @brief 三角形数量
+     */
+    size_t triangleCount() const { return triangle_vertices.size() / 3; }
+
+    /**
+     * @brief 模型沿法向的高度范围
+     *
+     * @param low 输出最小高度
+     * @param high 输出最大高度
+     * @return bool 模型是否非空
+     */
+    bool heightRange(double& low, double& high) const;
+
+    /**
+     * @brief 获取截平面坐标基
+     *
+     * @param u 输出基向量u
+     * @param v 输出基向量v
+     * @param n 输出单位法向
+     */
+    void basis(double* u, double* v, double* n) const;
+
+    /**
+     * @brief 单个截平面
+     *
+     * @param offset 截平面位置
+     * @return Slice 截面
+     */
+    Slice slice(double offset) const;
+
+    /**
+     * @brief 多个平行截平面（多线程）
+     *
+     * @param offsets 截平面位置，任意顺序
+     * @return std::vector<Slice> 与offsets一一对应的截面
+     */
+    std::vector<Slice> slice(const std::vector<double>& offsets) const;
+
+    /**
+     * @brief 等间距分层
+     *
+     * 在高度范围内取count个截平面，位于各层中间：low + (i + 0.5)·(high − low)/count
+     *
+     * @param count 层数
+     * @return std::vector<Slice> 自下而上的截面
+     */
+    std::vector<Slice> sliceUniform(size_t count) const;
+
+    /**
+     * @brief 轮廓有向面积（逆时针为正）
+     */
+    static double signedArea(const SliceContour& contour);
+
+private:
+    struct Segment {
+        uint64_t start_key; // 起点所在边的键
+        uint64_t end_key;   // 终点所在边的键
+        double start[2];
+        double end[2];
+    };
+
+    void buildSegments(int triangle, double offset, std::vector<Segment>& segments) const;
+    void chain(std::vector<Segment>& segments, std::vector<uint32_t>& table, std::vector<char>& flags,
+               std::vector<SliceContour>& contours) const;
+
+    double normal[3];                    // 单位法向
+    double axis_u[3];                    // 截平面基向量u
+    double axis_v[3];                    // 截平面基向量v
+    std::vector<double> vertex_height;   // 顶点沿法向的高度
+    std::vector<double> vertex_u;        // 顶点u坐标
+    std::vector<double> vertex_v;        // 顶点v坐标
+    std::vector<int> triangle_vertices;  // 三角形顶点索引
+    std::vector<double> triangle_low;    // 三角形最低高度
+    std::vector<double> triangle_high;   // 三角形最高高度
+};
+
+#endif // SLICER_H
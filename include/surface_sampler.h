@@ -0,0 +1,105 @@
+#ifndef SURFACE_SAMPLER_H
+#define SURFACE_SAMPLER_H
+
+#include "model_manager.h"
+#include "point_cloud.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 表面采样点集（SoA）
+ */
+struct SurfaceSamples {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<int> faces; // 采样点所在面索引（ModelManager::getFaces()中的位置）
+
+    size_t size() const { return x.size(); }
+};
+
+/**
+ * @brief 表面采样类
+ *
+ * 对模型面的三角剖分结果采样：
+ * - 均匀采样：按三角形面积构建别名表（alias table），每个样本O(1)选取三角形，
+ *   再用平方根变换的重心坐标在三角形内均匀取点
+ * - 泊松圆盘采样：以均匀采样生成候选点，按哈希网格（单元边长r/√3，每单元至多一点）
+ *   逐个接受与已接受点的欧氏距离不小于r的候选点
+ *
+ * 两种采样均按固定划分并行，结果只取决于种子，与线程数无关
+ */
+class SurfaceSampler {
+public:
+    /**
+     * @brief 从模型构建
+     *
+     * @param manager 模型管理器
+     */
+    explicit SurfaceSampler(const ModelManager& manager);
+
+    /**
+     * @brief 表面总面积
+     */
+    double totalArea() const { return total_area; }
+
+    /**
+     * @brief 三角形数量
+     */
+    size_t triangleCount() const { return triangle_faces.size(); }
+
+    /**
+     * @brief 面积加权均匀采样
+     *
+     * 样本按固定大小分块，第b块的随机数流由(seed, b)决定
+     *
+     * @param count 样本数
+     * @param seed 随机种子
+     * @param xs 输出x坐标
+     * @param ys 输出y坐标
+     * @param zs 输出z坐标
+     * @param faces 可选的输出面索引
+     */
+    void sampleUniform(size_t count, uint64_t seed, double* xs, double* ys, double* zs, int* faces = nullptr) const;
+
+    /**
+     * @brief 面积加权均匀采样，追加到点云
+     *
+     * @param count 样本数
+     * @param seed 随机种子
+     * @param cloud 点云
+     */
+    void sampleUniform(size_t count, uint64_t seed, PointCloud& cloud) const;
+
+    /**
+     * @brief 泊松圆盘采样
+     *
+     * 候选点数为 candidate_factor × 面积 / r²。网格按边长不小于r的瓦片划分并按坐标奇偶着色，
+     * 同色瓦片相隔至少一个瓦片，互不冲突，可并行处理；各色依次处理，瓦片内按候选点序号接受。
+     * 距离为三维欧氏距离，薄壁两侧的点也互相排斥
+     *
+     * @param radius 最小间距
+     * @param seed 随机种子
+     * @param candidate_factor 候选点过采样系数
+     * @return SurfaceSamples 采样结果
+     */
+    SurfaceSamples samplePoissonDisk(double radius, uint64_t seed, double candidate_factor = 10.0) const;
+
+private:
+    struct AliasEntry {
+        uint32_t threshold; // 本列保留概率（按2^32缩放）
+        uint32_t alias;     // 别名三角形
+    };
+
+    void buildAliasTable(const std::vector<double>& areas);
+    void generate(uint64_t seed, size_t first_block, size_t count, double* xs, double* ys, double* zs,
+                  int* faces) const;
+
+    std::vector<double> triangle_frames;   // 每个三角形9个分量：顶点a、边ab、边ac
+    std::vector<int> triangle_faces;       // 三角形所属面索引
+    std::vector<AliasEntry> alias_table;   // 别名表
+    double total_area;                     // 总面积
+};
+
+#endif // SURFACE_SAMPLER_H
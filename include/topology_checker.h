@@ -4,6 +4,22 @@
 #include "model_manager.h"
 #include <vector>
 
+/**
+ * @brief 拓扑检测报告
+ */
+struct TopologyReport {
+    std::vector<int> duplicate_edges;      // 重复边
+    std::vector<int> duplicate_faces;      // 重复面
+    std::vector<int> inconsistent_normals; // 法向不一致的面
+    
+    /**
+     * @brief 是否存在拓扑错误
+     */
+    bool hasErrors() const {
+        return !duplicate_edges.empty() || !duplicate_faces.empty() || !inconsistent_normals.empty();
+    }
+};
+
 /**
  * @brief 拓扑错误检测类
  * 
@@ -35,6 +51,14 @@ public:
      */
     static std::vector<int> detectNormalInconsistencies(const ModelManager& manager);
     
+    /**
+     * @brief 执行全部拓扑检测并返回报告（不输出信息）
+     * 
+     * @param manager 模型管理器
+     * @return TopologyReport 检测报告
+     */
+    static TopologyReport checkTopology(const ModelManager& manager);
+    
     /**
      * @brief 检测所有拓扑错误
      * 
@@ -0,0 +1,119 @@
+#ifndef TRIANGLE_BVH_H
+#define TRIANGLE_BVH_H
+
+#include "model_manager.h"
+#include <vector>
+
+/**
+ * @brief BVH节点
+ * 
+ * 叶节点count>0，first为首个三角形在BVH顺序中的位置；
+ * 内部节点count==0，first为左子节点索引，右子节点为first+1
+ */
+struct BVHNode {
+    double bounds_min[3]; // 包围盒最小点
+    double bounds_max[3]; // 包围盒最大点
+    int first;            // 首个三角形位置或左子节点索引
+    int count;            // 叶节点三角形数量
+};
+
+/**
+ * @brief 最近点查询结果
+ */
+struct ClosestPointResult {
+    double point[3]; // 最近点坐标
+    double distance; // 查询点到最近点的距离
+    int triangle;    // BVH顺序中的三角形位置，未找到为-1
+    int face;        // 面索引，未找到为-1
+    
+    ClosestPointResult() : distance(0.0), triangle(-1), face(-1) {
+        point[0] = point[1] = point[2] = 0.0;
+    }
+};
+
+/**
+ * @brief 三角形包围体层次结构（BVH）
+ * 
+ * 对模型面的三角剖分结果按分箱SAH构建二叉BVH，
+ * 三角形顶点坐标按BVH顺序连续存储，供射线求交、最近点、
+ * 绕数及碰撞检测等查询复用。构建后与模型解耦，坐标变化后需重建
+ */
+class TriangleBVH {
+public:
+    /**
+     * @brief 从模型管理器构建
+     * 
+     * @param manager 模型管理器
+     */
+    explicit TriangleBVH(const ModelManager& manager);
+    
+    /**
+     * @brief 从三角形坐标构建
+     * 
+     * @param positions 三角形顶点坐标，每个三角形9个分量
+     * @param faces 每个三角形所属面索引
+     */
+    TriangleBVH(const std::vector<double>& positions, const std::vector<int>& faces);
+    
+    /**
+     * @brief 获取节点数组（根节点为0）
+     */
+    const std::vector<BVHNode>& nodes() const { return node_list; }
+    
+    /**
+     * @brief 三角形数量
+     */
+    size_t triangleCount() const { return triangle_faces.size(); }
+    
+    /**
+     * @brief 获取BVH顺序中第i个三角形的9个顶点坐标分量
+     */
+    const double* triangle(size_t i) const { return &triangle_positions[9 * i]; }
+    
+    /**
+     * @brief 获取BVH顺序中第i个三角形所属面索引
+     */
+    int triangleFace(size_t i) const { return triangle_faces[i]; }
+    
+    /**
+     * @brief 获取整体包围盒
+     * 
+     * @param bounds_min 输出最小点
+     * @param bounds_max 输出最大点
+     * @return bool 是否非空
+     */
+    bool getBounds(double bounds_min[3], double bounds_max[3]) const;
+    
+    /**
+     * @brief 最近点查询
+     * 
+     * 按包围盒距离由近到远遍历，剪除距离超过当前最优值的节点
+     * 
+     * @param x 查询点x坐标
+     * @param y 查询点y坐标
+     * @param z 查询点z坐标
+     * @param max_distance 最大搜索距离
+     * @param result 输出查询结果
+     * @return bool 在最大搜索距离内是否找到
+     */
+    bool closestPoint(double x, double y, double z, double max_distance, ClosestPointResult& result) const;
+    
+    /**
+     * @brief 计算点到三角形的最近点
+     * 
+     * @param p 查询点
+     * @param tri 三角形9个顶点坐标分量
+     * @param closest 输出最近点
+     * @return double 距离平方
+     */
+    static double closestPointOnTriangle(const double* p, const double* tri, double* closest);
+    
+private:
+    void build(const std::vector<double>& positions, const std::vector<int>& faces);
+    
+    std::vector<BVHNode> node_list;          // 节点数组
+    std::vector<double> triangle_positions;  // BVH顺序的三角形坐标
+    std::vector<int> triangle_faces;         // BVH顺序的所属面索引
+};
+
+#endif // TRIANGLE_BVH_H
@@ -0,0 +1,68 @@
+#ifndef VOXELIZER_H
+#define VOXELIZER_H
+
+#include "model_manager.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 位压缩体素网格
+ * 
+ * 每个体素占1位，x方向连续存储，每行(y, z)按64位字对齐
+ */
+struct VoxelGrid {
+    int nx, ny, nz;             // 各方向体素数
+    double origin[3];           // 网格最小角点坐标
+    double voxel_size;          // 体素边长
+    int words_per_row;          // 每行64位字数
+    std::vector<uint64_t> bits; // 位数据
+    
+    VoxelGrid() : nx(0), ny(0), nz(0), voxel_size(0.0), words_per_row(0) {
+        origin[0] = origin[1] = origin[2] = 0.0;
+    }
+    
+    /**
+     * @brief 查询体素是否被占据
+     */
+    bool get(int x, int y, int z) const {
+        if (x < 0 || y < 0 || z < 0 || x >= nx || y >= ny || z >= nz) return false;
+        size_t word = (static_cast<size_t>(z) * ny + y) * words_per_row + (x >> 6);
+        return (bits[word] >> (x & 63)) & 1u;
+    }
+    
+    /**
+     * @brief 统计被占据的体素数
+     */
+    size_t count() const;
+};
+
+/**
+ * @brief 体素化填充方式
+ */
+enum class VoxelFill {
+    Surface, // 仅表面体素
+    Solid    // 表面体素加内部填充
+};
+
+/**
+ * @brief 体素化类
+ * 
+ * 将模型转换为体素网格，供格子类求解器直接使用，无需导出再导入。
+ * 表面采用保守光栅化：与三角形相交的体素均被标记；
+ * 实体填充沿x方向扫描线按穿越奇偶性判断内外（要求模型封闭）。
+ * 按z层并行，各线程写入互不重叠的行
+ */
+class Voxelizer {
+public:
+    /**
+     * @brief 体素化模型
+     * 
+     * @param manager 模型管理器
+     * @param resolution 最长边方向的体素数
+     * @param fill 填充方式
+     * @return VoxelGrid 体素网格（四周各留1层空体素）
+     */
+    static VoxelGrid voxelize(const ModelManager& manager, int resolution, VoxelFill fill = VoxelFill::Solid);
+};
+
+#endif // VOXELIZER_H
@@ -0,0 +1,91 @@
+#ifndef WINDING_NUMBER_H
+#define WINDING_NUMBER_H
+
+#include "model_manager.h"
+#include "triangle_bvh.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 快速广义绕数计算类
+ * 
+ * 用于判断点在实体内部还是外部。广义绕数对导入模型常见的
+ * 小缝隙、重叠面等不完美壳体仍然稳健：内部接近1，外部接近0。
+ * 在BVH每个节点上预计算偶极子（面积加权法向和与中心），
+ * 查询点离节点足够远时用偶极子近似整棵子树的立体角贡献，
+ * 近处则逐三角形精确计算
+ */
+class WindingNumber {
+public:
+    /**
+     * @brief 从模型管理器构建
+     * 
+     * @param manager 模型管理器（面方向需一致朝外，MeshTopology已统一）
+     * @param accuracy 远场判定系数β，查询点到节点中心距离大于β倍节点半径时使用近似
+     */
+    explicit WindingNumber(const ModelManager& manager, double accuracy = 2.0);
+    
+    /**
+     * @brief 复用已构建的BVH
+     * 
+     * @param bvh 三角形BVH
+     * @param accuracy 远场判定系数β
+     */
+    explicit WindingNumber(std::shared_ptr<const TriangleBVH> bvh, double accuracy = 2.0);
+    
+    /**
+     * @brief 计算单点绕数
+     * 
+     * @param x x坐标
+     * @param y y坐标
+     * @param z z坐标
+     * @return double 绕数
+     */
+    double evaluate(double x, double y, double z) const;
+    
+    /**
+     * @brief 判断点是否在实体内部
+     * 
+     * @param x x坐标
+     * @param y y坐标
+     * @param z z坐标
+     * @return bool 绕数不小于0.5时为内部
+     */
+    bool isInside(double x, double y, double z) const { return evaluate(x, y, z) >= 0.5; }
+    
+    /**
+     * @brief 批量计算绕数（多线程）
+     * 
+     * @param xs 查询点x坐标数组
+     * @param ys 查询点y坐标数组
+     * @param zs 查询点z坐标数组
+     * @param count 查询点数量
+     * @param winding 输出绕数数组，长度不小于count
+     */
+    void evaluate(const double* xs, const double* ys, const double* zs, size_t count, double* winding) const;
+    
+    /**
+     * @brief 批量内外分类（多线程）
+     * 
+     * @param xs 查询点x坐标数组
+     * @param ys 查询点y坐标数组
+     * @param zs 查询点z坐标数组
+     * @param count 查询点数量
+     * @param inside 输出分类结果，1为内部，0为外部
+     */
+    void classify(const double* xs, const double* ys, const double* zs, size_t count, std::vector<char>& inside) const;
+    
+    /**
+     * @brief 获取BVH
+     */
+    const TriangleBVH& bvh() const { return *bvh_ptr; }
+    
+private:
+    void precompute();
+    
+    std::shared_ptr<const TriangleBVH> bvh_ptr; // 三角形BVH
+    double beta;                                // 远场判定系数
+    std::vector<double> dipoles;                // 每节点：中心(3)、面积加权法向和(3)、半径(1)
+};
+
+#endif // WINDING_NUMBER_H
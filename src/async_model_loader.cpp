@@ -0,0 +1,261 @@
+#include "async_model_loader.h"
+#include "detail/clock.h"
+#include "model_io.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <exception>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#endif
+
+/**
+ * @brief 单个读取任务，依次经过读取队列与解析队列
+ */
+struct AsyncModelLoader::Task {
+    LoadedModel result;
+    std::string content;
+    std::promise<LoadedModel> promise;
+    const LoadCallback* on_loaded;  // 可选回调（由loadAll设置）
+    std::mutex* on_loaded_mutex;
+    
+    Task() : on_loaded(nullptr), on_loaded_mutex(nullptr) {}
+};
+
+/**
+ * @brief 构造函数
+ * 
+ * @param options 读取选项
+ */
+AsyncModelLoader::AsyncModelLoader(const AsyncLoadOptions& options)
+    : options(options), pending_bytes(0), stopping(false), reads_finished(false) {
+    unsigned io_count = std::max(1u, options.io_threads);
+    unsigned parse_count = options.parse_threads ? options.parse_threads : ParallelUtils::threadCount();
+    for (unsigned i = 0; i < io_count; ++i) {
+        read_threads.push_back(std::thread(&AsyncModelLoader::readLoop, this));
+    }
+    for (unsigned i = 0; i < parse_count; ++i) {
+        parse_threads.push_back(std::thread(&AsyncModelLoader::parseLoop, this));
+    }
+}
+
+/**
+ * @brief 析构函数
+ */
+AsyncModelLoader::~AsyncModelLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    read_ready.notify_all();
+    for (auto& t : read_threads) {
+        t.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        reads_finished = true;
+    }
+    parse_ready.notify_all();
+    for (auto& t : parse_threads) {
+        t.join();
+    }
+}
+
+/**
+ * @brief 提交一个文件读取任务
+ * 
+ * @param path 文件路径
+ * @return std::future<LoadedModel> 读取结果
+ */
+std::future<LoadedModel> AsyncModelLoader::submit(const std::string& path) {
+    std::shared_ptr<Task> task(new Task());
+    task->result.path = path;
+    std::future<LoadedModel> future = task->promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        read_queue.push_back(task);
+    }
+    read_ready.notify_one();
+    return future;
+}
+
+/**
+ * @brief 批量读取
+ * 
+ * @param paths 文件路径列表
+ * @param on_loaded 可选的逐文件回调
+ * @return std::vector<LoadedModel> 按输入顺序排列的结果
+ */
+std::vector<LoadedModel> AsyncModelLoader::loadAll(const std::vector<std::string>& paths,
+                                                   const LoadCallback& on_loaded) {
+    std::mutex on_loaded_mutex;
+    std::vector<std::future<LoadedModel>> futures;
+    futures.reserve(paths.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& path : paths) {
+            std::shared_ptr<Task> task(new Task());
+            task->result.path = path;
+            if (on_loaded) {
+                task->on_loaded = &on_loaded;
+                task->on_loaded_mutex = &on_loaded_mutex;
+            }
+            futures.push_back(task->promise.get_future());
+            read_queue.push_back(task);
+        }
+    }
+    read_ready.notify_all();
+    
+    // 回调异常经future传出；先等待全部任务完成再重新抛出，
+    // 避免仍在运行的任务访问已析构的回调与互斥量
+    std::vector<LoadedModel> results;
+    results.reserve(paths.size());
+    std::exception_ptr failure;
+    for (auto& future : futures) {
+        try {
+            results.push_back(future.get());
+        } catch (...) {
+            if (!failure) failure = std::current_exception();
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return results;
+}
+
+/**
+ * @brief 读取线程：取出任务读入文件内容后转入解析队列
+ * 
+ * 在途数据量达到上限时等待解析线程消化，避免预取占满内存
+ */
+void AsyncModelLoader::readLoop() {
+    for (;;) {
+        std::shared_ptr<Task> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            // 在途数据量未达上限时才领取下一个任务
+            read_ready.wait(lock, [this]() {
+                return (stopping && read_queue.empty()) ||
+                       (!read_queue.empty() && pending_bytes < options.max_pending_bytes);
+            });
+            if (read_queue.empty()) {
+                return;
+            }
+            task = read_queue.front();
+            read_queue.pop_front();
+        }
+        
+        double start = detail::nowSeconds();
+        try {
+            if (!ModelIO::readFile(task->result.path, task->content)) {
+                task->result.error = "无法打开文件: " + task->result.path;
+            }
+        } catch (const std::exception& e) {
+            std::string().swap(task->content);
+            task->result.error = std::string("读取文件异常: ") + e.what();
+        }
+        task->result.bytes = task->content.size();
+        task->result.read_seconds = detail::nowSeconds() - start;
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending_bytes += task->content.size();
+            parse_queue.push_back(task);
+        }
+        parse_ready.notify_one();
+    }
+}
+
+/**
+ * @brief 解析线程：解析文件内容并构建模型
+ * 
+ * 解析抛出的异常记为该文件的读取错误；回调抛出的异常经future传给调用方，
+ * 均不会终止解析线程
+ */
+void AsyncModelLoader::parseLoop() {
+    for (;;) {
+        std::shared_ptr<Task> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            parse_ready.wait(lock, [this]() { return reads_finished || !parse_queue.empty(); });
+            if (parse_queue.empty()) {
+                return;
+            }
+            task = parse_queue.front();
+            parse_queue.pop_front();
+        }
+        
+        LoadedModel& result = task->result;
+        if (result.error.empty()) {
+            double start = detail::nowSeconds();
+            try {
+                std::shared_ptr<ModelManager> manager(new ModelManager());
+                bool ok = ModelIO::isBinaryPath(result.path)
+                    ? ModelIO::parseBinary(task->content.data(), task->content.size(), *manager, &result.error)
+                    : ModelIO::parseOBJ(task->content.data(), task->content.size(), *manager, &result.error);
+                if (ok) {
+                    result.manager = manager;
+                }
+            } catch (const std::exception& e) {
+                result.manager.reset();
+                result.error = std::string("解析异常: ") + e.what();
+            }
+            result.parse_seconds = detail::nowSeconds() - start;
+        }
+        size_t bytes = task->content.size();
+        std::string().swap(task->content);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending_bytes -= bytes;
+        }
+        read_ready.notify_all();
+        
+        std::exception_ptr failure;
+        if (task->on_loaded) {
+            try {
+                std::lock_guard<std::mutex> lock(*task->on_loaded_mutex);
+                (*task->on_loaded)(result);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+        }
+        if (failure) {
+            task->promise.set_exception(failure);
+        } else {
+            task->promise.set_value(result);
+        }
+    }
+}
+
+/**
+ * @brief 列出目录中的模型文件
+ * 
+ * @param directory 目录路径
+ * @param files 输出文件路径
+ * @return bool 目录是否可读
+ */
+bool AsyncModelLoader::listModelFiles(const std::string& directory, std::vector<std::string>& files) {
+#if defined(__unix__) || defined(__APPLE__)
+    DIR* dir = ::opendir(directory.c_str());
+    if (!dir) {
+        return false;
+    }
+    std::vector<std::string> found;
+    while (dirent* entry = ::readdir(dir)) {
+        std::string name = entry->d_name;
+        bool obj = name.size() > 4 && name.compare(name.size() - 4, 4, ".obj") == 0;
+        if (obj || ModelIO::isBinaryPath(name)) {
+            found.push_back(directory + "/" + name);
+        }
+    }
+    ::closedir(dir);
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+    return true;
+#else
+    (void)directory;
+    (void)files;
+    return false;
+#endif
+}
@@ -0,0 +1,315 @@
+#include "batch_validator.h"
+#include "detail/clock.h"
+#include "detail/text_output.h"
+#include "model_io.h"
+#include "parallel_utils.h"
+#include "topology_checker.h"
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief 协作式超时信号，在检测阶段之间抛出
+ */
+struct ValidationTimeout {};
+
+/**
+ * @brief 检查是否超过截止时间
+ */
+void checkDeadline(double deadline) {
+    if (deadline > 0.0 && detail::nowSeconds() > deadline) {
+        throw ValidationTimeout();
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 构造函数
+ * 
+ * @param options 检测选项
+ */
+BatchValidator::BatchValidator(const BatchValidationOptions& options) : options(options) {}
+
+/**
+ * @brief 以有界线程池执行批量任务
+ * 
+ * task签名为 void task(size_t index, ValidationResult& result)，其抛出的异常记入结果状态；
+ * 回调抛出的第一个异常在停止分发任务、汇合全部工作线程后重新抛出
+ */
+template <typename Task>
+std::vector<ValidationResult> BatchValidator::run(size_t count, Task task, const ResultCallback& on_result) const {
+    std::vector<ValidationResult> results(count);
+    if (count == 0) {
+        return results;
+    }
+    unsigned workers = options.workers ? options.workers : ParallelUtils::threadCount();
+    workers = static_cast<unsigned>(std::min<size_t>(workers, count));
+    
+    std::atomic<size_t> next(0);
+    std::mutex callback_mutex;
+    std::exception_ptr callback_error; // 回调抛出的第一个异常（由callback_mutex保护）
+    auto worker_loop = [&]() {
+        for (;;) {
+            size_t index = next.fetch_add(1);
+            if (index >= count) {
+                break;
+            }
+            ValidationResult& result = results[index];
+            double start = detail::nowSeconds();
+            try {
+                task(index, result);
+            } catch (const ValidationTimeout&) {
+                result.status = ValidationStatus::Timeout;
+                result.message = "超出检测时限";
+            } catch (const std::bad_alloc&) {
+                result.status = ValidationStatus::MemoryLimit;
+                result.message = "内存分配失败";
+            } catch (const std::exception& e) {
+                result.status = ValidationStatus::LoadError;
+                result.message = e.what();
+            } catch (...) {
+                result.status = ValidationStatus::LoadError;
+                result.message = "未知异常";
+            }
+            result.elapsed_seconds = detail::nowSeconds() - start;
+            if (on_result) {
+                std::lock_guard<std::mutex> lock(callback_mutex);
+                if (callback_error) {
+                    continue;
+                }
+                try {
+                    on_result(result);
+                } catch (...) {
+                    // 回调出错后不再领取新任务，已在检测中的任务完成后统一汇合
+                    callback_error = std::current_exception();
+                    next.store(count);
+                }
+            }
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    try {
+        threads.reserve(workers - 1);
+        for (unsigned w = 1; w < workers; ++w) {
+            threads.push_back(std::thread(worker_loop));
+        }
+    } catch (...) {
+        // 线程创建失败不算错误：已创建的线程与调用线程继续领取剩余任务
+    }
+    worker_loop();
+    for (auto& t : threads) {
+        t.join();
+    }
+    if (callback_error) {
+        std::rethrow_exception(callback_error);
+    }
+    return results;
+}
+
+/**
+ * @brief 检测单个模型并填写结果
+ * 
+ * @param manager 模型管理器
+ * @param result 检测结果
+ * @param deadline 截止时间（秒），0表示不限
+ */
+void BatchValidator::checkModel(const ModelManager& manager, ValidationResult& result, double deadline) const {
+    result.vertex_count = manager.getVertices().size();
+    result.edge_count = manager.getEdges().size();
+    result.face_count = manager.getFaces().size();
+    result.memory_bytes = manager.estimateMemoryUsage();
+    if (options.memory_limit_bytes && result.memory_bytes > options.memory_limit_bytes) {
+        result.status = ValidationStatus::MemoryLimit;
+        result.message = "模型估算内存超出上限";
+        return;
+    }
+    
+    checkDeadline(deadline);
+    result.duplicate_edges = TopologyChecker::detectDuplicateEdges(manager).size();
+    checkDeadline(deadline);
+    result.duplicate_faces = TopologyChecker::detectDuplicateFaces(manager).size();
+    checkDeadline(deadline);
+    result.inconsistent_normals = TopologyChecker::detectNormalInconsistencies(manager).size();
+    
+    bool has_errors = result.duplicate_edges || result.duplicate_faces || result.inconsistent_normals;
+    result.status = has_errors ? ValidationStatus::Failed : ValidationStatus::Passed;
+}
+
+/**
+ * @brief 批量检测模型文件
+ * 
+ * @param paths 文件路径列表
+ * @param on_result 可选的逐零件结果回调
+ * @return std::vector<ValidationResult> 按输入顺序排列的结果
+ */
+std::vector<ValidationResult> BatchValidator::validateFiles(const std::vector<std::string>& paths,
+                                                            const ResultCallback& on_result) const {
+    auto task = [&](size_t index, ValidationResult& result) {
+        result.name = paths[index];
+        double deadline = options.timeout_seconds > 0.0 ? detail::nowSeconds() + options.timeout_seconds : 0.0;
+        
+        // 读取前按文件大小判断：文本内容需整体驻留内存
+        std::ifstream file(paths[index].c_str(), std::ios::binary | std::ios::ate);
+        if (!file) {
+            result.status = ValidationStatus::LoadError;
+            result.message = "无法打开文件";
+            return;
+        }
+        size_t file_size = static_cast<size_t>(file.tellg());
+        file.close();
+        if (options.memory_limit_bytes && file_size > options.memory_limit_bytes) {
+            result.status = ValidationStatus::MemoryLimit;
+            result.memory_bytes = file_size;
+            result.message = "文件大小超出内存上限";
+            return;
+        }
+        
+        ModelManager manager;
+        {
+            std::string content;
+            if (!ModelIO::readFile(paths[index], content)) {
+                result.status = ValidationStatus::LoadError;
+                result.message = "无法读取文件";
+                return;
+            }
+            std::string error;
+            bool parsed = ModelIO::isBinaryPath(paths[index])
+                ? ModelIO::parseBinary(content.data(), content.size(), manager, &error)
+                : ModelIO::parseOBJ(content.data(), content.size(), manager, &error);
+            if (!parsed) {
+                result.status = ValidationStatus::LoadError;
+                result.message = error;
+                return;
+            }
+        }
+        checkModel(manager, result, deadline);
+    };
+    return run(paths.size(), task, on_result);
+}
+
+/**
+ * @brief 批量检测内存中的模型
+ * 
+ * @param names 零件名称列表
+ * @param models 模型列表（与名称一一对应）
+ * @param on_result 可选的逐零件结果回调
+ * @return std::vector<ValidationResult> 按输入顺序排列的结果
+ */
+std::vector<ValidationResult> BatchValidator::validateModels(const std::vector<std::string>& names,
+                                                             const std::vector<std::shared_ptr<const ModelManager>>& models,
+                                                             const ResultCallback& on_result) const {
+    if (names.size() != models.size()) {
+        throw std::invalid_argument("零件名称与模型数量不一致");
+    }
+    auto task = [&](size_t index, ValidationResult& result) {
+        result.name = names[index];
+        if (!models[index]) {
+            result.status = ValidationStatus::LoadError;
+            result.message = "模型为空";
+            return;
+        }
+        double deadline = options.timeout_seconds > 0.0 ? detail::nowSeconds() + options.timeout_seconds : 0.0;
+        checkModel(*models[index], result, deadline);
+    };
+    return run(models.size(), task, on_result);
+}
+
+/**
+ * @brief 获取状态名称
+ * 
+ * @param status 检测状态
+ * @return const char* 状态名称
+ */
+const char* BatchValidator::statusName(ValidationStatus status) {
+    switch (status) {
+    case ValidationStatus::Passed: return "passed";
+    case ValidationStatus::Failed: return "failed";
+    case ValidationStatus::LoadError: return "load_error";
+    case ValidationStatus::Timeout: return "timeout";
+    case ValidationStatus::MemoryLimit: return "memory_limit";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 以单行JSON写出一个结果
+ * 
+ * @param out 输出流
+ * @param result 检测结果
+ */
+void BatchValidator::writeJSONLine(std::ostream& out, const ValidationResult& result) {
+    out << "{\"name\":";
+    detail::writeJSONString(out, result.name);
+    out << ",\"status\":\"" << statusName(result.status) << "\""
+        << ",\"vertices\":" << result.vertex_count
+        << ",\"edges\":" << result.edge_count
+        << ",\"faces\":" << result.face_count
+        << ",\"duplicate_edges\":" << result.duplicate_edges
+        << ",\"duplicate_faces\":" << result.duplicate_faces
+        << ",\"inconsistent_normals\":" << result.inconsistent_normals
+        << ",\"memory_bytes\":" << result.memory_bytes
+        << ",\"seconds\":" << result.elapsed_seconds;
+    if (!result.message.empty()) {
+        out << ",\"message\":";
+        detail::writeJSONString(out, result.message);
+    }
+    out << "}";
+}
+
+/**
+ * @brief 写出JSON汇总报告
+ * 
+ * @param out 输出流
+ * @param results 检测结果
+ */
+void BatchValidator::writeJSON(std::ostream& out, const std::vector<ValidationResult>& results) {
+    size_t counts[5] = {0, 0, 0, 0, 0};
+    double total_seconds = 0.0;
+    for (const auto& result : results) {
+        ++counts[static_cast<int>(result.status)];
+        total_seconds += result.elapsed_seconds;
+    }
+    out << "{\"summary\":{\"total\":" << results.size();
+    for (int s = 0; s < 5; ++s) {
+        out << ",\"" << statusName(static_cast<ValidationStatus>(s)) << "\":" << counts[s];
+    }
+    out << ",\"seconds\":" << total_seconds << "},\"parts\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        out << (i ? ",\n" : "\n");
+        writeJSONLine(out, results[i]);
+    }
+    out << "\n]}\n";
+}
+
+/**
+ * @brief 写出CSV报告
+ * 
+ * @param out 输出流
+ * @param results 检测结果
+ */
+void BatchValidator::writeCSV(std::ostream& out, const std::vector<ValidationResult>& results) {
+    out << "name,status,vertices,edges,faces,duplicate_edges,duplicate_faces,"
+           "inconsistent_normals,memory_bytes,seconds,message\n";
+    for (const auto& result : results) {
+        detail::writeCSVField(out, result.name);
+        out << "," << statusName(result.status)
+            << "," << result.vertex_count
+            << "," << result.edge_count
+            << "," << result.face_count
+            << "," << result.duplicate_edges
+            << "," << result.duplicate_faces
+            << "," << result.inconsistent_normals
+            << "," << result.memory_bytes
+            << "," << result.elapsed_seconds << ",";
+        detail::writeCSVField(out, result.message);
+        out << "\n";
+    }
+}
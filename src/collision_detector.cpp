@@ -0,0 +1,863 @@
+#include "collision_detector.h"
+#include "detail/vec3.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const int kContainmentSamples = 7; // 包含判断的采样顶点数（取中位数，奇数）
+
+inline void triangleNormal(const double* t, double* n) {
+    const double e1[3] = {t[3] - t[0], t[4] - t[1], t[5] - t[2]};
+    const double e2[3] = {t[6] - t[0], t[7] - t[1], t[8] - t[2]};
+    detail::cross3(e1, e2, n);
+}
+
+inline void triangleBounds(const double* t, double* lo, double* hi) {
+    for (int k = 0; k < 3; ++k) {
+        lo[k] = std::min(t[k], std::min(t[3 + k], t[6 + k]));
+        hi[k] = std::max(t[k], std::max(t[3 + k], t[6 + k]));
+    }
+}
+
+/**
+ * @brief 三个顶点到平面的有符号距离是否分居两侧且都超出容差
+ */
+inline bool straddles(const double* d, double tolerance) {
+    double lo = std::min(d[0], std::min(d[1], d[2]));
+    double hi = std::max(d[0], std::max(d[1], d[2]));
+    return hi > tolerance && lo < -tolerance;
+}
+
+/**
+ * @brief 三角形与对方平面的交线段在交线方向上的投影区间
+ *
+ * @param t 三角形顶点
+ * @param d 顶点到对方平面的有符号距离（可按任意正数缩放）
+ * @param origin 投影原点（减小大坐标下的舍入误差）
+ * @param dir 单位交线方向
+ */
+void crossingInterval(const double* t, const double* d, const double* origin, const double* dir,
+                      double& lo, double& hi) {
+    lo = std::numeric_limits<double>::infinity();
+    hi = -lo;
+    for (int i = 0; i < 3; ++i) {
+        int j = (i + 1) % 3;
+        const double* p = t + 3 * i;
+        const double* q = t + 3 * j;
+        if (d[i] == 0.0) {
+            const double v[3] = {p[0] - origin[0], p[1] - origin[1], p[2] - origin[2]};
+            double s = detail::dot3(v, dir);
+            lo = std::min(lo, s);
+            hi = std::max(hi, s);
+        }
+        if ((d[i] < 0.0 && d[j] > 0.0) || (d[i] > 0.0 && d[j] < 0.0)) {
+            double f = d[i] / (d[i] - d[j]);
+            const double v[3] = {p[0] + (q[0] - p[0]) * f - origin[0], p[1] + (q[1] - p[1]) * f - origin[1],
+                                 p[2] + (q[2] - p[2]) * f - origin[2]};
+            double s = detail::dot3(v, dir);
+            lo = std::min(lo, s);
+            hi = std::max(hi, s);
+        }
+    }
+}
+
+/**
+ * @brief 将包围盒（中心、半边长）经刚体变换后取轴对齐包围盒
+ */
+inline void transformBox(const RigidTransform& transform, const double* abs_rotation, const double* center,
+                         const double* extent, double* out_center, double* out_extent) {
+    transform.apply(center, out_center);
+    for (int i = 0; i < 3; ++i) {
+        out_extent[i] = abs_rotation[3 * i] * extent[0] + abs_rotation[3 * i + 1] * extent[1] +
+                        abs_rotation[3 * i + 2] * extent[2];
+    }
+}
+
+inline void nodeBox(const BVHNode& node, double* center, double* extent) {
+    for (int k = 0; k < 3; ++k) {
+        center[k] = 0.5 * (node.bounds_min[k] + node.bounds_max[k]);
+        extent[k] = 0.5 * (node.bounds_max[k] - node.bounds_min[k]);
+    }
+}
+
+inline bool boxesOverlap(const double* ca, const double* ea, const double* cb, const double* eb) {
+    return std::fabs(ca[0] - cb[0]) <= ea[0] + eb[0] && std::fabs(ca[1] - cb[1]) <= ea[1] + eb[1] &&
+           std::fabs(ca[2] - cb[2]) <= ea[2] + eb[2];
+}
+
+inline double boxDistance2(const double* ca, const double* ea, const double* cb, const double* eb) {
+    double sum = 0.0;
+    for (int k = 0; k < 3; ++k) {
+        double gap = std::fabs(ca[k] - cb[k]) - ea[k] - eb[k];
+        if (gap > 0.0) {
+            sum += gap * gap;
+        }
+    }
+    return sum;
+}
+
+inline double boundsDistance2(const double* lo_a, const double* hi_a, const double* lo_b, const double* hi_b) {
+    double sum = 0.0;
+    for (int k = 0; k < 3; ++k) {
+        double gap = std::max(lo_a[k] - hi_b[k], lo_b[k] - hi_a[k]);
+        if (gap > 0.0) {
+            sum += gap * gap;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief 两条线段之间的最小距离平方
+ *
+ * 先求两条直线的最近参数，再依次截断到[0, 1]并重算另一参数
+ */
+double segmentDistance2(const double* p1, const double* q1, const double* p2, const double* q2) {
+    const double d1[3] = {q1[0] - p1[0], q1[1] - p1[1], q1[2] - p1[2]};
+    const double d2[3] = {q2[0] - p2[0], q2[1] - p2[1], q2[2] - p2[2]};
+    const double r[3] = {p1[0] - p2[0], p1[1] - p2[1], p1[2] - p2[2]};
+    double a = detail::dot3(d1, d1);
+    double e = detail::dot3(d2, d2);
+    double f = detail::dot3(d2, r);
+    double s = 0.0;
+    double t = 0.0;
+    if (a <= 0.0 && e <= 0.0) {
+        return detail::dot3(r, r);
+    }
+    if (a <= 0.0) {
+        t = std::max(0.0, std::min(1.0, f / e));
+    } else {
+        double c = detail::dot3(d1, r);
+        if (e <= 0.0) {
+            s = std::max(0.0, std::min(1.0, -c / a));
+        } else {
+            double b = detail::dot3(d1, d2);
+            double denom = a * e - b * b;
+            s = denom > 0.0 ? std::max(0.0, std::min(1.0, (b * f - c * e) / denom)) : 0.0;
+            t = (b * s + f) / e;
+            if (t < 0.0) {
+                t = 0.0;
+                s = std::max(0.0, std::min(1.0, -c / a));
+            } else if (t > 1.0) {
+                t = 1.0;
+                s = std::max(0.0, std::min(1.0, (b - c) / a));
+            }
+        }
+    }
+    double sum = 0.0;
+    for (int k = 0; k < 3; ++k) {
+        double diff = (p1[k] + d1[k] * s) - (p2[k] + d2[k] * t);
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+/**
+ * @brief 将零件的BVH节点包围盒与三角形整体变换到另一坐标系
+ *
+ * @param tree 零件BVH
+ * @param transform 变换
+ * @param boxes 输出每个节点：中心(3)、半边长(3)
+ * @param triangles 输出每个三角形：顶点(9)、包围盒最小点(3)、最大点(3)
+ */
+void transformTree(const TriangleBVH& tree, const RigidTransform& transform, std::vector<double>& boxes,
+                   std::vector<double>& triangles) {
+    double abs_rotation[9];
+    for (int i = 0; i < 9; ++i) {
+        abs_rotation[i] = std::fabs(transform.rotation[i]);
+    }
+    const std::vector<BVHNode>& nodes = tree.nodes();
+    boxes.resize(6 * nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        double center[3], extent[3];
+        nodeBox(nodes[i], center, extent);
+        transformBox(transform, abs_rotation, center, extent, &boxes[6 * i], &boxes[6 * i + 3]);
+    }
+    triangles.resize(15 * tree.triangleCount());
+    for (size_t j = 0; j < tree.triangleCount(); ++j) {
+        const double* tri = tree.triangle(j);
+        double* out = &triangles[15 * j];
+        for (int v = 0; v < 3; ++v) {
+            transform.apply(tri + 3 * v, out + 3 * v);
+        }
+        triangleBounds(out, out + 9, out + 12);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 插值位姿
+ *
+ * 参考点沿起止位置连线匀速移动，姿态为 exp(t·ω)·R0
+ */
+RigidTransform RigidMotion::at(double t, const double* center) const {
+    double c0[3], c1[3];
+    start.apply(center, c0);
+    end.apply(center, c1);
+    double omega[3];
+    end.compose(start.inverse()).rotationVector(omega);
+    for (int k = 0; k < 3; ++k) {
+        omega[k] *= t;
+    }
+    const double zero[3] = {0.0, 0.0, 0.0};
+    RigidTransform orientation = start;
+    orientation.translation[0] = orientation.translation[1] = orientation.translation[2] = 0.0;
+    RigidTransform result = RigidTransform::fromRotationVector(omega, zero).compose(orientation);
+    double rotated[3];
+    result.apply(center, rotated);
+    for (int k = 0; k < 3; ++k) {
+        result.translation[k] = c0[k] + t * (c1[k] - c0[k]) - rotated[k];
+    }
+    return result;
+}
+
+/**
+ * @brief 参考点位移长度与转角
+ */
+void RigidMotion::extent(const double* center, double& displacement, double& angle) const {
+    double c0[3], c1[3];
+    start.apply(center, c0);
+    end.apply(center, c1);
+    const double d[3] = {c1[0] - c0[0], c1[1] - c0[1], c1[2] - c0[2]};
+    displacement = std::sqrt(detail::dot3(d, d));
+    double omega[3];
+    end.compose(start.inverse()).rotationVector(omega);
+    angle = std::sqrt(detail::dot3(omega, omega));
+}
+
+/**
+ * @brief 添加零件
+ *
+ * @param manager 模型管理器
+ * @return int 零件索引
+ */
+int CollisionDetector::addPart(const ModelManager& manager) {
+    return addPart(std::make_shared<TriangleBVH>(manager));
+}
+
+/**
+ * @brief 添加零件，复用已构建的BVH
+ *
+ * @param bvh 三角形BVH
+ * @return int 零件索引
+ */
+int CollisionDetector::addPart(std::shared_ptr<const TriangleBVH> bvh) {
+    if (!bvh) {
+        throw std::invalid_argument("零件BVH为空");
+    }
+    Part part;
+    part.bvh = bvh;
+    part.winding = std::make_shared<WindingNumber>(bvh);
+    double bounds_min[3], bounds_max[3];
+    part.empty = !bvh->getBounds(bounds_min, bounds_max);
+    for (int k = 0; k < 3; ++k) {
+        part.center[k] = part.empty ? 0.0 : 0.5 * (bounds_min[k] + bounds_max[k]);
+        part.extent[k] = part.empty ? 0.0 : 0.5 * (bounds_max[k] - bounds_min[k]);
+    }
+    part.radius = 0.0;
+    for (size_t t = 0; t < bvh->triangleCount(); ++t) {
+        const double* tri = bvh->triangle(t);
+        for (int v = 0; v < 3; ++v) {
+            const double d[3] = {tri[3 * v] - part.center[0], tri[3 * v + 1] - part.center[1],
+                                 tri[3 * v + 2] - part.center[2]};
+            part.radius = std::max(part.radius, detail::dot3(d, d));
+        }
+    }
+    part.radius = std::sqrt(part.radius);
+    parts.push_back(part);
+    return static_cast<int>(parts.size()) - 1;
+}
+
+/**
+ * @brief 添加实例
+ *
+ * @param part 零件索引
+ * @param transform 零件局部坐标到世界坐标的变换
+ * @return int 实例索引
+ */
+int CollisionDetector::addInstance(int part, const RigidTransform& transform) {
+    if (part < 0 || static_cast<size_t>(part) >= parts.size()) {
+        throw std::invalid_argument("零件索引无效");
+    }
+    Instance instance;
+    instance.part = part;
+    instance.transform = transform;
+    instances.push_back(instance);
+    return static_cast<int>(instances.size()) - 1;
+}
+
+/**
+ * @brief 更新实例变换
+ *
+ * @param instance 实例索引
+ * @param transform 新变换
+ */
+void CollisionDetector::setTransform(int instance, const RigidTransform& transform) {
+    if (instance < 0 || static_cast<size_t>(instance) >= instances.size()) {
+        throw std::invalid_argument("实例索引无效");
+    }
+    instances[instance].transform = transform;
+}
+
+/**
+ * @brief 计算实例的世界包围盒
+ *
+ * 局部包围盒经旋转后取轴对齐包围盒：半边长为|R|乘以局部半边长
+ */
+bool CollisionDetector::worldBounds(int instance, double bounds_min[3], double bounds_max[3]) const {
+    const Instance& inst = instances[instance];
+    const Part& part = parts[inst.part];
+    if (part.empty) {
+        return false;
+    }
+    double abs_rotation[9];
+    for (int i = 0; i < 9; ++i) {
+        abs_rotation[i] = std::fabs(inst.transform.rotation[i]);
+    }
+    double center[3], extent[3];
+    transformBox(inst.transform, abs_rotation, part.center, part.extent, center, extent);
+    for (int k = 0; k < 3; ++k) {
+        bounds_min[k] = center[k] - extent[k];
+        bounds_max[k] = center[k] + extent[k];
+    }
+    return true;
+}
+
+/**
+ * @brief 粗检测：世界包围盒重叠的实例对
+ *
+ * 沿包围盒中心方差最大的轴按最小端排序，每个实例向后扫描到最小端超过自身最大端为止，
+ * 其余两轴再做区间重叠判断。扫描按排序位置分块并行，各线程结果合并后排序
+ */
+std::vector<std::pair<int, int>> CollisionDetector::broadPhase() const {
+    std::vector<std::pair<int, int>> pairs;
+    const size_t n = instances.size();
+    std::vector<double> boxes(6 * n);
+    std::vector<int> valid;
+    valid.reserve(n);
+    double mean[3] = {0.0, 0.0, 0.0};
+    double square[3] = {0.0, 0.0, 0.0};
+    for (size_t i = 0; i < n; ++i) {
+        if (!worldBounds(static_cast<int>(i), &boxes[6 * i], &boxes[6 * i + 3])) {
+            continue;
+        }
+        valid.push_back(static_cast<int>(i));
+        for (int k = 0; k < 3; ++k) {
+            double c = 0.5 * (boxes[6 * i + k] + boxes[6 * i + 3 + k]);
+            mean[k] += c;
+            square[k] += c * c;
+        }
+    }
+    if (valid.size() < 2) {
+        return pairs;
+    }
+    int axis = 0;
+    double best_variance = -1.0;
+    for (int k = 0; k < 3; ++k) {
+        double m = mean[k] / valid.size();
+        double variance = square[k] / valid.size() - m * m;
+        if (variance > best_variance) {
+            best_variance = variance;
+            axis = k;
+        }
+    }
+    const int axis1 = (axis + 1) % 3;
+    const int axis2 = (axis + 2) % 3;
+    std::sort(valid.begin(), valid.end(), [&](int a, int b) {
+        double ma = boxes[6 * a + axis];
+        double mb = boxes[6 * b + axis];
+        return ma < mb || (ma == mb && a < b);
+    });
+
+    // 按排序顺序重排为连续数组：主轴区间在前，扫描时顺序访问
+    const size_t m = valid.size();
+    std::vector<double> sorted(6 * m);
+    for (size_t i = 0; i < m; ++i) {
+        const double* box = &boxes[6 * valid[i]];
+        double* out = &sorted[6 * i];
+        out[0] = box[axis];
+        out[1] = box[3 + axis];
+        out[2] = box[axis1];
+        out[3] = box[3 + axis1];
+        out[4] = box[axis2];
+        out[5] = box[3 + axis2];
+    }
+
+    const unsigned workers = ParallelUtils::threadCount();
+    std::vector<std::vector<std::pair<int, int>>> local(workers);
+    ParallelUtils::parallelForWithWorker(m, 256, [&](size_t begin, size_t end, unsigned worker) {
+        std::vector<std::pair<int, int>>& out = local[worker];
+        for (size_t i = begin; i < end; ++i) {
+            const double* a = &sorted[6 * i];
+            for (size_t j = i + 1; j < m; ++j) {
+                const double* b = &sorted[6 * j];
+                if (b[0] > a[1]) {
+                    break;
+                }
+                if (b[2] > a[3] || a[2] > b[3] || b[4] > a[5] || a[4] > b[5]) {
+                    continue;
+                }
+                int p = valid[i];
+                int q = valid[j];
+                out.push_back(p < q ? std::make_pair(p, q) : std::make_pair(q, p));
+            }
+        }
+    });
+    size_t total = 0;
+    for (const auto& list : local) {
+        total += list.size();
+    }
+    pairs.reserve(total);
+    for (const auto& list : local) {
+        pairs.insert(pairs.end(), list.begin(), list.end());
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+/**
+ * @brief 检测全部干涉实例对
+ *
+ * 粗检测得到的实例对按动态分块并行做精检测，结果保持实例对的字典序
+ */
+std::vector<CollisionPair> CollisionDetector::detect(const CollisionOptions& options) const {
+    std::vector<std::pair<int, int>> candidates = broadPhase();
+    std::vector<CollisionPair> results(candidates.size());
+    std::vector<char> hit(candidates.size(), 0);
+    ParallelUtils::parallelFor(candidates.size(), 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            hit[i] = testPair(candidates[i].first, candidates[i].second, options, results[i]) ? 1 : 0;
+        }
+    });
+    size_t count = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (hit[i]) {
+            results[count++] = results[i];
+        }
+    }
+    results.resize(count);
+    return results;
+}
+
+/**
+ * @brief 精检测一对实例
+ *
+ * 两个零件中节点较少的一个变换到另一个的局部坐标系中比较
+ */
+bool CollisionDetector::testPair(int instance_a, int instance_b, const CollisionOptions& options,
+                                 CollisionPair& result) const {
+    if (instance_a < 0 || instance_b < 0 || static_cast<size_t>(instance_a) >= instances.size() ||
+        static_cast<size_t>(instance_b) >= instances.size()) {
+        throw std::invalid_argument("实例索引无效");
+    }
+    if (instance_a > instance_b) {
+        std::swap(instance_a, instance_b);
+    }
+    result = CollisionPair();
+    result.instance_a = instance_a;
+    result.instance_b = instance_b;
+    if (instance_a == instance_b) {
+        return false;
+    }
+    const Instance& ia = instances[instance_a];
+    const Instance& ib = instances[instance_b];
+    const Part& pa = parts[ia.part];
+    const Part& pb = parts[ib.part];
+    if (pa.empty || pb.empty) {
+        return false;
+    }
+    RigidTransform b_to_a = ia.transform.inverse().compose(ib.transform);
+    RigidTransform a_to_b = b_to_a.inverse();
+    if (pb.bvh->nodes().size() <= pa.bvh->nodes().size()) {
+        result.triangle_pairs = intersectMeshes(pa, pb, b_to_a, options, result.face_a, result.face_b);
+    } else {
+        result.triangle_pairs = intersectMeshes(pb, pa, a_to_b, options, result.face_b, result.face_a);
+    }
+    if (result.triangle_pairs > 0) {
+        return true;
+    }
+    if (options.check_containment && (contains(pa, pb, b_to_a) || contains(pb, pa, a_to_b))) {
+        result.contained = true;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 同时遍历两棵BVH，统计相交三角形对
+ *
+ * B的节点包围盒与三角形（附包围盒）先整体变换到A的坐标系，遍历中每步展开包围盒较大的一侧，
+ * 叶节点对逐对做包围盒预筛与三角形相交测试。调用方令B为节点较少的零件，预变换开销较小
+ */
+size_t CollisionDetector::intersectMeshes(const Part& a, const Part& b, const RigidTransform& b_to_a,
+                                          const CollisionOptions& options, int& face_a, int& face_b) const {
+    const TriangleBVH& tree_a = *a.bvh;
+    const TriangleBVH& tree_b = *b.bvh;
+    const std::vector<BVHNode>& nodes_a = tree_a.nodes();
+    const std::vector<BVHNode>& nodes_b = tree_b.nodes();
+    std::vector<double> boxes_b;     // B节点包围盒（A坐标系）
+    std::vector<double> triangles_b; // B三角形及其包围盒（A坐标系）
+    transformTree(tree_b, b_to_a, boxes_b, triangles_b);
+
+    size_t found = 0;
+    std::vector<std::pair<int, int>> stack;
+    stack.reserve(64);
+    stack.push_back(std::make_pair(0, 0));
+    while (!stack.empty()) {
+        int na = stack.back().first;
+        int nb = stack.back().second;
+        stack.pop_back();
+        const BVHNode& node_a = nodes_a[na];
+        const BVHNode& node_b = nodes_b[nb];
+        double ca[3], ea[3];
+        nodeBox(node_a, ca, ea);
+        const double* cb = &boxes_b[6 * nb];
+        const double* eb = cb + 3;
+        if (!boxesOverlap(ca, ea, cb, eb)) {
+            continue;
+        }
+        bool leaf_a = node_a.count > 0;
+        bool leaf_b = node_b.count > 0;
+        if (!leaf_a || !leaf_b) {
+            bool split_a = leaf_b || (!leaf_a && ea[0] + ea[1] + ea[2] >= eb[0] + eb[1] + eb[2]);
+            if (split_a) {
+                stack.push_back(std::make_pair(node_a.first + 1, nb));
+                stack.push_back(std::make_pair(node_a.first, nb));
+            } else {
+                stack.push_back(std::make_pair(na, node_b.first + 1));
+                stack.push_back(std::make_pair(na, node_b.first));
+            }
+            continue;
+        }
+
+        for (int i = 0; i < node_a.count; ++i) {
+            const double* ta = tree_a.triangle(node_a.first + i);
+            double lo_a[3], hi_a[3];
+            triangleBounds(ta, lo_a, hi_a);
+            for (int j = 0; j < node_b.count; ++j) {
+                const double* tb = &triangles_b[15 * (node_b.first + j)];
+                const double* lo_b = tb + 9;
+                const double* hi_b = tb + 12;
+                if (hi_a[0] < lo_b[0] || hi_b[0] < lo_a[0] || hi_a[1] < lo_b[1] || hi_b[1] < lo_a[1] ||
+                    hi_a[2] < lo_b[2] || hi_b[2] < lo_a[2] || !trianglesIntersect(ta, tb, options.tolerance)) {
+                    continue;
+                }
+                if (found == 0) {
+                    face_a = tree_a.triangleFace(node_a.first + i);
+                    face_b = tree_b.triangleFace(node_b.first + j);
+                }
+                ++found;
+                if (!options.all_triangle_pairs) {
+                    return found;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief 同时遍历两棵BVH求最小距离
+ *
+ * 节点对按包围盒距离下界剪枝，展开包围盒较大的一侧并先访问较近的子节点对；
+ * 叶节点对先用三角形包围盒距离预筛，再求精确三角形距离
+ */
+double CollisionDetector::meshDistance(const Part& a, const Part& b, const RigidTransform& b_to_a,
+                                       double max_distance, int& face_a, int& face_b) const {
+    const TriangleBVH& tree_a = *a.bvh;
+    const TriangleBVH& tree_b = *b.bvh;
+    const std::vector<BVHNode>& nodes_a = tree_a.nodes();
+    const std::vector<BVHNode>& nodes_b = tree_b.nodes();
+    std::vector<double> boxes_b;
+    std::vector<double> triangles_b;
+    transformTree(tree_b, b_to_a, boxes_b, triangles_b);
+
+    struct Entry {
+        int a;
+        int b;
+        double bound; // 包围盒距离平方下界
+    };
+    double best = max_distance * max_distance;
+    face_a = face_b = -1;
+    std::vector<Entry> stack;
+    stack.reserve(64);
+    {
+        double ca[3], ea[3];
+        nodeBox(nodes_a[0], ca, ea);
+        Entry root = {0, 0, boxDistance2(ca, ea, &boxes_b[0], &boxes_b[3])};
+        stack.push_back(root);
+    }
+    while (!stack.empty()) {
+        Entry entry = stack.back();
+        stack.pop_back();
+        if (entry.bound >= best) {
+            continue;
+        }
+        const BVHNode& node_a = nodes_a[entry.a];
+        const BVHNode& node_b = nodes_b[entry.b];
+        bool leaf_a = node_a.count > 0;
+        bool leaf_b = node_b.count > 0;
+        if (leaf_a && leaf_b) {
+            for (int i = 0; i < node_a.count; ++i) {
+                const double* ta = tree_a.triangle(node_a.first + i);
+                double lo_a[3], hi_a[3];
+                triangleBounds(ta, lo_a, hi_a);
+                for (int j = 0; j < node_b.count; ++j) {
+                    const double* tb = &triangles_b[15 * (node_b.first + j)];
+                    if (boundsDistance2(lo_a, hi_a, tb + 9, tb + 12) >= best) {
+                        continue;
+                    }
+                    double d = triangleDistance(ta, tb);
+                    if (d * d < best) {
+                        best = d * d;
+                        face_a = tree_a.triangleFace(node_a.first + i);
+                        face_b = tree_b.triangleFace(node_b.first + j);
+                        if (best == 0.0) {
+                            return 0.0;
+                        }
+                    }
+                }
+            }
+            continue;
+        }
+        double ca[3], ea[3];
+        nodeBox(node_a, ca, ea);
+        const double* eb = &boxes_b[6 * entry.b + 3];
+        Entry children[2];
+        if (leaf_b || (!leaf_a && ea[0] + ea[1] + ea[2] >= eb[0] + eb[1] + eb[2])) {
+            for (int c = 0; c < 2; ++c) {
+                double cc[3], ec[3];
+                nodeBox(nodes_a[node_a.first + c], cc, ec);
+                Entry child = {node_a.first + c, entry.b, boxDistance2(cc, ec, &boxes_b[6 * entry.b], eb)};
+                children[c] = child;
+            }
+        } else {
+            for (int c = 0; c < 2; ++c) {
+                int nb = node_b.first + c;
+                Entry child = {entry.a, nb, boxDistance2(ca, ea, &boxes_b[6 * nb], &boxes_b[6 * nb + 3])};
+                children[c] = child;
+            }
+        }
+        if (children[0].bound < children[1].bound) {
+            std::swap(children[0], children[1]);
+        }
+        for (int c = 0; c < 2; ++c) {
+            if (children[c].bound < best) {
+                stack.push_back(children[c]);
+            }
+        }
+    }
+    return face_a < 0 ? max_distance : std::sqrt(best);
+}
+
+/**
+ * @brief 给定两实例位姿求网格距离，节点较少的零件变换到另一个的坐标系
+ */
+double CollisionDetector::pairDistance(int instance_a, const RigidTransform& transform_a, int instance_b,
+                                       const RigidTransform& transform_b, double max_distance, int& face_a,
+                                       int& face_b) const {
+    const Part& pa = parts[instances[instance_a].part];
+    const Part& pb = parts[instances[instance_b].part];
+    face_a = face_b = -1;
+    if (pa.empty || pb.empty) {
+        return max_distance;
+    }
+    if (pb.bvh->nodes().size() <= pa.bvh->nodes().size()) {
+        return meshDistance(pa, pb, transform_a.inverse().compose(transform_b), max_distance, face_a, face_b);
+    }
+    return meshDistance(pb, pa, transform_b.inverse().compose(transform_a), max_distance, face_b, face_a);
+}
+
+/**
+ * @brief 按当前位姿计算两实例的网格最小距离
+ */
+double CollisionDetector::distance(int instance_a, int instance_b, double max_distance) const {
+    if (instance_a < 0 || instance_b < 0 || static_cast<size_t>(instance_a) >= instances.size() ||
+        static_cast<size_t>(instance_b) >= instances.size()) {
+        throw std::invalid_argument("实例索引无效");
+    }
+    int face_a, face_b;
+    return pairDistance(instance_a, instances[instance_a].transform, instance_b, instances[instance_b].transform,
+                        max_distance, face_a, face_b);
+}
+
+/**
+ * @brief 连续碰撞检测：保守推进
+ *
+ * 两实例点速度上界之和 μ = Σ(|参考点位移| + |ω|·包围球半径)。每步距离查询只搜索到
+ * 剩余时间内可能走过的距离 μ·(1 − t)，超出即说明区间内不会接触
+ */
+ContinuousCollisionResult CollisionDetector::timeOfImpact(int instance_a, const RigidMotion& motion_a,
+                                                          int instance_b, const RigidMotion& motion_b,
+                                                          const ContinuousCollisionOptions& options) const {
+    if (instance_a < 0 || instance_b < 0 || static_cast<size_t>(instance_a) >= instances.size() ||
+        static_cast<size_t>(instance_b) >= instances.size()) {
+        throw std::invalid_argument("实例索引无效");
+    }
+    ContinuousCollisionResult result;
+    const Part& pa = parts[instances[instance_a].part];
+    const Part& pb = parts[instances[instance_b].part];
+    if (pa.empty || pb.empty || instance_a == instance_b) {
+        return result;
+    }
+    double move_a, angle_a, move_b, angle_b;
+    motion_a.extent(pa.center, move_a, angle_a);
+    motion_b.extent(pb.center, move_b, angle_b);
+    const double speed = move_a + angle_a * pa.radius + move_b + angle_b * pb.radius;
+
+    double t = 0.0;
+    for (;;) {
+        double reach = speed * (1.0 - t) + options.contact_distance;
+        int face_a, face_b;
+        double d = pairDistance(instance_a, motion_a.at(t, pa.center), instance_b, motion_b.at(t, pb.center), reach,
+                                face_a, face_b);
+        ++result.iterations;
+        result.distance = d;
+        if (face_a < 0) {
+            return result;
+        }
+        if (d <= options.contact_distance || result.iterations >= options.max_iterations) {
+            result.hit = true;
+            result.time = t;
+            result.face_a = face_a;
+            result.face_b = face_b;
+            return result;
+        }
+        if (!(speed > 0.0)) {
+            return result;
+        }
+        t += d / speed;
+        if (t > 1.0) {
+            return result;
+        }
+    }
+}
+
+/**
+ * @brief 沿位姿序列分段做连续碰撞检测
+ */
+std::vector<ContinuousCollisionResult> CollisionDetector::timeOfImpact(int instance_a,
+                                                                       const std::vector<RigidTransform>& path_a,
+                                                                       int instance_b,
+                                                                       const std::vector<RigidTransform>& path_b,
+                                                                       const ContinuousCollisionOptions& options) const {
+    if (path_a.size() != path_b.size()) {
+        throw std::invalid_argument("位姿序列长度不一致");
+    }
+    std::vector<ContinuousCollisionResult> results(path_a.size() > 1 ? path_a.size() - 1 : 0);
+    ParallelUtils::parallelFor(results.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = timeOfImpact(instance_a, RigidMotion(path_a[i], path_a[i + 1]), instance_b,
+                                      RigidMotion(path_b[i], path_b[i + 1]), options);
+        }
+    });
+    return results;
+}
+
+/**
+ * @brief 判断inner是否完全位于outer内部
+ *
+ * 仅在表面不相交时调用，此时inner的顶点要么全在outer内部、要么全在外部，
+ * 贴合处的顶点绕数约为0.5。先要求inner的包围盒落在outer的包围盒内，
+ * 再取均匀间隔的若干顶点计算绕数，以中位数判定，避免个别贴合顶点的干扰
+ */
+bool CollisionDetector::contains(const Part& outer, const Part& inner, const RigidTransform& inner_to_outer) const {
+    double abs_rotation[9];
+    for (int i = 0; i < 9; ++i) {
+        abs_rotation[i] = std::fabs(inner_to_outer.rotation[i]);
+    }
+    double center[3], extent[3];
+    transformBox(inner_to_outer, abs_rotation, inner.center, inner.extent, center, extent);
+    for (int k = 0; k < 3; ++k) {
+        if (center[k] - extent[k] < outer.center[k] - outer.extent[k] ||
+            center[k] + extent[k] > outer.center[k] + outer.extent[k]) {
+            return false;
+        }
+    }
+    const TriangleBVH& tree = *inner.bvh;
+    const size_t triangles = tree.triangleCount();
+    double winding[kContainmentSamples];
+    for (int s = 0; s < kContainmentSamples; ++s) {
+        size_t t = (triangles - 1) * s / (kContainmentSamples - 1);
+        double p[3];
+        inner_to_outer.apply(tree.triangle(t) + 3 * (s % 3), p);
+        winding[s] = outer.winding->evaluate(p[0], p[1], p[2]);
+    }
+    std::nth_element(winding, winding + kContainmentSamples / 2, winding + kContainmentSamples);
+    return winding[kContainmentSamples / 2] >= 0.5;
+}
+
+/**
+ * @brief 三角形相交测试
+ *
+ * 先求各顶点到对方平面的有符号距离（以未归一化法向计算，容差相应缩放）并要求严格跨越，再在两平面交线上比较
+ * 两个三角形各自的截线段区间，重叠长度超过容差即为穿透
+ */
+bool CollisionDetector::trianglesIntersect(const double* t1, const double* t2, double tolerance) {
+    double n1[3], n2[3];
+    triangleNormal(t1, n1);
+    triangleNormal(t2, n2);
+    double l1 = std::sqrt(detail::dot3(n1, n1));
+    double l2 = std::sqrt(detail::dot3(n2, n2));
+    if (!(l1 > 0.0) || !(l2 > 0.0)) {
+        return false;
+    }
+    double d1[3], d2[3];
+    for (int i = 0; i < 3; ++i) {
+        const double v[3] = {t1[3 * i] - t2[0], t1[3 * i + 1] - t2[1], t1[3 * i + 2] - t2[2]};
+        d1[i] = detail::dot3(n2, v);
+    }
+    if (!straddles(d1, tolerance * l2)) {
+        return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        const double v[3] = {t2[3 * i] - t1[0], t2[3 * i + 1] - t1[1], t2[3 * i + 2] - t1[2]};
+        d2[i] = detail::dot3(n1, v);
+    }
+    if (!straddles(d2, tolerance * l1)) {
+        return false;
+    }
+    double dir[3];
+    detail::cross3(n1, n2, dir);
+    double length = std::sqrt(detail::dot3(dir, dir));
+    if (!(length > 0.0)) {
+        return false;
+    }
+    for (int k = 0; k < 3; ++k) {
+        dir[k] /= length;
+    }
+    double lo1, hi1, lo2, hi2;
+    crossingInterval(t1, d1, t1, dir, lo1, hi1);
+    crossingInterval(t2, d2, t1, dir, lo2, hi2);
+    return std::min(hi1, hi2) - std::max(lo1, lo2) > tolerance;
+}
+
+/**
+ * @brief 两个三角形之间的最小距离
+ *
+ * 不相交时最近点对必然落在某个顶点与对方三角形之间，或两条边之间
+ */
+double CollisionDetector::triangleDistance(const double* t1, const double* t2) {
+    if (trianglesIntersect(t1, t2, 0.0)) {
+        return 0.0;
+    }
+    double best = std::numeric_limits<double>::infinity();
+    double closest[3];
+    for (int v = 0; v < 3; ++v) {
+        best = std::min(best, TriangleBVH::closestPointOnTriangle(t1 + 3 * v, t2, closest));
+        best = std::min(best, TriangleBVH::closestPointOnTriangle(t2 + 3 * v, t1, closest));
+    }
+    for (int i = 0; i < 3; ++i) {
+        const double* p1 = t1 + 3 * i;
+        const double* q1 = t1 + 3 * ((i + 1) % 3);
+        for (int j = 0; j < 3; ++j) {
+            best = std::min(best, segmentDistance2(p1, q1, t2 + 3 * j, t2 + 3 * ((j + 1) % 3)));
+        }
+    }
+    return std::sqrt(best);
+}
@@ -0,0 +1,680 @@
+#include "command_line.h"
+#include "detail/clock.h"
+#include "detail/text_output.h"
+#include "model_manager.h"
+#include "model_io.h"
+#include "async_model_loader.h"
+#include "batch_validator.h"
+#include "mesh_topology.h"
+#include "model_fingerprint.h"
+#include "model_server.h"
+#include "parallel_utils.h"
+#include "primitive_builder.h"
+#include "ray_caster.h"
+#include "triangle_bvh.h"
+#include "winding_number.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 命令行参数错误
+ */
+struct UsageError {
+    std::string message;
+};
+
+/**
+ * @brief 解析后的命令行参数
+ * 
+ * 支持 --name value 与 --name=value 两种写法，其余参数按位置收集
+ */
+struct Arguments {
+    std::string command;
+    std::vector<std::string> positional;
+    std::map<std::string, std::string> options;
+    
+    bool has(const std::string& name) const { return options.count(name) != 0; }
+    
+    std::string get(const std::string& name, const std::string& fallback) const {
+        auto it = options.find(name);
+        return it == options.end() ? fallback : it->second;
+    }
+    
+    double getDouble(const std::string& name, double fallback) const {
+        auto it = options.find(name);
+        if (it == options.end()) return fallback;
+        char* end = nullptr;
+        double value = std::strtod(it->second.c_str(), &end);
+        if (end == it->second.c_str() || *end != '\0') {
+            throw UsageError{"选项 --" + name + " 需要数值"};
+        }
+        return value;
+    }
+    
+    long getInteger(const std::string& name, long fallback) const {
+        auto it = options.find(name);
+        if (it == options.end()) return fallback;
+        char* end = nullptr;
+        long value = std::strtol(it->second.c_str(), &end, 10);
+        if (end == it->second.c_str() || *end != '\0' || value < 0) {
+            throw UsageError{"选项 --" + name + " 需要非负整数"};
+        }
+        return value;
+    }
+};
+
+Arguments parseArguments(int argc, char** argv) {
+    Arguments args;
+    if (argc >= 2) {
+        args.command = argv[1];
+    }
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            std::string name = arg.substr(2);
+            size_t eq = name.find('=');
+            if (eq != std::string::npos) {
+                args.options[name.substr(0, eq)] = name.substr(eq + 1);
+            } else if (name == "help") {
+                args.options[name] = "1";
+            } else if (i + 1 < argc) {
+                args.options[name] = argv[++i];
+            } else {
+                throw UsageError{"选项 --" + name + " 缺少参数值"};
+            }
+        } else {
+            args.positional.push_back(arg);
+        }
+    }
+    return args;
+}
+
+/**
+ * @brief 输出格式
+ */
+enum class OutputFormat { Text, JSON, CSV };
+
+OutputFormat parseFormat(const Arguments& args) {
+    std::string format = args.get("format", "text");
+    if (format == "text") return OutputFormat::Text;
+    if (format == "json") return OutputFormat::JSON;
+    if (format == "csv") return OutputFormat::CSV;
+    throw UsageError{"未知输出格式: " + format};
+}
+
+/**
+ * @brief 有序键值报告，按输出格式写为文本、JSON对象或CSV
+ */
+class Report {
+public:
+    void add(const std::string& key, const std::string& value) { entries.push_back(Entry{key, value, false}); }
+    void add(const std::string& key, double value) { entries.push_back(Entry{key, format(value), true}); }
+    void add(const std::string& key, size_t value) { entries.push_back(Entry{key, std::to_string(value), true}); }
+    void add(const std::string& key, bool value) { entries.push_back(Entry{key, value ? "true" : "false", true}); }
+    
+    void write(std::ostream& out, OutputFormat output) const {
+        if (output == OutputFormat::JSON) {
+            out << "{";
+            for (size_t i = 0; i < entries.size(); ++i) {
+                out << (i ? "," : "") << "\"" << entries[i].key << "\":";
+                if (entries[i].numeric) {
+                    out << entries[i].value;
+                } else {
+                    detail::writeJSONString(out, entries[i].value);
+                }
+            }
+            out << "}" << std::endl;
+        } else if (output == OutputFormat::CSV) {
+            out << "key,value\n";
+            for (const auto& entry : entries) {
+                out << entry.key << ",";
+                detail::writeCSVField(out, entry.value);
+                out << "\n";
+            }
+        } else {
+            for (const auto& entry : entries) {
+                out << entry.key << ": " << entry.value << "\n";
+            }
+        }
+    }
+    
+private:
+    struct Entry {
+        std::string key;
+        std::string value;
+        bool numeric;
+    };
+    
+    static std::string format(double value) {
+        if (!std::isfinite(value)) return "null";
+        std::ostringstream stream;
+        stream.precision(12);
+        stream << value;
+        return stream.str();
+    }
+    
+    std::vector<Entry> entries;
+};
+
+void loadModel(const std::string& path, ModelManager& manager) {
+    std::string error;
+    if (!ModelIO::load(path, manager, &error)) {
+        throw UsageError{error};
+    }
+}
+
+const std::string& requirePositional(const Arguments& args, size_t index, const char* what) {
+    if (index >= args.positional.size()) {
+        throw UsageError{std::string("缺少参数: ") + what};
+    }
+    return args.positional[index];
+}
+
+/**
+ * @brief 计算包围盒
+ */
+void computeBounds(const ModelManager& manager, double* min, double* max) {
+    for (int k = 0; k < 3; ++k) {
+        min[k] = std::numeric_limits<double>::infinity();
+        max[k] = -std::numeric_limits<double>::infinity();
+    }
+    for (const auto& v : manager.getVertices()) {
+        double p[3] = {v->x, v->y, v->z};
+        for (int k = 0; k < 3; ++k) {
+            min[k] = std::min(min[k], p[k]);
+            max[k] = std::max(max[k], p[k]);
+        }
+    }
+}
+
+int commandImport(const Arguments& args, OutputFormat output) {
+    const std::string& first = requirePositional(args, 0, "输入文件或目录");
+    std::vector<std::string> files;
+    bool single = args.positional.size() == 1 && !AsyncModelLoader::listModelFiles(first, files);
+    if (single) {
+        ModelManager manager;
+        double start = detail::nowSeconds();
+        loadModel(first, manager);
+        double elapsed = detail::nowSeconds() - start;
+        
+        Report report;
+        report.add("file", first);
+        report.add("format", std::string(ModelIO::isBinaryPath(first) ? "cadm" : "obj"));
+        report.add("vertices", manager.getVertices().size());
+        report.add("edges", manager.getEdges().size());
+        report.add("faces", manager.getFaces().size());
+        report.add("memory_bytes", manager.estimateMemoryUsage());
+        report.add("load_seconds", elapsed);
+        report.write(std::cout, output);
+        return 0;
+    }
+    
+    // 多个文件或目录：读取与解析流水线并行
+    files.clear();
+    for (const auto& path : args.positional) {
+        if (!AsyncModelLoader::listModelFiles(path, files)) {
+            files.push_back(path);
+        }
+    }
+    AsyncLoadOptions options;
+    options.io_threads = static_cast<unsigned>(args.getInteger("io-threads", options.io_threads));
+    options.parse_threads = ParallelUtils::threadCount();
+    double start = detail::nowSeconds();
+    std::vector<LoadedModel> results;
+    {
+        AsyncModelLoader loader(options);
+        results = loader.loadAll(files);
+    }
+    double elapsed = detail::nowSeconds() - start;
+    
+    size_t loaded = 0, vertices = 0, faces = 0, bytes = 0;
+    for (const auto& result : results) {
+        bytes += result.bytes;
+        if (!result.ok()) {
+            std::cerr << "读取失败: " << result.path << " (" << result.error << ")" << std::endl;
+            continue;
+        }
+        ++loaded;
+        vertices += result.manager->getVertices().size();
+        faces += result.manager->getFaces().size();
+    }
+    Report report;
+    report.add("files", results.size());
+    report.add("loaded", loaded);
+    report.add("failed", results.size() - loaded);
+    report.add("vertices", vertices);
+    report.add("faces", faces);
+    report.add("bytes", bytes);
+    report.add("load_seconds", elapsed);
+    report.add("megabytes_per_second", elapsed > 0.0 ? bytes / elapsed / 1048576.0 : 0.0);
+    report.write(std::cout, output);
+    return loaded == results.size() ? 0 : 2;
+}
+
+int commandCheck(const Arguments& args, OutputFormat output) {
+    if (args.positional.empty()) {
+        throw UsageError{"缺少参数: 输入文件"};
+    }
+    BatchValidationOptions options;
+    options.workers = ParallelUtils::threadCount();
+    options.timeout_seconds = args.getDouble("timeout", 0.0);
+    options.memory_limit_bytes = static_cast<size_t>(args.getInteger("memory-limit", 0));
+    BatchValidator validator(options);
+    
+    // 文本格式逐零件流式输出，JSON/CSV在全部完成后输出汇总
+    BatchValidator::ResultCallback on_result;
+    if (output == OutputFormat::Text) {
+        on_result = [](const ValidationResult& result) {
+            std::cout << BatchValidator::statusName(result.status) << "  " << result.name;
+            if (result.status == ValidationStatus::Failed) {
+                std::cout << "  (重复边 " << result.duplicate_edges << ", 重复面 " << result.duplicate_faces
+                          << ", 法向不一致 " << result.inconsistent_normals << ")";
+            } else if (!result.message.empty()) {
+                std::cout << "  (" << result.message << ")";
+            }
+            std::cout << std::endl;
+        };
+    }
+    auto results = validator.validateFiles(args.positional, on_result);
+    if (output == OutputFormat::JSON) {
+        BatchValidator::writeJSON(std::cout, results);
+    } else if (output == OutputFormat::CSV) {
+        BatchValidator::writeCSV(std::cout, results);
+    }
+    for (const auto& result : results) {
+        if (result.status != ValidationStatus::Passed) {
+            return 2;
+        }
+    }
+    return 0;
+}
+
+int commandConvert(const Arguments& args, OutputFormat output) {
+    const std::string& input = requirePositional(args, 0, "输入文件");
+    const std::string& target = requirePositional(args, 1, "输出文件");
+    ModelManager manager;
+    double start = detail::nowSeconds();
+    loadModel(input, manager);
+    double loaded = detail::nowSeconds();
+    if (!ModelIO::save(target, manager)) {
+        throw UsageError{"无法写出文件: " + target};
+    }
+    double saved = detail::nowSeconds();
+    
+    Report report;
+    report.add("input", input);
+    report.add("output", target);
+    report.add("vertices", manager.getVertices().size());
+    report.add("faces", manager.getFaces().size());
+    report.add("load_seconds", loaded - start);
+    report.add("save_seconds", saved - loaded);
+    report.write(std::cout, output);
+    return 0;
+}
+
+int commandStats(const Arguments& args, OutputFormat output) {
+    const std::string& path = requirePositional(args, 0, "输入文件");
+    ModelManager manager;
+    loadModel(path, manager);
+    auto topology = manager.getMeshTopology();
+    const auto& vertices = manager.getVertices();
+    
+    size_t boundary_edges = 0;
+    size_t nonmanifold_edges = 0;
+    for (size_t e = 0; e < topology->edgeCount(); ++e) {
+        int valence = topology->edge_face_offsets[e + 1] - topology->edge_face_offsets[e];
+        if (valence == 1) ++boundary_edges;
+        if (valence > 2) ++nonmanifold_edges;
+    }
+    
+    double area = 0.0;
+    double volume = 0.0;
+    for (size_t t = 0; t < topology->triangleCount(); ++t) {
+        const Point3D& a = *vertices[topology->triangle_vertices[3 * t]];
+        const Point3D& b = *vertices[topology->triangle_vertices[3 * t + 1]];
+        const Point3D& c = *vertices[topology->triangle_vertices[3 * t + 2]];
+        double u[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+        double v[3] = {c.x - a.x, c.y - a.y, c.z - a.z};
+        double n[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+        area += 0.5 * std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        volume += (a.x * n[0] + a.y * n[1] + a.z * n[2]) / 6.0;
+    }
+    bool closed = boundary_edges == 0 && nonmanifold_edges == 0 && topology->edgeCount() > 0;
+    
+    double min[3], max[3];
+    computeBounds(manager, min, max);
+    
+    Report report;
+    report.add("file", path);
+    report.add("vertices", vertices.size());
+    report.add("edges", topology->edgeCount());
+    report.add("faces", topology->faceCount());
+    report.add("triangles", topology->triangleCount());
+    report.add("boundary_edges", boundary_edges);
+    report.add("nonmanifold_edges", nonmanifold_edges);
+    report.add("closed", closed);
+    report.add("bbox_min_x", min[0]);
+    report.add("bbox_min_y", min[1]);
+    report.add("bbox_min_z", min[2]);
+    report.add("bbox_max_x", max[0]);
+    report.add("bbox_max_y", max[1]);
+    report.add("bbox_max_z", max[2]);
+    report.add("surface_area", area);
+    report.add("volume", closed ? volume : std::numeric_limits<double>::quiet_NaN());
+    report.write(std::cout, output);
+    return 0;
+}
+
+int commandBench(const Arguments& args, OutputFormat output) {
+    const std::string& path = requirePositional(args, 0, "输入文件");
+    size_t queries = static_cast<size_t>(args.getInteger("queries", 100000));
+    
+    ModelManager manager;
+    double t0 = detail::nowSeconds();
+    loadModel(path, manager);
+    double t1 = detail::nowSeconds();
+    manager.getMeshTopology();
+    double t2 = detail::nowSeconds();
+    std::shared_ptr<const TriangleBVH> bvh(new TriangleBVH(manager));
+    double t3 = detail::nowSeconds();
+    
+    // 查询点与射线在放大的包围盒内按固定种子随机生成，保证结果可复现
+    double min[3], max[3];
+    bvh->getBounds(min, max);
+    double extent[3];
+    for (int k = 0; k < 3; ++k) {
+        double pad = 0.1 * (max[k] - min[k]) + 1e-6;
+        min[k] -= pad;
+        max[k] += pad;
+        extent[k] = max[k] - min[k];
+    }
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> xs(queries), ys(queries), zs(queries);
+    std::vector<Ray> rays(queries);
+    for (size_t i = 0; i < queries; ++i) {
+        xs[i] = min[0] + unit(rng) * extent[0];
+        ys[i] = min[1] + unit(rng) * extent[1];
+        zs[i] = min[2] + unit(rng) * extent[2];
+        double theta = 2.0 * M_PI * unit(rng);
+        double cz = 2.0 * unit(rng) - 1.0;
+        double sz = std::sqrt(1.0 - cz * cz);
+        rays[i] = Ray(xs[i], ys[i], zs[i], sz * std::cos(theta), sz * std::sin(theta), cz);
+    }
+    
+    RayCaster caster(bvh);
+    std::vector<RayHit> hits;
+    double t4 = detail::nowSeconds();
+    caster.intersect(rays, hits);
+    double t5 = detail::nowSeconds();
+    size_t hit_count = 0;
+    for (const auto& hit : hits) {
+        if (hit.hit()) ++hit_count;
+    }
+    
+    WindingNumber winding(bvh);
+    std::vector<char> inside;
+    double t6 = detail::nowSeconds();
+    winding.classify(xs.data(), ys.data(), zs.data(), queries, inside);
+    double t7 = detail::nowSeconds();
+    size_t inside_count = 0;
+    for (char flag : inside) {
+        if (flag) ++inside_count;
+    }
+    
+    double t8 = detail::nowSeconds();
+    ParallelUtils::parallelFor(queries, 1024, [&](size_t begin, size_t end) {
+        ClosestPointResult result;
+        for (size_t i = begin; i < end; ++i) {
+            bvh->closestPoint(xs[i], ys[i], zs[i], std::numeric_limits<double>::infinity(), result);
+        }
+    });
+    double t9 = detail::nowSeconds();
+    
+    auto rate = [](size_t count, double seconds) { return seconds > 0.0 ? count / seconds : 0.0; };
+    Report report;
+    report.add("file", path);
+    report.add("threads", static_cast<size_t>(ParallelUtils::threadCount()));
+    report.add("triangles", bvh->triangleCount());
+    report.add("queries", queries);
+    report.add("load_seconds", t1 - t0);
+    report.add("topology_seconds", t2 - t1);
+    report.add("bvh_seconds", t3 - t2);
+    report.add("ray_seconds", t5 - t4);
+    report.add("rays_per_second", rate(queries, t5 - t4));
+    report.add("ray_hits", hit_count);
+    report.add("winding_seconds", t7 - t6);
+    report.add("winding_per_second", rate(queries, t7 - t6));
+    report.add("inside_points", inside_count);
+    report.add("closest_seconds", t9 - t8);
+    report.add("closest_per_second", rate(queries, t9 - t8));
+    report.write(std::cout, output);
+    return 0;
+}
+
+int commandGenerate(const Arguments& args, OutputFormat output) {
+    const std::string& shape = requirePositional(args, 0, "基本体类型");
+    const std::string& target = requirePositional(args, 1, "输出文件");
+    double tolerance = args.getDouble("tolerance", 0.01);
+    double radius = args.getDouble("radius", 1.0);
+    double height = args.getDouble("height", 2.0);
+    Point3D center(0, args.getDouble("x", 0.0), args.getDouble("y", 0.0), args.getDouble("z", 0.0));
+    
+    ModelManager manager;
+    bool ok = false;
+    if (shape == "cylinder") {
+        ok = PrimitiveBuilder::cylinder(manager, center, radius, height, tolerance, args.getDouble("inner-radius", 0.0));
+    } else if (shape == "cone") {
+        ok = PrimitiveBuilder::cone(manager, center, radius, args.getDouble("top-radius", 0.0), height, tolerance);
+    } else if (shape == "sphere") {
+        ok = PrimitiveBuilder::sphere(manager, center, radius, tolerance);
+    } else if (shape == "torus") {
+        ok = PrimitiveBuilder::torus(manager, center, radius, args.getDouble("minor-radius", 0.25 * radius), tolerance);
+    } else if (shape == "hexprism") {
+        ok = PrimitiveBuilder::hexPrism(manager, center, args.getDouble("across-flats", 2.0 * radius), height);
+    } else {
+        throw UsageError{"未知基本体类型: " + shape};
+    }
+    if (!ok) {
+        throw UsageError{"基本体参数无效"};
+    }
+    if (!ModelIO::save(target, manager)) {
+        throw UsageError{"无法写出文件: " + target};
+    }
+    
+    Report report;
+    report.add("shape", shape);
+    report.add("output", target);
+    report.add("vertices", manager.getVertices().size());
+    report.add("faces", manager.getFaces().size());
+    report.write(std::cout, output);
+    return 0;
+}
+
+int commandDedup(const Arguments& args, OutputFormat output) {
+    requirePositional(args, 0, "输入文件或目录");
+    std::vector<std::string> files;
+    for (const auto& path : args.positional) {
+        if (!AsyncModelLoader::listModelFiles(path, files)) {
+            files.push_back(path);
+        }
+    }
+    double tolerance = args.getDouble("tolerance", 0.0);
+    
+    // 读取流水线中逐个计算指纹，模型随即释放，内存占用与零件数量无关
+    std::vector<Fingerprint> fingerprints(files.size());
+    std::vector<char> loaded(files.size(), 0);
+    std::unordered_map<std::string, size_t> index_of;
+    for (size_t i = 0; i < files.size(); ++i) {
+        index_of[files[i]] = i;
+    }
+    AsyncLoadOptions options;
+    options.parse_threads = ParallelUtils::threadCount();
+    {
+        AsyncModelLoader loader(options);
+        loader.loadAll(files, [&](const LoadedModel& model) {
+            if (!model.ok()) {
+                std::cerr << "读取失败: " << model.path << " (" << model.error << ")" << std::endl;
+                return;
+            }
+            size_t i = index_of[model.path];
+            fingerprints[i] = ModelFingerprint::compute(*model.manager, tolerance, false);
+            loaded[i] = 1;
+        });
+    }
+    std::vector<size_t> valid;
+    std::vector<Fingerprint> valid_fingerprints;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (loaded[i]) {
+            valid.push_back(i);
+            valid_fingerprints.push_back(fingerprints[i]);
+        }
+    }
+    auto groups = ModelFingerprint::groupDuplicates(valid_fingerprints);
+    
+    if (output == OutputFormat::JSON) {
+        std::cout << "{\"files\":" << files.size() << ",\"loaded\":" << valid.size() << ",\"groups\":[";
+        for (size_t g = 0; g < groups.size(); ++g) {
+            std::cout << (g ? "," : "") << "{\"fingerprint\":\"" << valid_fingerprints[groups[g][0]].hex() << "\",\"files\":[";
+            for (size_t k = 0; k < groups[g].size(); ++k) {
+                std::cout << (k ? "," : "");
+                detail::writeJSONString(std::cout, files[valid[groups[g][k]]]);
+            }
+            std::cout << "]}";
+        }
+        std::cout << "]}" << std::endl;
+    } else if (output == OutputFormat::CSV) {
+        std::cout << "group,fingerprint,file\n";
+        for (size_t g = 0; g < groups.size(); ++g) {
+            for (size_t index : groups[g]) {
+                std::cout << g << "," << valid_fingerprints[index].hex() << ",";
+                detail::writeCSVField(std::cout, files[valid[index]]);
+                std::cout << "\n";
+            }
+        }
+    } else {
+        for (size_t g = 0; g < groups.size(); ++g) {
+            std::cout << "重复组 " << g << " (" << valid_fingerprints[groups[g][0]].hex() << "):" << std::endl;
+            for (size_t index : groups[g]) {
+                std::cout << "  " << files[valid[index]] << std::endl;
+            }
+        }
+        std::cout << "共 " << valid.size() << " 个零件，" << groups.size() << " 个重复组" << std::endl;
+    }
+    return loaded.size() == valid.size() ? 0 : 2;
+}
+
+int commandServe(const Arguments& args, OutputFormat) {
+    const std::string& socket_path = requirePositional(args, 0, "套接字路径");
+    ModelServer server(socket_path);
+    // 模型名称取文件名（不含目录）
+    for (size_t i = 1; i < args.positional.size(); ++i) {
+        const std::string& path = args.positional[i];
+        size_t slash = path.find_last_of("/\\");
+        std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+        std::string error;
+        if (!server.loadModel(name, path, &error)) {
+            throw UsageError{error};
+        }
+    }
+    std::string error;
+    if (!server.start(&error)) {
+        throw UsageError{error};
+    }
+    std::cerr << "服务已启动: " << socket_path << std::endl;
+    server.wait();
+    return 0;
+}
+
+int commandQuery(const Arguments& args, OutputFormat) {
+    const std::string& socket_path = requirePositional(args, 0, "套接字路径");
+    requirePositional(args, 1, "请求");
+    std::string line;
+    for (size_t i = 1; i < args.positional.size(); ++i) {
+        line += (i > 1 ? " " : "") + args.positional[i];
+    }
+    ModelClient client;
+    std::string error;
+    if (!client.connect(socket_path, &error)) {
+        throw UsageError{error};
+    }
+    std::string response;
+    if (!client.request(line, response)) {
+        throw UsageError{"服务器未响应"};
+    }
+    std::cout << response << std::endl;
+    return response.compare(0, 10, "{\"ok\":true") == 0 ? 0 : 2;
+}
+
+} // namespace
+
+/**
+ * @brief 输出用法说明
+ * 
+ * @param out 输出流
+ */
+void CommandLine::printUsage(std::ostream& out) {
+    out << "用法: cad_model_manager <子命令> [参数] [选项]\n"
+           "\n"
+           "子命令:\n"
+           "  import <文件或目录>...           读取模型并输出规模与耗时（多个文件时并行流水线读取，\n"
+           "                                   --io-threads 读取线程数）\n"
+           "  check <文件>...                  批量拓扑检测（--timeout 秒, --memory-limit 字节）\n"
+           "  convert <输入> <输出>            格式转换（.obj / .cadm）\n"
+           "  stats <文件>                     几何与拓扑统计\n"
+           "  bench <文件>                     查询性能测试（--queries 数量）\n"
+           "  generate <类型> <输出>           生成基本体：cylinder|cone|sphere|torus|hexprism\n"
+           "                                   （--radius --height --tolerance --inner-radius\n"
+           "                                     --top-radius --minor-radius --across-flats --x --y --z）\n"
+           "  dedup <文件或目录>...            按几何指纹查找重复零件（--tolerance 量化容差）\n"
+           "  serve <套接字> [文件]...          常驻模型并经Unix域套接字提供查询\n"
+           "  query <套接字> <请求>            向模型服务器发送请求（BBOX/CLOSEST/TOPOLOGY/EXPORT等）\n"
+           "  demo                             运行内置演示\n"
+           "\n"
+           "通用选项:\n"
+           "  --threads N                      线程数（0为硬件线程数）\n"
+           "  --format text|json|csv           输出格式\n";
+}
+
+/**
+ * @brief 执行命令行
+ * 
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return int 进程退出码
+ */
+int CommandLine::run(int argc, char** argv) {
+    try {
+        Arguments args = parseArguments(argc, argv);
+        if (args.command.empty() || args.command == "help" || args.command == "--help" || args.has("help")) {
+            printUsage(args.command.empty() ? std::cerr : std::cout);
+            return args.command.empty() ? 1 : 0;
+        }
+        ParallelUtils::setThreadCount(static_cast<unsigned>(args.getInteger("threads", 0)));
+        OutputFormat output = parseFormat(args);
+        
+        if (args.command == "import") return commandImport(args, output);
+        if (args.command == "check") return commandCheck(args, output);
+        if (args.command == "convert") return commandConvert(args, output);
+        if (args.command == "stats") return commandStats(args, output);
+        if (args.command == "bench") return commandBench(args, output);
+        if (args.command == "generate") return commandGenerate(args, output);
+        if (args.command == "dedup") return commandDedup(args, output);
+        if (args.command == "serve") return commandServe(args, output);
+        if (args.command == "query") return commandQuery(args, output);
+        throw UsageError{"未知子命令: " + args.command};
+    } catch (const UsageError& e) {
+        std::cerr << "错误: " << e.message << std::endl;
+        return 1;
+    }
+}
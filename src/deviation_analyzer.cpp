@@ -0,0 +1,448 @@
+#include "deviation_analyzer.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+const int kNormalStride = 21; // 每个三角形的伪法向分量数
+const double kFeatureEpsilon = 1e-9; // 判定最近点落在边或顶点上的重心坐标阈值
+
+/**
+ * @brief 顶点坐标键：坐标按位比较，同一顶点在各三角形中的坐标完全一致
+ */
+struct CoordinateKey {
+    uint64_t bits[3];
+
+    bool operator==(const CoordinateKey& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+    }
+};
+
+struct CoordinateKeyHasher {
+    size_t operator()(const CoordinateKey& key) const {
+        uint64_t h = key.bits[0] * 0x9e3779b97f4a7c15ULL;
+        h ^= key.bits[1] + 0x7f4a7c159e3779b9ULL + (h << 6) + (h >> 2);
+        h ^= key.bits[2] + 0x94d049bb133111ebULL + (h << 6) + (h >> 2);
+        return static_cast<size_t>(h);
+    }
+};
+
+CoordinateKey makeKey(const double* p) {
+    CoordinateKey key;
+    for (int k = 0; k < 3; ++k) {
+        double value = p[k] == 0.0 ? 0.0 : p[k]; // 负零归零
+        std::memcpy(&key.bits[k], &value, sizeof(value));
+    }
+    return key;
+}
+
+/**
+ * @brief 分块内的偏差统计累加器
+ */
+struct DeviationAccumulator {
+    size_t count;
+    size_t unmatched;
+    size_t within_tolerance;
+    size_t below_range;
+    size_t above_range;
+    double min;
+    double max;
+    double sum;
+    double squared_sum;
+
+    DeviationAccumulator()
+        : count(0), unmatched(0), within_tolerance(0), below_range(0), above_range(0),
+          min(std::numeric_limits<double>::max()), max(-std::numeric_limits<double>::max()),
+          sum(0.0), squared_sum(0.0) {}
+
+    void merge(const DeviationAccumulator& other) {
+        count += other.count;
+        unmatched += other.unmatched;
+        within_tolerance += other.within_tolerance;
+        below_range += other.below_range;
+        above_range += other.above_range;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+        sum += other.sum;
+        squared_sum += other.squared_sum;
+    }
+};
+
+/**
+ * @brief 按最近点所在特征选取伪法向，返回有向距离
+ *
+ * @param normals 三角形的21个伪法向分量
+ * @param tri 三角形9个顶点坐标分量
+ * @param p 查询点
+ * @param hit 最近点查询结果
+ */
+double signedDistance(const double* normals, const double* tri, const double* p, const ClosestPointResult& hit) {
+    // 最近点的重心坐标
+    double e0[3], e1[3], d[3];
+    for (int k = 0; k < 3; ++k) {
+        e0[k] = tri[3 + k] - tri[k];
+        e1[k] = tri[6 + k] - tri[k];
+        d[k] = hit.point[k] - tri[k];
+    }
+    double d00 = e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2];
+    double d01 = e0[0] * e1[0] + e0[1] * e1[1] + e0[2] * e1[2];
+    double d11 = e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2];
+    double d20 = d[0] * e0[0] + d[1] * e0[1] + d[2] * e0[2];
+    double d21 = d[0] * e1[0] + d[1] * e1[1] + d[2] * e1[2];
+    double denom = d00 * d11 - d01 * d01;
+
+    const double* normal = normals; // 面法向
+    if (denom > 0.0) {
+        double v = (d11 * d20 - d01 * d21) / denom;
+        double w = (d00 * d21 - d01 * d20) / denom;
+        double u = 1.0 - v - w;
+        bool zu = u < kFeatureEpsilon, zv = v < kFeatureEpsilon, zw = w < kFeatureEpsilon;
+        if (zv && zw) {
+            normal = normals + 3;
+        } else if (zu && zw) {
+            normal = normals + 6;
+        } else if (zu && zv) {
+            normal = normals + 9;
+        } else if (zw) {
+            normal = normals + 12; // 边01
+        } else if (zu) {
+            normal = normals + 15; // 边12
+        } else if (zv) {
+            normal = normals + 18; // 边20
+        }
+    }
+
+    double side = (p[0] - hit.point[0]) * normal[0] + (p[1] - hit.point[1]) * normal[1] +
+                  (p[2] - hit.point[2]) * normal[2];
+    return side < 0.0 ? -hit.distance : hit.distance;
+}
+
+} // namespace
+
+/**
+ * @brief 由直方图估计偏差分位数
+ */
+double DeviationStats::percentile(double fraction) const {
+    if (count == 0 || histogram.empty()) {
+        return 0.0;
+    }
+    double target = std::max(0.0, std::min(1.0, fraction)) * count;
+    double cumulative = static_cast<double>(below_range);
+    if (target <= cumulative) {
+        return std::max(min, -histogram_range);
+    }
+    double width = 2.0 * histogram_range / histogram.size();
+    for (size_t b = 0; b < histogram.size(); ++b) {
+        double next = cumulative + histogram[b];
+        if (target <= next && histogram[b] > 0) {
+            double t = (target - cumulative) / histogram[b];
+            return -histogram_range + (b + t) * width;
+        }
+        cumulative = next;
+    }
+    return std::min(max, histogram_range);
+}
+
+/**
+ * @brief 从名义模型构建
+ *
+ * @param nominal 名义模型
+ */
+DeviationAnalyzer::DeviationAnalyzer(const ModelManager& nominal)
+    : bvh_ptr(std::make_shared<TriangleBVH>(nominal)) {
+    buildPseudoNormals();
+}
+
+/**
+ * @brief 复用已构建的BVH
+ *
+ * @param bvh 名义模型的三角形BVH
+ */
+DeviationAnalyzer::DeviationAnalyzer(std::shared_ptr<const TriangleBVH> bvh)
+    : bvh_ptr(bvh) {
+    buildPseudoNormals();
+}
+
+/**
+ * @brief 计算角度加权伪法向
+ *
+ * 只依赖BVH中的三角形坐标：坐标完全相同的角点视为同一顶点，
+ * 顶点伪法向为相邻三角形法向按顶角加权求和，边伪法向为两侧三角形法向之和
+ */
+void DeviationAnalyzer::buildPseudoNormals() {
+    const TriangleBVH& bvh = *bvh_ptr;
+    size_t triangle_count = bvh.triangleCount();
+    pseudo_normals.assign(kNormalStride * triangle_count, 0.0);
+
+    std::unordered_map<CoordinateKey, int, CoordinateKeyHasher> vertex_lookup;
+    vertex_lookup.reserve(triangle_count);
+    std::vector<int> corner_vertices(3 * triangle_count);
+    for (size_t t = 0; t < triangle_count; ++t) {
+        const double* tri = bvh.triangle(t);
+        for (int c = 0; c < 3; ++c) {
+            auto inserted = vertex_lookup.insert(
+                std::make_pair(makeKey(tri + 3 * c), static_cast<int>(vertex_lookup.size())));
+            corner_vertices[3 * t + c] = inserted.first->second;
+        }
+    }
+
+    // 面法向与顶点角度加权
+    std::vector<double> vertex_normals(3 * vertex_lookup.size(), 0.0);
+    std::unordered_map<uint64_t, int> edge_lookup;
+    edge_lookup.reserve(2 * triangle_count);
+    std::vector<double> edge_normals;
+    std::vector<int> corner_edges(3 * triangle_count);
+    for (size_t t = 0; t < triangle_count; ++t) {
+        const double* tri = bvh.triangle(t);
+        double* normal = &pseudo_normals[kNormalStride * t];
+        double ux = tri[3] - tri[0], uy = tri[4] - tri[1], uz = tri[5] - tri[2];
+        double vx = tri[6] - tri[0], vy = tri[7] - tri[1], vz = tri[8] - tri[2];
+        double nx = uy * vz - uz * vy;
+        double ny = uz * vx - ux * vz;
+        double nz = ux * vy - uy * vx;
+        double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (length > 0.0) {
+            normal[0] = nx / length;
+            normal[1] = ny / length;
+            normal[2] = nz / length;
+        }
+
+        for (int c = 0; c < 3; ++c) {
+            const double* a = tri + 3 * c;
+            const double* b = tri + 3 * ((c + 1) % 3);
+            const double* p = tri + 3 * ((c + 2) % 3);
+            double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            double ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+            double lab = std::sqrt(ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2]);
+            double lap = std::sqrt(ap[0] * ap[0] + ap[1] * ap[1] + ap[2] * ap[2]);
+            double angle = 0.0;
+            if (lab > 0.0 && lap > 0.0) {
+                double cosine = (ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2]) / (lab * lap);
+                angle = std::acos(std::max(-1.0, std::min(1.0, cosine)));
+            }
+            int vertex = corner_vertices[3 * t + c];
+            for (int k = 0; k < 3; ++k) {
+                vertex_normals[3 * vertex + k] += angle * normal[k];
+            }
+
+            int va = corner_vertices[3 * t + c];
+            int vb = corner_vertices[3 * t + (c + 1) % 3];
+            uint64_t key = (static_cast<uint64_t>(std::min(va, vb)) << 32) | static_cast<uint32_t>(std::max(va, vb));
+            auto inserted = edge_lookup.insert(std::make_pair(key, static_cast<int>(edge_normals.size() / 3)));
+            if (inserted.second) {
+                edge_normals.resize(edge_normals.size() + 3, 0.0);
+            }
+            int edge = inserted.first->second;
+            corner_edges[3 * t + c] = edge;
+            for (int k = 0; k < 3; ++k) {
+                edge_normals[3 * edge + k] += normal[k];
+            }
+        }
+    }
+
+    for (size_t t = 0; t < triangle_count; ++t) {
+        double* normal = &pseudo_normals[kNormalStride * t];
+        for (int c = 0; c < 3; ++c) {
+            const double* vn = &vertex_normals[3 * corner_vertices[3 * t + c]];
+            const double* en = &edge_normals[3 * corner_edges[3 * t + c]];
+            for (int k = 0; k < 3; ++k) {
+                normal[3 + 3 * c + k] = vn[k];
+                normal[12 + 3 * c + k] = en[k];
+            }
+        }
+    }
+}
+
+/**
+ * @brief 单点有向偏差
+ */
+double DeviationAnalyzer::deviation(double x, double y, double z, double max_distance) const {
+    ClosestPointResult hit;
+    if (!bvh_ptr->closestPoint(x, y, z, max_distance, hit)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double p[3] = {x, y, z};
+    return signedDistance(&pseudo_normals[kNormalStride * hit.triangle], bvh_ptr->triangle(hit.triangle), p, hit);
+}
+
+/**
+ * @brief 流式分析点云
+ *
+ * 双缓冲：后台线程读取下一块的同时并行处理当前块，
+ * 读取函数抛出的异常在等待读取线程结束后重新抛出；
+ * 处理当前块或sink抛出的异常同样在读取线程结束后再向外传播
+ */
+DeviationStats DeviationAnalyzer::analyze(const PointChunkSource& source, const DeviationOptions& options,
+                                          const DeviationSink& sink) const {
+    DeviationStats stats;
+    stats.histogram_range = options.histogram_range;
+    int bins = std::max(1, options.histogram_bins);
+    stats.histogram.assign(bins, 0);
+
+    size_t chunk = std::max<size_t>(1, options.chunk_size);
+    std::vector<double> buffers[2][3];
+    for (int b = 0; b < 2; ++b) {
+        for (int k = 0; k < 3; ++k) {
+            buffers[b][k].resize(chunk);
+        }
+    }
+    std::vector<double> deviations(chunk);
+
+    unsigned workers = ParallelUtils::threadCount();
+    std::vector<DeviationAccumulator> partial(workers);
+    std::vector<std::vector<size_t>> partial_histograms(workers, std::vector<size_t>(bins, 0));
+    const double bin_scale = options.histogram_range > 0.0 ? bins / (2.0 * options.histogram_range) : 0.0;
+    const RigidTransform& transform = options.transform;
+
+    int current = 0;
+    size_t count = source(buffers[0][0].data(), buffers[0][1].data(), buffers[0][2].data(), chunk);
+    size_t first = 0;
+    while (count > 0) {
+        // 后台读取下一块
+        int next = 1 - current;
+        size_t next_count = 0;
+        std::exception_ptr read_error;
+        std::thread reader([&]() {
+            try {
+                next_count = source(buffers[next][0].data(), buffers[next][1].data(), buffers[next][2].data(), chunk);
+            } catch (...) {
+                read_error = std::current_exception();
+            }
+        });
+
+        // 处理当前块或sink抛出异常时也要先等待读取线程结束，否则线程对象析构时终止进程
+        try {
+            double* xs = buffers[current][0].data();
+            double* ys = buffers[current][1].data();
+            double* zs = buffers[current][2].data();
+            ParallelUtils::parallelForWithWorker(count, 4096, [&](size_t begin, size_t end, unsigned worker) {
+                DeviationAccumulator local;
+                std::vector<size_t>& histogram = partial_histograms[worker];
+                ClosestPointResult hit;
+                for (size_t i = begin; i < end; ++i) {
+                    double p[3] = {xs[i], ys[i], zs[i]};
+                    transform.apply(p, p);
+                    xs[i] = p[0];
+                    ys[i] = p[1];
+                    zs[i] = p[2];
+                    if (!bvh_ptr->closestPoint(p[0], p[1], p[2], options.max_distance, hit)) {
+                        deviations[i] = std::numeric_limits<double>::quiet_NaN();
+                        ++local.unmatched;
+                        continue;
+                    }
+                    double d = signedDistance(&pseudo_normals[kNormalStride * hit.triangle],
+                                              bvh_ptr->triangle(hit.triangle), p, hit);
+                    deviations[i] = d;
+                    ++local.count;
+                    local.sum += d;
+                    local.squared_sum += d * d;
+                    local.min = std::min(local.min, d);
+                    local.max = std::max(local.max, d);
+                    if (std::fabs(d) <= options.tolerance) {
+                        ++local.within_tolerance;
+                    }
+                    if (d < -options.histogram_range) {
+                        ++local.below_range;
+                    } else if (d > options.histogram_range) {
+                        ++local.above_range;
+                    } else {
+                        int bin = static_cast<int>((d + options.histogram_range) * bin_scale);
+                        ++histogram[std::min(bin, bins - 1)];
+                    }
+                }
+                partial[worker].merge(local);
+            });
+
+            if (sink) {
+                sink(first, count, xs, ys, zs, deviations.data());
+            }
+        } catch (...) {
+            reader.join();
+            throw;
+        }
+        reader.join();
+        if (read_error) {
+            std::rethrow_exception(read_error);
+        }
+        first += count;
+        count = next_count;
+        current = next;
+    }
+
+    DeviationAccumulator total;
+    for (unsigned w = 0; w < workers; ++w) {
+        total.merge(partial[w]);
+        for (int b = 0; b < bins; ++b) {
+            stats.histogram[b] += partial_histograms[w][b];
+        }
+    }
+    stats.count = total.count;
+    stats.unmatched = total.unmatched;
+    stats.within_tolerance = total.within_tolerance;
+    stats.below_range = total.below_range;
+    stats.above_range = total.above_range;
+    if (total.count > 0) {
+        stats.min = total.min;
+        stats.max = total.max;
+        stats.mean = total.sum / total.count;
+        stats.rms = std::sqrt(total.squared_sum / total.count);
+        stats.std_dev = std::sqrt(std::max(0.0, total.squared_sum / total.count - stats.mean * stats.mean));
+    }
+    return stats;
+}
+
+/**
+ * @brief 分析内存中的点云（SoA）
+ */
+DeviationStats DeviationAnalyzer::analyze(const double* xs, const double* ys, const double* zs, size_t count,
+                                          const DeviationOptions& options, const DeviationSink& sink) const {
+    size_t position = 0;
+    PointChunkSource source = [&](double* out_x, double* out_y, double* out_z, size_t capacity) {
+        size_t n = std::min(capacity, count - position);
+        std::copy(xs + position, xs + position + n, out_x);
+        std::copy(ys + position, ys + position + n, out_y);
+        std::copy(zs + position, zs + position + n, out_z);
+        position += n;
+        return n;
+    };
+    DeviationOptions chunked = options;
+    chunked.chunk_size = std::min(std::max<size_t>(count, 1), options.chunk_size);
+    return analyze(source, chunked, sink);
+}
+
+/**
+ * @brief 偏差色图
+ */
+void DeviationAnalyzer::colorMap(double deviation, const DeviationOptions& options, unsigned char rgb[3]) {
+    if (std::isnan(deviation)) {
+        rgb[0] = rgb[1] = rgb[2] = 128;
+        return;
+    }
+    double magnitude = std::fabs(deviation);
+    if (magnitude <= options.tolerance) {
+        rgb[0] = 0;
+        rgb[1] = 255;
+        rgb[2] = 0;
+        return;
+    }
+    double span = options.histogram_range - options.tolerance;
+    double t = span > 0.0 ? std::min(1.0, (magnitude - options.tolerance) / span) : 1.0;
+    // 前半段由绿色过渡到黄色/青色，后半段过渡到红色/蓝色
+    unsigned char rising = static_cast<unsigned char>(255.0 * std::min(1.0, 2.0 * t) + 0.5);
+    unsigned char falling = static_cast<unsigned char>(255.0 * std::min(1.0, 2.0 - 2.0 * t) + 0.5);
+    if (deviation > 0.0) {
+        rgb[0] = rising;
+        rgb[1] = falling;
+        rgb[2] = 0;
+    } else {
+        rgb[0] = 0;
+        rgb[1] = falling;
+        rgb[2] = rising;
+    }
+}
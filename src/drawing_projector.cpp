@@ -0,0 +1,339 @@
+#include "drawing_projector.h"
+#include "detail/vec3.h"
+#include "mesh_topology.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+inline void normalize3(double* v) {
+    double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length > 0.0) {
+        v[0] /= length;
+        v[1] /= length;
+        v[2] /= length;
+    }
+}
+
+/**
+ * @brief 视图的深度缓冲
+ *
+ * 像素(i, j)的中心对应视图坐标 (origin_x + (i + 0.5)·pixel, origin_y + (j + 0.5)·pixel)，
+ * 深度为沿观察方向的坐标，越小越近
+ */
+struct DepthBuffer {
+    int width;
+    int height;
+    double origin_x;
+    double origin_y;
+    double pixel;
+    std::vector<double> depth;
+
+    /**
+     * @brief 点所在像素及其8邻域的最小深度
+     *
+     * 边恰好位于面片覆盖范围的边界上，所在像素中心可能未被相邻面覆盖，
+     * 取邻域最小值使贴合在面后的边（如俯视时被顶面遮住的底边）稳定地判为隐藏
+     */
+    double nearest(double x, double y) const {
+        int ci = static_cast<int>(std::floor((x - origin_x) / pixel));
+        int cj = static_cast<int>(std::floor((y - origin_y) / pixel));
+        double result = std::numeric_limits<double>::infinity();
+        for (int j = std::max(cj - 1, 0); j <= std::min(cj + 1, height - 1); ++j) {
+            for (int i = std::max(ci - 1, 0); i <= std::min(ci + 1, width - 1); ++i) {
+                result = std::min(result, depth[static_cast<size_t>(j) * width + i]);
+            }
+        }
+        return result;
+    }
+};
+
+const int kEndpointGuard = 2; // 端点处沿用内侧采样结果的像素数
+
+} // namespace
+
+/**
+ * @brief 可见线数量
+ */
+size_t DrawingView::visibleCount() const {
+    size_t count = 0;
+    for (const auto& line : lines) {
+        count += line.visible ? 1 : 0;
+    }
+    return count;
+}
+
+/**
+ * @brief 从模型构建
+ *
+ * 面法向由Newell法按面顶点环计算（拓扑已统一面方向），
+ * 相邻面法向夹角超过特征角、边界边与非流形边记为特征边；
+ * 所有边恰有两个相邻面时为封闭网格，投影时剔除背面
+ */
+DrawingProjector::DrawingProjector(const ModelManager& manager, double feature_angle) {
+    const auto& vertices = manager.getVertices();
+    positions.resize(3 * vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        positions[3 * i] = vertices[i]->x;
+        positions[3 * i + 1] = vertices[i]->y;
+        positions[3 * i + 2] = vertices[i]->z;
+    }
+    auto topology = manager.getMeshTopology();
+    const MeshTopology& topo = *topology;
+    triangle_vertices = topo.triangle_vertices;
+    triangle_faces = topo.triangle_faces;
+    edge_vertices = topo.edge_vertices;
+
+    const size_t face_count = topo.faceCount();
+    face_normals.assign(3 * face_count, 0.0);
+    for (size_t f = 0; f < face_count; ++f) {
+        int begin = topo.face_offsets[f];
+        int end = topo.face_offsets[f + 1];
+        double* n = &face_normals[3 * f];
+        for (int c = begin; c < end; ++c) {
+            const double* p = &positions[3 * topo.face_vertices[c]];
+            const double* q = &positions[3 * topo.face_vertices[c + 1 < end ? c + 1 : begin]];
+            n[0] += (p[1] - q[1]) * (p[2] + q[2]);
+            n[1] += (p[2] - q[2]) * (p[0] + q[0]);
+            n[2] += (p[0] - q[0]) * (p[1] + q[1]);
+        }
+        normalize3(n);
+    }
+
+    const double threshold = std::cos(feature_angle * M_PI / 180.0);
+    const size_t edge_count = topo.edgeCount();
+    edge_faces.assign(2 * edge_count, -1);
+    feature_flags.assign(edge_count, 0);
+    closed = edge_count > 0;
+    for (size_t e = 0; e < edge_count; ++e) {
+        int begin = topo.edge_face_offsets[e];
+        int end = topo.edge_face_offsets[e + 1];
+        if (end - begin != 2) {
+            closed = false;
+            edge_faces[2 * e] = end > begin ? topo.edge_faces[begin] : -1;
+            feature_flags[e] = 1;
+            continue;
+        }
+        int f0 = topo.edge_faces[begin];
+        int f1 = topo.edge_faces[begin + 1];
+        edge_faces[2 * e] = f0;
+        edge_faces[2 * e + 1] = f1;
+        const double* n0 = &face_normals[3 * f0];
+        const double* n1 = &face_normals[3 * f1];
+        if (n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] < threshold) {
+            feature_flags[e] = 1;
+        }
+    }
+    for (size_t e = 0; e < edge_count; ++e) {
+        if (feature_flags[e]) {
+            feature_edges.push_back(static_cast<int>(e));
+        }
+    }
+}
+
+/**
+ * @brief 标准视图的观察方向
+ */
+void DrawingProjector::viewDirection(StandardView view, double* direction) {
+    static const double kDirections[7][3] = {
+        {0.0, 1.0, 0.0}, {0.0, -1.0, 0.0}, {0.0, 0.0, -1.0}, {0.0, 0.0, 1.0},
+        {1.0, 0.0, 0.0}, {-1.0, 0.0, 0.0}, {-1.0, 1.0, -1.0}};
+    const double* d = kDirections[static_cast<int>(view)];
+    direction[0] = d[0];
+    direction[1] = d[1];
+    direction[2] = d[2];
+    normalize3(direction);
+}
+
+/**
+ * @brief 投影标准视图
+ */
+DrawingView DrawingProjector::project(StandardView view, const DrawingOptions& options) const {
+    double direction[3];
+    viewDirection(view, direction);
+    return project(direction, options);
+}
+
+/**
+ * @brief 批量投影
+ */
+std::vector<DrawingView> DrawingProjector::project(const double* directions, size_t count,
+                                                   const DrawingOptions& options) const {
+    std::vector<DrawingView> views(count);
+    ParallelUtils::parallelFor(count, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            views[i] = project(directions + 3 * i, options);
+        }
+    });
+    return views;
+}
+
+/**
+ * @brief 投影单个视图
+ *
+ * 视图x轴取 direction × ẑ（观察方向平行于z轴时取 direction × ŷ），y轴为 x × direction，
+ * 主视图、俯视图、右视图的坐标轴与制图习惯一致。
+ * 光栅化时每个三角形按深度斜率加偏移（覆盖邻域比较所跨的像素距离），边上的采样点
+ * 不会被所在面遮挡；边按约一个像素的步长采样，相邻同类采样合并为一条线段
+ */
+DrawingView DrawingProjector::project(const double* direction, const DrawingOptions& options) const {
+    DrawingView view;
+    for (int k = 0; k < 3; ++k) {
+        view.direction[k] = direction[k];
+    }
+    normalize3(view.direction);
+    const double* d = view.direction;
+    const double z_axis[3] = {0.0, 0.0, 1.0};
+    const double y_axis[3] = {0.0, 1.0, 0.0};
+    detail::cross3(d, z_axis, view.right);
+    if (view.right[0] * view.right[0] + view.right[1] * view.right[1] + view.right[2] * view.right[2] < 1e-12) {
+        detail::cross3(d, y_axis, view.right);
+    }
+    normalize3(view.right);
+    detail::cross3(view.right, d, view.up);
+
+    // 顶点投影
+    const size_t vertex_count = positions.size() / 3;
+    if (vertex_count == 0) {
+        return view;
+    }
+    std::vector<double> px(vertex_count), py(vertex_count), pz(vertex_count);
+    double lo[3] = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                    std::numeric_limits<double>::infinity()};
+    double hi[3] = {-lo[0], -lo[1], -lo[2]};
+    for (size_t i = 0; i < vertex_count; ++i) {
+        const double* p = &positions[3 * i];
+        px[i] = view.right[0] * p[0] + view.right[1] * p[1] + view.right[2] * p[2];
+        py[i] = view.up[0] * p[0] + view.up[1] * p[1] + view.up[2] * p[2];
+        pz[i] = d[0] * p[0] + d[1] * p[1] + d[2] * p[2];
+        lo[0] = std::min(lo[0], px[i]);
+        lo[1] = std::min(lo[1], py[i]);
+        lo[2] = std::min(lo[2], pz[i]);
+        hi[0] = std::max(hi[0], px[i]);
+        hi[1] = std::max(hi[1], py[i]);
+        hi[2] = std::max(hi[2], pz[i]);
+    }
+
+    // 深度缓冲：长边resolution像素，四周各留一个像素
+    const int resolution = std::max(options.resolution, 8);
+    double extent = std::max(hi[0] - lo[0], hi[1] - lo[1]);
+    DepthBuffer buffer;
+    buffer.pixel = extent > 0.0 ? extent / (resolution - 2) : 1.0;
+    buffer.origin_x = lo[0] - buffer.pixel;
+    buffer.origin_y = lo[1] - buffer.pixel;
+    buffer.width = static_cast<int>(std::ceil((hi[0] - lo[0]) / buffer.pixel)) + 2;
+    buffer.height = static_cast<int>(std::ceil((hi[1] - lo[1]) / buffer.pixel)) + 2;
+    buffer.depth.assign(static_cast<size_t>(buffer.width) * buffer.height, std::numeric_limits<double>::infinity());
+    const double depth_epsilon = 1e-9 * std::max(1.0, hi[2] - lo[2]);
+
+    const size_t triangle_count = triangle_vertices.size() / 3;
+    for (size_t t = 0; t < triangle_count; ++t) {
+        if (closed) {
+            const double* n = &face_normals[3 * triangle_faces[t]];
+            if (n[0] * d[0] + n[1] * d[1] + n[2] * d[2] > 0.0) {
+                continue; // 封闭网格的背面总被正面遮挡
+            }
+        }
+        const int* ids = &triangle_vertices[3 * t];
+        double x[3], y[3], z[3];
+        for (int v = 0; v < 3; ++v) {
+            x[v] = (px[ids[v]] - buffer.origin_x) / buffer.pixel;
+            y[v] = (py[ids[v]] - buffer.origin_y) / buffer.pixel;
+            z[v] = pz[ids[v]];
+        }
+        double area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (std::fabs(area) < 1e-12) {
+            continue;
+        }
+        // 深度平面 z = z0 + a·(x − x0) + b·(y − y0)
+        double a = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+        double b = ((x[1] - x[0]) * (z[2] - z[0]) - (x[2] - x[0]) * (z[1] - z[0])) / area;
+        double offset = options.depth_offset * (std::fabs(a) + std::fabs(b)) + depth_epsilon;
+        int i0 = std::max(0, static_cast<int>(std::ceil(std::min(x[0], std::min(x[1], x[2])) - 0.5)));
+        int i1 = std::min(buffer.width - 1, static_cast<int>(std::floor(std::max(x[0], std::max(x[1], x[2])) - 0.5)));
+        int j0 = std::max(0, static_cast<int>(std::ceil(std::min(y[0], std::min(y[1], y[2])) - 0.5)));
+        int j1 = std::min(buffer.height - 1, static_cast<int>(std::floor(std::max(y[0], std::max(y[1], y[2])) - 0.5)));
+        double sign = area > 0.0 ? 1.0 : -1.0;
+        for (int j = j0; j <= j1; ++j) {
+            double cy = j + 0.5;
+            for (int i = i0; i <= i1; ++i) {
+                double cx = i + 0.5;
+                double w0 = sign * ((x[2] - x[1]) * (cy - y[1]) - (y[2] - y[1]) * (cx - x[1]));
+                double w1 = sign * ((x[0] - x[2]) * (cy - y[2]) - (y[0] - y[2]) * (cx - x[2]));
+                double w2 = sign * ((x[1] - x[0]) * (cy - y[0]) - (y[1] - y[0]) * (cx - x[0]));
+                if (w0 < 0.0 || w1 < 0.0 || w2 < 0.0) {
+                    continue;
+                }
+                double depth = z[0] + a * (cx - x[0]) + b * (cy - y[0]) + offset;
+                double& slot = buffer.depth[static_cast<size_t>(j) * buffer.width + i];
+                if (depth < slot) {
+                    slot = depth;
+                }
+            }
+        }
+    }
+
+    // 特征边与轮廓线按像素步长采样消隐
+    const size_t edge_count = edge_vertices.size() / 2;
+    std::vector<char> flags;
+    for (size_t e = 0; e < edge_count; ++e) {
+        bool silhouette = false;
+        if (!feature_flags[e]) {
+            int f0 = edge_faces[2 * e];
+            int f1 = edge_faces[2 * e + 1];
+            const double* n0 = &face_normals[3 * f0];
+            const double* n1 = &face_normals[3 * f1];
+            bool front0 = n0[0] * d[0] + n0[1] * d[1] + n0[2] * d[2] < 0.0;
+            bool front1 = n1[0] * d[0] + n1[1] * d[1] + n1[2] * d[2] < 0.0;
+            if (front0 == front1) {
+                continue;
+            }
+            silhouette = true;
+        }
+        int v0 = edge_vertices[2 * e];
+        int v1 = edge_vertices[2 * e + 1];
+        double dx = px[v1] - px[v0];
+        double dy = py[v1] - py[v0];
+        double dz = pz[v1] - pz[v0];
+        double length = std::sqrt(dx * dx + dy * dy) / buffer.pixel;
+        if (length < 1e-6) {
+            continue; // 沿视向的边投影为点
+        }
+        int samples = std::max(1, static_cast<int>(std::ceil(length)));
+        flags.resize(samples);
+        for (int s = 0; s < samples; ++s) {
+            double t = (s + 0.5) / samples;
+            flags[s] = pz[v0] + t * dz <= buffer.nearest(px[v0] + t * dx, py[v0] + t * dy);
+        }
+        // 端点附近的邻域会覆盖共享该顶点的其他面，沿用内侧采样的结果
+        int guard = std::min(kEndpointGuard, (samples - 1) / 2);
+        for (int s = 0; s < guard; ++s) {
+            flags[s] = flags[guard];
+            flags[samples - 1 - s] = flags[samples - 1 - guard];
+        }
+        int run_start = 0;
+        for (int s = 1; s <= samples; ++s) {
+            if (s < samples && flags[s] == flags[run_start]) {
+                continue;
+            }
+            bool visible = flags[run_start] != 0;
+            if (visible || options.include_hidden) {
+                double t0 = static_cast<double>(run_start) / samples;
+                double t1 = static_cast<double>(s) / samples;
+                DrawingLine line;
+                line.start[0] = px[v0] + t0 * dx;
+                line.start[1] = py[v0] + t0 * dy;
+                line.end[0] = px[v0] + t1 * dx;
+                line.end[1] = py[v0] + t1 * dy;
+                line.edge = static_cast<int>(e);
+                line.visible = visible;
+                line.silhouette = silhouette;
+                view.lines.push_back(line);
+            }
+            run_start = s;
+        }
+    }
+    return view;
+}
@@ -1,5 +1,83 @@
 #include "geometry_algorithm.h"
+#include "detail/vec3.h"
+#include "parallel_utils.h"
 #include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief 轮廓顶点随选中边内缩单位距离的位移
+ *
+ * 位移x满足 x·n_prev = w_prev、x·n_next = w_next（n为边的内法向，选中边w = 1，否则为0），
+ * 即相邻两条偏置线的交点；两条边共线时退化为沿法向位移
+ */
+void insetDirections(const Profile2D& profile, const std::vector<int>& edges, std::vector<double>& dx,
+                     std::vector<double>& dy) {
+    const size_t n = profile.size();
+    std::vector<double> weight(n, edges.empty() ? 1.0 : 0.0);
+    for (int e : edges) {
+        if (e >= 0 && static_cast<size_t>(e) < n) {
+            weight[e] = 1.0;
+        }
+    }
+    std::vector<double> nx(n), ny(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = i + 1 < n ? i + 1 : 0;
+        double ex = profile.x(j) - profile.x(i);
+        double ey = profile.y(j) - profile.y(i);
+        double length = std::sqrt(ex * ex + ey * ey);
+        nx[i] = length > 0.0 ? -ey / length : 0.0;
+        ny[i] = length > 0.0 ? ex / length : 0.0;
+    }
+    dx.resize(n);
+    dy.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t prev = i > 0 ? i - 1 : n - 1;
+        double a = weight[prev];
+        double b = weight[i];
+        double det = nx[prev] * ny[i] - ny[prev] * nx[i];
+        if (std::fabs(det) < 1e-12) {
+            double w = std::max(a, b);
+            dx[i] = w * nx[i];
+            dy[i] = w * ny[i];
+        } else {
+            dx[i] = (a * ny[i] - b * ny[prev]) / det;
+            dy[i] = (b * nx[prev] - a * nx[i]) / det;
+        }
+    }
+}
+
+/**
+ * @brief 端面棱边倒角的截面站点
+ *
+ * 从端面（高度0，内缩size）到侧面（高度size，内缩0）依次给出各环相对端面的高度与内缩量；
+ * 圆角沿以(size, size)为圆心的四分之一圆弧等角度分段
+ */
+void blendStations(const EdgeBlend& blend, std::vector<double>& heights, std::vector<double>& insets) {
+    heights.clear();
+    insets.clear();
+    if (blend.type == EdgeBlendType::Sharp || blend.size <= 0.0) {
+        heights.push_back(0.0);
+        insets.push_back(0.0);
+        return;
+    }
+    int segments = blend.type == EdgeBlendType::Fillet ? std::max(blend.segments, 1) : 1;
+    for (int k = 0; k <= segments; ++k) {
+        double theta = 0.5 * M_PI * k / segments;
+        if (blend.type == EdgeBlendType::Fillet) {
+            heights.push_back(blend.size * (1.0 - std::cos(theta)));
+            insets.push_back(blend.size * (1.0 - std::sin(theta)));
+        } else {
+            heights.push_back(k == 0 ? 0.0 : blend.size);
+            insets.push_back(k == 0 ? blend.size : 0.0);
+        }
+    }
+}
+
+} // namespace
 
 /**
  * @brief 计算两点之间的距离
@@ -43,66 +121,218 @@ Point3D GeometryAlgorithm::projectPointToFace(const Point3D& point, const Face&
     return *vertex;
 }
 
+/**
+ * @brief 批量计算点到模型表面的投影（最近点）
+ * 
+ * @param bvh 模型的三角形BVH
+ * @param xs 点x坐标
+ * @param ys 点y坐标
+ * @param zs 点z坐标
+ * @param count 点数量
+ * @param out_x 输出投影点x坐标
+ * @param out_y 输出投影点y坐标
+ * @param out_z 输出投影点z坐标
+ * @param distances 可选的输出距离
+ */
+void GeometryAlgorithm::projectPointsToSurface(const TriangleBVH& bvh, const double* xs, const double* ys,
+                                               const double* zs, size_t count, double* out_x, double* out_y,
+                                               double* out_z, double* distances) {
+    ParallelUtils::parallelFor(count, 1024, [&](size_t begin, size_t end) {
+        ClosestPointResult result;
+        for (size_t i = begin; i < end; ++i) {
+            double x = xs[i], y = ys[i], z = zs[i];
+            if (bvh.closestPoint(x, y, z, std::numeric_limits<double>::max(), result)) {
+                x = result.point[0];
+                y = result.point[1];
+                z = result.point[2];
+            }
+            out_x[i] = x;
+            out_y[i] = y;
+            out_z[i] = z;
+            if (distances) {
+                distances[i] = result.triangle >= 0 ? result.distance : 0.0;
+            }
+        }
+    });
+}
+
 /**
  * @brief 计算面的法向量
  * 
+ * 按面中前两条边围成的角计算，首条边的走向取与第二条边相接的方向（与MeshTopology的面环一致），
+ * 因此法向反映面按边顺序给出的绕向
+ * 
  * @param face 面
  * @param manager 模型管理器
- * @return double* 法向量数组 [x, y, z]
+ * @return std::array<double, 3> 单位法向量，退化时为(0, 0, 1)
  */
-double* GeometryAlgorithm::calculateFaceNormal(const Face& face, const ModelManager& manager) {
-    static double normal[3];
-    
-    // 简化实现：假设面是三角形，使用前三个顶点计算法向量
+std::array<double, 3> GeometryAlgorithm::calculateFaceNormal(const Face& face, const ModelManager& manager) {
+    std::array<double, 3> normal = {{0.0, 0.0, 1.0}};
     if (face.edge_ids.size() < 3) {
-        normal[0] = 0.0;
-        normal[1] = 0.0;
-        normal[2] = 1.0;
         return normal;
     }
     
     // 获取边的顶点
     auto edge1 = manager.getEdge(face.edge_ids[0]);
     auto edge2 = manager.getEdge(face.edge_ids[1]);
-    
     if (!edge1 || !edge2) {
-        normal[0] = 0.0;
-        normal[1] = 0.0;
-        normal[2] = 1.0;
         return normal;
     }
     
-    auto v1 = manager.getVertex(edge1->start_id);
-    auto v2 = manager.getVertex(edge1->end_id);
-    auto v3 = manager.getVertex(edge2->end_id);
-    
+    // 公共顶点为角点v2，首条边的另一端为v1，第二条边的另一端为v3
+    int shared = (edge1->end_id == edge2->start_id || edge1->end_id == edge2->end_id) ? edge1->end_id
+                                                                                        : edge1->start_id;
+    int first = shared == edge1->end_id ? edge1->start_id : edge1->end_id;
+    int third = shared == edge2->start_id ? edge2->end_id : edge2->start_id;
+    auto v1 = manager.getVertex(first);
+    auto v2 = manager.getVertex(shared);
+    auto v3 = manager.getVertex(third);
     if (!v1 || !v2 || !v3) {
-        normal[0] = 0.0;
-        normal[1] = 0.0;
-        normal[2] = 1.0;
         return normal;
     }
     
     // 计算向量
     double v1v2[3] = {v2->x - v1->x, v2->y - v1->y, v2->z - v1->z};
-    double v1v3[3] = {v3->x - v1->x, v3->y - v1->y, v3->z - v1->z};
+    double v2v3[3] = {v3->x - v2->x, v3->y - v2->y, v3->z - v2->z};
     
     // 叉乘计算法向量
-    normal[0] = v1v2[1] * v1v3[2] - v1v2[2] * v1v3[1];
-    normal[1] = v1v2[2] * v1v3[0] - v1v2[0] * v1v3[2];
-    normal[2] = v1v2[0] * v1v3[1] - v1v2[1] * v1v3[0];
+    double n[3] = {v1v2[1] * v2v3[2] - v1v2[2] * v2v3[1],
+                   v1v2[2] * v2v3[0] - v1v2[0] * v2v3[2],
+                   v1v2[0] * v2v3[1] - v1v2[1] * v2v3[0]};
     
     // 归一化
-    double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
-    if (length > 1e-6) {
-        normal[0] /= length;
-        normal[1] /= length;
-        normal[2] /= length;
+    double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length > 1e-12) {
+        normal[0] = n[0] / length;
+        normal[1] = n[1] / length;
+        normal[2] = n[2] / length;
     }
     
     return normal;
 }
 
+/**
+ * @brief 计算顶点法向（按折角拆分）
+ * 
+ * @param manager 模型管理器
+ * @param topology 网格拓扑邻接结构
+ * @param weighting 权重方式
+ * @param crease_angle 折角阈值（弧度）
+ * @return VertexNormals 顶点法向数据
+ */
+VertexNormals GeometryAlgorithm::calculateVertexNormals(const ModelManager& manager, const MeshTopology& topology,
+                                                        NormalWeighting weighting, double crease_angle) {
+    const auto& vertices = manager.getVertices();
+    size_t face_count = topology.faceCount();
+    size_t vertex_count = topology.vertexCount();
+    size_t corner_count = topology.face_vertices.size();
+    
+    VertexNormals result;
+    result.weighting = weighting;
+    result.crease_angle = crease_angle;
+    result.face_normals.assign(face_count * 3, 0.0);
+    result.face_areas.assign(face_count, 0.0);
+    result.vertex_normals.assign(vertex_count * 3, 0.0);
+    result.corner_normals.assign(corner_count * 3, 0.0);
+    std::vector<double> corner_angles(corner_count, 0.0);
+    
+    // 面法向（Newell方法，适用于任意多边形）、面积与角点内角
+    ParallelUtils::parallelFor(face_count, 256, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            int first = topology.face_offsets[f];
+            int last = topology.face_offsets[f + 1];
+            int n = last - first;
+            double nx = 0.0, ny = 0.0, nz = 0.0;
+            for (int c = first; c < last; ++c) {
+                const Point3D& a = *vertices[topology.face_vertices[c]];
+                const Point3D& b = *vertices[topology.face_vertices[c + 1 < last ? c + 1 : first]];
+                nx += (a.y - b.y) * (a.z + b.z);
+                ny += (a.z - b.z) * (a.x + b.x);
+                nz += (a.x - b.x) * (a.y + b.y);
+            }
+            double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            result.face_areas[f] = 0.5 * length;
+            if (length > 1e-12) {
+                result.face_normals[3 * f] = nx / length;
+                result.face_normals[3 * f + 1] = ny / length;
+                result.face_normals[3 * f + 2] = nz / length;
+            }
+            
+            for (int c = first; c < last && n >= 3; ++c) {
+                const Point3D& p = *vertices[topology.face_vertices[c]];
+                const Point3D& prev = *vertices[topology.face_vertices[c > first ? c - 1 : last - 1]];
+                const Point3D& next = *vertices[topology.face_vertices[c + 1 < last ? c + 1 : first]];
+                double u[3] = {prev.x - p.x, prev.y - p.y, prev.z - p.z};
+                double v[3] = {next.x - p.x, next.y - p.y, next.z - p.z};
+                double lu = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+                double lv = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                if (lu > 1e-12 && lv > 1e-12) {
+                    double cos_angle = (u[0] * v[0] + u[1] * v[1] + u[2] * v[2]) / (lu * lv);
+                    cos_angle = std::max(-1.0, std::min(1.0, cos_angle));
+                    corner_angles[c] = std::acos(cos_angle);
+                }
+            }
+        }
+    });
+    
+    // 沿顶点→面邻接收集：每个顶点只写自己的平滑法向和自己的角点法向
+    double cos_crease = std::cos(std::max(0.0, std::min(crease_angle, M_PI))) - 1e-12;
+    ParallelUtils::parallelFor(vertex_count, 256, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            int first = topology.vertex_face_offsets[v];
+            int last = topology.vertex_face_offsets[v + 1];
+            
+            double sum[3] = {0.0, 0.0, 0.0};
+            for (int k = first; k < last; ++k) {
+                int g = topology.vertex_faces[k];
+                double w = weighting == NormalWeighting::Angle ? corner_angles[topology.vertex_face_corners[k]]
+                                                               : result.face_areas[g];
+                sum[0] += w * result.face_normals[3 * g];
+                sum[1] += w * result.face_normals[3 * g + 1];
+                sum[2] += w * result.face_normals[3 * g + 2];
+            }
+            double length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+            if (length > 1e-12) {
+                result.vertex_normals[3 * v] = sum[0] / length;
+                result.vertex_normals[3 * v + 1] = sum[1] / length;
+                result.vertex_normals[3 * v + 2] = sum[2] / length;
+            }
+            
+            for (int k = first; k < last; ++k) {
+                int f = topology.vertex_faces[k];
+                int corner = topology.vertex_face_corners[k];
+                const double* nf = &result.face_normals[3 * f];
+                double corner_sum[3] = {0.0, 0.0, 0.0};
+                for (int j = first; j < last; ++j) {
+                    int g = topology.vertex_faces[j];
+                    const double* ng = &result.face_normals[3 * g];
+                    if (g != f && nf[0] * ng[0] + nf[1] * ng[1] + nf[2] * ng[2] < cos_crease) continue;
+                    double w = weighting == NormalWeighting::Angle ? corner_angles[topology.vertex_face_corners[j]]
+                                                                   : result.face_areas[g];
+                    corner_sum[0] += w * ng[0];
+                    corner_sum[1] += w * ng[1];
+                    corner_sum[2] += w * ng[2];
+                }
+                double corner_length = std::sqrt(corner_sum[0] * corner_sum[0] +
+                                                 corner_sum[1] * corner_sum[1] +
+                                                 corner_sum[2] * corner_sum[2]);
+                double* out = &result.corner_normals[3 * corner];
+                if (corner_length > 1e-12) {
+                    out[0] = corner_sum[0] / corner_length;
+                    out[1] = corner_sum[1] / corner_length;
+                    out[2] = corner_sum[2] / corner_length;
+                } else {
+                    out[0] = nf[0];
+                    out[1] = nf[1];
+                    out[2] = nf[2];
+                }
+            }
+        }
+    });
+    
+    return result;
+}
+
 /**
  * @brief 平移变换
  * 
@@ -202,9 +432,9 @@ bool GeometryAlgorithm::extrude(ModelManager& manager, const std::vector<Point3D
     }
     manager.addFace(face_id++, base_edges);
     
-    // 拉伸后的轮廓面
+    // 拉伸后的轮廓面：边逆序排列，使绕向与底面、侧面在公共边上一致
     std::vector<int> top_edges;
-    for (size_t i = vertex_count + 1; i <= vertex_count * 2; ++i) {
+    for (size_t i = vertex_count * 2; i > vertex_count; --i) {
         top_edges.push_back(static_cast<int>(i));
     }
     manager.addFace(face_id++, top_edges);
@@ -213,7 +443,7 @@ bool GeometryAlgorithm::extrude(ModelManager& manager, const std::vector<Point3D
     for (size_t i = 0; i < vertex_count; ++i) {
         std::vector<int> side_edges;
         side_edges.push_back(vertex_count * 2 + 1 + i);
-        side_edges.push_back(vertex_count + 1 + (i + 1) % vertex_count);
+        side_edges.push_back(vertex_count + 1 + i);
         side_edges.push_back(vertex_count * 2 + 1 + (i + 1) % vertex_count);
         side_edges.push_back(i + 1);
         manager.addFace(face_id++, side_edges);
@@ -225,6 +455,10 @@ bool GeometryAlgorithm::extrude(ModelManager& manager, const std::vector<Point3D
 /**
  * @brief 旋转特征建模
  * 
+ * 各截面环由轮廓顶点绕（axis_point, axis_direction）旋转得到：
+ * 相对轴点的向量分解为沿轴分量与垂直分量，仅垂直分量按Rodrigues公式旋转。
+ * 旋转一整圈时最后一步回到首个截面环，不生成端面
+ * 
  * @param manager 模型管理器
  * @param profile_vertices 轮廓顶点
  * @param axis_point 旋转轴点
@@ -233,35 +467,66 @@ bool GeometryAlgorithm::extrude(ModelManager& manager, const std::vector<Point3D
  * @return bool 是否成功
  */
 bool GeometryAlgorithm::revolve(ModelManager& manager, const std::vector<Point3D>& profile_vertices, 
-                               const Point3D& /*axis_point*/, const double* /*axis_direction*/, double angle) {
-    if (profile_vertices.empty()) {
+                               const Point3D& axis_point, const double* axis_direction, double angle) {
+    if (profile_vertices.empty() || !axis_direction) {
+        return false;
+    }
+    double axis[3] = {axis_direction[0], axis_direction[1], axis_direction[2]};
+    double axis_length = std::sqrt(detail::dot3(axis, axis));
+    if (!(axis_length > 0.0)) {
         return false;
     }
+    for (int k = 0; k < 3; ++k) {
+        axis[k] /= axis_length;
+    }
+    const double full_turn = 2.0 * M_PI;
+    if (std::fabs(angle) > full_turn * (1.0 + 1e-12)) {
+        return false;
+    }
+    const bool closed = std::fabs(angle) >= full_turn * (1.0 - 1e-12);
     
-    // 简化实现：绕Z轴旋转90度
     const int steps = 4; // 旋转步数
     const double step_angle = angle / steps;
+    const int rings = closed ? steps : steps + 1; // 截面环数，整圈时首尾共用一个环
     
     size_t vertex_count = profile_vertices.size();
-    manager.reserveVertices(vertex_count * (steps + 1));
-    manager.reserveEdges(vertex_count * (steps * 2 + 1));
+    manager.reserveVertices(vertex_count * rings);
+    manager.reserveEdges(vertex_count * (steps + rings));
     manager.reserveFaces(vertex_count * steps + 2);
     
+    // 轮廓顶点相对轴点分解：沿轴分量保持不变，垂直分量及其绕轴转过90度的向量按角度组合
+    std::vector<double> along(vertex_count * 3), radial(vertex_count * 3), tangent(vertex_count * 3);
+    for (size_t i = 0; i < vertex_count; ++i) {
+        const auto& v = profile_vertices[i];
+        double r[3] = {v.x - axis_point.x, v.y - axis_point.y, v.z - axis_point.z};
+        double h = detail::dot3(axis, r);
+        for (int k = 0; k < 3; ++k) {
+            along[3 * i + k] = h * axis[k];
+            radial[3 * i + k] = r[k] - along[3 * i + k];
+        }
+        detail::cross3(axis, &radial[3 * i], &tangent[3 * i]);
+    }
+    
     // 添加旋转顶点
     int base_id = 1;
-    for (int step = 0; step <= steps; ++step) {
-        double current_angle = step_angle * step;
+    for (int step = 0; step < rings; ++step) {
+        double cos_theta = std::cos(step_angle * step);
+        double sin_theta = std::sin(step_angle * step);
         for (size_t i = 0; i < vertex_count; ++i) {
-            const auto& v = profile_vertices[i];
-            Point3D rotated = rotateZ(v, current_angle);
-            manager.addVertex(base_id + step * vertex_count + i, rotated.x, rotated.y, rotated.z);
+            const double* a = &along[3 * i];
+            const double* r = &radial[3 * i];
+            const double* t = &tangent[3 * i];
+            manager.addVertex(base_id + step * vertex_count + i,
+                              axis_point.x + a[0] + r[0] * cos_theta + t[0] * sin_theta,
+                              axis_point.y + a[1] + r[1] * cos_theta + t[1] * sin_theta,
+                              axis_point.z + a[2] + r[2] * cos_theta + t[2] * sin_theta);
         }
     }
     
     // 添加边
     int edge_id = 1;
-    // 每个步骤的轮廓边
-    for (int step = 0; step <= steps; ++step) {
+    // 每个截面环的轮廓边
+    for (int step = 0; step < rings; ++step) {
         for (size_t i = 0; i < vertex_count; ++i) {
             int next = (i + 1) % vertex_count;
             manager.addEdge(edge_id++, base_id + step * vertex_count + i, base_id + step * vertex_count + next);
@@ -270,32 +535,393 @@ bool GeometryAlgorithm::revolve(ModelManager& manager, const std::vector<Point3D
     // 旋转方向边
     for (size_t i = 0; i < vertex_count; ++i) {
         for (int step = 0; step < steps; ++step) {
-            manager.addEdge(edge_id++, base_id + step * vertex_count + i, base_id + (step + 1) * vertex_count + i);
+            int next_ring = (step + 1) % rings;
+            manager.addEdge(edge_id++, base_id + step * vertex_count + i, base_id + next_ring * vertex_count + i);
         }
     }
     
     // 添加面
     int face_id = 1;
-    // 端面
-    std::vector<int> end_edges;
-    for (size_t i = 0; i < vertex_count; ++i) {
-        end_edges.push_back(i + 1);
+    if (!closed) {
+        // 起始端面：边逆序排列，侧面按轮廓方向经过首环的边，端面需反向经过才与侧面绕向一致
+        std::vector<int> end_edges;
+        for (size_t i = 0; i < vertex_count; ++i) {
+            end_edges.push_back(vertex_count - i);
+        }
+        manager.addFace(face_id++, end_edges);
+        
+        // 终止端面：侧面反向经过末环的边，端面按轮廓方向排列
+        std::vector<int> last_edges;
+        for (size_t i = 0; i < vertex_count; ++i) {
+            last_edges.push_back(steps * vertex_count + i + 1);
+        }
+        manager.addFace(face_id++, last_edges);
     }
-    manager.addFace(face_id++, end_edges);
     
-    // 侧面
+    // 侧面：相邻两步的轮廓边与两条旋转方向边围成四边形
+    int ring_base = rings * vertex_count + 1;
     for (int step = 0; step < steps; ++step) {
         for (size_t i = 0; i < vertex_count; ++i) {
             std::vector<int> side_edges;
             int base = step * vertex_count + 1;
-            int next_base = (step + 1) * vertex_count + 1;
+            int next_base = ((step + 1) % rings) * vertex_count + 1;
             side_edges.push_back(base + i);
-            side_edges.push_back(base + (i + 1) % vertex_count);
-            side_edges.push_back(next_base + (i + 1) % vertex_count);
+            side_edges.push_back(ring_base + ((i + 1) % vertex_count) * steps + step);
             side_edges.push_back(next_base + i);
+            side_edges.push_back(ring_base + i * steps + step);
             manager.addFace(face_id++, side_edges);
         }
     }
     
     return true;
 }
+
+/**
+ * @brief 以二维轮廓拉伸
+ * 
+ * @param manager 模型管理器
+ * @param profile 轮廓
+ * @param distance 拉伸距离
+ * @param tolerance 清理容差
+ * @return bool 是否成功
+ */
+bool GeometryAlgorithm::extrude(ModelManager& manager, const Profile2D& profile, double distance, double tolerance) {
+    Profile2D cleaned = profile;
+    cleaned.clean(tolerance);
+    return extrude(manager, cleaned.toPoints(ProfilePlane::XY), distance);
+}
+
+/**
+ * @brief 以二维截面旋转
+ * 
+ * 截面坐标(x, y)映射为 axis_point + x·u + y·a，a为单位轴方向，
+ * u为世界x轴（轴接近x轴时取y轴）在轴法平面内的单位投影；绕Z轴时即为xz平面
+ * 
+ * @param manager 模型管理器
+ * @param profile 截面
+ * @param axis_point 旋转轴点
+ * @param axis_direction 旋转轴方向
+ * @param angle 旋转角度（弧度）
+ * @param tolerance 清理容差
+ * @return bool 是否成功
+ */
+bool GeometryAlgorithm::revolve(ModelManager& manager, const Profile2D& profile, const Point3D& axis_point,
+                                const double* axis_direction, double angle, double tolerance) {
+    if (!axis_direction) {
+        throw std::invalid_argument("旋转轴方向为空");
+    }
+    double axis[3] = {axis_direction[0], axis_direction[1], axis_direction[2]};
+    double axis_length = std::sqrt(detail::dot3(axis, axis));
+    if (!(axis_length > 0.0)) {
+        throw std::invalid_argument("旋转轴方向长度为零");
+    }
+    for (int k = 0; k < 3; ++k) {
+        axis[k] /= axis_length;
+    }
+    
+    Profile2D cleaned = profile;
+    cleaned.clean(tolerance);
+    // 截面x为到旋转轴的距离，负值即位于轴的另一侧
+    for (size_t i = 0; i < cleaned.size(); ++i) {
+        if (cleaned.x(i) < -tolerance) {
+            throw std::invalid_argument("旋转截面跨越旋转轴");
+        }
+    }
+    
+    double reference[3] = {1.0, 0.0, 0.0};
+    if (std::fabs(axis[0]) > 0.9) {
+        reference[0] = 0.0;
+        reference[1] = 1.0;
+    }
+    double projection = detail::dot3(reference, axis);
+    double radial[3];
+    for (int k = 0; k < 3; ++k) {
+        radial[k] = reference[k] - projection * axis[k];
+    }
+    double radial_length = std::sqrt(detail::dot3(radial, radial));
+    for (int k = 0; k < 3; ++k) {
+        radial[k] /= radial_length;
+    }
+    
+    std::vector<Point3D> section;
+    section.reserve(cleaned.size());
+    for (size_t i = 0; i < cleaned.size(); ++i) {
+        double x = cleaned.x(i);
+        double y = cleaned.y(i);
+        section.push_back(Point3D(static_cast<int>(i + 1), axis_point.x + x * radial[0] + y * axis[0],
+                                  axis_point.y + x * radial[1] + y * axis[1],
+                                  axis_point.z + x * radial[2] + y * axis[2]));
+    }
+    return revolve(manager, section, axis_point, axis, angle);
+}
+
+/**
+ * @brief 带端面倒角/圆角的拉伸
+ * 
+ * 环k的顶点为 p + s_k·d_bottom + t_k·d_top（d为单位内缩位移，s、t为两端的内缩量），
+ * 按环批量计算坐标后统一写入模型；两端站点在侧面中部重合时合并为一个环
+ * 
+ * @param manager 模型管理器
+ * @param profile 轮廓
+ * @param distance 拉伸距离
+ * @param bottom 起始端面棱边倒角
+ * @param top 终止端面棱边倒角
+ * @param tolerance 清理容差
+ * @return bool 是否成功
+ */
+bool GeometryAlgorithm::extrude(ModelManager& manager, const Profile2D& profile, double distance,
+                                const EdgeBlend& bottom, const EdgeBlend& top, double tolerance) {
+    Profile2D cleaned = profile;
+    cleaned.clean(tolerance);
+    const size_t n = cleaned.size();
+    const double height = std::fabs(distance);
+    const double direction = distance < 0.0 ? -1.0 : 1.0;
+    
+    std::vector<double> bottom_heights, bottom_insets, top_heights, top_insets;
+    blendStations(bottom, bottom_heights, bottom_insets);
+    blendStations(top, top_heights, top_insets);
+    if (bottom_heights.back() + top_heights.back() > height * (1.0 + 1e-12)) {
+        throw std::invalid_argument("两端倒角尺寸之和超过拉伸高度");
+    }
+    
+    std::vector<double> bottom_x, bottom_y, top_x, top_y;
+    insetDirections(cleaned, bottom.edges, bottom_x, bottom_y);
+    insetDirections(cleaned, top.edges, top_x, top_y);
+    const std::vector<double>* inset_x[2] = {&bottom_x, &top_x};
+    const std::vector<double>* inset_y[2] = {&bottom_y, &top_y};
+    const double full_inset[2] = {bottom_insets.front(), top_insets.front()};
+    for (int end = 0; end < 2; ++end) {
+        if (full_inset[end] <= 0.0) {
+            continue;
+        }
+        Profile2D rim;
+        rim.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rim.append(cleaned.x(i) + full_inset[end] * (*inset_x[end])[i],
+                       cleaned.y(i) + full_inset[end] * (*inset_y[end])[i]);
+        }
+        // 内缩过度时边会反向（整体翻转的凸轮廓面积仍为正，需逐边检查）
+        bool reversed = false;
+        for (size_t i = 0; i < n && !reversed; ++i) {
+            size_t j = i + 1 < n ? i + 1 : 0;
+            double dot = (rim.x(j) - rim.x(i)) * (cleaned.x(j) - cleaned.x(i)) +
+                         (rim.y(j) - rim.y(i)) * (cleaned.y(j) - cleaned.y(i));
+            reversed = dot <= 0.0;
+        }
+        if (reversed || rim.signedArea() <= 0.0 || rim.selfIntersects(tolerance)) {
+            throw std::invalid_argument("倒角尺寸超过轮廓局部尺寸");
+        }
+    }
+    
+    // 环站点：起始端自端面向上，终止端自侧面向端面
+    std::vector<double> ring_z, ring_bottom, ring_top;
+    for (size_t k = 0; k < bottom_heights.size(); ++k) {
+        ring_z.push_back(bottom_heights[k]);
+        ring_bottom.push_back(bottom_insets[k]);
+        ring_top.push_back(0.0);
+    }
+    for (size_t k = top_heights.size(); k-- > 0;) {
+        double z = height - top_heights[k];
+        if (top_insets[k] == 0.0 && ring_bottom.back() == 0.0 && std::fabs(z - ring_z.back()) <= 1e-12 * height) {
+            continue;
+        }
+        ring_z.push_back(z);
+        ring_bottom.push_back(0.0);
+        ring_top.push_back(top_insets[k]);
+    }
+    
+    const size_t ring_count = ring_z.size();
+    std::vector<double> xs(ring_count * n), ys(ring_count * n);
+    for (size_t k = 0; k < ring_count; ++k) {
+        double s = ring_bottom[k];
+        double t = ring_top[k];
+        double* x = &xs[k * n];
+        double* y = &ys[k * n];
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = cleaned.x(i) + s * bottom_x[i] + t * top_x[i];
+            y[i] = cleaned.y(i) + s * bottom_y[i] + t * top_y[i];
+        }
+    }
+    
+    // 编号接续模型中已有的顶点、边与面，可在同一模型中追加多个特征
+    const int vertex_base = manager.nextVertexId();
+    const int edge_base = manager.nextEdgeId();
+    int face_id = manager.nextFaceId();
+    manager.reserveVertices(manager.getVertices().size() + ring_count * n);
+    manager.reserveEdges(manager.getEdges().size() + (2 * ring_count - 1) * n);
+    manager.reserveFaces(manager.getFaces().size() + (ring_count - 1) * n + 2);
+    for (size_t k = 0; k < ring_count; ++k) {
+        for (size_t i = 0; i < n; ++i) {
+            manager.addVertex(vertex_base + static_cast<int>(k * n + i), xs[k * n + i], ys[k * n + i],
+                              direction * ring_z[k]);
+        }
+    }
+    
+    // 环边：环k的边i编号为 edge_base + k·n + i；纵向边（环k到k+1）编号为 edge_base + R·n + k·n + i
+    for (size_t k = 0; k < ring_count; ++k) {
+        for (size_t i = 0; i < n; ++i) {
+            size_t next = (i + 1) % n;
+            manager.addEdge(edge_base + static_cast<int>(k * n + i), vertex_base + static_cast<int>(k * n + i),
+                            vertex_base + static_cast<int>(k * n + next));
+        }
+    }
+    const int vertical_base = edge_base + static_cast<int>(ring_count * n);
+    for (size_t k = 0; k + 1 < ring_count; ++k) {
+        for (size_t i = 0; i < n; ++i) {
+            manager.addEdge(vertical_base + static_cast<int>(k * n + i), vertex_base + static_cast<int>(k * n + i),
+                            vertex_base + static_cast<int>((k + 1) * n + i));
+        }
+    }
+    
+    // 端面与环间侧面
+    std::vector<int> cap_edges(n);
+    for (size_t i = 0; i < n; ++i) {
+        cap_edges[i] = edge_base + static_cast<int>(i);
+    }
+    manager.addFace(face_id++, cap_edges);
+    // 终止端面的边逆序排列，绕向与侧面在公共边上一致
+    for (size_t i = 0; i < n; ++i) {
+        cap_edges[i] = edge_base + static_cast<int>((ring_count - 1) * n + (n - 1 - i));
+    }
+    manager.addFace(face_id++, cap_edges);
+    std::vector<int> side_edges(4);
+    for (size_t k = 0; k + 1 < ring_count; ++k) {
+        for (size_t i = 0; i < n; ++i) {
+            size_t next = (i + 1) % n;
+            side_edges[0] = vertical_base + static_cast<int>(k * n + i);
+            side_edges[1] = edge_base + static_cast<int>((k + 1) * n + i);
+            side_edges[2] = vertical_base + static_cast<int>(k * n + next);
+            side_edges[3] = edge_base + static_cast<int>(k * n + i);
+            manager.addFace(face_id++, side_edges);
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 曲面加厚（偏置抽壳）
+ * 
+ * @param manager 输出模型管理器
+ * @param surface 输入曲面模型
+ * @param thickness 厚度
+ * @return bool 是否成功
+ */
+bool GeometryAlgorithm::thicken(ModelManager& manager, const ModelManager& surface, double thickness) {
+    auto topology_ptr = surface.getMeshTopology();
+    const MeshTopology& topology = *topology_ptr;
+    if (topology.faceCount() == 0 || thickness == 0.0) {
+        return false;
+    }
+    
+    auto normals = surface.getVertexNormals(NormalWeighting::Angle, M_PI);
+    const auto& vertices = surface.getVertices();
+    size_t vertex_count = topology.vertexCount();
+    double sign = thickness > 0.0 ? 1.0 : -1.0;
+    double distance = std::fabs(thickness);
+    RayCaster caster(surface);
+    
+    // 顶点并行：计算受限偏置距离与偏置后坐标
+    std::vector<double> offset(vertex_count * 3);
+    ParallelUtils::parallelFor(vertex_count, 256, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            const Point3D& p = *vertices[v];
+            double dir[3] = {sign * normals->vertex_normals[3 * v],
+                             sign * normals->vertex_normals[3 * v + 1],
+                             sign * normals->vertex_normals[3 * v + 2]};
+            double limit = distance;
+            
+            // 凹侧曲率限制：相邻顶点位于偏置方向前方时，法向夹角给出局部曲率半径
+            for (int k = topology.vertex_face_offsets[v]; k < topology.vertex_face_offsets[v + 1]; ++k) {
+                int f = topology.vertex_faces[k];
+                int c = topology.vertex_face_corners[k];
+                int first = topology.face_offsets[f];
+                int last = topology.face_offsets[f + 1];
+                int neighbors[2] = {topology.face_vertices[c + 1 < last ? c + 1 : first],
+                                    topology.face_vertices[c > first ? c - 1 : last - 1]};
+                for (int u : neighbors) {
+                    const Point3D& q = *vertices[u];
+                    double e[3] = {q.x - p.x, q.y - p.y, q.z - p.z};
+                    if (e[0] * dir[0] + e[1] * dir[1] + e[2] * dir[2] <= 0.0) continue;
+                    const double* nu = &normals->vertex_normals[3 * u];
+                    double cos_angle = sign * (nu[0] * dir[0] + nu[1] * dir[1] + nu[2] * dir[2]);
+                    double angle = std::acos(std::max(-1.0, std::min(1.0, cos_angle)));
+                    if (angle < 1e-9) continue;
+                    double length = std::sqrt(e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+                    limit = std::min(limit, length / angle);
+                }
+            }
+            
+            // 壁厚限制：沿偏置方向碰到曲面自身时不超过该距离的一半
+            double eps = 1e-9 * (1.0 + distance);
+            Ray ray(p.x, p.y, p.z, dir[0], dir[1], dir[2], eps, 2.0 * limit);
+            RayHit hit = caster.intersect(ray, RayQueryMode::Nearest);
+            if (hit.hit()) {
+                limit = std::min(limit, 0.5 * hit.t);
+            }
+            
+            offset[3 * v] = p.x + dir[0] * limit;
+            offset[3 * v + 1] = p.y + dir[1] * limit;
+            offset[3 * v + 2] = p.z + dir[2] * limit;
+        }
+    });
+    
+    // 内外两层顶点
+    int base_id = manager.nextVertexId();
+    int outer_id = base_id + static_cast<int>(vertex_count);
+    manager.reserveVertices(vertex_count * 2);
+    for (size_t v = 0; v < vertex_count; ++v) {
+        manager.addVertex(base_id + static_cast<int>(v), vertices[v]->x, vertices[v]->y, vertices[v]->z);
+    }
+    for (size_t v = 0; v < vertex_count; ++v) {
+        manager.addVertex(outer_id + static_cast<int>(v), offset[3 * v], offset[3 * v + 1], offset[3 * v + 2]);
+    }
+    
+    // 两层面：偏置方向一侧保持原方向，另一侧反向
+    int face_id = manager.nextFaceId();
+    std::vector<int> loop;
+    for (size_t f = 0; f < topology.faceCount(); ++f) {
+        int first = topology.face_offsets[f];
+        int last = topology.face_offsets[f + 1];
+        if (last - first < 3) continue;
+        for (int layer = 0; layer < 2; ++layer) {
+            bool reverse = (layer == 0) == (sign > 0.0);
+            int id_base = layer == 0 ? base_id : outer_id;
+            loop.clear();
+            for (int c = first; c < last; ++c) {
+                loop.push_back(id_base + topology.face_vertices[c]);
+            }
+            if (reverse) {
+                std::reverse(loop.begin() + 1, loop.end());
+            }
+            manager.addFaceFromVertices(face_id++, loop);
+        }
+    }
+    
+    // 边界缝合：线性遍历只属于一个面的边
+    for (size_t f = 0; f < topology.faceCount(); ++f) {
+        int first = topology.face_offsets[f];
+        int last = topology.face_offsets[f + 1];
+        for (int c = first; c < last; ++c) {
+            int e = topology.corner_edges[c];
+            if (e < 0 || topology.edge_face_offsets[e + 1] - topology.edge_face_offsets[e] != 1) continue;
+            int a = topology.face_vertices[c];
+            int b = topology.face_vertices[c + 1 < last ? c + 1 : first];
+            loop.clear();
+            if (sign > 0.0) {
+                loop.push_back(base_id + a);
+                loop.push_back(base_id + b);
+                loop.push_back(outer_id + b);
+                loop.push_back(outer_id + a);
+            } else {
+                loop.push_back(base_id + b);
+                loop.push_back(base_id + a);
+                loop.push_back(outer_id + a);
+                loop.push_back(outer_id + b);
+            }
+            manager.addFaceFromVertices(face_id++, loop);
+        }
+    }
+    
+    return true;
+}
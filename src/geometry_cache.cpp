@@ -0,0 +1,299 @@
+#include "geometry_cache.h"
+#include "detail/posix_platform.h"
+#include "geometry_algorithm.h"
+#include "model_io.h"
+#include "sha256.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief 以小端字节序追加64位整数
+ */
+void hashUint64(Sha256& hash, uint64_t value) {
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    hash.update(bytes, 8);
+}
+
+/**
+ * @brief 追加双精度数（负零规范化为正零）
+ */
+void hashDouble(Sha256& hash, double value) {
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hashUint64(hash, bits);
+}
+
+} // namespace
+
+/**
+ * @brief 构造函数
+ * 
+ * @param memory_capacity 内存层容量（字节）
+ * @param directory 磁盘层目录
+ */
+GeometryCache::GeometryCache(size_t memory_capacity, const std::string& directory)
+    : capacity(memory_capacity), directory(directory) {}
+
+/**
+ * @brief 计算特征缓存键
+ * 
+ * @param feature 特征类型名称
+ * @param profile 轮廓顶点
+ * @param parameters 特征参数
+ * @return std::string 十六进制摘要
+ */
+std::string GeometryCache::makeKey(const std::string& feature, const std::vector<Point3D>& profile,
+                                   const std::vector<double>& parameters) {
+    Sha256 hash;
+    // 版本前缀：特征生成算法或存储格式变化时更换，使旧缓存失效
+    static const char prefix[] = "cad-feature-cache-v3";
+    hash.update(prefix, sizeof(prefix));
+    hash.update(feature.c_str(), feature.size() + 1);
+    hashUint64(hash, profile.size());
+    for (const auto& p : profile) {
+        hashDouble(hash, p.x);
+        hashDouble(hash, p.y);
+        hashDouble(hash, p.z);
+    }
+    hashUint64(hash, parameters.size());
+    for (double value : parameters) {
+        hashDouble(hash, value);
+    }
+    return hash.finishHex();
+}
+
+/**
+ * @brief 带缓存的拉伸特征建模
+ */
+bool GeometryCache::extrude(ModelManager& manager, const std::vector<Point3D>& profile_vertices, double distance) {
+    std::vector<double> parameters(1, distance);
+    std::string key = makeKey("extrude", profile_vertices, parameters);
+    return cached(key, manager, [&](ModelManager& scratch) {
+        return GeometryAlgorithm::extrude(scratch, profile_vertices, distance);
+    });
+}
+
+/**
+ * @brief 带缓存的旋转特征建模
+ */
+bool GeometryCache::revolve(ModelManager& manager, const std::vector<Point3D>& profile_vertices,
+                            const Point3D& axis_point, const double* axis_direction, double angle) {
+    double values[] = {axis_point.x, axis_point.y, axis_point.z,
+                       axis_direction[0], axis_direction[1], axis_direction[2], angle};
+    std::vector<double> parameters(values, values + 7);
+    std::string key = makeKey("revolve", profile_vertices, parameters);
+    return cached(key, manager, [&](ModelManager& scratch) {
+        return GeometryAlgorithm::revolve(scratch, profile_vertices, axis_point, axis_direction, angle);
+    });
+}
+
+/**
+ * @brief 依次查找内存层、磁盘层，均未命中时生成并存入缓存
+ */
+template <typename Build>
+bool GeometryCache::cached(const std::string& key, ModelManager& manager, Build build) {
+    if (lookup(key, manager)) {
+        return true;
+    }
+    ModelManager scratch;
+    if (!build(scratch)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++counters.misses;
+    }
+    std::shared_ptr<std::string> blob(new std::string());
+    ModelIO::encodeBinary(scratch, *blob);
+    insertInMemory(key, blob);
+    writeToDisk(key, *blob);
+    return append(blob->data(), blob->size(), manager);
+}
+
+/**
+ * @brief 查找缓存并追加到模型
+ * 
+ * @param key 缓存键
+ * @param manager 目标模型
+ * @return bool 是否命中
+ */
+bool GeometryCache::lookup(const std::string& key, ModelManager& manager) {
+    Blob blob = findInMemory(key);
+    if (blob) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++counters.memory_hits;
+    } else if (!directory.empty() && readFromDisk(key, blob)) {
+        // 磁盘层条目已校验，提升到内存层后与内存层命中同样追加
+        insertInMemory(key, blob);
+        std::lock_guard<std::mutex> lock(mutex);
+        ++counters.disk_hits;
+    } else {
+        return false;
+    }
+    return append(blob->data(), blob->size(), manager);
+}
+
+/**
+ * @brief 存入缓存
+ * 
+ * @param key 缓存键
+ * @param model 特征几何
+ */
+void GeometryCache::store(const std::string& key, const ModelManager& model) {
+    std::shared_ptr<std::string> blob(new std::string());
+    ModelIO::encodeBinary(model, *blob);
+    insertInMemory(key, blob);
+    writeToDisk(key, *blob);
+}
+
+/**
+ * @brief 清空内存层
+ */
+void GeometryCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lru.clear();
+    counters.entries = 0;
+    counters.bytes = 0;
+}
+
+/**
+ * @brief 获取统计信息
+ */
+GeometryCacheStats GeometryCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+GeometryCache::Blob GeometryCache::findInMemory(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return Blob();
+    }
+    lru.splice(lru.begin(), lru, it->second.position);
+    return it->second.blob;
+}
+
+/**
+ * @brief 插入内存层，超出容量时淘汰最久未使用的条目
+ */
+void GeometryCache::insertInMemory(const std::string& key, const Blob& blob) {
+    if (blob->size() > capacity) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        lru.splice(lru.begin(), lru, it->second.position);
+        return;
+    }
+    while (counters.bytes + blob->size() > capacity && !lru.empty()) {
+        auto victim = entries.find(lru.back());
+        counters.bytes -= victim->second.blob->size();
+        entries.erase(victim);
+        lru.pop_back();
+    }
+    lru.push_front(key);
+    Entry entry;
+    entry.blob = blob;
+    entry.position = lru.begin();
+    entries[key] = entry;
+    counters.bytes += blob->size();
+    counters.entries = entries.size();
+}
+
+/**
+ * @brief 从磁盘层读取：映射缓存文件，先在空模型中完整解析校验，再复制一份供内存层使用
+ * 
+ * 校验不触碰目标模型，损坏或截断的缓存文件不会留下部分几何；
+ * 校验失败的文件直接删除，下次按未命中重新生成
+ */
+bool GeometryCache::readFromDisk(const std::string& key, Blob& blob) {
+    std::string path = directory + "/" + key + ".cadm";
+#if CAD_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        std::remove(path.c_str());
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    const char* data = static_cast<const char*>(mapping);
+    ModelManager scratch;
+    bool ok = ModelIO::parseBinary(data, size, scratch);
+    if (ok) {
+        blob.reset(new std::string(data, size));
+    }
+    ::munmap(mapping, size);
+#else
+    std::shared_ptr<std::string> content(new std::string());
+    if (!ModelIO::readFile(path, *content)) {
+        return false;
+    }
+    ModelManager scratch;
+    bool ok = ModelIO::parseBinary(content->data(), content->size(), scratch);
+    if (ok) {
+        blob = content;
+    }
+#endif
+    if (!ok) {
+        std::remove(path.c_str());
+    }
+    return ok;
+}
+
+/**
+ * @brief 写入磁盘层：先写临时文件再重命名，避免并发读者看到不完整的文件
+ */
+void GeometryCache::writeToDisk(const std::string& key, const std::string& blob) {
+    if (directory.empty()) {
+        return;
+    }
+    std::string path = directory + "/" + key + ".cadm";
+    std::ostringstream temp;
+    temp << path << ".tmp" << std::hash<std::thread::id>()(std::this_thread::get_id());
+    {
+        std::ofstream file(temp.str().c_str(), std::ios::binary);
+        if (!file) {
+            return;
+        }
+        file.write(blob.data(), blob.size());
+        if (!file) {
+            file.close();
+            std::remove(temp.str().c_str());
+            return;
+        }
+    }
+    if (std::rename(temp.str().c_str(), path.c_str()) != 0) {
+        std::remove(temp.str().c_str());
+    }
+}
+
+/**
+ * @brief 将缓存几何追加到模型，顶点ID从nextVertexId()起依次编号
+ */
+bool GeometryCache::append(const char* data, size_t size, ModelManager& manager) {
+    return ModelIO::parseBinary(data, size, manager);
+}
@@ -1,9 +1,78 @@
 #include "model_manager.h"
 #include "geometry_algorithm.h"
 #include "topology_checker.h"
+#include "mesh_analyzer.h"
+#include "ray_caster.h"
+#include "winding_number.h"
+#include "voxelizer.h"
+#include "signed_distance_field.h"
+#include "primitive_builder.h"
+#include "model_io.h"
+#include "batch_validator.h"
+#include "command_line.h"
+#include "model_server.h"
+#include "shared_model_region.h"
+#include "async_model_loader.h"
+#include "geometry_cache.h"
+#include "model_fingerprint.h"
+#include "rigid_registration.h"
+#include "deviation_analyzer.h"
+#include "point_cloud.h"
+#include "point_cloud_io.h"
+#include "surface_sampler.h"
+#include "collision_detector.h"
+#include "slicer.h"
+#include "drawing_projector.h"
+#include "profile2d.h"
+#include "mesh_topology.h"
+#include "triangle_bvh.h"
 #include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+// 演示中失败的检查数量，非零时demo返回失败
+static int demo_failures = 0;
+
+/**
+ * @brief 记录一项演示检查，不满足时输出失败信息
+ * 
+ * @param condition 检查条件
+ * @param description 检查内容
+ */
+void check(bool condition, const std::string& description) {
+    if (!condition) {
+        ++demo_failures;
+        std::cerr << "检查失败: " << description << std::endl;
+    }
+}
+
+/**
+ * @brief 比较两个模型的几何是否一致
+ * 
+ * 顶点坐标按存储顺序逐一比较，面按拓扑中的顶点索引环比较，不要求顶点ID相同
+ */
+bool sameGeometry(const ModelManager& a, const ModelManager& b) {
+    const auto& va = a.getVertices();
+    const auto& vb = b.getVertices();
+    if (va.size() != vb.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < va.size(); ++i) {
+        if (va[i]->x != vb[i]->x || va[i]->y != vb[i]->y || va[i]->z != vb[i]->z) {
+            return false;
+        }
+    }
+    auto ta = a.getMeshTopology();
+    auto tb = b.getMeshTopology();
+    return ta->face_offsets == tb->face_offsets && ta->face_vertices == tb->face_vertices;
+}
+
 /**
  * @brief 测试螺栓建模
  * 
@@ -33,32 +102,52 @@ void testBoltModeling() {
         std::cout << "螺栓头部拉伸失败!" << std::endl;
     }
     
-    // 螺栓杆部轮廓（圆形，简化为四边形）
-    std::vector<Point3D> shaft_profile;
-    double shaft_radius = 0.5;
-    shaft_profile.push_back(Point3D(101, -shaft_radius, -shaft_radius, 0.0));
-    shaft_profile.push_back(Point3D(102, shaft_radius, -shaft_radius, 0.0));
-    shaft_profile.push_back(Point3D(103, shaft_radius, shaft_radius, 0.0));
-    shaft_profile.push_back(Point3D(104, -shaft_radius, shaft_radius, 0.0));
-    
-    // 拉伸杆部
-    std::cout << "拉伸螺栓杆部..." << std::endl;
-    success = GeometryAlgorithm::extrude(manager, shaft_profile, 3.0);
+    // 螺栓杆部：按弦高误差0.005生成圆柱，位于头部下方
+    std::cout << "生成螺栓杆部..." << std::endl;
+    success = PrimitiveBuilder::cylinder(manager, Point3D(0, 0.0, 0.0, -3.0), 0.5, 3.0, 0.005);
     if (success) {
-        std::cout << "螺栓杆部拉伸成功!" << std::endl;
+        std::cout << "螺栓杆部生成成功!" << std::endl;
     } else {
-        std::cout << "螺栓杆部拉伸失败!" << std::endl;
+        std::cout << "螺栓杆部生成失败!" << std::endl;
     }
     
     // 检测拓扑错误
     std::cout << "检测螺栓模型拓扑错误..." << std::endl;
     TopologyChecker::detectAllTopologyErrors(manager);
+    check(!TopologyChecker::checkTopology(manager).hasErrors(), "螺栓模型（拉伸头部与圆柱杆部）无拓扑错误");
     
     // 输出模型信息
     std::cout << "螺栓模型信息:" << std::endl;
     std::cout << "顶点数量: " << manager.getVertices().size() << std::endl;
     std::cout << "边数量: " << manager.getEdges().size() << std::endl;
     std::cout << "面数量: " << manager.getFaces().size() << std::endl;
+    
+    // 顶点法向：30度折角拆分六角头棱边
+    auto normals = manager.getVertexNormals(NormalWeighting::Angle, M_PI / 6);
+    const double* n = &normals->corner_normals[0];
+    std::cout << "首个角点法向(折角30度): (" << n[0] << ", " << n[1] << ", " << n[2] << ")" << std::endl;
+    const double* vn = &normals->vertex_normals[0];
+    std::cout << "首个顶点平滑法向: (" << vn[0] << ", " << vn[1] << ", " << vn[2] << ")" << std::endl;
+    
+    // 射线拾取：自上方垂直向下拾取头部顶面，批量射线按包遍历
+    RayCaster caster(manager);
+    std::vector<Ray> rays;
+    for (int i = 0; i < 16; ++i) {
+        rays.push_back(Ray(-0.6 + 0.08 * i, 0.1, 5.0, 0.0, 0.0, -1.0));
+    }
+    std::vector<RayHit> hits;
+    caster.intersect(rays, hits);
+    int hit_count = 0;
+    for (const auto& hit : hits) {
+        if (hit.hit()) ++hit_count;
+    }
+    std::cout << "射线拾取命中: " << hit_count << "/" << rays.size()
+              << "，命中高度: " << (hits[0].hit() ? 5.0 - hits[0].t : 0.0) << std::endl;
+    
+    // 体素化：最长边64个体素，实体填充
+    VoxelGrid grid = Voxelizer::voxelize(manager, 64);
+    std::cout << "体素网格: " << grid.nx << "x" << grid.ny << "x" << grid.nz
+              << "，占据体素: " << grid.count() << std::endl;
 }
 
 /**
@@ -71,23 +160,13 @@ void testWasherModeling() {
     
     ModelManager manager;
     
-    // 垫片外轮廓（圆形，简化为八边形）
-    std::vector<Point3D> outer_profile;
-    double outer_radius = 1.5;
-    for (int i = 0; i < 8; ++i) {
-        double angle = 2 * M_PI / 8 * i;
-        double x = outer_radius * std::cos(angle);
-        double y = outer_radius * std::sin(angle);
-        outer_profile.push_back(Point3D(i + 1, x, y, 0.0));
-    }
-    
-    // 拉伸垫片
-    std::cout << "拉伸垫片..." << std::endl;
-    bool success = GeometryAlgorithm::extrude(manager, outer_profile, 0.2);
+    // 垫片：外半径1.5、内半径0.55的空心圆管，按弦高误差0.005生成
+    std::cout << "生成垫片..." << std::endl;
+    bool success = PrimitiveBuilder::cylinder(manager, Point3D(0, 0.0, 0.0, 0.0), 1.5, 0.2, 0.005, 0.55);
     if (success) {
-        std::cout << "垫片拉伸成功!" << std::endl;
+        std::cout << "垫片生成成功!" << std::endl;
     } else {
-        std::cout << "垫片拉伸失败!" << std::endl;
+        std::cout << "垫片生成失败!" << std::endl;
     }
     
     // 检测拓扑错误
@@ -99,6 +178,878 @@ void testWasherModeling() {
     std::cout << "顶点数量: " << manager.getVertices().size() << std::endl;
     std::cout << "边数量: " << manager.getEdges().size() << std::endl;
     std::cout << "面数量: " << manager.getFaces().size() << std::endl;
+    
+    // 点内外分类：垫片中心与外侧点
+    WindingNumber winding(manager);
+    std::cout << "孔中心点绕数: " << winding.evaluate(0.0, 0.0, 0.1)
+              << "，环内点是否在内部: " << (winding.isInside(1.0, 0.0, 0.1) ? "是" : "否") << std::endl;
+    
+    // 有向距离场：网格间距0.05，窄带3格
+    SignedDistanceField sdf(manager, 0.05);
+    std::cout << "距离场块数: " << sdf.allocatedBlocks()
+              << "，环内点有向距离: " << sdf.sample(1.0, 0.0, 0.1) << std::endl;
+}
+
+/**
+ * @brief 测试曲面加厚
+ * 
+ * 将L形支架中面加厚为实体
+ */
+void testThickenModeling() {
+    std::cout << "\n=== 测试曲面加厚 ===" << std::endl;
+    
+    // L形支架中面：水平板与竖直板共用一条边
+    ModelManager surface;
+    surface.addVertex(1, 0.0, 0.0, 0.0);
+    surface.addVertex(2, 2.0, 0.0, 0.0);
+    surface.addVertex(3, 2.0, 1.0, 0.0);
+    surface.addVertex(4, 0.0, 1.0, 0.0);
+    surface.addVertex(5, 0.0, 1.0, 1.0);
+    surface.addVertex(6, 2.0, 1.0, 1.0);
+    std::vector<int> plate;
+    plate.push_back(1);
+    plate.push_back(2);
+    plate.push_back(3);
+    plate.push_back(4);
+    surface.addFaceFromVertices(1, plate);
+    std::vector<int> flange;
+    flange.push_back(4);
+    flange.push_back(3);
+    flange.push_back(6);
+    flange.push_back(5);
+    surface.addFaceFromVertices(2, flange);
+    
+    ModelManager solid;
+    bool success = GeometryAlgorithm::thicken(solid, surface, 0.1);
+    std::cout << (success ? "加厚成功!" : "加厚失败!") << std::endl;
+    TopologyChecker::detectAllTopologyErrors(solid);
+    std::cout << "顶点数量: " << solid.getVertices().size()
+              << "，边数量: " << solid.getEdges().size()
+              << "，面数量: " << solid.getFaces().size() << std::endl;
+}
+
+/**
+ * @brief 测试曲率分析
+ * 
+ * 旋转矩形截面生成环形扇段，分析其平面、柱面与尖锐区域
+ */
+void testCurvatureAnalysis() {
+    std::cout << "\n=== 测试曲率分析 ===" << std::endl;
+    
+    ModelManager manager;
+    
+    // 矩形截面（xz平面内），绕Z轴旋转90度
+    std::vector<Point3D> section;
+    section.push_back(Point3D(1, 1.0, 0.0, 0.0));
+    section.push_back(Point3D(2, 1.5, 0.0, 0.0));
+    section.push_back(Point3D(3, 1.5, 0.0, 0.2));
+    section.push_back(Point3D(4, 1.0, 0.0, 0.2));
+    double axis[3] = {0.0, 0.0, 1.0};
+    GeometryAlgorithm::revolve(manager, section, Point3D(0, 0.0, 0.0, 0.0), axis, M_PI / 2);
+    check(TopologyChecker::checkTopology(manager).inconsistent_normals.empty(), "旋转扇段法向一致");
+    
+    // 整圈旋转：末环与首环重合，不生成端面
+    ModelManager ring;
+    GeometryAlgorithm::revolve(ring, section, Point3D(0, 0.0, 0.0, 0.0), axis, 2 * M_PI);
+    std::cout << "整圈旋转 顶点数: " << ring.getVertices().size() << "，面数: " << ring.getFaces().size() << std::endl;
+    check(ring.getVertices().size() == 4 * section.size() && ring.getFaces().size() == 4 * section.size(),
+          "整圈旋转无重复接缝环与端面");
+    check(!TopologyChecker::checkTopology(ring).hasErrors(), "整圈旋转无拓扑错误");
+    
+    CurvatureData curvature = MeshAnalyzer::analyzeCurvature(manager);
+    int counts[3] = {0, 0, 0};
+    for (SurfaceClass c : curvature.face_classes) {
+        ++counts[static_cast<int>(c)];
+    }
+    std::cout << "特征边数量: " << curvature.feature_edges.size() << std::endl;
+    std::cout << "平面/柱面/曲面 面数量: " << counts[0] << "/" << counts[1] << "/" << counts[2] << std::endl;
+}
+
+/**
+ * @brief 测试批量拓扑检测
+ * 
+ * 生成若干零件，部分写出为OBJ文件，再以线程池批量读取与检测并输出汇总报告
+ */
+void testBatchValidation() {
+    std::cout << "\n=== 测试批量拓扑检测 ===" << std::endl;
+    
+    std::vector<std::string> names;
+    std::vector<std::shared_ptr<const ModelManager>> models;
+    for (int i = 0; i < 4; ++i) {
+        std::shared_ptr<ModelManager> part(new ModelManager());
+        PrimitiveBuilder::cylinder(*part, Point3D(0, 0.0, 0.0, 0.0), 1.0 + i, 2.0, 0.01);
+        names.push_back("cylinder_" + std::to_string(i));
+        models.push_back(part);
+    }
+    
+    // OBJ往返：写出后与一个不存在的文件一起按文件批量检测
+    std::vector<std::string> paths;
+    paths.push_back("batch_part.obj");
+    paths.push_back("missing_part.obj");
+    ModelIO::saveOBJ(paths[0], *models[0]);
+    
+    BatchValidationOptions options;
+    options.workers = 2;
+    options.timeout_seconds = 10.0;
+    BatchValidator validator(options);
+    auto results = validator.validateModels(names, models);
+    auto file_results = validator.validateFiles(paths, [](const ValidationResult& result) {
+        BatchValidator::writeJSONLine(std::cout, result);
+        std::cout << std::endl;
+    });
+    std::remove(paths[0].c_str());
+    results.insert(results.end(), file_results.begin(), file_results.end());
+    
+    std::cout << "往返后面数量: " << file_results[0].face_count << " / " << models[0]->getFaces().size() << std::endl;
+    BatchValidator::writeCSV(std::cout, results);
+}
+
+/**
+ * @brief 测试本地模型服务器
+ * 
+ * 常驻一个垫片模型，客户端经Unix域套接字查询包围盒、最近点与拓扑，
+ * 并通过共享内存导入模型
+ */
+void testModelServer() {
+    std::cout << "\n=== 测试本地模型服务器 ===" << std::endl;
+    
+    std::shared_ptr<ModelManager> washer(new ModelManager());
+    PrimitiveBuilder::cylinder(*washer, Point3D(0, 0.0, 0.0, 0.0), 1.5, 0.2, 0.01, 0.55);
+    
+    ModelServer server("cad_demo.sock");
+    server.addModel("washer", washer);
+    std::string error;
+    if (!server.start(&error)) {
+        std::cout << "服务器未启动: " << error << std::endl;
+        return;
+    }
+    
+    ModelClient client;
+    if (!client.connect(server.socketPath(), &error)) {
+        std::cout << "连接失败: " << error << std::endl;
+        return;
+    }
+    const char* requests[] = {"BBOX washer", "CLOSEST washer 0 0 1", "TOPOLOGY washer", "EXPORT washer"};
+    std::string response;
+    for (const char* line : requests) {
+        if (client.request(line, response)) {
+            std::cout << line << " -> " << response << std::endl;
+        }
+    }
+    
+    // 从EXPORT响应中取出共享内存名称并导入
+    size_t begin = response.find("\"shm\":\"");
+    if (begin != std::string::npos) {
+        begin += 7;
+        std::string shm_name = response.substr(begin, response.find('"', begin) - begin);
+        ModelManager imported;
+        if (ModelClient::importShared(shm_name, imported, &error)) {
+            std::cout << "共享内存导入面数量: " << imported.getFaces().size() << " / " << washer->getFaces().size() << std::endl;
+        }
+    }
+    client.close();
+    server.stop();
+}
+
+/**
+ * @brief 测试共享内存模型发布
+ * 
+ * 写者发布旋转生成的模型，读者只读映射后零拷贝读取坐标并复制出一致版本
+ */
+void testSharedModelRegion() {
+    std::cout << "\n=== 测试共享内存模型发布 ===" << std::endl;
+    
+    ModelManager manager;
+    std::vector<Point3D> section;
+    section.push_back(Point3D(1, 1.0, 0.0, 0.0));
+    section.push_back(Point3D(2, 1.5, 0.0, 0.0));
+    section.push_back(Point3D(3, 1.5, 0.0, 0.2));
+    section.push_back(Point3D(4, 1.0, 0.0, 0.2));
+    double axis[3] = {0.0, 0.0, 1.0};
+    GeometryAlgorithm::revolve(manager, section, Point3D(0, 0.0, 0.0, 0.0), axis, M_PI / 2);
+    
+    std::string name = "/cad-demo-region";
+    std::string error;
+    SharedModelRegion publisher;
+    if (!publisher.create(name, SharedModelRegion::requiredBytes(manager), &error) || !publisher.publish(manager)) {
+        std::cout << "发布失败: " << error << std::endl;
+        return;
+    }
+    
+    SharedModelRegion reader;
+    if (!reader.attach(name, &error)) {
+        std::cout << "映射失败: " << error << std::endl;
+        publisher.unlink();
+        return;
+    }
+    
+    // 零拷贝读取：直接在共享内存上计算Z向范围，读完后校验序列号
+    SharedModelRegion::Snapshot snapshot;
+    if (reader.beginRead(snapshot)) {
+        double z_min = snapshot.zs[0];
+        double z_max = snapshot.zs[0];
+        for (size_t i = 1; i < snapshot.vertex_count; ++i) {
+            z_min = std::min(z_min, snapshot.zs[i]);
+            z_max = std::max(z_max, snapshot.zs[i]);
+        }
+        std::cout << "快照序列号 " << snapshot.sequence << "，Z范围 [" << z_min << ", " << z_max << "]，一致: "
+                  << (reader.validate(snapshot) ? "是" : "否") << std::endl;
+    }
+    
+    // 写者修改坐标后重新发布，读者得到新版本
+    manager.setVertexPosition(manager.getVertices()[0]->id, 1.0, 0.0, -0.1);
+    publisher.publish(manager);
+    ModelManager copy;
+    if (reader.readModel(copy)) {
+        std::cout << "新序列号 " << reader.sequence() << "，复制面数量: " << copy.getFaces().size()
+                  << "，首顶点z: " << copy.getVertices()[0]->z << std::endl;
+    }
+    publisher.unlink();
+}
+
+/**
+ * @brief 测试异步模型读取
+ * 
+ * 写出一批零件文件，再以读取/解析流水线并行读回
+ */
+void testAsyncLoading() {
+    std::cout << "\n=== 测试异步模型读取 ===" << std::endl;
+    
+    std::vector<std::string> paths;
+    for (int i = 0; i < 8; ++i) {
+        ModelManager part;
+        PrimitiveBuilder::sphere(part, Point3D(0, 0.0, 0.0, 0.0), 1.0 + 0.5 * i, 0.01);
+        paths.push_back("async_part_" + std::to_string(i) + (i % 2 ? ".cadm" : ".obj"));
+        ModelIO::save(paths.back(), part);
+    }
+    
+    AsyncLoadOptions options;
+    options.io_threads = 2;
+    size_t faces = 0;
+    std::vector<LoadedModel> results;
+    {
+        AsyncModelLoader loader(options);
+        results = loader.loadAll(paths);
+    }
+    size_t loaded = 0;
+    for (const auto& result : results) {
+        if (result.ok()) {
+            ++loaded;
+            faces += result.manager->getFaces().size();
+        }
+    }
+    for (const auto& path : paths) {
+        std::remove(path.c_str());
+    }
+    std::cout << "读取成功 " << loaded << "/" << results.size() << "，总面数: " << faces << std::endl;
+}
+
+/**
+ * @brief 测试特征几何缓存
+ * 
+ * 重复拉伸相同的螺栓头部轮廓：首次生成后命中内存层，
+ * 新建缓存实例后命中磁盘层
+ */
+void testGeometryCache() {
+    std::cout << "\n=== 测试特征几何缓存 ===" << std::endl;
+    
+    std::vector<Point3D> head_profile;
+    for (int i = 0; i < 6; ++i) {
+        double angle = 2 * M_PI / 6 * i;
+        head_profile.push_back(Point3D(i + 1, std::cos(angle), std::sin(angle), 0.0));
+    }
+    
+    // 清除上次运行可能残留的磁盘缓存文件，使首次拉伸按未命中处理
+    std::string key = GeometryCache::makeKey("extrude", head_profile, std::vector<double>(1, 0.5));
+    std::remove(("./" + key + ".cadm").c_str());
+    
+    GeometryCache cache(1u << 20, ".");
+    ModelManager assembly;
+    for (int i = 0; i < 10; ++i) {
+        cache.extrude(assembly, head_profile, 0.5);
+    }
+    GeometryCacheStats stats = cache.stats();
+    std::cout << "内存命中 " << stats.memory_hits << "，未命中 " << stats.misses
+              << "，装配体顶点数: " << assembly.getVertices().size() << std::endl;
+    
+    GeometryCache reopened(1u << 20, ".");
+    ModelManager part;
+    reopened.extrude(part, head_profile, 0.5);
+    std::cout << "新实例磁盘命中 " << reopened.stats().disk_hits << "，面数量: " << part.getFaces().size() << std::endl;
+    check(stats.misses == 1 && stats.memory_hits == 9, "重复拉伸仅首次未命中");
+    check(reopened.stats().disk_hits == 1, "新缓存实例命中磁盘层");
+    
+    // 缓存几何与直接生成的几何一致，.cadm编码后解析回来保持不变
+    ModelManager direct;
+    GeometryAlgorithm::extrude(direct, head_profile, 0.5);
+    check(sameGeometry(part, direct), "磁盘层命中的几何与直接拉伸一致");
+    std::string encoded;
+    ModelIO::encodeBinary(direct, encoded);
+    ModelManager decoded;
+    check(ModelIO::parseBinary(encoded.data(), encoded.size(), decoded) && sameGeometry(decoded, direct),
+          ".cadm编码往返后几何不变");
+    
+    std::remove(("./" + key + ".cadm").c_str());
+}
+
+/**
+ * @brief 测试几何指纹
+ * 
+ * 同一零件以不同ID编号重建后指纹相同，尺寸不同的零件指纹不同
+ */
+void testModelFingerprint() {
+    std::cout << "\n=== 测试几何指纹 ===" << std::endl;
+    
+    std::vector<std::shared_ptr<const ModelManager>> library;
+    for (int i = 0; i < 3; ++i) {
+        std::shared_ptr<ModelManager> washer(new ModelManager());
+        // 先放一个占位顶点，使后续顶点ID编号各不相同
+        washer->addVertex(1000 * (i + 1), 9.0, 9.0, 9.0);
+        PrimitiveBuilder::cylinder(*washer, Point3D(0, 0.0, 0.0, 0.0), i == 2 ? 1.6 : 1.5, 0.2, 0.01, 0.55);
+        library.push_back(washer);
+    }
+    for (const auto& part : library) {
+        std::cout << "指纹: " << ModelFingerprint::compute(*part).hex() << std::endl;
+    }
+    auto groups = ModelFingerprint::findDuplicates(library);
+    std::cout << "重复组数量: " << groups.size() << std::endl;
+    check(ModelFingerprint::compute(*library[0]) == ModelFingerprint::compute(*library[1]),
+          "ID编号不同的相同零件指纹相同");
+    check(!(ModelFingerprint::compute(*library[0]) == ModelFingerprint::compute(*library[2])),
+          "尺寸不同的零件指纹不同");
+    check(groups.size() == 1 && groups[0].size() == 2, "恰好找到一组两个重复零件");
+}
+
+/**
+ * @brief 测试点到面ICP配准
+ * 
+ * 在圆环面三角形上取样作为扫描点，施加已知刚体偏移后配准回名义模型
+ */
+void testRigidRegistration() {
+    std::cout << "\n=== 测试ICP配准 ===" << std::endl;
+    
+    ModelManager nominal;
+    PrimitiveBuilder::torus(nominal, Point3D(0, 0.0, 0.0, 0.0), 3.0, 1.0, 0.01);
+    TriangleBVH bvh(nominal);
+    
+    double omega[3] = {0.02, -0.03, 0.05};
+    double offset[3] = {0.1, -0.05, 0.08};
+    RigidTransform misalignment = RigidTransform::fromRotationVector(omega, offset);
+    std::vector<double> xs, ys, zs;
+    for (size_t t = 0; t < bvh.triangleCount(); ++t) {
+        const double* tri = bvh.triangle(t);
+        double p[3] = {(tri[0] + tri[3] + tri[6]) / 3.0, (tri[1] + tri[4] + tri[7]) / 3.0,
+                       (tri[2] + tri[5] + tri[8]) / 3.0};
+        misalignment.apply(p, p);
+        xs.push_back(p[0]);
+        ys.push_back(p[1]);
+        zs.push_back(p[2]);
+    }
+    
+    RegistrationResult result = RigidRegistration::alignPointToPlane(bvh, xs.data(), ys.data(), zs.data(), xs.size());
+    RigidTransform residual = result.transform.compose(misalignment);
+    double error = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        error = std::max(error, std::fabs(residual.translation[i]));
+    }
+    std::cout << "扫描点数量: " << xs.size() << "，迭代次数: " << result.iterations
+              << "，是否收敛: " << (result.converged ? "是" : "否") << std::endl;
+    std::cout << "RMS偏差: " << result.rms << "，残余平移: " << error << std::endl;
+    check(result.converged && error < 1e-4, "ICP配准恢复已知刚体偏移");
+}
+
+/**
+ * @brief 测试偏差分析
+ * 
+ * 将球面顶点沿径向交替内缩与外扩作为扫描点，分块流式计算有向偏差
+ */
+void testDeviationAnalysis() {
+    std::cout << "\n=== 测试偏差分析 ===" << std::endl;
+    
+    ModelManager nominal;
+    PrimitiveBuilder::sphere(nominal, Point3D(0, 0.0, 0.0, 0.0), 2.0, 0.01);
+    DeviationAnalyzer analyzer(nominal);
+    
+    const auto& vertices = nominal.getVertices();
+    size_t position = 0;
+    PointChunkSource source = [&](double* xs, double* ys, double* zs, size_t capacity) {
+        size_t n = std::min(capacity, vertices.size() - position);
+        for (size_t i = 0; i < n; ++i, ++position) {
+            double scale = 1.0 + ((position % 7) * 0.01 - 0.03);
+            xs[i] = vertices[position]->x * scale;
+            ys[i] = vertices[position]->y * scale;
+            zs[i] = vertices[position]->z * scale;
+        }
+        return n;
+    };
+    
+    DeviationOptions options;
+    options.tolerance = 0.03;
+    options.histogram_range = 0.1;
+    options.histogram_bins = 10;
+    options.chunk_size = 256;
+    size_t outside = 0;
+    DeviationStats stats = analyzer.analyze(source, options,
+        [&](size_t, size_t count, const double*, const double*, const double*, const double* deviations) {
+            for (size_t i = 0; i < count; ++i) {
+                if (std::fabs(deviations[i]) > options.tolerance) ++outside;
+            }
+        });
+    unsigned char rgb[3];
+    DeviationAnalyzer::colorMap(stats.max, options, rgb);
+    std::cout << "点数: " << stats.count << "，偏差范围: [" << stats.min << ", " << stats.max
+              << "]，RMS: " << stats.rms << std::endl;
+    std::cout << "公差内: " << stats.within_tolerance << "，超差: " << outside
+              << "，中位数: " << stats.percentile(0.5) << "，最大偏差颜色: (" << static_cast<int>(rgb[0]) << ", "
+              << static_cast<int>(rgb[1]) << ", " << static_cast<int>(rgb[2]) << ")" << std::endl;
+}
+
+/**
+ * @brief 测试点云容器
+ * 
+ * 读取带点数行的PTS扫描与PLY点云，流式转换为原生格式后映射打开，再做网格索引查询与表面投影
+ */
+void testPointCloud() {
+    std::cout << "\n=== 测试点云容器 ===" << std::endl;
+    
+    {
+        // 扫描仪导出的PTS：首行为点数，每行 x y z 强度 r g b
+        std::ofstream pts("demo_scan.pts");
+        pts << "3\n0.5 0.25 1.0 -1024 120 130 140\n1.5 0.25 1.0 -980 121 131 141\n2.5 0.25 1.0 -950 122 132 142\n";
+    }
+    PointCloud scan;
+    std::string pts_error;
+    bool pts_loaded = PointCloudIO::load("demo_scan.pts", scan, &pts_error);
+    std::cout << "PTS读取: " << (pts_loaded ? "成功" : "失败 " + pts_error) << "，点数: " << scan.size() << std::endl;
+    std::remove("demo_scan.pts");
+    
+    {
+        std::ofstream ply("demo_scan.ply");
+        ply << "ply\nformat ascii 1.0\nelement vertex 200\nproperty float x\nproperty float y\n"
+            << "property float z\nproperty uchar intensity\nend_header\n";
+        for (int i = 0; i < 200; ++i) {
+            double angle = 2 * M_PI * i / 50;
+            ply << 1.05 * std::cos(angle) << " " << 1.05 * std::sin(angle) << " " << (i / 50) * 0.5 << " 255\n";
+        }
+    }
+    std::string error;
+    size_t converted = PointCloudIO::convert("demo_scan.ply", "demo_scan.cadp", &error);
+    PointCloud cloud;
+    if (!cloud.openMapped("demo_scan.cadp", &error)) {
+        std::cout << "打开点云失败: " << error << std::endl;
+        return;
+    }
+    std::cout << "转换点数: " << converted << "，映射模式: " << (cloud.isMapped() ? "是" : "否")
+              << "，分块数: " << cloud.chunkCount() << std::endl;
+    
+    PointCloudIndex index(cloud);
+    size_t nearest = 0;
+    double distance = 0.0;
+    index.nearest(1.0, 0.0, 0.0, 1.0, nearest, distance);
+    std::vector<size_t> neighbours;
+    index.radiusSearch(1.0, 0.0, 0.0, 0.2, neighbours);
+    std::cout << "最近点序号: " << nearest << "，距离: " << distance << "，半径内点数: " << neighbours.size() << std::endl;
+    
+    ModelManager nominal;
+    PrimitiveBuilder::cylinder(nominal, Point3D(0, 0.0, 0.0, 0.0), 1.0, 1.5, 0.01);
+    TriangleBVH bvh(nominal);
+    PointChunkView view = cloud.chunk(0);
+    std::vector<double> px(view.count), py(view.count), pz(view.count), distances(view.count);
+    GeometryAlgorithm::projectPointsToSurface(bvh, view.x, view.y, view.z, view.count,
+                                              px.data(), py.data(), pz.data(), distances.data());
+    std::cout << "投影最大距离: " << *std::max_element(distances.begin(), distances.end()) << std::endl;
+    
+    cloud.clear();
+    std::remove("demo_scan.ply");
+    std::remove("demo_scan.cadp");
+}
+
+/**
+ * @brief 测试表面采样
+ * 
+ * 在圆环面上做面积加权均匀采样与泊松圆盘采样，并检查最小间距
+ */
+void testSurfaceSampling() {
+    std::cout << "\n=== 测试表面采样 ===" << std::endl;
+    
+    ModelManager torus;
+    PrimitiveBuilder::torus(torus, Point3D(0, 0.0, 0.0, 0.0), 2.0, 0.5, 0.01);
+    SurfaceSampler sampler(torus);
+    
+    PointCloud cloud;
+    sampler.sampleUniform(100000, 42, cloud);
+    double lo[3], hi[3];
+    cloud.getBounds(lo, hi);
+    std::cout << "表面积: " << sampler.totalArea() << "，均匀采样点数: " << cloud.size()
+              << "，包围盒z范围: [" << lo[2] << ", " << hi[2] << "]" << std::endl;
+    
+    double radius = 0.1;
+    SurfaceSamples samples = sampler.samplePoissonDisk(radius, 42);
+    double min_spacing = 1e300;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        for (size_t j = i + 1; j < samples.size(); ++j) {
+            double dx = samples.x[i] - samples.x[j];
+            double dy = samples.y[i] - samples.y[j];
+            double dz = samples.z[i] - samples.z[j];
+            min_spacing = std::min(min_spacing, std::sqrt(dx * dx + dy * dy + dz * dz));
+        }
+    }
+    std::cout << "泊松圆盘采样点数: " << samples.size() << "，最小间距: " << min_spacing
+              << "（要求不小于" << radius << "）" << std::endl;
+}
+
+/**
+ * @brief 测试装配体碰撞检测
+ * 
+ * 板件上放置垫片与螺栓：贴合接触不算干涉，螺栓下沉插入板件与销钉埋入板件内部时报告干涉
+ */
+void testCollisionDetection() {
+    std::cout << "\n=== 测试碰撞检测 ===" << std::endl;
+    
+    ModelManager plate, washer, bolt, pin;
+    PrimitiveBuilder::hexPrism(plate, Point3D(0, 0.0, 0.0, 0.0), 8.0, 1.0);
+    PrimitiveBuilder::cylinder(washer, Point3D(0, 0.0, 0.0, 0.0), 2.0, 0.3, 0.01, 1.0);
+    PrimitiveBuilder::cylinder(bolt, Point3D(0, 0.0, 0.0, 0.0), 0.9, 3.0, 0.01);
+    PrimitiveBuilder::cylinder(pin, Point3D(0, 0.0, 0.0, 0.0), 0.2, 0.5, 0.01);
+    
+    CollisionDetector detector;
+    int plate_part = detector.addPart(plate);
+    int washer_part = detector.addPart(washer);
+    int bolt_part = detector.addPart(bolt);
+    int pin_part = detector.addPart(pin);
+    
+    const int grid = 10;
+    int expected = 0;
+    for (int i = 0; i < grid; ++i) {
+        for (int j = 0; j < grid; ++j) {
+            double angle[3] = {0.0, 0.0, 0.1 * i};
+            double offset[3] = {10.0 * i, 10.0 * j, 0.0};
+            detector.addInstance(plate_part, RigidTransform::fromRotationVector(angle, offset));
+            offset[2] = 1.0;
+            detector.addInstance(washer_part, RigidTransform::fromRotationVector(angle, offset));
+            // 每7组中一根螺栓下沉0.5穿入板件
+            bool sunk = (i * grid + j) % 7 == 0;
+            offset[2] = sunk ? 0.5 : 1.0;
+            detector.addInstance(bolt_part, RigidTransform::fromRotationVector(angle, offset));
+            // 每9组中一个销钉完全埋在板件内部
+            bool buried = (i * grid + j) % 9 == 4;
+            double pin_offset[3] = {10.0 * i + 2.5, 10.0 * j, buried ? 0.25 : 5.0};
+            detector.addInstance(pin_part, RigidTransform::fromRotationVector(angle, pin_offset));
+            expected += (sunk ? 1 : 0) + (buried ? 1 : 0);
+        }
+    }
+    
+    std::vector<std::pair<int, int>> candidates = detector.broadPhase();
+    std::vector<CollisionPair> collisions = detector.detect();
+    int contained = 0;
+    for (const auto& pair : collisions) {
+        contained += pair.contained ? 1 : 0;
+    }
+    std::cout << "实例数: " << detector.instanceCount() << "，粗检测候选对: " << candidates.size()
+              << "，干涉对: " << collisions.size() << "（其中包含关系 " << contained << "），预期: " << expected
+              << std::endl;
+    
+    double crossing[9] = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+    double piercing[9] = {0.2, 0.2, -1.0, 0.2, 0.2, 1.0, 0.3, 0.3, 1.0};
+    double touching[9] = {0.2, 0.2, 0.0, 0.2, 0.2, 1.0, 0.3, 0.3, 1.0};
+    std::cout << "三角形穿透: " << CollisionDetector::trianglesIntersect(crossing, piercing, 1e-9)
+              << "，顶点接触: " << CollisionDetector::trianglesIntersect(crossing, touching, 1e-9) << std::endl;
+}
+
+/**
+ * @brief 测试连续碰撞检测
+ * 
+ * 螺栓边旋转边下落到板件上，用保守推进求首次接触时间，并与密集静态采样对比
+ */
+void testContinuousCollision() {
+    std::cout << "\n=== 测试连续碰撞检测 ===" << std::endl;
+    
+    ModelManager plate, bolt;
+    PrimitiveBuilder::hexPrism(plate, Point3D(0, 0.0, 0.0, 0.0), 8.0, 1.0);
+    PrimitiveBuilder::cylinder(bolt, Point3D(0, 0.0, 0.0, 0.0), 0.9, 3.0, 0.01);
+    
+    CollisionDetector detector;
+    int plate_instance = detector.addInstance(detector.addPart(plate), RigidTransform());
+    int bolt_instance = detector.addInstance(detector.addPart(bolt), RigidTransform());
+    
+    // 螺栓从z=5落到z=-1，同时绕x轴倾倒1弧度
+    double zero[3] = {0.0, 0.0, 0.0};
+    double tilt[3] = {1.0, 0.0, 0.0};
+    double from[3] = {1.0, 0.0, 5.0};
+    double to[3] = {1.0, 0.0, -1.0};
+    RigidMotion still;
+    RigidMotion fall(RigidTransform::fromRotationVector(zero, from), RigidTransform::fromRotationVector(tilt, to));
+    ContinuousCollisionResult result = detector.timeOfImpact(plate_instance, still, bolt_instance, fall);
+    std::cout << "首次接触时间: " << result.time << "，距离查询次数: " << result.iterations << std::endl;
+    
+    // 密集静态采样：逐步移动螺栓并检查距离
+    const int steps = 400;
+    const double center[3] = {0.0, 0.0, 1.5};
+    double sampled = 1.0;
+    int queries = 0;
+    for (int i = 0; i <= steps; ++i) {
+        double t = static_cast<double>(i) / steps;
+        detector.setTransform(bolt_instance, fall.at(t, center));
+        ++queries;
+        if (detector.distance(plate_instance, bolt_instance) <= 1e-4) {
+            sampled = t;
+            break;
+        }
+    }
+    std::cout << "密集采样（" << steps << "步）首个接触时间: " << sampled << "，距离查询次数: " << queries << std::endl;
+    
+    // 分段路径批量检测
+    std::vector<RigidTransform> path_plate, path_bolt;
+    for (int i = 0; i <= 20; ++i) {
+        path_plate.push_back(RigidTransform());
+        path_bolt.push_back(fall.at(i / 20.0, center));
+    }
+    std::vector<ContinuousCollisionResult> segments =
+        detector.timeOfImpact(plate_instance, path_plate, bolt_instance, path_bolt);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (segments[i].hit) {
+            std::cout << "分段检测: 第" << i << "段内接触，时间: " << (i + segments[i].time) / segments.size()
+                      << std::endl;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 测试截面分层
+ * 
+ * 圆环面水平截面为外轮廓与孔两个环，竖直截面与等间距分层检查轮廓闭合与面积
+ */
+void testSlicing() {
+    std::cout << "\n=== 测试截面分层 ===" << std::endl;
+    
+    ModelManager torus;
+    PrimitiveBuilder::torus(torus, Point3D(0, 0.0, 0.0, 0.0), 3.0, 1.0, 0.01);
+    
+    Slicer horizontal(torus);
+    Slice middle = horizontal.slice(0.0);
+    std::cout << "z=0截面轮廓数: " << middle.contours.size() << std::endl;
+    for (const auto& contour : middle.contours) {
+        std::cout << "  " << (contour.closed ? "闭合" : "开放") << "，点数: " << contour.size()
+                  << "，有向面积: " << Slicer::signedArea(contour) << std::endl;
+    }
+    std::cout << "理论面积: 外轮廓 " << M_PI * 16.0 << "，孔 " << -M_PI * 4.0 << std::endl;
+    
+    Slicer vertical(torus, 0.0, 1.0, 0.0);
+    Slice side = vertical.slice(0.0);
+    std::cout << "y=0截面轮廓数: " << side.contours.size() << "（理论为两个半径1的圆，面积各 " << M_PI << "）"
+              << std::endl;
+    for (const auto& contour : side.contours) {
+        std::cout << "  有向面积: " << Slicer::signedArea(contour) << std::endl;
+    }
+    
+    std::vector<Slice> layers = horizontal.sliceUniform(50);
+    size_t loops = 0;
+    size_t open = 0;
+    for (const auto& layer : layers) {
+        for (const auto& contour : layer.contours) {
+            ++loops;
+            open += contour.closed ? 0 : 1;
+        }
+    }
+    std::cout << "等间距50层，轮廓总数: " << loops << "，未闭合: " << open << std::endl;
+}
+
+/**
+ * @brief 测试工程视图投影
+ * 
+ * 六角棱柱与圆管的标准视图统计可见线与隐藏线，并批量投影多个方向
+ */
+void testDrawingProjection() {
+    std::cout << "\n=== 测试工程视图投影 ===" << std::endl;
+    
+    ModelManager prism;
+    PrimitiveBuilder::hexPrism(prism, Point3D(0, 0.0, 0.0, 0.0), 8.0, 2.0);
+    ModelManager tube;
+    PrimitiveBuilder::cylinder(tube, Point3D(0, 0.0, 0.0, 0.0), 1.0, 3.0, 0.01, 0.5);
+    
+    const StandardView views[] = {StandardView::Front, StandardView::Top, StandardView::Isometric};
+    const char* names[] = {"主视图", "俯视图", "轴测图"};
+    const ModelManager* models[] = {&prism, &tube};
+    const char* model_names[] = {"六角棱柱", "圆管"};
+    for (int m = 0; m < 2; ++m) {
+        DrawingProjector projector(*models[m]);
+        std::cout << model_names[m] << "特征边数: " << projector.featureEdgeCount() << std::endl;
+        for (int v = 0; v < 3; ++v) {
+            DrawingView view = projector.project(views[v]);
+            size_t silhouettes = 0;
+            for (const auto& line : view.lines) {
+                silhouettes += line.silhouette ? 1 : 0;
+            }
+            std::cout << "  " << names[v] << " 可见线: " << view.visibleCount()
+                      << "，隐藏线: " << view.lines.size() - view.visibleCount()
+                      << "，轮廓线: " << silhouettes << std::endl;
+        }
+    }
+    
+    // 绕z轴与仰角均匀分布的100个观察方向
+    std::vector<double> directions;
+    for (int i = 0; i < 100; ++i) {
+        double azimuth = 2.0 * M_PI * i / 100.0;
+        double elevation = M_PI * ((i % 10) - 4.5) / 10.0;
+        directions.push_back(std::cos(elevation) * std::cos(azimuth));
+        directions.push_back(std::cos(elevation) * std::sin(azimuth));
+        directions.push_back(std::sin(elevation));
+    }
+    DrawingProjector projector(tube);
+    DrawingOptions options;
+    options.resolution = 256;
+    options.include_hidden = false;
+    std::vector<DrawingView> batch = projector.project(directions.data(), 100, options);
+    size_t total = 0;
+    for (const auto& view : batch) {
+        total += view.lines.size();
+    }
+    std::cout << "批量投影100个视图，可见线总数: " << total << std::endl;
+}
+
+/**
+ * @brief 测试二维轮廓处理
+ * 
+ * 带重合点、共线点的顺时针六边形清理后拉伸；密集采样轮廓简化、偏置与自相交检查
+ */
+void testProfileProcessing() {
+    std::cout << "\n=== 测试二维轮廓处理 ===" << std::endl;
+    
+    // 顺时针六边形，每条边中点插入共线点，首点重复一次
+    Profile2D hexagon;
+    for (int i = 6; i > 0; --i) {
+        double a0 = 2 * M_PI / 6 * i;
+        double a1 = 2 * M_PI / 6 * (i - 1);
+        hexagon.append(std::cos(a0), std::sin(a0));
+        hexagon.append(0.5 * (std::cos(a0) + std::cos(a1)), 0.5 * (std::sin(a0) + std::sin(a1)));
+    }
+    hexagon.append(hexagon.x(0), hexagon.y(0));
+    std::cout << "原始顶点数: " << hexagon.size() << "，有向面积: " << hexagon.signedArea() << std::endl;
+    Profile2D cleaned = hexagon;
+    size_t removed = cleaned.clean();
+    std::cout << "清理去除顶点: " << removed << "，剩余: " << cleaned.size()
+              << "，有向面积: " << cleaned.signedArea() << std::endl;
+    
+    ModelManager manager;
+    GeometryAlgorithm::extrude(manager, hexagon, 0.5);
+    std::cout << "拉伸面数: " << manager.getFaces().size() << std::endl;
+    
+    // 自相交轮廓在建模前被拒绝
+    Profile2D crossed;
+    crossed.append(0.0, 0.0);
+    crossed.append(2.0, 1.0);
+    crossed.append(2.0, 0.0);
+    crossed.append(0.0, 1.0);
+    crossed.append(-1.0, 0.5);
+    std::cout << "交叉轮廓自相交: " << (crossed.selfIntersects() ? "是" : "否") << std::endl;
+    try {
+        ModelManager rejected;
+        GeometryAlgorithm::extrude(rejected, crossed, 1.0);
+    } catch (const std::invalid_argument& e) {
+        std::cout << "拉伸被拒绝: " << e.what() << std::endl;
+    }
+    
+    // 矩形截面绕过点(2, 1, 0)、方向(1, 1, 0)的斜轴旋转半圈，顶点到轴的距离应保持截面x坐标
+    Profile2D section;
+    section.append(1.0, 0.0);
+    section.append(1.5, 0.0);
+    section.append(1.5, 0.2);
+    section.append(1.0, 0.2);
+    Point3D axis_point(0, 2.0, 1.0, 0.0);
+    double axis[3] = {1.0, 1.0, 0.0};
+    ModelManager swept;
+    GeometryAlgorithm::revolve(swept, section, axis_point, axis, M_PI);
+    double min_radius = 1e30, max_radius = 0.0;
+    for (const auto& v : swept.getVertices()) {
+        double r[3] = {v->x - axis_point.x, v->y - axis_point.y, v->z - axis_point.z};
+        double along = (r[0] + r[1]) / std::sqrt(2.0);
+        double radius = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] - along * along);
+        min_radius = std::min(min_radius, radius);
+        max_radius = std::max(max_radius, radius);
+    }
+    std::cout << "斜轴旋转 顶点到轴距离: " << min_radius << " ~ " << max_radius << std::endl;
+    check(std::fabs(min_radius - 1.0) < 1e-9 && std::fabs(max_radius - 1.5) < 1e-9, "斜轴旋转保持截面到轴的距离");
+    check(!TopologyChecker::checkTopology(swept).hasErrors(), "斜轴旋转无拓扑错误");
+    
+    Profile2D straddling = section;
+    straddling.append(-0.5, 0.1);
+    bool rejected_section = false;
+    try {
+        ModelManager rejected;
+        GeometryAlgorithm::revolve(rejected, straddling, axis_point, axis, M_PI);
+    } catch (const std::invalid_argument& e) {
+        rejected_section = true;
+        std::cout << "旋转被拒绝: " << e.what() << std::endl;
+    }
+    check(rejected_section, "跨越旋转轴的截面被拒绝");
+    
+    // 密集采样的波浪形轮廓
+    Profile2D wavy;
+    const int samples = 100000;
+    for (int i = 0; i < samples; ++i) {
+        double a = 2 * M_PI * i / samples;
+        double r = 1.0 + 0.1 * std::sin(7 * a);
+        wavy.append(r * std::cos(a), r * std::sin(a));
+    }
+    Profile2D simple = wavy.simplified(1e-4);
+    std::cout << "简化: " << wavy.size() << " -> " << simple.size() << " 个顶点，面积 " << wavy.signedArea()
+              << " -> " << simple.signedArea() << std::endl;
+    Profile2D grown = simple.offset(0.05);
+    Profile2D shrunk = simple.offset(-0.05);
+    std::cout << "偏置±0.05 面积: " << grown.signedArea() << " / " << shrunk.signedArea()
+              << "，自相交: " << (grown.selfIntersects() || shrunk.selfIntersects() ? "是" : "否") << std::endl;
+}
+
+/**
+ * @brief 测试拉伸倒角与圆角
+ * 
+ * 六角螺栓头顶面整圈倒角；方形垫块侧棱圆角并对两端面倒圆；单条棱边倒角；倒角过大时报错
+ */
+void testEdgeBlending() {
+    std::cout << "\n=== 测试拉伸倒角与圆角 ===" << std::endl;
+    
+    Profile2D hexagon;
+    for (int i = 0; i < 6; ++i) {
+        double angle = 2 * M_PI / 6 * i;
+        hexagon.append(std::cos(angle), std::sin(angle));
+    }
+    
+    ModelManager head;
+    GeometryAlgorithm::extrude(head, hexagon, 0.5, EdgeBlend(), EdgeBlend(EdgeBlendType::Chamfer, 0.1));
+    std::cout << "螺栓头顶面倒角 面数: " << head.getFaces().size() << "，顶点数: " << head.getVertices().size()
+              << "，拓扑错误: " << (TopologyChecker::checkTopology(head).hasErrors() ? "有" : "无") << std::endl;
+    check(!TopologyChecker::checkTopology(head).hasErrors(), "顶面倒角拉伸无拓扑错误");
+    
+    Profile2D square;
+    square.append(-1.0, -1.0);
+    square.append(1.0, -1.0);
+    square.append(1.0, 1.0);
+    square.append(-1.0, 1.0);
+    Profile2D rounded = square.filleted(0.3, 4);
+    ModelManager block;
+    GeometryAlgorithm::extrude(block, rounded, 0.6, EdgeBlend(EdgeBlendType::Fillet, 0.1, 4),
+                               EdgeBlend(EdgeBlendType::Fillet, 0.1, 4));
+    std::cout << "垫块侧棱圆角轮廓顶点数: " << rounded.size() << "，两端圆角后面数: " << block.getFaces().size()
+              << "，拓扑错误: " << (TopologyChecker::checkTopology(block).hasErrors() ? "有" : "无") << std::endl;
+    check(!TopologyChecker::checkTopology(block).hasErrors(), "两端圆角拉伸无拓扑错误");
+    
+    EdgeBlend single(EdgeBlendType::Chamfer, 0.1);
+    single.edges.push_back(0);
+    ModelManager partial;
+    GeometryAlgorithm::extrude(partial, hexagon, 0.5, EdgeBlend(), single);
+    std::cout << "单条棱边倒角 面数: " << partial.getFaces().size() << std::endl;
+    check(!TopologyChecker::checkTopology(partial).hasErrors(), "单条棱边倒角拉伸无拓扑错误");
+    
+    bool rejected_blend = false;
+    try {
+        ModelManager rejected;
+        GeometryAlgorithm::extrude(rejected, hexagon, 2.0, EdgeBlend(EdgeBlendType::Chamfer, 0.9), EdgeBlend());
+    } catch (const std::invalid_argument& e) {
+        rejected_blend = true;
+        std::cout << "倒角0.9被拒绝: " << e.what() << std::endl;
+    }
+    check(rejected_blend, "超出轮廓尺寸的倒角被拒绝");
 }
 
 /**
@@ -129,11 +1080,13 @@ void testGeometryAlgorithms() {
 }
 
 /**
- * @brief 主函数
+ * @brief 运行内置演示
  * 
  * 测试CAD模型管理器的功能，包括螺栓/垫片建模、几何算法和拓扑检测
+ * 
+ * @return int 全部检查通过返回0，否则返回1
  */
-int main() {
+int runDemos() {
     std::cout << "=== CAD模型管理器测试 ===" << std::endl;
     
     // 测试几何算法
@@ -145,7 +1098,77 @@ int main() {
     // 测试垫片建模
     testWasherModeling();
     
+    // 测试曲面加厚
+    testThickenModeling();
+    
+    // 测试曲率分析
+    testCurvatureAnalysis();
+    
+    // 测试批量拓扑检测
+    testBatchValidation();
+    
+    // 测试本地模型服务器
+    testModelServer();
+    
+    // 测试共享内存模型发布
+    testSharedModelRegion();
+    
+    // 测试异步模型读取
+    testAsyncLoading();
+    
+    // 测试特征几何缓存
+    testGeometryCache();
+    
+    // 测试几何指纹
+    testModelFingerprint();
+    
+    // 测试ICP配准
+    testRigidRegistration();
+    
+    // 测试偏差分析
+    testDeviationAnalysis();
+    
+    // 测试点云容器
+    testPointCloud();
+    
+    // 测试表面采样
+    testSurfaceSampling();
+    
+    // 测试碰撞检测
+    testCollisionDetection();
+    
+    // 测试连续碰撞检测
+    testContinuousCollision();
+    
+    // 测试截面分层
+    testSlicing();
+    
+    // 测试工程视图投影
+    testDrawingProjection();
+    
+    // 测试二维轮廓处理
+    testProfileProcessing();
+    
+    // 测试拉伸倒角与圆角
+    testEdgeBlending();
+    
+    if (demo_failures > 0) {
+        std::cout << "\n=== 测试完成，" << demo_failures << "项检查失败 ===" << std::endl;
+        return 1;
+    }
     std::cout << "\n=== 所有测试完成 ===" << std::endl;
     
     return 0;
 }
+
+/**
+ * @brief 主函数
+ * 
+ * demo子命令运行内置演示，其余子命令交由命令行工具处理
+ */
+int main(int argc, char** argv) {
+    if (argc >= 2 && std::string(argv[1]) == "demo") {
+        return runDemos();
+    }
+    return CommandLine::run(argc, argv);
+}
@@ -0,0 +1,202 @@
+#include "mesh_analyzer.h"
+#include "mesh_topology.h"
+#include "parallel_utils.h"
+#include <algorithm>
+
+/**
+ * @brief 曲率估计与特征边检测
+ * 
+ * @param manager 模型管理器
+ * @param options 分析参数
+ * @return CurvatureData 曲率分析结果
+ */
+CurvatureData MeshAnalyzer::analyzeCurvature(ModelManager& manager, const CurvatureOptions& options) {
+    auto topology_ptr = manager.getMeshTopology();
+    auto normals_ptr = manager.getVertexNormals(NormalWeighting::Angle, M_PI);
+    const MeshTopology& topology = *topology_ptr;
+    const VertexNormals& normals = *normals_ptr;
+    const auto& vertices = manager.getVertices();
+    
+    size_t vertex_count = topology.vertexCount();
+    size_t edge_count = topology.edgeCount();
+    size_t face_count = topology.faceCount();
+    
+    CurvatureData data;
+    data.mean_curvature.assign(vertex_count, 0.0);
+    data.gaussian_curvature.assign(vertex_count, 0.0);
+    data.dihedral_angles.assign(edge_count, 0.0);
+    data.vertex_classes.assign(vertex_count, SurfaceClass::Planar);
+    data.face_classes.assign(face_count, SurfaceClass::Planar);
+    std::vector<char> feature(edge_count, 0);
+    
+    // 面中心
+    std::vector<double> centroids(face_count * 3, 0.0);
+    ParallelUtils::parallelFor(face_count, 512, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            int first = topology.face_offsets[f];
+            int last = topology.face_offsets[f + 1];
+            if (last <= first) continue;
+            for (int c = first; c < last; ++c) {
+                const Point3D& p = *vertices[topology.face_vertices[c]];
+                centroids[3 * f] += p.x;
+                centroids[3 * f + 1] += p.y;
+                centroids[3 * f + 2] += p.z;
+            }
+            double inv = 1.0 / (last - first);
+            centroids[3 * f] *= inv;
+            centroids[3 * f + 1] *= inv;
+            centroids[3 * f + 2] *= inv;
+        }
+    });
+    
+    // 边遍历：有向二面角与特征边
+    ParallelUtils::parallelFor(edge_count, 512, [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; ++e) {
+            int first = topology.edge_face_offsets[e];
+            int last = topology.edge_face_offsets[e + 1];
+            if (last - first != 2) {
+                feature[e] = 1;
+                continue;
+            }
+            int f = topology.edge_faces[first];
+            int g = topology.edge_faces[first + 1];
+            const double* nf = &normals.face_normals[3 * f];
+            const double* ng = &normals.face_normals[3 * g];
+            double cos_angle = nf[0] * ng[0] + nf[1] * ng[1] + nf[2] * ng[2];
+            double angle = std::acos(std::max(-1.0, std::min(1.0, cos_angle)));
+            // 相邻面中心位于本面法向背侧即为外凸
+            double side = (centroids[3 * g] - centroids[3 * f]) * nf[0] +
+                          (centroids[3 * g + 1] - centroids[3 * f + 1]) * nf[1] +
+                          (centroids[3 * g + 2] - centroids[3 * f + 2]) * nf[2];
+            data.dihedral_angles[e] = side > 0.0 ? -angle : angle;
+            feature[e] = angle > options.feature_angle ? 1 : 0;
+        }
+    });
+    
+    // 顶点收集：角亏、混合面积与边弯曲量
+    ParallelUtils::parallelFor(vertex_count, 256, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            int first = topology.vertex_face_offsets[v];
+            int last = topology.vertex_face_offsets[v + 1];
+            double angle_sum = 0.0;
+            double area = 0.0;
+            double bending = 0.0;
+            double max_bend = 0.0;
+            bool boundary = false;
+            bool sharp = false;
+            for (int k = first; k < last; ++k) {
+                int f = topology.vertex_faces[k];
+                int c = topology.vertex_face_corners[k];
+                int loop_first = topology.face_offsets[f];
+                int loop_last = topology.face_offsets[f + 1];
+                int n = loop_last - loop_first;
+                if (n < 3) continue;
+                area += normals.face_areas[f] / n;
+                
+                int prev_corner = c > loop_first ? c - 1 : loop_last - 1;
+                int next_corner = c + 1 < loop_last ? c + 1 : loop_first;
+                const Point3D& p = *vertices[v];
+                const Point3D& prev = *vertices[topology.face_vertices[prev_corner]];
+                const Point3D& next = *vertices[topology.face_vertices[next_corner]];
+                double u[3] = {prev.x - p.x, prev.y - p.y, prev.z - p.z};
+                double w[3] = {next.x - p.x, next.y - p.y, next.z - p.z};
+                double lu = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+                double lw = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+                if (lu > 1e-12 && lw > 1e-12) {
+                    double cos_angle = (u[0] * w[0] + u[1] * w[1] + u[2] * w[2]) / (lu * lw);
+                    angle_sum += std::acos(std::max(-1.0, std::min(1.0, cos_angle)));
+                }
+                
+                // 方向一致时每条内部边恰好作为某个面的出边出现一次；边界边的入边单独计入
+                int out_edge = topology.corner_edges[c];
+                int in_edge = topology.corner_edges[prev_corner];
+                int candidates[2] = {out_edge, in_edge};
+                for (int j = 0; j < 2; ++j) {
+                    int e = candidates[j];
+                    if (e < 0) continue;
+                    int valence = topology.edge_face_offsets[e + 1] - topology.edge_face_offsets[e];
+                    if (valence != 2) {
+                        boundary = true;
+                        sharp = true;
+                        continue;
+                    }
+                    if (j == 1) continue;
+                    if (feature[e]) sharp = true;
+                    double length = j == 0 ? lw : lu;
+                    bending += length * data.dihedral_angles[e];
+                    max_bend = std::max(max_bend, std::fabs(data.dihedral_angles[e]));
+                }
+            }
+            
+            double defect = (boundary ? M_PI : 2.0 * M_PI) - angle_sum;
+            if (area > 1e-12) {
+                data.gaussian_curvature[v] = defect / area;
+                data.mean_curvature[v] = bending / (4.0 * area);
+            }
+            if (sharp) {
+                data.vertex_classes[v] = SurfaceClass::Sharp;
+            } else if (std::fabs(defect) < options.flat_angle) {
+                data.vertex_classes[v] = max_bend < options.flat_angle ? SurfaceClass::Planar : SurfaceClass::Cylindrical;
+            } else {
+                data.vertex_classes[v] = SurfaceClass::Curved;
+            }
+        }
+    });
+    
+    // 面分类：弯曲的非特征边全部平行（柱面母线）为柱面
+    double parallel_cos = std::cos(options.flat_angle);
+    ParallelUtils::parallelFor(face_count, 512, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            bool bent = false;
+            bool ruled = true;
+            double axis[3] = {0.0, 0.0, 0.0};
+            for (int c = topology.face_offsets[f]; c < topology.face_offsets[f + 1]; ++c) {
+                int e = topology.corner_edges[c];
+                if (e < 0 || feature[e] || std::fabs(data.dihedral_angles[e]) < options.flat_angle) continue;
+                const Point3D& a = *vertices[topology.edge_vertices[2 * e]];
+                const Point3D& b = *vertices[topology.edge_vertices[2 * e + 1]];
+                double d[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+                double length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+                if (length < 1e-12) continue;
+                d[0] /= length;
+                d[1] /= length;
+                d[2] /= length;
+                if (!bent) {
+                    axis[0] = d[0];
+                    axis[1] = d[1];
+                    axis[2] = d[2];
+                    bent = true;
+                } else if (std::fabs(axis[0] * d[0] + axis[1] * d[1] + axis[2] * d[2]) < parallel_cos) {
+                    ruled = false;
+                }
+            }
+            if (bent) {
+                data.face_classes[f] = ruled ? SurfaceClass::Cylindrical : SurfaceClass::Curved;
+            }
+        }
+    });
+    
+    for (size_t e = 0; e < edge_count; ++e) {
+        if (feature[e]) {
+            data.feature_edges.push_back(static_cast<int>(e));
+        }
+    }
+    
+    // 写入属性通道
+    std::vector<double> vertex_class_values(vertex_count);
+    for (size_t v = 0; v < vertex_count; ++v) {
+        vertex_class_values[v] = static_cast<double>(data.vertex_classes[v]);
+    }
+    std::vector<double> face_class_values(face_count);
+    for (size_t f = 0; f < face_count; ++f) {
+        face_class_values[f] = static_cast<double>(data.face_classes[f]);
+    }
+    manager.setAttributeChannel(AttributeDomain::Vertex, "mean_curvature", data.mean_curvature);
+    manager.setAttributeChannel(AttributeDomain::Vertex, "gaussian_curvature", data.gaussian_curvature);
+    manager.setAttributeChannel(AttributeDomain::Vertex, "surface_class", vertex_class_values);
+    manager.setAttributeChannel(AttributeDomain::Edge, "dihedral_angle", data.dihedral_angles);
+    manager.setAttributeChannel(AttributeDomain::Edge, "feature_edge", std::vector<double>(feature.begin(), feature.end()));
+    manager.setAttributeChannel(AttributeDomain::Face, "surface_class", face_class_values);
+    
+    return data;
+}
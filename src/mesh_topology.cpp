@@ -0,0 +1,416 @@
+#include "mesh_topology.h"
+#include "model_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+/**
+ * @brief 生成无向边的查找键（小索引在高位）
+ */
+uint64_t makeEdgeKey(int a, int b) {
+    uint32_t lo = static_cast<uint32_t>(std::min(a, b));
+    uint32_t hi = static_cast<uint32_t>(std::max(a, b));
+    return (static_cast<uint64_t>(lo) << 32) | hi;
+}
+
+/**
+ * @brief 二维叉积 (b − a) × (c − b)，逆时针转向为正
+ */
+inline double cross2(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - by) - (by - ay) * (cx - bx);
+}
+
+/**
+ * @brief 点p是否位于逆时针三角形abc内（含边界）
+ */
+inline bool insideTriangle(double px, double py, double ax, double ay, double bx, double by, double cx,
+                           double cy) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax) >= 0.0 &&
+           (cx - bx) * (py - by) - (cy - by) * (px - bx) >= 0.0 &&
+           (ax - cx) * (py - cy) - (ay - cy) * (px - cx) >= 0.0;
+}
+
+} // namespace
+
+/**
+ * @brief 从模型管理器构建拓扑
+ *
+ * @param manager 模型管理器
+ */
+MeshTopology::MeshTopology(const ModelManager& manager) {
+    const auto& vertices = manager.getVertices();
+    vertex_index.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        vertex_index[vertices[i]->id] = static_cast<int>(i);
+    }
+
+    buildFaceLoops(manager);
+    buildEdges();
+    orientFaces(manager);
+    buildVertexFaces();
+    buildTriangles(manager);
+}
+
+/**
+ * @brief 通过顶点ID获取顶点索引
+ *
+ * @param vertex_id 顶点ID
+ * @return int 顶点索引，不存在时返回-1
+ */
+int MeshTopology::vertexIndex(int vertex_id) const {
+    auto it = vertex_index.find(vertex_id);
+    if (it != vertex_index.end()) {
+        return it->second;
+    }
+    return -1;
+}
+
+/**
+ * @brief 构建面顶点环
+ *
+ * 将面的边按公共顶点首尾相接；若边无法闭合成环，
+ * 则退化为按出现顺序收集不重复顶点
+ */
+void MeshTopology::buildFaceLoops(const ModelManager& manager) {
+    const auto& faces = manager.getFaces();
+    face_offsets.reserve(faces.size() + 1);
+    face_closed.reserve(faces.size());
+    face_offsets.push_back(0);
+
+    std::vector<std::pair<int, int>> face_edges;
+    std::vector<char> used;
+    std::vector<int> loop;
+    for (const auto& face : faces) {
+        face_edges.clear();
+        for (int edge_id : face->edge_ids) {
+            auto edge = manager.getEdge(edge_id);
+            if (!edge) continue;
+            int a = vertexIndex(edge->start_id);
+            int b = vertexIndex(edge->end_id);
+            if (a < 0 || b < 0 || a == b) continue;
+            face_edges.push_back(std::make_pair(a, b));
+        }
+
+        loop.clear();
+        bool closed = false;
+        if (!face_edges.empty()) {
+            used.assign(face_edges.size(), 0);
+            used[0] = 1;
+            // 首条边的走向取与第二条边相接的方向，使顶点环顺序与边ID顺序一致
+            int start = face_edges[0].first;
+            int second = face_edges[0].second;
+            if (face_edges.size() > 1 &&
+                (start == face_edges[1].first || start == face_edges[1].second) &&
+                second != face_edges[1].first && second != face_edges[1].second) {
+                std::swap(start, second);
+            }
+            loop.push_back(start);
+            loop.push_back(second);
+            size_t used_count = 1;
+            for (;;) {
+                int tail = loop.back();
+                bool extended = false;
+                for (size_t i = 0; i < face_edges.size(); ++i) {
+                    if (used[i]) continue;
+                    int next = -1;
+                    if (face_edges[i].first == tail) {
+                        next = face_edges[i].second;
+                    } else if (face_edges[i].second == tail) {
+                        next = face_edges[i].first;
+                    }
+                    if (next < 0) continue;
+                    used[i] = 1;
+                    ++used_count;
+                    loop.push_back(next);
+                    extended = true;
+                    break;
+                }
+                if (!extended || loop.back() == loop.front()) {
+                    break;
+                }
+            }
+            closed = loop.size() > 3 && loop.back() == loop.front() && used_count == face_edges.size();
+            if (closed) {
+                loop.pop_back();
+            } else {
+                // 边无法闭合：按出现顺序收集不重复顶点
+                loop.clear();
+                for (const auto& e : face_edges) {
+                    if (std::find(loop.begin(), loop.end(), e.first) == loop.end()) loop.push_back(e.first);
+                    if (std::find(loop.begin(), loop.end(), e.second) == loop.end()) loop.push_back(e.second);
+                }
+            }
+        }
+
+        face_vertices.insert(face_vertices.end(), loop.begin(), loop.end());
+        face_offsets.push_back(static_cast<int>(face_vertices.size()));
+        face_closed.push_back(closed ? 1 : 0);
+    }
+}
+
+/**
+ * @brief 构建无向边及边→面邻接
+ */
+void MeshTopology::buildEdges() {
+    std::unordered_map<uint64_t, int> edge_lookup;
+    edge_lookup.reserve(face_vertices.size());
+    corner_edges.assign(face_vertices.size(), -1);
+
+    std::vector<int> edge_face_counts;
+    for (size_t f = 0; f + 1 < face_offsets.size(); ++f) {
+        int begin = face_offsets[f];
+        int end = face_offsets[f + 1];
+        int n = end - begin;
+        if (n < 2) continue;
+        for (int c = begin; c < end; ++c) {
+            int a = face_vertices[c];
+            int b = face_vertices[c + 1 < end ? c + 1 : begin];
+            uint64_t key = makeEdgeKey(a, b);
+            auto it = edge_lookup.find(key);
+            int edge;
+            if (it == edge_lookup.end()) {
+                edge = static_cast<int>(edge_vertices.size() / 2);
+                edge_lookup[key] = edge;
+                edge_vertices.push_back(std::min(a, b));
+                edge_vertices.push_back(std::max(a, b));
+                edge_face_counts.push_back(0);
+            } else {
+                edge = it->second;
+            }
+            corner_edges[c] = edge;
+            ++edge_face_counts[edge];
+        }
+    }
+
+    edge_face_offsets.assign(edge_face_counts.size() + 1, 0);
+    for (size_t e = 0; e < edge_face_counts.size(); ++e) {
+        edge_face_offsets[e + 1] = edge_face_offsets[e] + edge_face_counts[e];
+    }
+    edge_faces.assign(edge_face_offsets.back(), -1);
+    std::vector<int> fill(edge_face_offsets.begin(), edge_face_offsets.end() - 1);
+    for (size_t f = 0; f + 1 < face_offsets.size(); ++f) {
+        for (int c = face_offsets[f]; c < face_offsets[f + 1]; ++c) {
+            int edge = corner_edges[c];
+            if (edge >= 0) {
+                edge_faces[fill[edge]++] = static_cast<int>(f);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 统一面方向
+ *
+ * 沿流形边做广度优先传播，使相邻面在公共边上的走向相反；
+ * 对封闭连通分量再按有向体积翻转为外法向
+ */
+void MeshTopology::orientFaces(const ModelManager& manager) {
+    size_t face_count = face_offsets.size() - 1;
+    face_components.assign(face_count, -1);
+    face_flipped.assign(face_count, 0);
+    if (face_count == 0) return;
+
+    // 面f沿其环经过边e时的走向：+1表示从edge_vertices[2e]走向edge_vertices[2e+1]
+    auto edgeDirection = [this](int f, int e) {
+        for (int c = face_offsets[f]; c < face_offsets[f + 1]; ++c) {
+            if (corner_edges[c] == e) {
+                return face_vertices[c] == edge_vertices[2 * e] ? 1 : -1;
+            }
+        }
+        return 0;
+    };
+
+    std::vector<int>& component = face_components;
+    std::vector<char>& flipped = face_flipped;
+    std::vector<int> queue;
+    const auto& vertices = manager.getVertices();
+
+    int component_count = 0;
+    for (size_t seed = 0; seed < face_count; ++seed) {
+        if (component[seed] >= 0) continue;
+        int comp = component_count++;
+        component[seed] = comp;
+        queue.clear();
+        queue.push_back(static_cast<int>(seed));
+        bool closed = true;
+        for (size_t q = 0; q < queue.size(); ++q) {
+            int f = queue[q];
+            for (int c = face_offsets[f]; c < face_offsets[f + 1]; ++c) {
+                int e = corner_edges[c];
+                if (e < 0) continue;
+                int valence = edge_face_offsets[e + 1] - edge_face_offsets[e];
+                if (valence != 2) {
+                    closed = false;
+                    continue;
+                }
+                int g = edge_faces[edge_face_offsets[e]];
+                if (g == f) g = edge_faces[edge_face_offsets[e] + 1];
+                if (g == f || component[g] >= 0) continue;
+                int dir_f = edgeDirection(f, e) * (flipped[f] ? -1 : 1);
+                int dir_g = edgeDirection(g, e);
+                flipped[g] = (dir_f == dir_g) ? 1 : 0;
+                component[g] = comp;
+                queue.push_back(g);
+            }
+        }
+
+        if (!closed) continue;
+        // 封闭分量：有向体积为负时整体翻转
+        double volume = 0.0;
+        for (int f : queue) {
+            int begin = face_offsets[f];
+            int end = face_offsets[f + 1];
+            if (end - begin < 3) continue;
+            const Point3D& p0 = *vertices[face_vertices[begin]];
+            for (int c = begin + 1; c + 1 < end; ++c) {
+                const Point3D& p1 = *vertices[face_vertices[c]];
+                const Point3D& p2 = *vertices[face_vertices[c + 1]];
+                double tri = p0.x * (p1.y * p2.z - p1.z * p2.y) -
+                             p0.y * (p1.x * p2.z - p1.z * p2.x) +
+                             p0.z * (p1.x * p2.y - p1.y * p2.x);
+                volume += flipped[f] ? -tri : tri;
+            }
+        }
+        if (volume < 0.0) {
+            for (int f : queue) {
+                flipped[f] = flipped[f] ? 0 : 1;
+            }
+        }
+    }
+
+    // 翻转面环：保持首顶点不变，其余顶点逆序；角点边整体逆序
+    for (size_t f = 0; f < face_count; ++f) {
+        if (!flipped[f]) continue;
+        int begin = face_offsets[f];
+        int end = face_offsets[f + 1];
+        if (end - begin < 3) continue;
+        std::reverse(face_vertices.begin() + begin + 1, face_vertices.begin() + end);
+        std::reverse(corner_edges.begin() + begin, corner_edges.begin() + end);
+    }
+}
+
+/**
+ * @brief 构建顶点→面邻接
+ */
+void MeshTopology::buildVertexFaces() {
+    size_t vertex_count = vertex_index.size();
+    vertex_face_offsets.assign(vertex_count + 1, 0);
+    for (int v : face_vertices) {
+        ++vertex_face_offsets[v + 1];
+    }
+    for (size_t v = 0; v < vertex_count; ++v) {
+        vertex_face_offsets[v + 1] += vertex_face_offsets[v];
+    }
+    vertex_faces.assign(face_vertices.size(), -1);
+    vertex_face_corners.assign(face_vertices.size(), -1);
+    std::vector<int> fill(vertex_face_offsets.begin(), vertex_face_offsets.end() - 1);
+    for (size_t f = 0; f + 1 < face_offsets.size(); ++f) {
+        for (int c = face_offsets[f]; c < face_offsets[f + 1]; ++c) {
+            int slot = fill[face_vertices[c]]++;
+            vertex_faces[slot] = static_cast<int>(f);
+            vertex_face_corners[slot] = c;
+        }
+    }
+}
+
+/**
+ * @brief 对面顶点环做三角剖分
+ *
+ * 面环按法向主轴投影到二维：凸面直接扇形三角化，凹面（如凹轮廓拉伸的端面）做耳切，
+ * 三角形顶点顺序与面环一致
+ */
+void MeshTopology::buildTriangles(const ModelManager& manager) {
+    const auto& vertices = manager.getVertices();
+    std::vector<double> px, py;
+    std::vector<int> prev, next;
+    for (size_t f = 0; f + 1 < face_offsets.size(); ++f) {
+        int begin = face_offsets[f];
+        int end = face_offsets[f + 1];
+        int n = end - begin;
+        if (n < 3) continue;
+
+        // 按Newell法向的主轴投影到二维，并使面环在投影平面内为逆时针
+        double normal[3] = {0.0, 0.0, 0.0};
+        for (int c = begin; c < end; ++c) {
+            const Point3D& a = *vertices[face_vertices[c]];
+            const Point3D& b = *vertices[face_vertices[c + 1 < end ? c + 1 : begin]];
+            normal[0] += (a.y - b.y) * (a.z + b.z);
+            normal[1] += (a.z - b.z) * (a.x + b.x);
+            normal[2] += (a.x - b.x) * (a.y + b.y);
+        }
+        int axis = 2;
+        if (std::fabs(normal[0]) >= std::fabs(normal[1]) && std::fabs(normal[0]) >= std::fabs(normal[2])) {
+            axis = 0;
+        } else if (std::fabs(normal[1]) >= std::fabs(normal[2])) {
+            axis = 1;
+        }
+        int u_axis = (axis + 1) % 3;
+        int v_axis = (axis + 2) % 3;
+        double sign = normal[axis] < 0.0 ? -1.0 : 1.0;
+        px.resize(n);
+        py.resize(n);
+        bool convex = true;
+        for (int k = 0; k < n; ++k) {
+            const Point3D& p = *vertices[face_vertices[begin + k]];
+            double coords[3] = {p.x, p.y, p.z};
+            px[k] = coords[u_axis];
+            py[k] = sign * coords[v_axis];
+        }
+        for (int k = 0; k < n && convex; ++k) {
+            int a = k > 0 ? k - 1 : n - 1;
+            int b = k + 1 < n ? k + 1 : 0;
+            convex = cross2(px[a], py[a], px[k], py[k], px[b], py[b]) >= 0.0;
+        }
+        if (convex) {
+            for (int c = begin + 1; c + 1 < end; ++c) {
+                triangle_vertices.push_back(face_vertices[begin]);
+                triangle_vertices.push_back(face_vertices[c]);
+                triangle_vertices.push_back(face_vertices[c + 1]);
+                triangle_faces.push_back(static_cast<int>(f));
+            }
+            continue;
+        }
+
+        // 凹多边形耳切：凸角且三角形内不含其他剩余顶点即为耳
+        prev.resize(n);
+        next.resize(n);
+        for (int k = 0; k < n; ++k) {
+            prev[k] = k > 0 ? k - 1 : n - 1;
+            next[k] = k + 1 < n ? k + 1 : 0;
+        }
+        int remaining = n;
+        int current = 0;
+        int misses = 0;
+        while (remaining > 3) {
+            int a = prev[current];
+            int b = next[current];
+            bool ear = cross2(px[a], py[a], px[current], py[current], px[b], py[b]) > 0.0;
+            for (int k = next[b]; ear && k != a; k = next[k]) {
+                ear = !insideTriangle(px[k], py[k], px[a], py[a], px[current], py[current], px[b], py[b]);
+            }
+            // 退化面找不到耳时依次切去当前角，保证终止
+            if (ear || misses >= remaining) {
+                triangle_vertices.push_back(face_vertices[begin + a]);
+                triangle_vertices.push_back(face_vertices[begin + current]);
+                triangle_vertices.push_back(face_vertices[begin + b]);
+                triangle_faces.push_back(static_cast<int>(f));
+                next[a] = b;
+                prev[b] = a;
+                --remaining;
+                misses = 0;
+                current = a;
+            } else {
+                ++misses;
+                current = b;
+            }
+        }
+        int a = prev[current];
+        int b = next[current];
+        triangle_vertices.push_back(face_vertices[begin + a]);
+        triangle_vertices.push_back(face_vertices[begin + current]);
+        triangle_vertices.push_back(face_vertices[begin + b]);
+        triangle_faces.push_back(static_cast<int>(f));
+    }
+}
@@ -0,0 +1,180 @@
+#include "model_fingerprint.h"
+#include "detail/hash_mix.h"
+#include "mesh_topology.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+const uint64_t kSeeds[2] = {0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL};
+
+/**
+ * @brief 坐标规范化为64位整数：精确模式取位模式（负零归零），量化模式取网格编号
+ */
+inline uint64_t coordinateKey(double value, double inverse_tolerance) {
+    if (inverse_tolerance > 0.0) {
+        return static_cast<uint64_t>(static_cast<int64_t>(std::llround(value * inverse_tolerance)));
+    }
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief 顶点环的规范化哈希：从哈希最小的顶点起，取正反两个走向中较小的结果
+ */
+uint64_t loopHash(const uint64_t* vertex_hashes, const int* loop, int n, uint64_t seed) {
+    int start = 0;
+    for (int i = 1; i < n; ++i) {
+        if (vertex_hashes[loop[i]] < vertex_hashes[loop[start]]) {
+            start = i;
+        }
+    }
+    uint64_t forward = seed ^ static_cast<uint64_t>(n);
+    uint64_t backward = forward;
+    for (int i = 0; i < n; ++i) {
+        forward = detail::mix(forward ^ vertex_hashes[loop[(start + i) % n]]);
+        backward = detail::mix(backward ^ vertex_hashes[loop[(start - i + n) % n]]);
+    }
+    return std::min(forward, backward);
+}
+
+} // namespace
+
+/**
+ * @brief 32个字符的十六进制表示
+ */
+std::string Fingerprint::hex() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(32, '0');
+    for (int lane = 0; lane < 2; ++lane) {
+        for (int i = 0; i < 16; ++i) {
+            text[lane * 16 + i] = digits[(hash[lane] >> (60 - 4 * i)) & 15];
+        }
+    }
+    return text;
+}
+
+/**
+ * @brief 计算模型指纹
+ * 
+ * 顶点哈希与面哈希均按块计算，各块的部分和按线程累加后相加合并
+ * 
+ * @param manager 模型管理器
+ * @param tolerance 量化容差
+ * @param parallel 是否按面并行
+ * @return Fingerprint 模型指纹
+ */
+Fingerprint ModelFingerprint::compute(const ModelManager& manager, double tolerance, bool parallel) {
+    const auto& vertices = manager.getVertices();
+    auto topology = manager.getMeshTopology();
+    double inverse_tolerance = tolerance > 0.0 ? 1.0 / tolerance : 0.0;
+    size_t vertex_count = vertices.size();
+    size_t face_count = topology->faceCount();
+    
+    // 每个顶点两条独立的哈希通道
+    std::vector<uint64_t> vertex_hashes(2 * vertex_count);
+    auto hashVertices = [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            uint64_t qx = coordinateKey(vertices[v]->x, inverse_tolerance);
+            uint64_t qy = coordinateKey(vertices[v]->y, inverse_tolerance);
+            uint64_t qz = coordinateKey(vertices[v]->z, inverse_tolerance);
+            for (int lane = 0; lane < 2; ++lane) {
+                vertex_hashes[lane * vertex_count + v] =
+                    detail::mix(qz ^ detail::mix(qy ^ detail::mix(qx ^ kSeeds[lane])));
+            }
+        }
+    };
+    
+    unsigned workers = parallel ? ParallelUtils::threadCount() : 1;
+    std::vector<uint64_t> partial(2 * workers, 0);
+    auto hashFaces = [&](size_t begin, size_t end, unsigned worker) {
+        uint64_t sum[2] = {0, 0};
+        for (size_t f = begin; f < end; ++f) {
+            int first = topology->face_offsets[f];
+            int n = topology->face_offsets[f + 1] - first;
+            const int* loop = topology->face_vertices.data() + first;
+            for (int lane = 0; lane < 2; ++lane) {
+                uint64_t face = n > 0 ? loopHash(&vertex_hashes[lane * vertex_count], loop, n, kSeeds[lane]) : kSeeds[lane];
+                sum[lane] += detail::mix(face);
+            }
+        }
+        partial[2 * worker] += sum[0];
+        partial[2 * worker + 1] += sum[1];
+    };
+    
+    if (parallel) {
+        ParallelUtils::parallelFor(vertex_count, 4096, hashVertices);
+        ParallelUtils::parallelForWithWorker(face_count, 1024, hashFaces);
+    } else {
+        hashVertices(0, vertex_count);
+        hashFaces(0, face_count, 0);
+    }
+    
+    Fingerprint fingerprint;
+    fingerprint.vertex_count = vertex_count;
+    fingerprint.face_count = face_count;
+    for (unsigned w = 0; w < workers; ++w) {
+        fingerprint.hash[0] += partial[2 * w];
+        fingerprint.hash[1] += partial[2 * w + 1];
+    }
+    // 混入数量，使不含面的模型也能区分
+    fingerprint.hash[0] = detail::mix(fingerprint.hash[0] ^ detail::mix(vertex_count));
+    fingerprint.hash[1] = detail::mix(fingerprint.hash[1] ^ detail::mix(face_count ^ kSeeds[1]));
+    return fingerprint;
+}
+
+/**
+ * @brief 查找重复模型
+ * 
+ * @param models 模型列表
+ * @param tolerance 量化容差
+ * @return std::vector<std::vector<size_t>> 重复组
+ */
+std::vector<std::vector<size_t>> ModelFingerprint::findDuplicates(const std::vector<std::shared_ptr<const ModelManager>>& models,
+                                                                  double tolerance) {
+    std::vector<Fingerprint> fingerprints(models.size());
+    // 模型间并行，单个模型内串行，避免嵌套创建线程
+    ParallelUtils::parallelFor(models.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (models[i]) {
+                fingerprints[i] = compute(*models[i], tolerance, false);
+            }
+        }
+    });
+    return groupDuplicates(fingerprints);
+}
+
+/**
+ * @brief 按已计算的指纹分组
+ * 
+ * @param fingerprints 指纹列表
+ * @return std::vector<std::vector<size_t>> 重复组
+ */
+std::vector<std::vector<size_t>> ModelFingerprint::groupDuplicates(const std::vector<Fingerprint>& fingerprints) {
+    std::unordered_map<Fingerprint, size_t, FingerprintHasher> first_index;
+    first_index.reserve(fingerprints.size());
+    std::unordered_map<size_t, size_t> group_of; // 首个模型索引到组序号
+    std::vector<std::vector<size_t>> groups;
+    for (size_t i = 0; i < fingerprints.size(); ++i) {
+        auto inserted = first_index.insert(std::make_pair(fingerprints[i], i));
+        if (inserted.second) {
+            continue;
+        }
+        size_t first = inserted.first->second;
+        auto it = group_of.find(first);
+        if (it == group_of.end()) {
+            group_of[first] = groups.size();
+            groups.push_back(std::vector<size_t>(1, first));
+            it = group_of.find(first);
+        }
+        groups[it->second].push_back(i);
+    }
+    return groups;
+}
@@ -0,0 +1,420 @@
+#include "model_io.h"
+#include "mesh_topology.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+namespace {
+
+/**
+ * @brief 跳过空白字符（不跨行）
+ */
+const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+/**
+ * @brief 原生二进制格式文件头
+ */
+struct BinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t vertex_count;
+    uint64_t face_count;
+    uint64_t index_count;
+};
+
+const uint32_t kBinaryVersion = 1;
+
+} // namespace
+
+/**
+ * @brief 从内存缓冲区解析OBJ
+ * 
+ * 先解析到局部缓冲区，整个文件有效后才写入模型，解析失败时模型保持不变
+ * 
+ * @param data 文件内容
+ * @param size 内容字节数
+ * @param manager 模型管理器
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelIO::parseOBJ(const char* data, size_t size, ModelManager& manager, std::string* error) {
+    const char* p = data;
+    const char* end = data + size;
+    int line_number = 0;
+    std::vector<double> coordinates;  // 顶点坐标，每3个一组
+    std::vector<int> face_indices;    // 面的顶点序号（从0起）
+    std::vector<size_t> face_offsets(1, 0);
+    std::string token;
+    
+    while (p < end) {
+        ++line_number;
+        const char* line_end = p;
+        while (line_end < end && *line_end != '\n') ++line_end;
+        p = skipSpaces(p, line_end);
+        
+        if (p + 1 < line_end && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+            // 顶点：v x y z
+            token.assign(p + 2, line_end);
+            char* cursor = &token[0];
+            double c[3];
+            for (int k = 0; k < 3; ++k) {
+                char* next = nullptr;
+                c[k] = std::strtod(cursor, &next);
+                if (next == cursor) {
+                    if (error) *error = "第" + std::to_string(line_number) + "行顶点坐标无效";
+                    return false;
+                }
+                cursor = next;
+            }
+            coordinates.insert(coordinates.end(), c, c + 3);
+        } else if (p + 1 < line_end && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            // 面：f a b c ...，支持 a/b/c 形式与负索引
+            int vertex_count = static_cast<int>(coordinates.size() / 3);
+            size_t face_begin = face_indices.size();
+            const char* q = p + 2;
+            while (q < line_end) {
+                q = skipSpaces(q, line_end);
+                if (q >= line_end) break;
+                char* next = nullptr;
+                long index = std::strtol(q, &next, 10);
+                if (next == q || index == 0) {
+                    if (error) *error = "第" + std::to_string(line_number) + "行面索引无效";
+                    return false;
+                }
+                int resolved = index > 0 ? static_cast<int>(index) - 1 : vertex_count + static_cast<int>(index);
+                if (resolved < 0 || resolved >= vertex_count) {
+                    if (error) *error = "第" + std::to_string(line_number) + "行面索引越界";
+                    return false;
+                }
+                face_indices.push_back(resolved);
+                q = next;
+                while (q < line_end && *q != ' ' && *q != '\t') ++q;
+            }
+            if (face_indices.size() - face_begin >= 3) {
+                face_offsets.push_back(face_indices.size());
+            } else {
+                face_indices.resize(face_begin);
+            }
+        }
+        p = line_end < end ? line_end + 1 : end;
+    }
+    
+    size_t vertex_count = coordinates.size() / 3;
+    int vertex_base = manager.nextVertexId();
+    manager.reserveVertices(manager.getVertices().size() + vertex_count);
+    for (size_t i = 0; i < vertex_count; ++i) {
+        manager.addVertex(vertex_base + static_cast<int>(i),
+                          coordinates[3 * i], coordinates[3 * i + 1], coordinates[3 * i + 2]);
+    }
+    
+    int face_id = manager.nextFaceId();
+    manager.reserveFaces(manager.getFaces().size() + face_offsets.size() - 1);
+    std::vector<int> loop;
+    for (size_t face = 0; face + 1 < face_offsets.size(); ++face) {
+        loop.clear();
+        for (size_t c = face_offsets[face]; c < face_offsets[face + 1]; ++c) {
+            loop.push_back(vertex_base + face_indices[c]);
+        }
+        manager.addFaceFromVertices(face_id++, loop);
+    }
+    return true;
+}
+
+/**
+ * @brief 读取整个文件到字符串
+ * 
+ * @param path 文件路径
+ * @param content 输出文件内容
+ * @return bool 是否成功
+ */
+bool ModelIO::readFile(const std::string& path, std::string& content) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+/**
+ * @brief 读取OBJ文件
+ * 
+ * @param path 文件路径
+ * @param manager 模型管理器
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelIO::loadOBJ(const std::string& path, ModelManager& manager, std::string* error) {
+    std::string content;
+    if (!readFile(path, content)) {
+        if (error) *error = "无法打开文件: " + path;
+        return false;
+    }
+    return parseOBJ(content.data(), content.size(), manager, error);
+}
+
+/**
+ * @brief 写出OBJ文件
+ * 
+ * @param path 文件路径
+ * @param manager 模型管理器
+ * @return bool 是否成功
+ */
+bool ModelIO::saveOBJ(const std::string& path, const ModelManager& manager) {
+    std::ofstream file(path.c_str());
+    if (!file) {
+        return false;
+    }
+    file.precision(17);
+    for (const auto& v : manager.getVertices()) {
+        file << "v " << v->x << " " << v->y << " " << v->z << "\n";
+    }
+    auto topology = manager.getMeshTopology();
+    for (size_t f = 0; f < topology->faceCount(); ++f) {
+        int first = topology->face_offsets[f];
+        int last = topology->face_offsets[f + 1];
+        if (last - first < 3) continue;
+        file << "f";
+        for (int c = first; c < last; ++c) {
+            file << " " << topology->face_vertices[c] + 1;
+        }
+        file << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief 从内存缓冲区解析原生二进制格式
+ * 
+ * 先校验文件头、长度、面偏移与索引（保留ID时还校验ID冲突），全部通过后才写入模型，
+ * 解析失败时模型保持不变
+ * 
+ * @param data 文件内容
+ * @param size 内容字节数
+ * @param manager 模型管理器
+ * @param error 可选的错误信息输出
+ * @param keep_vertex_ids 是否保留文件中的顶点ID
+ * @return bool 是否成功
+ */
+bool ModelIO::parseBinary(const char* data, size_t size, ModelManager& manager, std::string* error,
+                          bool keep_vertex_ids) {
+    BinaryHeader header;
+    if (size < sizeof(header)) {
+        if (error) *error = "二进制文件头不完整";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, "CADM", 4) != 0 || header.version != kBinaryVersion) {
+        if (error) *error = "不是受支持的二进制模型文件";
+        return false;
+    }
+    uint64_t n = header.vertex_count;
+    uint64_t f = header.face_count;
+    uint64_t k = header.index_count;
+    uint64_t expected = sizeof(header) + n * (3 * sizeof(double) + sizeof(int32_t)) +
+                        (f + 1) * sizeof(uint32_t) + k * sizeof(uint32_t);
+    if (n > size || f > size || k > size || expected != size) {
+        if (error) *error = "二进制文件长度与文件头不符";
+        return false;
+    }
+    
+    // 各段均按自然对齐写出，但输入缓冲区本身可能未对齐，逐值memcpy读取
+    const char* xs = data + sizeof(header);
+    const char* ys = xs + n * sizeof(double);
+    const char* zs = ys + n * sizeof(double);
+    const char* ids = zs + n * sizeof(double);
+    const char* offsets = ids + n * sizeof(int32_t);
+    const char* indices = offsets + (f + 1) * sizeof(uint32_t);
+    
+    // 校验面偏移与索引
+    uint32_t begin;
+    std::memcpy(&begin, offsets, sizeof(uint32_t));
+    for (size_t face = 0; face < f; ++face) {
+        uint32_t end;
+        std::memcpy(&end, offsets + (face + 1) * sizeof(uint32_t), sizeof(uint32_t));
+        if (end < begin || end > k) {
+            if (error) *error = "二进制文件面偏移无效";
+            return false;
+        }
+        for (uint32_t c = begin; c < end; ++c) {
+            uint32_t index;
+            std::memcpy(&index, indices + c * sizeof(uint32_t), sizeof(uint32_t));
+            if (index >= n) {
+                if (error) *error = "二进制文件面顶点索引越界";
+                return false;
+            }
+        }
+        begin = end;
+    }
+    
+    // 确定顶点ID：默认与parseOBJ相同，从nextVertexId()起依次编号，不会与已有顶点合并
+    std::vector<int> vertex_ids(static_cast<size_t>(n));
+    int vertex_base = manager.nextVertexId();
+    std::unordered_set<int> seen;
+    for (size_t i = 0; i < n; ++i) {
+        if (!keep_vertex_ids) {
+            vertex_ids[i] = vertex_base + static_cast<int>(i);
+            continue;
+        }
+        int32_t id;
+        std::memcpy(&id, ids + i * sizeof(int32_t), sizeof(int32_t));
+        if (!seen.insert(id).second || manager.getVertex(id)) {
+            if (error) *error = "二进制文件顶点ID重复或与已有顶点冲突: " + std::to_string(id);
+            return false;
+        }
+        vertex_ids[i] = id;
+    }
+    
+    manager.reserveVertices(manager.getVertices().size() + static_cast<size_t>(n));
+    for (size_t i = 0; i < n; ++i) {
+        double x, y, z;
+        std::memcpy(&x, xs + i * sizeof(double), sizeof(double));
+        std::memcpy(&y, ys + i * sizeof(double), sizeof(double));
+        std::memcpy(&z, zs + i * sizeof(double), sizeof(double));
+        manager.addVertex(vertex_ids[i], x, y, z);
+    }
+    
+    int face_id = manager.nextFaceId();
+    manager.reserveFaces(manager.getFaces().size() + static_cast<size_t>(f));
+    std::vector<int> loop;
+    std::memcpy(&begin, offsets, sizeof(uint32_t));
+    for (size_t face = 0; face < f; ++face) {
+        uint32_t end;
+        std::memcpy(&end, offsets + (face + 1) * sizeof(uint32_t), sizeof(uint32_t));
+        loop.clear();
+        for (uint32_t c = begin; c < end; ++c) {
+            uint32_t index;
+            std::memcpy(&index, indices + c * sizeof(uint32_t), sizeof(uint32_t));
+            loop.push_back(vertex_ids[index]);
+        }
+        if (loop.size() >= 3) {
+            manager.addFaceFromVertices(face_id++, loop);
+        }
+        begin = end;
+    }
+    return true;
+}
+
+/**
+ * @brief 读取原生二进制文件
+ * 
+ * @param path 文件路径
+ * @param manager 模型管理器
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelIO::loadBinary(const std::string& path, ModelManager& manager, std::string* error) {
+    std::string content;
+    if (!readFile(path, content)) {
+        if (error) *error = "无法打开文件: " + path;
+        return false;
+    }
+    return parseBinary(content.data(), content.size(), manager, error);
+}
+
+/**
+ * @brief 将模型编码为原生二进制格式
+ * 
+ * @param manager 模型管理器
+ * @param buffer 输出编码结果
+ */
+void ModelIO::encodeBinary(const ModelManager& manager, std::string& buffer) {
+    const auto& vertices = manager.getVertices();
+    auto topology = manager.getMeshTopology();
+    size_t n = vertices.size();
+    size_t f = topology->faceCount();
+    size_t k = topology->face_vertices.size();
+    
+    BinaryHeader header;
+    std::memcpy(header.magic, "CADM", 4);
+    header.version = kBinaryVersion;
+    header.vertex_count = n;
+    header.face_count = f;
+    header.index_count = k;
+    buffer.resize(sizeof(header) + n * (3 * sizeof(double) + sizeof(int32_t)) + (f + 1 + k) * sizeof(uint32_t));
+    
+    char* out = &buffer[0];
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    for (int axis = 0; axis < 3; ++axis) {
+        for (size_t i = 0; i < n; ++i) {
+            double value = axis == 0 ? vertices[i]->x : (axis == 1 ? vertices[i]->y : vertices[i]->z);
+            std::memcpy(out, &value, sizeof(double));
+            out += sizeof(double);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        int32_t id = vertices[i]->id;
+        std::memcpy(out, &id, sizeof(int32_t));
+        out += sizeof(int32_t);
+    }
+    for (size_t i = 0; i <= f; ++i) {
+        uint32_t offset = static_cast<uint32_t>(topology->face_offsets[i]);
+        std::memcpy(out, &offset, sizeof(uint32_t));
+        out += sizeof(uint32_t);
+    }
+    for (size_t i = 0; i < k; ++i) {
+        uint32_t index = static_cast<uint32_t>(topology->face_vertices[i]);
+        std::memcpy(out, &index, sizeof(uint32_t));
+        out += sizeof(uint32_t);
+    }
+}
+
+/**
+ * @brief 写出原生二进制文件
+ * 
+ * @param path 文件路径
+ * @param manager 模型管理器
+ * @return bool 是否成功
+ */
+bool ModelIO::saveBinary(const std::string& path, const ModelManager& manager) {
+    std::ofstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string buffer;
+    encodeBinary(manager, buffer);
+    file.write(buffer.data(), buffer.size());
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief 判断路径是否为原生二进制格式
+ */
+bool ModelIO::isBinaryPath(const std::string& path) {
+    const std::string extension = ".cadm";
+    return path.size() >= extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief 按扩展名读取模型
+ * 
+ * @param path 文件路径
+ * @param manager 模型管理器
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelIO::load(const std::string& path, ModelManager& manager, std::string* error) {
+    return isBinaryPath(path) ? loadBinary(path, manager, error) : loadOBJ(path, manager, error);
+}
+
+/**
+ * @brief 按扩展名写出模型
+ * 
+ * @param path 文件路径
+ * @param manager 模型管理器
+ * @return bool 是否成功
+ */
+bool ModelIO::save(const std::string& path, const ModelManager& manager) {
+    return isBinaryPath(path) ? saveBinary(path, manager) : saveOBJ(path, manager);
+}
@@ -1,10 +1,28 @@
 #include "model_manager.h"
+#include "mesh_topology.h"
+#include "geometry_algorithm.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief 生成顶点ID对的无向查找键
+ */
+uint64_t makeVertexPairKey(int a, int b) {
+    uint32_t lo = static_cast<uint32_t>(std::min(a, b));
+    uint32_t hi = static_cast<uint32_t>(std::max(a, b));
+    return (static_cast<uint64_t>(lo) << 32) | hi;
+}
+
+} // namespace
 
 /**
  * @brief 构造函数
  */
-ModelManager::ModelManager() {
-    // 初始化时不需要特殊操作
+ModelManager::ModelManager()
+    : max_vertex_id(0), max_edge_id(0), max_face_id(0),
+      topology_version(1), geometry_version(1),
+      topology_cache_version(0), normals_cache_version(0) {
 }
 
 /**
@@ -14,6 +32,96 @@ ModelManager::~ModelManager() {
     // 智能指针会自动管理内存，不需要手动释放
 }
 
+/**
+ * @brief 拷贝构造函数
+ * 
+ * @param other 源模型
+ */
+ModelManager::ModelManager(const ModelManager& other)
+    : max_vertex_id(0), max_edge_id(0), max_face_id(0),
+      topology_version(1), geometry_version(1),
+      topology_cache_version(0), normals_cache_version(0) {
+    std::lock_guard<std::mutex> lock(other.cache_mutex);
+    copyFrom(other);
+}
+
+/**
+ * @brief 拷贝赋值
+ * 
+ * @param other 源模型
+ * @return ModelManager& 自身引用
+ */
+ModelManager& ModelManager::operator=(const ModelManager& other) {
+    if (this != &other) {
+        std::unique_lock<std::mutex> lock_this(cache_mutex, std::defer_lock);
+        std::unique_lock<std::mutex> lock_other(other.cache_mutex, std::defer_lock);
+        std::lock(lock_this, lock_other);
+        copyFrom(other);
+    }
+    return *this;
+}
+
+/**
+ * @brief 复制模型数据（调用方持有源模型的缓存锁）
+ * 
+ * 顶点、边、面逐个复制，映射表指向与向量中相同的副本
+ * 
+ * @param other 源模型
+ */
+void ModelManager::copyFrom(const ModelManager& other) {
+    vertices.clear();
+    edges.clear();
+    faces.clear();
+    vertex_map.clear();
+    edge_map.clear();
+    face_map.clear();
+    vertices.reserve(other.vertices.size());
+    vertex_map.reserve(other.vertex_map.size());
+    for (const auto& v : other.vertices) {
+        auto copy = std::make_shared<Point3D>(*v);
+        vertices.push_back(copy);
+        vertex_map[copy->id] = copy;
+    }
+    // 向量与映射表引用同一对象，按原指针对应到副本
+    std::unordered_map<const Edge*, std::shared_ptr<Edge>> edge_copies;
+    edge_copies.reserve(other.edges.size());
+    edges.reserve(other.edges.size());
+    for (const auto& e : other.edges) {
+        auto copy = std::make_shared<Edge>(*e);
+        edge_copies[e.get()] = copy;
+        edges.push_back(copy);
+    }
+    edge_map.reserve(other.edge_map.size());
+    for (const auto& entry : other.edge_map) {
+        auto it = edge_copies.find(entry.second.get());
+        edge_map[entry.first] = it != edge_copies.end() ? it->second : std::make_shared<Edge>(*entry.second);
+    }
+    std::unordered_map<const Face*, std::shared_ptr<Face>> face_copies;
+    face_copies.reserve(other.faces.size());
+    faces.reserve(other.faces.size());
+    for (const auto& f : other.faces) {
+        auto copy = std::make_shared<Face>(*f);
+        face_copies[f.get()] = copy;
+        faces.push_back(copy);
+    }
+    face_map.reserve(other.face_map.size());
+    for (const auto& entry : other.face_map) {
+        auto it = face_copies.find(entry.second.get());
+        face_map[entry.first] = it != face_copies.end() ? it->second : std::make_shared<Face>(*entry.second);
+    }
+    edge_lookup = other.edge_lookup;
+    max_vertex_id = other.max_vertex_id;
+    max_edge_id = other.max_edge_id;
+    max_face_id = other.max_face_id;
+    topology_version = other.topology_version;
+    geometry_version = other.geometry_version;
+    topology_cache = other.topology_cache;
+    topology_cache_version = other.topology_cache_version;
+    normals_cache = other.normals_cache;
+    normals_cache_version = other.normals_cache_version;
+    attribute_channels = other.attribute_channels;
+}
+
 /**
  * @brief 添加顶点
  * 
@@ -37,6 +145,9 @@ std::shared_ptr<Point3D> ModelManager::addVertex(int id, double x, double y, dou
     // 添加到映射和向量中
     vertex_map[id] = vertex;
     vertices.push_back(vertex);
+    max_vertex_id = std::max(max_vertex_id, id);
+    ++topology_version;
+    ++geometry_version;
     
     return vertex;
 }
@@ -69,6 +180,10 @@ std::shared_ptr<Edge> ModelManager::addEdge(int id, int start_id, int end_id) {
     // 添加到映射和向量中
     edge_map[id] = edge;
     edges.push_back(edge);
+    edge_lookup.insert(std::make_pair(makeVertexPairKey(start_id, end_id), id));
+    max_edge_id = std::max(max_edge_id, id);
+    ++topology_version;
+    ++geometry_version;
     
     return edge;
 }
@@ -102,10 +217,58 @@ std::shared_ptr<Face> ModelManager::addFace(int id, const std::vector<int>& edge
     // 添加到映射和向量中
     face_map[id] = face;
     faces.push_back(face);
+    max_face_id = std::max(max_face_id, id);
+    ++topology_version;
+    ++geometry_version;
     
     return face;
 }
 
+/**
+ * @brief 按顶点ID环添加面
+ * 
+ * @param id 面ID
+ * @param vertex_ids 按面方向排列的顶点ID环
+ * @return std::shared_ptr<Face> 添加的面智能指针，顶点不存在时返回nullptr
+ */
+std::shared_ptr<Face> ModelManager::addFaceFromVertices(int id, const std::vector<int>& vertex_ids) {
+    auto it = face_map.find(id);
+    if (it != face_map.end()) {
+        return it->second;
+    }
+    
+    std::vector<int> edge_ids;
+    edge_ids.reserve(vertex_ids.size());
+    for (size_t i = 0; i < vertex_ids.size(); ++i) {
+        int a = vertex_ids[i];
+        int b = vertex_ids[(i + 1) % vertex_ids.size()];
+        int edge_id = findEdge(a, b);
+        if (edge_id < 0) {
+            edge_id = nextEdgeId();
+            if (!addEdge(edge_id, a, b)) {
+                return nullptr;
+            }
+        }
+        edge_ids.push_back(edge_id);
+    }
+    return addFace(id, edge_ids);
+}
+
+/**
+ * @brief 查找连接两个顶点的边
+ * 
+ * @param vertex_a 顶点ID
+ * @param vertex_b 顶点ID
+ * @return int 边ID，不存在时返回-1
+ */
+int ModelManager::findEdge(int vertex_a, int vertex_b) const {
+    auto it = edge_lookup.find(makeVertexPairKey(vertex_a, vertex_b));
+    if (it != edge_lookup.end()) {
+        return it->second;
+    }
+    return -1;
+}
+
 /**
  * @brief 通过ID获取顶点
  * 
@@ -201,3 +364,122 @@ void ModelManager::reserveEdges(size_t size) {
 void ModelManager::reserveFaces(size_t size) {
     faces.reserve(size);
 }
+
+/**
+ * @brief 估算模型占用的内存字节数
+ * 
+ * @return size_t 估算字节数
+ */
+size_t ModelManager::estimateMemoryUsage() const {
+    // 智能指针控制块与对象同块分配；哈希映射按每个节点一个指针槽加节点本身估算
+    const size_t shared_overhead = 2 * sizeof(void*) + sizeof(std::shared_ptr<int>);
+    const size_t map_overhead = 4 * sizeof(void*) + sizeof(int);
+    size_t bytes = 0;
+    bytes += vertices.capacity() * sizeof(std::shared_ptr<Point3D>);
+    bytes += vertices.size() * (sizeof(Point3D) + shared_overhead + map_overhead);
+    bytes += edges.capacity() * sizeof(std::shared_ptr<Edge>);
+    bytes += edges.size() * (sizeof(Edge) + shared_overhead + 2 * map_overhead);
+    bytes += faces.capacity() * sizeof(std::shared_ptr<Face>);
+    for (const auto& face : faces) {
+        bytes += sizeof(Face) + shared_overhead + map_overhead;
+        bytes += face->edge_ids.capacity() * sizeof(int);
+    }
+    return bytes;
+}
+
+/**
+ * @brief 修改顶点坐标
+ * 
+ * @param id 顶点ID
+ * @param x x坐标
+ * @param y y坐标
+ * @param z z坐标
+ * @return bool 顶点是否存在
+ */
+bool ModelManager::setVertexPosition(int id, double x, double y, double z) {
+    auto vertex = getVertex(id);
+    if (!vertex) {
+        return false;
+    }
+    vertex->x = x;
+    vertex->y = y;
+    vertex->z = z;
+    ++geometry_version;
+    return true;
+}
+
+/**
+ * @brief 标记几何已修改
+ */
+void ModelManager::markGeometryModified() {
+    ++geometry_version;
+}
+
+/**
+ * @brief 获取网格拓扑邻接结构
+ * 
+ * @return std::shared_ptr<const MeshTopology> 拓扑邻接结构
+ */
+std::shared_ptr<const MeshTopology> ModelManager::getMeshTopology() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    // 面朝向与三角剖分依赖坐标，按几何版本号（拓扑变化时同样递增）缓存
+    if (!topology_cache || topology_cache_version != geometry_version) {
+        topology_cache = std::make_shared<MeshTopology>(*this);
+        topology_cache_version = geometry_version;
+    }
+    return topology_cache;
+}
+
+/**
+ * @brief 获取顶点法向
+ * 
+ * @param weighting 权重方式
+ * @param crease_angle 折角阈值（弧度）
+ * @return std::shared_ptr<const VertexNormals> 顶点法向数据
+ */
+std::shared_ptr<const VertexNormals> ModelManager::getVertexNormals(NormalWeighting weighting, double crease_angle) const {
+    auto topology = getMeshTopology();
+    
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (normals_cache && normals_cache_version == geometry_version &&
+        normals_cache->weighting == weighting && normals_cache->crease_angle == crease_angle) {
+        return normals_cache;
+    }
+    
+    auto normals = std::make_shared<VertexNormals>(
+        GeometryAlgorithm::calculateVertexNormals(*this, *topology, weighting, crease_angle));
+    normals_cache = normals;
+    normals_cache_version = geometry_version;
+    return normals_cache;
+}
+
+/**
+ * @brief 设置属性通道
+ * 
+ * @param domain 属性所属几何域
+ * @param name 通道名称
+ * @param values 逐元素数值
+ */
+void ModelManager::setAttributeChannel(AttributeDomain domain, const std::string& name, std::vector<double> values) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    AttributeChannel channel;
+    channel.values = std::make_shared<const std::vector<double>>(std::move(values));
+    channel.geometry_version = geometry_version;
+    attribute_channels[std::make_pair(static_cast<int>(domain), name)] = channel;
+}
+
+/**
+ * @brief 获取属性通道
+ * 
+ * @param domain 属性所属几何域
+ * @param name 通道名称
+ * @return std::shared_ptr<const std::vector<double>> 通道数值，不存在或已失效时返回nullptr
+ */
+std::shared_ptr<const std::vector<double>> ModelManager::getAttributeChannel(AttributeDomain domain, const std::string& name) const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = attribute_channels.find(std::make_pair(static_cast<int>(domain), name));
+    if (it == attribute_channels.end() || it->second.geometry_version != geometry_version) {
+        return nullptr;
+    }
+    return it->second.values;
+}
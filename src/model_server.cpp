@@ -0,0 +1,634 @@
+#include "model_server.h"
+#include "detail/posix_platform.h"
+#include "detail/text_output.h"
+#include "model_io.h"
+#include "shared_model_region.h"
+#include "mesh_topology.h"
+#include "topology_checker.h"
+#include "triangle_bvh.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+/**
+ * @brief 常驻模型及其按需构建的查询结构
+ */
+struct ModelServer::ResidentModel {
+    std::shared_ptr<const ModelManager> manager;
+    std::mutex mutex;                       // 保护以下按需构建的成员
+    std::shared_ptr<const TriangleBVH> bvh; // 最近点查询用BVH
+    std::unique_ptr<SharedModelRegion> region; // 已发布的共享内存区域
+};
+
+namespace {
+
+const size_t kMaxRequestLine = 64u << 10;  // 请求行长度上限，超出时返回错误并关闭连接
+const size_t kMaxResponseLine = 64u << 20; // 客户端接受的响应行长度上限
+
+/**
+ * @brief 按空白拆分请求行
+ */
+std::vector<std::string> splitWords(const std::string& line) {
+    std::vector<std::string> words;
+    std::istringstream stream(line);
+    std::string word;
+    while (stream >> word) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+std::string errorResponse(const std::string& message) {
+    return "{\"ok\":false,\"error\":" + detail::jsonString(message) + "}";
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end != text.c_str() && *end == '\0';
+}
+
+/**
+ * @brief 当前进程ID，用于生成共享内存名称
+ */
+long processId() {
+#if CAD_HAVE_POSIX_IPC
+    return static_cast<long>(::getpid());
+#else
+    return 0;
+#endif
+}
+
+#if CAD_HAVE_POSIX_IPC
+#ifdef MSG_NOSIGNAL
+const int kSendFlags = MSG_NOSIGNAL;
+#else
+const int kSendFlags = 0;
+#endif
+
+/**
+ * @brief 禁止对端关闭后写套接字触发SIGPIPE
+ * 
+ * Linux在send时以MSG_NOSIGNAL抑制；macOS等不支持该标志的平台改为设置套接字选项SO_NOSIGPIPE
+ */
+void suppressSigpipe(int fd) {
+#if defined(SO_NOSIGPIPE)
+    int enabled = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#else
+    (void)fd;
+#endif
+}
+
+/**
+ * @brief 发送完整缓冲区
+ */
+bool sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = ::send(fd, data, size, kSendFlags);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+/**
+ * @brief 构造函数
+ * 
+ * @param socket_path Unix域套接字路径
+ */
+ModelServer::ModelServer(const std::string& socket_path)
+    : socket_path(socket_path), listen_fd(-1), running(false), export_counter(0) {}
+
+/**
+ * @brief 析构函数
+ */
+ModelServer::~ModelServer() {
+    stop();
+    std::lock_guard<std::mutex> lock(models_mutex);
+    for (auto& entry : models) {
+        releaseModel(*entry.second);
+    }
+}
+
+/**
+ * @brief 添加常驻模型
+ * 
+ * @param name 模型名称
+ * @param model 模型
+ * @return bool 是否成功
+ */
+bool ModelServer::addModel(const std::string& name, std::shared_ptr<const ModelManager> model) {
+    if (name.empty() || !model || name.find_first_of(" \t\r\n") != std::string::npos) {
+        return false;
+    }
+    std::shared_ptr<ResidentModel> resident(new ResidentModel());
+    resident->manager = model;
+    std::lock_guard<std::mutex> lock(models_mutex);
+    return models.insert(std::make_pair(name, resident)).second;
+}
+
+/**
+ * @brief 读取模型文件并常驻
+ * 
+ * @param name 模型名称
+ * @param path 文件路径
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelServer::loadModel(const std::string& name, const std::string& path, std::string* error) {
+    std::shared_ptr<ModelManager> manager(new ModelManager());
+    if (!ModelIO::load(path, *manager, error)) {
+        return false;
+    }
+    if (!addModel(name, manager)) {
+        if (error) *error = "模型名称无效或已存在: " + name;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 移除常驻模型
+ * 
+ * @param name 模型名称
+ * @return bool 模型是否存在
+ */
+bool ModelServer::removeModel(const std::string& name) {
+    std::shared_ptr<ResidentModel> resident;
+    {
+        std::lock_guard<std::mutex> lock(models_mutex);
+        auto it = models.find(name);
+        if (it == models.end()) {
+            return false;
+        }
+        resident = it->second;
+        models.erase(it);
+    }
+    releaseModel(*resident);
+    return true;
+}
+
+/**
+ * @brief 释放模型发布的共享内存
+ */
+void ModelServer::releaseModel(ResidentModel& model) {
+    std::lock_guard<std::mutex> lock(model.mutex);
+    if (model.region) {
+        model.region->unlink();
+        model.region.reset();
+    }
+}
+
+std::shared_ptr<ModelServer::ResidentModel> ModelServer::findModel(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(models_mutex);
+    auto it = models.find(name);
+    return it == models.end() ? std::shared_ptr<ResidentModel>() : it->second;
+}
+
+/**
+ * @brief 处理单条请求
+ * 
+ * @param line 请求行
+ * @return std::string 响应行
+ */
+std::string ModelServer::handleRequest(const std::string& line) {
+    std::vector<std::string> words = splitWords(line);
+    if (words.empty()) {
+        return errorResponse("空请求");
+    }
+    const std::string& command = words[0];
+    std::ostringstream out;
+    out.precision(17);
+    
+    if (command == "PING") {
+        return "{\"ok\":true}";
+    }
+    if (command == "SHUTDOWN") {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            running = false;
+        }
+        state_changed.notify_all();
+        return "{\"ok\":true}";
+    }
+    if (command == "LIST") {
+        std::lock_guard<std::mutex> lock(models_mutex);
+        out << "{\"ok\":true,\"models\":[";
+        bool first = true;
+        for (const auto& entry : models) {
+            out << (first ? "" : ",") << "{\"name\":" << detail::jsonString(entry.first)
+                << ",\"vertices\":" << entry.second->manager->getVertices().size()
+                << ",\"faces\":" << entry.second->manager->getFaces().size() << "}";
+            first = false;
+        }
+        out << "]}";
+        return out.str();
+    }
+    if (command == "LOAD") {
+        if (words.size() != 3) return errorResponse("用法: LOAD <名称> <路径>");
+        std::string error;
+        if (!loadModel(words[1], words[2], &error)) return errorResponse(error);
+        return "{\"ok\":true}";
+    }
+    if (command == "UNLOAD") {
+        if (words.size() != 2) return errorResponse("用法: UNLOAD <名称>");
+        if (!removeModel(words[1])) return errorResponse("模型不存在: " + words[1]);
+        return "{\"ok\":true}";
+    }
+    
+    // 以下请求均针对单个常驻模型
+    if (words.size() < 2) {
+        return errorResponse("缺少模型名称");
+    }
+    std::shared_ptr<ResidentModel> resident = findModel(words[1]);
+    if (!resident) {
+        return errorResponse("模型不存在: " + words[1]);
+    }
+    const ModelManager& manager = *resident->manager;
+    
+    if (command == "BBOX") {
+        double min[3], max[3];
+        for (int k = 0; k < 3; ++k) {
+            min[k] = std::numeric_limits<double>::infinity();
+            max[k] = -std::numeric_limits<double>::infinity();
+        }
+        for (const auto& v : manager.getVertices()) {
+            double p[3] = {v->x, v->y, v->z};
+            for (int k = 0; k < 3; ++k) {
+                min[k] = std::min(min[k], p[k]);
+                max[k] = std::max(max[k], p[k]);
+            }
+        }
+        if (manager.getVertices().empty()) {
+            return errorResponse("模型为空");
+        }
+        out << "{\"ok\":true,\"min\":[" << min[0] << "," << min[1] << "," << min[2]
+            << "],\"max\":[" << max[0] << "," << max[1] << "," << max[2] << "]}";
+        return out.str();
+    }
+    if (command == "CLOSEST") {
+        double p[3];
+        double max_distance = std::numeric_limits<double>::infinity();
+        if (words.size() < 5 || words.size() > 6 ||
+            !parseDouble(words[2], p[0]) || !parseDouble(words[3], p[1]) || !parseDouble(words[4], p[2]) ||
+            (words.size() == 6 && !parseDouble(words[5], max_distance))) {
+            return errorResponse("用法: CLOSEST <名称> <x> <y> <z> [最大距离]");
+        }
+        std::shared_ptr<const TriangleBVH> bvh;
+        {
+            std::lock_guard<std::mutex> lock(resident->mutex);
+            if (!resident->bvh) {
+                resident->bvh.reset(new TriangleBVH(manager));
+            }
+            bvh = resident->bvh;
+        }
+        ClosestPointResult result;
+        if (!bvh->closestPoint(p[0], p[1], p[2], max_distance, result)) {
+            return "{\"ok\":true,\"found\":false}";
+        }
+        out << "{\"ok\":true,\"found\":true,\"point\":[" << result.point[0] << "," << result.point[1] << ","
+            << result.point[2] << "],\"distance\":" << result.distance << ",\"face\":" << result.face << "}";
+        return out.str();
+    }
+    if (command == "TOPOLOGY") {
+        auto topology = manager.getMeshTopology();
+        size_t boundary_edges = 0;
+        size_t nonmanifold_edges = 0;
+        for (size_t e = 0; e < topology->edgeCount(); ++e) {
+            int valence = topology->edge_face_offsets[e + 1] - topology->edge_face_offsets[e];
+            if (valence == 1) ++boundary_edges;
+            if (valence > 2) ++nonmanifold_edges;
+        }
+        TopologyReport report = TopologyChecker::checkTopology(manager);
+        out << "{\"ok\":true,\"vertices\":" << manager.getVertices().size()
+            << ",\"edges\":" << manager.getEdges().size()
+            << ",\"faces\":" << manager.getFaces().size()
+            << ",\"boundary_edges\":" << boundary_edges
+            << ",\"nonmanifold_edges\":" << nonmanifold_edges
+            << ",\"duplicate_edges\":" << report.duplicate_edges.size()
+            << ",\"duplicate_faces\":" << report.duplicate_faces.size()
+            << ",\"inconsistent_normals\":" << report.inconsistent_normals.size() << "}";
+        return out.str();
+    }
+    if (command == "EXPORT") {
+        std::lock_guard<std::mutex> lock(resident->mutex);
+        if (!resident->region) {
+            // 常驻模型不可变，首次导出后复用同一区域
+            std::string name = "/cad-" + std::to_string(static_cast<long>(processId())) + "-" +
+                               std::to_string(++export_counter);
+            std::unique_ptr<SharedModelRegion> region(new SharedModelRegion());
+            std::string error;
+            if (!region->create(name, SharedModelRegion::requiredBytes(manager), &error)) {
+                return errorResponse(error);
+            }
+            if (!region->publish(manager)) {
+                region->unlink();
+                return errorResponse("共享内存区域容量不足");
+            }
+            resident->region = std::move(region);
+        }
+        out << "{\"ok\":true,\"shm\":" << detail::jsonString(resident->region->name())
+            << ",\"bytes\":" << resident->region->mappedBytes()
+            << ",\"sequence\":" << resident->region->sequence() << "}";
+        return out.str();
+    }
+    return errorResponse("未知请求: " + command);
+}
+
+/**
+ * @brief 开始监听
+ * 
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelServer::start(std::string* error) {
+#if CAD_HAVE_POSIX_IPC
+    if (running) {
+        return true;
+    }
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        if (error) *error = "套接字路径无效或过长";
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+    
+    listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        if (error) *error = std::string("无法创建套接字: ") + std::strerror(errno);
+        return false;
+    }
+    ::unlink(socket_path.c_str());
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd, 64) != 0) {
+        if (error) *error = std::string("无法监听套接字: ") + std::strerror(errno);
+        ::close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+    running = true;
+    accept_thread = std::thread(&ModelServer::acceptLoop, this);
+    return true;
+#else
+    if (error) *error = "当前平台不支持Unix域套接字";
+    return false;
+#endif
+}
+
+/**
+ * @brief 停止服务
+ */
+void ModelServer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        running = false;
+    }
+    state_changed.notify_all();
+    if (accept_thread.joinable()) {
+        accept_thread.join();
+    }
+    std::vector<Connection> finished;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        finished.swap(connections);
+    }
+    for (auto& connection : finished) {
+        connection.thread.join();
+    }
+#if CAD_HAVE_POSIX_IPC
+    if (listen_fd >= 0) {
+        ::close(listen_fd);
+        listen_fd = -1;
+        ::unlink(socket_path.c_str());
+    }
+#endif
+}
+
+/**
+ * @brief 阻塞直到服务结束
+ */
+void ModelServer::wait() {
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        state_changed.wait(lock, [this]() { return !running; });
+    }
+    stop();
+}
+
+/**
+ * @brief 接受连接，每个连接由独立线程服务
+ * 
+ * 以带超时的poll等待，使stop()或SHUTDOWN能及时结束循环
+ */
+void ModelServer::acceptLoop() {
+#if CAD_HAVE_POSIX_IPC
+    while (running) {
+        pollfd descriptor;
+        descriptor.fd = listen_fd;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        if (::poll(&descriptor, 1, 100) <= 0) {
+            continue;
+        }
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        suppressSigpipe(fd);
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        // 回收已结束的连接线程
+        for (size_t i = 0; i < connections.size();) {
+            if (*connections[i].done) {
+                connections[i].thread.join();
+                connections[i] = std::move(connections.back());
+                connections.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        Connection connection;
+        connection.done = std::make_shared<std::atomic<bool>>(false);
+        connection.thread = std::thread(&ModelServer::serveConnection, this, fd, connection.done);
+        connections.push_back(std::move(connection));
+    }
+#endif
+}
+
+/**
+ * @brief 服务单个连接：逐行读取请求并写回响应
+ */
+void ModelServer::serveConnection(int fd, std::shared_ptr<std::atomic<bool>> done) {
+#if CAD_HAVE_POSIX_IPC
+    std::string pending;
+    char buffer[4096];
+    bool open = true;
+    while (open && running) {
+        pollfd descriptor;
+        descriptor.fd = fd;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        if (::poll(&descriptor, 1, 100) <= 0) {
+            continue;
+        }
+        ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) continue;
+            break;
+        }
+        pending.append(buffer, static_cast<size_t>(received));
+        size_t newline;
+        while ((newline = pending.find('\n')) != std::string::npos) {
+            std::string line = pending.substr(0, newline);
+            pending.erase(0, newline + 1);
+            if (!line.empty() && line[line.size() - 1] == '\r') {
+                line.erase(line.size() - 1);
+            }
+            std::string response = handleRequest(line) + "\n";
+            if (!sendAll(fd, response.data(), response.size())) {
+                open = false;
+                break;
+            }
+        }
+        // 未完成的请求行超过上限时不再缓存，避免不发换行的客户端耗尽内存
+        if (open && pending.size() > kMaxRequestLine) {
+            std::string response = errorResponse("请求行过长") + "\n";
+            sendAll(fd, response.data(), response.size());
+            open = false;
+        }
+    }
+    ::close(fd);
+#else
+    (void)fd;
+#endif
+    *done = true;
+}
+
+/**
+ * @brief 构造函数
+ */
+ModelClient::ModelClient() : fd(-1) {}
+
+/**
+ * @brief 析构函数
+ */
+ModelClient::~ModelClient() {
+    close();
+}
+
+/**
+ * @brief 连接服务器
+ * 
+ * @param socket_path Unix域套接字路径
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelClient::connect(const std::string& socket_path, std::string* error) {
+    close();
+#if CAD_HAVE_POSIX_IPC
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        if (error) *error = "套接字路径无效或过长";
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (error) *error = std::string("无法连接服务器: ") + std::strerror(errno);
+        close();
+        return false;
+    }
+    suppressSigpipe(fd);
+    return true;
+#else
+    (void)socket_path;
+    if (error) *error = "当前平台不支持Unix域套接字";
+    return false;
+#endif
+}
+
+/**
+ * @brief 断开连接
+ */
+void ModelClient::close() {
+#if CAD_HAVE_POSIX_IPC
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+    fd = -1;
+    pending.clear();
+}
+
+/**
+ * @brief 发送请求并等待响应
+ * 
+ * @param line 请求行
+ * @param response 输出响应行
+ * @return bool 是否成功
+ */
+bool ModelClient::request(const std::string& line, std::string& response) {
+#if CAD_HAVE_POSIX_IPC
+    if (fd < 0) {
+        return false;
+    }
+    std::string message = line + "\n";
+    if (!sendAll(fd, message.data(), message.size())) {
+        return false;
+    }
+    size_t newline;
+    char buffer[4096];
+    while ((newline = pending.find('\n')) == std::string::npos) {
+        ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) continue;
+            return false;
+        }
+        pending.append(buffer, static_cast<size_t>(received));
+        if (pending.size() > kMaxResponseLine) {
+            close();
+            return false;
+        }
+    }
+    response = pending.substr(0, newline);
+    pending.erase(0, newline + 1);
+    return true;
+#else
+    (void)line;
+    (void)response;
+    return false;
+#endif
+}
+
+/**
+ * @brief 从服务器发布的共享内存读取模型
+ * 
+ * @param shm_name 共享内存名称
+ * @param manager 模型管理器
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool ModelClient::importShared(const std::string& shm_name, ModelManager& manager, std::string* error) {
+    SharedModelRegion region;
+    if (!region.attach(shm_name, error)) {
+        return false;
+    }
+    if (!region.readModel(manager)) {
+        if (error) *error = "无法读取一致的模型版本: " + shm_name;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,457 @@
+#include "point_cloud.h"
+#include "detail/posix_platform.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+const size_t PointCloud::kDefaultChunkSize;
+const uint32_t PointCloud::kFileVersion;
+
+namespace {
+
+/**
+ * @brief 校验原生点云文件头，返回数据所需字节数
+ *
+ * 点数与分块大小均来自文件，相乘前先用除法与文件剩余字节数比较，避免溢出后通过长度检查
+ */
+bool checkHeader(const PointCloudFileHeader& header, size_t file_size, size_t& data_bytes, std::string* error) {
+    if (std::memcmp(header.magic, "CADP", 4) != 0 || header.version != PointCloud::kFileVersion) {
+        if (error) *error = "不是有效的点云文件";
+        return false;
+    }
+    if (header.chunk_size == 0) {
+        if (error) *error = "点云文件分块大小无效";
+        return false;
+    }
+    uint64_t chunks = header.point_count / header.chunk_size + (header.point_count % header.chunk_size != 0);
+    size_t available = file_size < sizeof(PointCloudFileHeader) ? 0 : file_size - sizeof(PointCloudFileHeader);
+    const uint64_t point_bytes = 3 * sizeof(double);
+    if (header.chunk_size > available / point_bytes ||
+        chunks > available / point_bytes / header.chunk_size) {
+        if (error) *error = "点云文件不完整";
+        return false;
+    }
+    data_bytes = static_cast<size_t>(chunks * header.chunk_size * point_bytes);
+    return true;
+}
+
+} // namespace
+
+PointCloud::PointCloud()
+    : chunk_size(kDefaultChunkSize), point_count(0), mapping(nullptr), mapping_bytes(0) {
+}
+
+PointCloud::~PointCloud() {
+    clear();
+}
+
+/**
+ * @brief 分配一个新分块
+ */
+double* PointCloud::appendChunk() {
+    owned.push_back(std::unique_ptr<double[]>(new double[3 * chunk_size]));
+    chunk_data.push_back(owned.back().get());
+    return owned.back().get();
+}
+
+/**
+ * @brief 追加一个点
+ */
+bool PointCloud::append(double x, double y, double z) {
+    if (mapping) {
+        return false;
+    }
+    size_t offset = point_count % chunk_size;
+    double* block = offset == 0 && point_count / chunk_size == chunk_data.size()
+        ? appendChunk() : chunk_data[point_count / chunk_size];
+    block[offset] = x;
+    block[chunk_size + offset] = y;
+    block[2 * chunk_size + offset] = z;
+    ++point_count;
+    return true;
+}
+
+/**
+ * @brief 批量追加点（SoA）
+ */
+bool PointCloud::append(const double* xs, const double* ys, const double* zs, size_t count) {
+    if (mapping) {
+        return false;
+    }
+    size_t done = 0;
+    while (done < count) {
+        size_t index = point_count / chunk_size;
+        size_t offset = point_count % chunk_size;
+        double* block = index == chunk_data.size() ? appendChunk() : chunk_data[index];
+        size_t n = std::min(count - done, chunk_size - offset);
+        std::memcpy(block + offset, xs + done, n * sizeof(double));
+        std::memcpy(block + chunk_size + offset, ys + done, n * sizeof(double));
+        std::memcpy(block + 2 * chunk_size + offset, zs + done, n * sizeof(double));
+        point_count += n;
+        done += n;
+    }
+    return true;
+}
+
+/**
+ * @brief 预留容量：提前分配分块
+ */
+void PointCloud::reserve(size_t count) {
+    if (mapping) {
+        return;
+    }
+    size_t chunks = (count + chunk_size - 1) / chunk_size;
+    owned.reserve(chunks);
+    chunk_data.reserve(chunks);
+    while (chunk_data.size() < chunks) {
+        appendChunk();
+    }
+}
+
+/**
+ * @brief 清空点云（同时解除映射）
+ */
+void PointCloud::clear() {
+#if CAD_HAVE_MMAP
+    if (mapping) {
+        ::munmap(mapping, mapping_bytes);
+    }
+#endif
+    mapping = nullptr;
+    mapping_bytes = 0;
+    chunk_data.clear();
+    owned.clear();
+    point_count = 0;
+    chunk_size = kDefaultChunkSize;
+}
+
+/**
+ * @brief 获取分块视图
+ */
+PointChunkView PointCloud::chunk(size_t index) const {
+    PointChunkView view;
+    if (index >= chunkCount()) {
+        return view;
+    }
+    const double* block = chunk_data[index];
+    view.x = block;
+    view.y = block + chunk_size;
+    view.z = block + 2 * chunk_size;
+    view.count = std::min(chunk_size, point_count - index * chunk_size);
+    return view;
+}
+
+/**
+ * @brief 获取包围盒：按块并行求最值后合并
+ */
+bool PointCloud::getBounds(double bounds_min[3], double bounds_max[3]) const {
+    if (point_count == 0) {
+        return false;
+    }
+    size_t chunks = chunkCount();
+    std::vector<double> partial(6 * chunks);
+    ParallelUtils::parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            PointChunkView view = chunk(c);
+            const double* axes[3] = {view.x, view.y, view.z};
+            for (int k = 0; k < 3; ++k) {
+                double lo = axes[k][0], hi = axes[k][0];
+                for (size_t i = 1; i < view.count; ++i) {
+                    lo = std::min(lo, axes[k][i]);
+                    hi = std::max(hi, axes[k][i]);
+                }
+                partial[6 * c + k] = lo;
+                partial[6 * c + 3 + k] = hi;
+            }
+        }
+    });
+    for (int k = 0; k < 3; ++k) {
+        bounds_min[k] = partial[k];
+        bounds_max[k] = partial[3 + k];
+    }
+    for (size_t c = 1; c < chunks; ++c) {
+        for (int k = 0; k < 3; ++k) {
+            bounds_min[k] = std::min(bounds_min[k], partial[6 * c + k]);
+            bounds_max[k] = std::max(bounds_max[k], partial[6 * c + 3 + k]);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 堆上占用的字节数
+ */
+size_t PointCloud::memoryBytes() const {
+    return owned.size() * 3 * chunk_size * sizeof(double) + chunk_data.capacity() * sizeof(double*) +
+           owned.capacity() * sizeof(std::unique_ptr<double[]>);
+}
+
+/**
+ * @brief 写出原生点云文件
+ */
+bool PointCloud::save(const std::string& path, std::string* error) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        if (error) *error = "无法创建文件: " + path;
+        return false;
+    }
+    PointCloudFileHeader header;
+    std::memcpy(header.magic, "CADP", 4);
+    header.version = kFileVersion;
+    header.point_count = point_count;
+    header.chunk_size = chunk_size;
+    header.reserved = 0;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    std::vector<double> padding;
+    for (size_t c = 0; ok && c < chunkCount(); ++c) {
+        PointChunkView view = chunk(c);
+        const double* axes[3] = {view.x, view.y, view.z};
+        for (int k = 0; ok && k < 3; ++k) {
+            ok = std::fwrite(axes[k], sizeof(double), view.count, file) == view.count;
+            if (ok && view.count < chunk_size) {
+                padding.assign(chunk_size - view.count, 0.0);
+                ok = std::fwrite(padding.data(), sizeof(double), padding.size(), file) == padding.size();
+            }
+        }
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok && error) {
+        *error = "写入文件失败: " + path;
+    }
+    return ok;
+}
+
+/**
+ * @brief 以只读映射方式打开原生点云文件
+ */
+bool PointCloud::openMapped(const std::string& path, std::string* error) {
+    clear();
+#if CAD_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (error) *error = "无法打开文件: " + path;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(PointCloudFileHeader)) {
+        ::close(fd);
+        if (error) *error = "不是有效的点云文件";
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* region = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        if (error) *error = "映射文件失败: " + path;
+        return false;
+    }
+    PointCloudFileHeader header;
+    std::memcpy(&header, region, sizeof(header));
+    size_t data_bytes = 0;
+    if (!checkHeader(header, size, data_bytes, error)) {
+        ::munmap(region, size);
+        return false;
+    }
+    mapping = region;
+    mapping_bytes = size;
+    chunk_size = static_cast<size_t>(header.chunk_size);
+    point_count = static_cast<size_t>(header.point_count);
+    double* data = reinterpret_cast<double*>(static_cast<char*>(region) + sizeof(PointCloudFileHeader));
+    for (size_t c = 0; c < chunkCount(); ++c) {
+        chunk_data.push_back(data + 3 * chunk_size * c);
+    }
+    return true;
+#else
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        if (error) *error = "无法打开文件: " + path;
+        return false;
+    }
+    PointCloudFileHeader header;
+    size_t data_bytes = 0;
+    long file_size = std::fseek(file, 0, SEEK_END) == 0 ? std::ftell(file) : -1;
+    bool ok = file_size >= 0 && std::fseek(file, 0, SEEK_SET) == 0 &&
+              std::fread(&header, sizeof(header), 1, file) == 1 &&
+              checkHeader(header, static_cast<size_t>(file_size), data_bytes, error);
+    if (ok) {
+        chunk_size = static_cast<size_t>(header.chunk_size);
+        size_t chunks = data_bytes / (3 * sizeof(double) * chunk_size);
+        for (size_t c = 0; ok && c < chunks; ++c) {
+            double* block = appendChunk();
+            ok = std::fread(block, sizeof(double), 3 * chunk_size, file) == 3 * chunk_size;
+        }
+        point_count = ok ? static_cast<size_t>(header.point_count) : 0;
+        if (!ok && error) *error = "点云文件不完整";
+    }
+    std::fclose(file);
+    if (!ok) {
+        clear();
+    }
+    return ok;
+#endif
+}
+
+/**
+ * @brief 构建索引
+ *
+ * 先并行计算每点所在单元，再计数、前缀和、回填得到CSR
+ */
+PointCloudIndex::PointCloudIndex(const PointCloud& cloud, double cell_size)
+    : cloud(cloud), cell(cell_size) {
+    double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {0.0, 0.0, 0.0};
+    cloud.getBounds(lo, hi);
+    double extent[3];
+    for (int k = 0; k < 3; ++k) {
+        origin[k] = lo[k];
+        extent[k] = hi[k] - lo[k];
+    }
+    size_t count = cloud.size();
+    if (!(cell > 0.0)) {
+        // 自动选取：按非零尺寸方向的包围盒体积（面积/长度）使每个单元约8个点
+        double measure = 1.0;
+        int active = 0;
+        for (int k = 0; k < 3; ++k) {
+            if (extent[k] > 0.0) {
+                measure *= extent[k];
+                ++active;
+            }
+        }
+        double target_cells = std::max(1.0, count / 8.0);
+        cell = active > 0 ? std::pow(measure / target_cells, 1.0 / active) : 1.0;
+    }
+    // 限制单元总数不超过点数，避免退化分布下网格过大
+    size_t max_cells = std::max<size_t>(count, 1);
+    for (;;) {
+        size_t total = 1;
+        for (int k = 0; k < 3; ++k) {
+            dims[k] = std::max(1, static_cast<int>(std::min(extent[k] / cell, 2097151.0)) + 1);
+            total *= dims[k];
+        }
+        if (total <= max_cells) break;
+        cell *= 1.25;
+    }
+
+    size_t cell_count = static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+    std::vector<uint32_t> point_cells(count);
+    size_t chunk_size = cloud.chunkSize();
+    ParallelUtils::parallelFor(cloud.chunkCount(), 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            PointChunkView view = cloud.chunk(c);
+            for (size_t i = 0; i < view.count; ++i) {
+                size_t index = cellIndex(cellCoordinate(view.x[i], 0), cellCoordinate(view.y[i], 1),
+                                         cellCoordinate(view.z[i], 2));
+                point_cells[c * chunk_size + i] = static_cast<uint32_t>(index);
+            }
+        }
+    });
+
+    cell_offsets.assign(cell_count + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        ++cell_offsets[point_cells[i] + 1];
+    }
+    for (size_t c = 0; c < cell_count; ++c) {
+        cell_offsets[c + 1] += cell_offsets[c];
+    }
+    cell_points.resize(count);
+    std::vector<uint32_t> fill(cell_offsets.begin(), cell_offsets.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        cell_points[fill[point_cells[i]]++] = static_cast<uint32_t>(i);
+    }
+}
+
+/**
+ * @brief 坐标所在单元（截断到网格范围内）
+ */
+int PointCloudIndex::cellCoordinate(double value, int axis) const {
+    double t = (value - origin[axis]) / cell;
+    if (!(t > 0.0)) return 0;
+    return static_cast<int>(std::min(t, static_cast<double>(dims[axis] - 1)));
+}
+
+/**
+ * @brief 最近点查询
+ */
+bool PointCloudIndex::nearest(double x, double y, double z, double max_distance, size_t& index,
+                              double& distance) const {
+    if (cell_points.empty()) {
+        return false;
+    }
+    int center[3] = {cellCoordinate(x, 0), cellCoordinate(y, 1), cellCoordinate(z, 2)};
+    double best = max_distance < std::numeric_limits<double>::max() ? max_distance * max_distance
+                                                                    : std::numeric_limits<double>::max();
+    bool found = false;
+    int max_ring = std::max(dims[0], std::max(dims[1], dims[2]));
+    double p[3];
+    for (int ring = 0; ring <= max_ring; ++ring) {
+        // 第ring层单元到查询点的距离不小于(ring-1)*cell
+        double gap = (ring - 1) * cell;
+        if (ring > 0 && gap > 0.0 && gap * gap > best) break;
+        int lo[3], hi[3];
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::max(0, center[k] - ring);
+            hi[k] = std::min(dims[k] - 1, center[k] + ring);
+        }
+        for (int k = lo[2]; k <= hi[2]; ++k) {
+            for (int j = lo[1]; j <= hi[1]; ++j) {
+                bool shell_row = std::abs(k - center[2]) == ring || std::abs(j - center[1]) == ring;
+                // 非外壳行只访问两端单元
+                int step = shell_row ? 1 : std::max(1, 2 * ring);
+                for (int i = center[0] - ring; i <= center[0] + ring; i += step) {
+                    if (i < lo[0] || i > hi[0]) continue;
+                    size_t c = cellIndex(i, j, k);
+                    for (uint32_t s = cell_offsets[c]; s < cell_offsets[c + 1]; ++s) {
+                        cloud.point(cell_points[s], p);
+                        double dx = p[0] - x, dy = p[1] - y, dz = p[2] - z;
+                        double d2 = dx * dx + dy * dy + dz * dz;
+                        if (d2 <= best) {
+                            best = d2;
+                            index = cell_points[s];
+                            found = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if (found) {
+        distance = std::sqrt(best);
+    }
+    return found;
+}
+
+/**
+ * @brief 半径查询
+ */
+void PointCloudIndex::radiusSearch(double x, double y, double z, double radius, std::vector<size_t>& indices) const {
+    if (cell_points.empty() || radius < 0.0) {
+        return;
+    }
+    int lo[3] = {cellCoordinate(x - radius, 0), cellCoordinate(y - radius, 1), cellCoordinate(z - radius, 2)};
+    int hi[3] = {cellCoordinate(x + radius, 0), cellCoordinate(y + radius, 1), cellCoordinate(z + radius, 2)};
+    double r2 = radius * radius;
+    double p[3];
+    for (int k = lo[2]; k <= hi[2]; ++k) {
+        for (int j = lo[1]; j <= hi[1]; ++j) {
+            for (int i = lo[0]; i <= hi[0]; ++i) {
+                size_t c = cellIndex(i, j, k);
+                for (uint32_t s = cell_offsets[c]; s < cell_offsets[c + 1]; ++s) {
+                    cloud.point(cell_points[s], p);
+                    double dx = p[0] - x, dy = p[1] - y, dz = p[2] - z;
+                    if (dx * dx + dy * dy + dz * dz <= r2) {
+                        indices.push_back(cell_points[s]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 索引占用的字节数
+ */
+size_t PointCloudIndex::memoryBytes() const {
+    return (cell_offsets.capacity() + cell_points.capacity()) * sizeof(uint32_t);
+}
@@ -0,0 +1,577 @@
+#include "point_cloud_io.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+const size_t kBufferSize = 1 << 20; // 读缓冲区初始大小
+const size_t kBatchSize = 1 << 16;  // 整体读取与转换时每批点数
+
+// PLY属性数值类型
+enum PlyType { PlyInt8, PlyUint8, PlyInt16, PlyUint16, PlyInt32, PlyUint32, PlyFloat32, PlyFloat64, PlyUnknown };
+
+PlyType parsePlyType(const std::string& name) {
+    if (name == "char" || name == "int8") return PlyInt8;
+    if (name == "uchar" || name == "uint8") return PlyUint8;
+    if (name == "short" || name == "int16") return PlyInt16;
+    if (name == "ushort" || name == "uint16") return PlyUint16;
+    if (name == "int" || name == "int32") return PlyInt32;
+    if (name == "uint" || name == "uint32") return PlyUint32;
+    if (name == "float" || name == "float32") return PlyFloat32;
+    if (name == "double" || name == "float64") return PlyFloat64;
+    return PlyUnknown;
+}
+
+size_t plyTypeSize(int type) {
+    static const size_t sizes[] = {1, 1, 2, 2, 4, 4, 4, 8};
+    return sizes[type];
+}
+
+/**
+ * @brief 按类型解码一个二进制属性值
+ */
+double decodePly(const char* data, int type, bool swap) {
+    unsigned char bytes[8];
+    size_t size = plyTypeSize(type);
+    std::memcpy(bytes, data, size);
+    if (swap) {
+        std::reverse(bytes, bytes + size);
+    }
+    switch (type) {
+    case PlyInt8: { int8_t v; std::memcpy(&v, bytes, 1); return v; }
+    case PlyUint8: return bytes[0];
+    case PlyInt16: { int16_t v; std::memcpy(&v, bytes, 2); return v; }
+    case PlyUint16: { uint16_t v; std::memcpy(&v, bytes, 2); return v; }
+    case PlyInt32: { int32_t v; std::memcpy(&v, bytes, 4); return v; }
+    case PlyUint32: { uint32_t v; std::memcpy(&v, bytes, 4); return v; }
+    case PlyFloat32: { float v; std::memcpy(&v, bytes, 4); return v; }
+    default: { double v; std::memcpy(&v, bytes, 8); return v; }
+    }
+}
+
+bool hostIsLittleEndian() {
+    uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+std::string lowerExtension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return std::string();
+    }
+    std::string extension = path.substr(dot);
+    for (auto& c : extension) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return extension;
+}
+
+inline bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+}
+
+} // namespace
+
+PointCloudReader::PointCloudReader()
+    : file(nullptr), format(Format::XYZ), buffer_begin(0), buffer_end(0), end_of_file(false),
+      line_number(0), declared_count(0), points_read(0), property_count(0), record_size(0),
+      swap_bytes(false), count_line_pending(false), native_chunk_size(0), native_chunk_count(0),
+      native_chunk_pos(0) {
+    for (int k = 0; k < 3; ++k) {
+        coordinate_property[k] = -1;
+        coordinate_offset[k] = 0;
+        coordinate_type[k] = PlyFloat64;
+    }
+}
+
+PointCloudReader::~PointCloudReader() {
+    close();
+}
+
+/**
+ * @brief 关闭文件
+ */
+void PointCloudReader::close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    buffer.clear();
+    buffer_begin = buffer_end = 0;
+    native_chunk.clear();
+}
+
+/**
+ * @brief 打开文件并解析文件头
+ */
+bool PointCloudReader::open(const std::string& path, std::string* error) {
+    close();
+    error_message.clear();
+    end_of_file = false;
+    line_number = 0;
+    declared_count = 0;
+    points_read = 0;
+    count_line_pending = false;
+
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error_message = "无法打开文件: " + path;
+        if (error) *error = error_message;
+        return false;
+    }
+    buffer.assign(kBufferSize + 1, '\0');
+
+    std::string extension = lowerExtension(path);
+    bool ok = true;
+    if (extension == ".cadp") {
+        format = Format::Native;
+        PointCloudFileHeader header;
+        if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, "CADP", 4) != 0 ||
+            header.version != PointCloud::kFileVersion || header.chunk_size == 0) {
+            error_message = "不是有效的点云文件";
+            ok = false;
+        } else {
+            declared_count = static_cast<size_t>(header.point_count);
+            native_chunk_size = static_cast<size_t>(header.chunk_size);
+            native_chunk.resize(3 * native_chunk_size);
+            native_chunk_count = native_chunk_pos = 0;
+        }
+    } else if (extension == ".ply") {
+        ok = parseHeaderPLY();
+    } else {
+        format = Format::XYZ;
+        count_line_pending = extension == ".pts";
+    }
+    if (!ok) {
+        if (error) *error = error_message;
+        close();
+    }
+    return ok;
+}
+
+/**
+ * @brief 保证缓冲区中至少有minimum字节未消费数据（文件结束时可能不足）
+ */
+bool PointCloudReader::fill(size_t minimum) {
+    while (buffer_end - buffer_begin < minimum && !end_of_file) {
+        if (buffer_begin > 0) {
+            std::memmove(buffer.data(), buffer.data() + buffer_begin, buffer_end - buffer_begin);
+            buffer_end -= buffer_begin;
+            buffer_begin = 0;
+        }
+        size_t capacity = buffer.size() - 1;
+        if (buffer_end == capacity || capacity < minimum) {
+            buffer.resize(std::max(2 * capacity, minimum) + 1);
+            capacity = buffer.size() - 1;
+        }
+        size_t n = std::fread(buffer.data() + buffer_end, 1, capacity - buffer_end, file);
+        if (n == 0) {
+            end_of_file = true;
+        }
+        buffer_end += n;
+        buffer[buffer_end] = '\0';
+    }
+    return buffer_end - buffer_begin >= minimum;
+}
+
+/**
+ * @brief 取下一行，行尾置为'\0'，返回的指针在下次读取前有效
+ */
+bool PointCloudReader::nextLine(char*& line, char*& line_end) {
+    size_t scanned = 0;
+    for (;;) {
+        char* begin = buffer.data() + buffer_begin;
+        char* end = buffer.data() + buffer_end;
+        char* newline = static_cast<char*>(std::memchr(begin + scanned, '\n', end - begin - scanned));
+        if (newline || end_of_file) {
+            if (!newline && begin == end) {
+                return false;
+            }
+            char* stop = newline ? newline : end;
+            *stop = '\0';
+            if (stop > begin && stop[-1] == '\r') {
+                stop[-1] = '\0';
+                --stop;
+            }
+            line = begin;
+            line_end = stop;
+            buffer_begin = newline ? static_cast<size_t>(newline + 1 - buffer.data()) : buffer_end;
+            ++line_number;
+            return true;
+        }
+        scanned = end - begin;
+        fill(scanned + 1);
+    }
+}
+
+/**
+ * @brief 解析PLY文件头
+ */
+bool PointCloudReader::parseHeaderPLY() {
+    char* line;
+    char* line_end;
+    if (!nextLine(line, line_end) || std::strcmp(line, "ply") != 0) {
+        error_message = "不是有效的PLY文件";
+        return false;
+    }
+    format = Format::XYZ;
+    bool in_vertex = false;
+    bool vertex_seen = false;
+    int property_index = 0;
+    size_t offset = 0;
+    bool has_list = false;
+    for (;;) {
+        if (!nextLine(line, line_end)) {
+            error_message = "PLY文件头不完整";
+            return false;
+        }
+        std::istringstream stream(line);
+        std::string keyword;
+        stream >> keyword;
+        if (keyword == "end_header") {
+            break;
+        } else if (keyword == "format") {
+            std::string name;
+            stream >> name;
+            if (name == "ascii") {
+                format = Format::PLYAscii;
+            } else if (name == "binary_little_endian" || name == "binary_big_endian") {
+                format = Format::PLYBinary;
+                swap_bytes = (name == "binary_little_endian") != hostIsLittleEndian();
+            } else {
+                error_message = "不支持的PLY格式: " + name;
+                return false;
+            }
+        } else if (keyword == "element") {
+            std::string name;
+            unsigned long long count = 0;
+            stream >> name >> count;
+            in_vertex = (name == "vertex");
+            if (in_vertex) {
+                vertex_seen = true;
+                declared_count = static_cast<size_t>(count);
+            } else if (!vertex_seen && count > 0) {
+                error_message = "不支持位于vertex之前的PLY元素: " + name;
+                return false;
+            }
+        } else if (keyword == "property" && in_vertex) {
+            std::string type_name, name;
+            stream >> type_name;
+            if (type_name == "list") {
+                has_list = true;
+                ++property_index;
+                continue;
+            }
+            stream >> name;
+            PlyType type = parsePlyType(type_name);
+            if (type == PlyUnknown) {
+                error_message = "未知的PLY属性类型: " + type_name;
+                return false;
+            }
+            int axis = name == "x" ? 0 : name == "y" ? 1 : name == "z" ? 2 : -1;
+            if (axis >= 0) {
+                coordinate_property[axis] = property_index;
+                coordinate_offset[axis] = offset;
+                coordinate_type[axis] = type;
+            }
+            offset += plyTypeSize(type);
+            ++property_index;
+        }
+    }
+    if (format == Format::XYZ) {
+        error_message = "PLY文件缺少format声明";
+        return false;
+    }
+    if (!vertex_seen || coordinate_property[0] < 0 || coordinate_property[1] < 0 || coordinate_property[2] < 0) {
+        error_message = "PLY文件缺少顶点坐标属性";
+        return false;
+    }
+    if (has_list) {
+        error_message = "不支持含列表属性的PLY顶点";
+        return false;
+    }
+    property_count = property_index;
+    record_size = offset;
+    return true;
+}
+
+/**
+ * @brief 读取下一批点
+ */
+size_t PointCloudReader::read(double* xs, double* ys, double* zs, size_t capacity) {
+    if (!file || failed() || capacity == 0) {
+        return 0;
+    }
+    switch (format) {
+    case Format::XYZ:
+        return readXYZ(xs, ys, zs, capacity);
+    case Format::PLYAscii:
+        return readPLYAscii(xs, ys, zs, capacity);
+    case Format::PLYBinary:
+        return readPLYBinary(xs, ys, zs, capacity);
+    default:
+        return readNative(xs, ys, zs, capacity);
+    }
+}
+
+/**
+ * @brief 读取XYZ文本
+ */
+size_t PointCloudReader::readXYZ(double* xs, double* ys, double* zs, size_t capacity) {
+    size_t n = 0;
+    char* line;
+    char* line_end;
+    while (n < capacity && nextLine(line, line_end)) {
+        char* p = line;
+        while (p < line_end && isSeparator(*p)) ++p;
+        if (p == line_end || !(std::isdigit(static_cast<unsigned char>(*p)) || *p == '-' || *p == '+' || *p == '.')) {
+            continue; // 空行、注释或表头
+        }
+        if (count_line_pending) {
+            // .pts首个数据行为单个整数时是点数行
+            count_line_pending = false;
+            char* q = p;
+            while (q < line_end && std::isdigit(static_cast<unsigned char>(*q))) ++q;
+            while (q < line_end && isSeparator(*q)) ++q;
+            if (q == line_end && std::isdigit(static_cast<unsigned char>(*p))) {
+                continue;
+            }
+        }
+        double c[3];
+        for (int k = 0; k < 3; ++k) {
+            char* next = nullptr;
+            c[k] = std::strtod(p, &next);
+            if (next == p) {
+                error_message = "第" + std::to_string(line_number) + "行坐标无效";
+                return 0;
+            }
+            p = next;
+            while (p < line_end && isSeparator(*p)) ++p;
+        }
+        xs[n] = c[0];
+        ys[n] = c[1];
+        zs[n] = c[2];
+        ++n;
+    }
+    points_read += n;
+    return n;
+}
+
+/**
+ * @brief 读取ASCII PLY顶点
+ */
+size_t PointCloudReader::readPLYAscii(double* xs, double* ys, double* zs, size_t capacity) {
+    size_t n = 0;
+    char* line;
+    char* line_end;
+    int last = std::max(coordinate_property[0], std::max(coordinate_property[1], coordinate_property[2]));
+    while (n < capacity && points_read + n < declared_count) {
+        if (!nextLine(line, line_end)) {
+            error_message = "PLY顶点数据不完整";
+            return 0;
+        }
+        char* p = line;
+        double c[3] = {0.0, 0.0, 0.0};
+        for (int property = 0; property <= last; ++property) {
+            char* next = nullptr;
+            double value = std::strtod(p, &next);
+            if (next == p) {
+                error_message = "第" + std::to_string(line_number) + "行顶点属性无效";
+                return 0;
+            }
+            p = next;
+            for (int k = 0; k < 3; ++k) {
+                if (coordinate_property[k] == property) c[k] = value;
+            }
+        }
+        xs[n] = c[0];
+        ys[n] = c[1];
+        zs[n] = c[2];
+        ++n;
+    }
+    points_read += n;
+    return n;
+}
+
+/**
+ * @brief 读取二进制PLY顶点
+ */
+size_t PointCloudReader::readPLYBinary(double* xs, double* ys, double* zs, size_t capacity) {
+    size_t n = 0;
+    while (n < capacity && points_read + n < declared_count) {
+        if (!fill(record_size)) {
+            error_message = "PLY顶点数据不完整";
+            return 0;
+        }
+        // 缓冲区中已有的完整记录一次处理完
+        size_t available = (buffer_end - buffer_begin) / record_size;
+        size_t batch = std::min(available, std::min(capacity - n, declared_count - points_read - n));
+        const char* record = buffer.data() + buffer_begin;
+        for (size_t i = 0; i < batch; ++i, record += record_size) {
+            xs[n + i] = decodePly(record + coordinate_offset[0], coordinate_type[0], swap_bytes);
+            ys[n + i] = decodePly(record + coordinate_offset[1], coordinate_type[1], swap_bytes);
+            zs[n + i] = decodePly(record + coordinate_offset[2], coordinate_type[2], swap_bytes);
+        }
+        buffer_begin += batch * record_size;
+        n += batch;
+    }
+    points_read += n;
+    return n;
+}
+
+/**
+ * @brief 读取原生点云文件：逐块读入后按需拷出
+ */
+size_t PointCloudReader::readNative(double* xs, double* ys, double* zs, size_t capacity) {
+    size_t n = 0;
+    while (n < capacity && points_read + n < declared_count) {
+        if (native_chunk_pos == native_chunk_count) {
+            if (std::fread(native_chunk.data(), sizeof(double), native_chunk.size(), file) != native_chunk.size()) {
+                error_message = "点云文件不完整";
+                return 0;
+            }
+            native_chunk_count = std::min(native_chunk_size, declared_count - points_read - n);
+            native_chunk_pos = 0;
+        }
+        size_t batch = std::min(capacity - n, native_chunk_count - native_chunk_pos);
+        const double* block = native_chunk.data();
+        std::memcpy(xs + n, block + native_chunk_pos, batch * sizeof(double));
+        std::memcpy(ys + n, block + native_chunk_size + native_chunk_pos, batch * sizeof(double));
+        std::memcpy(zs + n, block + 2 * native_chunk_size + native_chunk_pos, batch * sizeof(double));
+        native_chunk_pos += batch;
+        n += batch;
+    }
+    points_read += n;
+    return n;
+}
+
+/**
+ * @brief 读取点云文件，追加到点云
+ */
+bool PointCloudIO::load(const std::string& path, PointCloud& cloud, std::string* error) {
+    PointCloudReader reader;
+    if (!reader.open(path, error)) {
+        return false;
+    }
+    if (reader.declaredCount() > 0) {
+        cloud.reserve(cloud.size() + reader.declaredCount());
+    }
+    std::vector<double> xs(kBatchSize), ys(kBatchSize), zs(kBatchSize);
+    for (;;) {
+        size_t n = reader.read(xs.data(), ys.data(), zs.data(), kBatchSize);
+        if (n == 0) break;
+        if (!cloud.append(xs.data(), ys.data(), zs.data(), n)) {
+            if (error) *error = "映射模式的点云不可追加";
+            return false;
+        }
+    }
+    if (reader.failed()) {
+        if (error) *error = reader.error();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 写出XYZ文本文件
+ */
+bool PointCloudIO::saveXYZ(const std::string& path, const PointCloud& cloud) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    bool ok = true;
+    for (size_t c = 0; ok && c < cloud.chunkCount(); ++c) {
+        PointChunkView view = cloud.chunk(c);
+        for (size_t i = 0; ok && i < view.count; ++i) {
+            ok = std::fprintf(file, "%.17g %.17g %.17g\n", view.x[i], view.y[i], view.z[i]) > 0;
+        }
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief 流式转换点云文件
+ *
+ * 原生格式先写占位文件头，按块写出坐标，最后回写点数
+ */
+size_t PointCloudIO::convert(const std::string& input, const std::string& output, std::string* error) {
+    PointCloudReader reader;
+    if (!reader.open(input, error)) {
+        return 0;
+    }
+    FILE* file = std::fopen(output.c_str(), "wb");
+    if (!file) {
+        if (error) *error = "无法创建文件: " + output;
+        return 0;
+    }
+
+    bool native = lowerExtension(output) == ".cadp";
+    const size_t chunk_size = PointCloud::kDefaultChunkSize;
+    PointCloudFileHeader header;
+    std::memcpy(header.magic, "CADP", 4);
+    header.version = PointCloud::kFileVersion;
+    header.point_count = 0;
+    header.chunk_size = chunk_size;
+    header.reserved = 0;
+    bool ok = !native || std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // 原生格式按整块缓冲：x、y、z三段
+    std::vector<double> block(3 * chunk_size);
+    size_t total = 0;
+    for (;;) {
+        size_t offset = total % chunk_size;
+        size_t capacity = native ? chunk_size - offset : chunk_size;
+        size_t base = native ? offset : 0;
+        size_t n = ok ? reader.read(&block[base], &block[chunk_size + base], &block[2 * chunk_size + base], capacity) : 0;
+        if (n == 0) break;
+        total += n;
+        if (native) {
+            if (total % chunk_size == 0) {
+                ok = std::fwrite(block.data(), sizeof(double), block.size(), file) == block.size();
+            }
+        } else {
+            for (size_t i = 0; ok && i < n; ++i) {
+                ok = std::fprintf(file, "%.17g %.17g %.17g\n", block[i], block[chunk_size + i],
+                                  block[2 * chunk_size + i]) > 0;
+            }
+        }
+    }
+    if (ok && native && total % chunk_size != 0) {
+        size_t used = total % chunk_size;
+        for (int k = 0; k < 3; ++k) {
+            std::fill(block.begin() + k * chunk_size + used, block.begin() + (k + 1) * chunk_size, 0.0);
+        }
+        ok = std::fwrite(block.data(), sizeof(double), block.size(), file) == block.size();
+    }
+    if (ok && native) {
+        header.point_count = total;
+        ok = std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    }
+    ok = std::fclose(file) == 0 && ok;
+
+    if (reader.failed()) {
+        if (error) *error = reader.error();
+        return 0;
+    }
+    if (!ok) {
+        if (error) *error = "写入文件失败: " + output;
+        return 0;
+    }
+    return total;
+}
+
+/**
+ * @brief 判断路径是否为点云文件（按扩展名）
+ */
+bool PointCloudIO::isPointCloudPath(const std::string& path) {
+    std::string extension = lowerExtension(path);
+    return extension == ".xyz" || extension == ".pts" || extension == ".ply" || extension == ".cadp";
+}
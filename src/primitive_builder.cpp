@@ -0,0 +1,323 @@
+#include "primitive_builder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief 基本体网格缓冲区
+ * 
+ * 顶点坐标按SoA数组累积，面以CSR形式记录局部顶点索引，
+ * 最后一次性写入模型管理器
+ */
+struct MeshBuffer {
+    std::vector<double> xs, ys, zs;
+    std::vector<int> face_offsets;
+    std::vector<int> face_indices;
+    
+    MeshBuffer() : face_offsets(1, 0) {}
+    
+    int addVertex(double x, double y, double z) {
+        xs.push_back(x);
+        ys.push_back(y);
+        zs.push_back(z);
+        return static_cast<int>(xs.size()) - 1;
+    }
+    
+    /**
+     * @brief 添加一圈环形顶点，返回首个顶点索引
+     */
+    int addRing(const std::vector<double>& cos_table, const std::vector<double>& sin_table,
+                double cx, double cy, double radius, double z) {
+        int first = static_cast<int>(xs.size());
+        size_t n = cos_table.size();
+        xs.resize(xs.size() + n);
+        ys.resize(ys.size() + n);
+        zs.resize(zs.size() + n, z);
+        for (size_t i = 0; i < n; ++i) {
+            xs[first + i] = cx + radius * cos_table[i];
+            ys[first + i] = cy + radius * sin_table[i];
+        }
+        return first;
+    }
+    
+    void addFace(int a, int b, int c) {
+        face_indices.push_back(a);
+        face_indices.push_back(b);
+        face_indices.push_back(c);
+        face_offsets.push_back(static_cast<int>(face_indices.size()));
+    }
+    
+    void addFace(int a, int b, int c, int d) {
+        face_indices.push_back(a);
+        face_indices.push_back(b);
+        face_indices.push_back(c);
+        face_indices.push_back(d);
+        face_offsets.push_back(static_cast<int>(face_indices.size()));
+    }
+    
+    /**
+     * @brief 环形面（reverse为true时反向，使法向朝-Z）
+     */
+    void addRingFace(int first, int n, bool reverse) {
+        for (int i = 0; i < n; ++i) {
+            face_indices.push_back(first + (reverse ? (n - i) % n : i));
+        }
+        face_offsets.push_back(static_cast<int>(face_indices.size()));
+    }
+    
+    /**
+     * @brief 连接两圈环形顶点的四边形带（lower在下，upper在上，法向朝外）
+     */
+    void addBand(int lower, int upper, int n, bool reverse) {
+        for (int i = 0; i < n; ++i) {
+            int j = (i + 1) % n;
+            if (reverse) {
+                addFace(lower + i, upper + i, upper + j, lower + j);
+            } else {
+                addFace(lower + i, lower + j, upper + j, upper + i);
+            }
+        }
+    }
+    
+    bool emit(ModelManager& manager) const {
+        if (xs.empty()) {
+            return false;
+        }
+        int base_id = manager.nextVertexId();
+        size_t face_count = face_offsets.size() - 1;
+        manager.reserveVertices(manager.getVertices().size() + xs.size());
+        manager.reserveEdges(manager.getEdges().size() + face_indices.size());
+        manager.reserveFaces(manager.getFaces().size() + face_count);
+        for (size_t i = 0; i < xs.size(); ++i) {
+            manager.addVertex(base_id + static_cast<int>(i), xs[i], ys[i], zs[i]);
+        }
+        int face_id = manager.nextFaceId();
+        std::vector<int> loop;
+        for (size_t f = 0; f < face_count; ++f) {
+            loop.clear();
+            for (int c = face_offsets[f]; c < face_offsets[f + 1]; ++c) {
+                loop.push_back(base_id + face_indices[c]);
+            }
+            if (!manager.addFaceFromVertices(face_id++, loop)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief 生成圆周方向的三角函数表（起始角为0）
+ */
+void makeTables(int segments, std::vector<double>& cos_table, std::vector<double>& sin_table) {
+    cos_table.resize(segments);
+    sin_table.resize(segments);
+    double step = 2.0 * M_PI / segments;
+    for (int i = 0; i < segments; ++i) {
+        cos_table[i] = std::cos(step * i);
+        sin_table[i] = std::sin(step * i);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 由弦高误差计算圆周分段数
+ * 
+ * 弦高 s = r(1 - cos(π/n)) ≤ tolerance，即 n ≥ π / acos(1 - tolerance/r)
+ * 
+ * @param radius 半径
+ * @param tolerance 允许的最大弦高误差
+ * @return int 分段数
+ */
+int PrimitiveBuilder::segmentsForTolerance(double radius, double tolerance) {
+    if (radius <= 0.0 || tolerance <= 0.0) {
+        return 3;
+    }
+    if (tolerance >= radius) {
+        return 3;
+    }
+    double n = std::ceil(M_PI / std::acos(1.0 - tolerance / radius));
+    return static_cast<int>(std::max(3.0, std::min(n, 65536.0)));
+}
+
+/**
+ * @brief 圆柱或空心圆管
+ * 
+ * @param manager 模型管理器
+ * @param center 底面圆心
+ * @param radius 外半径
+ * @param height 高度
+ * @param tolerance 弦高误差
+ * @param inner_radius 内半径
+ * @return bool 是否成功
+ */
+bool PrimitiveBuilder::cylinder(ModelManager& manager, const Point3D& center, double radius, double height,
+                                double tolerance, double inner_radius) {
+    if (radius <= 0.0 || height <= 0.0 || inner_radius >= radius) {
+        return false;
+    }
+    int n = segmentsForTolerance(radius, tolerance);
+    std::vector<double> cos_table, sin_table;
+    makeTables(n, cos_table, sin_table);
+    
+    MeshBuffer buffer;
+    int bottom = buffer.addRing(cos_table, sin_table, center.x, center.y, radius, center.z);
+    int top = buffer.addRing(cos_table, sin_table, center.x, center.y, radius, center.z + height);
+    buffer.addBand(bottom, top, n, false);
+    if (inner_radius > 0.0) {
+        int inner_bottom = buffer.addRing(cos_table, sin_table, center.x, center.y, inner_radius, center.z);
+        int inner_top = buffer.addRing(cos_table, sin_table, center.x, center.y, inner_radius, center.z + height);
+        buffer.addBand(inner_bottom, inner_top, n, true);
+        for (int i = 0; i < n; ++i) {
+            int j = (i + 1) % n;
+            buffer.addFace(bottom + i, inner_bottom + i, inner_bottom + j, bottom + j);
+            buffer.addFace(top + i, top + j, inner_top + j, inner_top + i);
+        }
+    } else {
+        buffer.addRingFace(bottom, n, true);
+        buffer.addRingFace(top, n, false);
+    }
+    return buffer.emit(manager);
+}
+
+/**
+ * @brief 圆锥或圆台
+ * 
+ * @param manager 模型管理器
+ * @param center 底面圆心
+ * @param bottom_radius 底面半径
+ * @param top_radius 顶面半径
+ * @param height 高度
+ * @param tolerance 弦高误差
+ * @return bool 是否成功
+ */
+bool PrimitiveBuilder::cone(ModelManager& manager, const Point3D& center, double bottom_radius, double top_radius,
+                            double height, double tolerance) {
+    if (bottom_radius <= 0.0 || top_radius < 0.0 || height <= 0.0) {
+        return false;
+    }
+    int n = segmentsForTolerance(std::max(bottom_radius, top_radius), tolerance);
+    std::vector<double> cos_table, sin_table;
+    makeTables(n, cos_table, sin_table);
+    
+    MeshBuffer buffer;
+    int bottom = buffer.addRing(cos_table, sin_table, center.x, center.y, bottom_radius, center.z);
+    buffer.addRingFace(bottom, n, true);
+    if (top_radius > 0.0) {
+        int top = buffer.addRing(cos_table, sin_table, center.x, center.y, top_radius, center.z + height);
+        buffer.addBand(bottom, top, n, false);
+        buffer.addRingFace(top, n, false);
+    } else {
+        int apex = buffer.addVertex(center.x, center.y, center.z + height);
+        for (int i = 0; i < n; ++i) {
+            buffer.addFace(bottom + i, bottom + (i + 1) % n, apex);
+        }
+    }
+    return buffer.emit(manager);
+}
+
+/**
+ * @brief 球
+ * 
+ * @param manager 模型管理器
+ * @param center 球心
+ * @param radius 半径
+ * @param tolerance 弦高误差
+ * @return bool 是否成功
+ */
+bool PrimitiveBuilder::sphere(ModelManager& manager, const Point3D& center, double radius, double tolerance) {
+    if (radius <= 0.0) {
+        return false;
+    }
+    int n = std::max(4, segmentsForTolerance(radius, tolerance));
+    int rings = std::max(1, n / 2 - 1); // 不含两极的纬线圈数
+    std::vector<double> cos_table, sin_table;
+    makeTables(n, cos_table, sin_table);
+    
+    MeshBuffer buffer;
+    int south = buffer.addVertex(center.x, center.y, center.z - radius);
+    int first_ring = static_cast<int>(buffer.xs.size());
+    for (int r = 0; r < rings; ++r) {
+        double polar = M_PI * (r + 1) / (rings + 1);
+        buffer.addRing(cos_table, sin_table, center.x, center.y, radius * std::sin(polar),
+                       center.z - radius * std::cos(polar));
+    }
+    int north = buffer.addVertex(center.x, center.y, center.z + radius);
+    
+    for (int i = 0; i < n; ++i) {
+        int j = (i + 1) % n;
+        buffer.addFace(south, first_ring + j, first_ring + i);
+    }
+    for (int r = 0; r + 1 < rings; ++r) {
+        buffer.addBand(first_ring + r * n, first_ring + (r + 1) * n, n, false);
+    }
+    int last_ring = first_ring + (rings - 1) * n;
+    for (int i = 0; i < n; ++i) {
+        int j = (i + 1) % n;
+        buffer.addFace(last_ring + i, last_ring + j, north);
+    }
+    return buffer.emit(manager);
+}
+
+/**
+ * @brief 圆环
+ * 
+ * @param manager 模型管理器
+ * @param center 圆环中心
+ * @param major_radius 中心圆半径
+ * @param minor_radius 截面圆半径
+ * @param tolerance 弦高误差
+ * @return bool 是否成功
+ */
+bool PrimitiveBuilder::torus(ModelManager& manager, const Point3D& center, double major_radius, double minor_radius,
+                             double tolerance) {
+    if (minor_radius <= 0.0 || major_radius <= minor_radius) {
+        return false;
+    }
+    int n_major = segmentsForTolerance(major_radius + minor_radius, tolerance);
+    int n_minor = segmentsForTolerance(minor_radius, tolerance);
+    std::vector<double> cos_table, sin_table;
+    makeTables(n_major, cos_table, sin_table);
+    
+    // 每个截面角对应一圈绕Z轴的环
+    MeshBuffer buffer;
+    for (int m = 0; m < n_minor; ++m) {
+        double phi = 2.0 * M_PI * m / n_minor;
+        buffer.addRing(cos_table, sin_table, center.x, center.y, major_radius + minor_radius * std::cos(phi),
+                       center.z + minor_radius * std::sin(phi));
+    }
+    for (int m = 0; m < n_minor; ++m) {
+        int lower = m * n_major;
+        int upper = ((m + 1) % n_minor) * n_major;
+        buffer.addBand(lower, upper, n_major, false);
+    }
+    return buffer.emit(manager);
+}
+
+/**
+ * @brief 六角棱柱
+ * 
+ * @param manager 模型管理器
+ * @param center 底面中心
+ * @param across_flats 对边距离
+ * @param height 高度
+ * @return bool 是否成功
+ */
+bool PrimitiveBuilder::hexPrism(ModelManager& manager, const Point3D& center, double across_flats, double height) {
+    if (across_flats <= 0.0 || height <= 0.0) {
+        return false;
+    }
+    std::vector<double> cos_table, sin_table;
+    makeTables(6, cos_table, sin_table);
+    double radius = across_flats / std::sqrt(3.0); // 外接圆半径
+    
+    MeshBuffer buffer;
+    int bottom = buffer.addRing(cos_table, sin_table, center.x, center.y, radius, center.z);
+    int top = buffer.addRing(cos_table, sin_table, center.x, center.y, radius, center.z + height);
+    buffer.addRingFace(bottom, 6, true);
+    buffer.addRingFace(top, 6, false);
+    buffer.addBand(bottom, top, 6, false);
+    return buffer.emit(manager);
+}
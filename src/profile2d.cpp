@@ -0,0 +1,455 @@
+#include "profile2d.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+inline double distance2(double ax, double ay, double bx, double by) {
+    double dx = bx - ax;
+    double dy = by - ay;
+    return dx * dx + dy * dy;
+}
+
+/**
+ * @brief 点p到线段ab的距离平方
+ */
+inline double pointSegmentDistance2(double px, double py, double ax, double ay, double bx, double by) {
+    double dx = bx - ax;
+    double dy = by - ay;
+    double length2 = dx * dx + dy * dy;
+    double t = length2 > 0.0 ? ((px - ax) * dx + (py - ay) * dy) / length2 : 0.0;
+    t = std::max(0.0, std::min(1.0, t));
+    return distance2(px, py, ax + t * dx, ay + t * dy);
+}
+
+/**
+ * @brief 点c相对有向线段ab的方位（叉积）
+ */
+inline double orient(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+/**
+ * @brief 线段ab与cd的距离平方（严格相交时为0）
+ */
+double segmentDistance2(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy) {
+    double o1 = orient(ax, ay, bx, by, cx, cy);
+    double o2 = orient(ax, ay, bx, by, dx, dy);
+    double o3 = orient(cx, cy, dx, dy, ax, ay);
+    double o4 = orient(cx, cy, dx, dy, bx, by);
+    if (((o1 > 0.0 && o2 < 0.0) || (o1 < 0.0 && o2 > 0.0)) && ((o3 > 0.0 && o4 < 0.0) || (o3 < 0.0 && o4 > 0.0))) {
+        return 0.0;
+    }
+    return std::min(std::min(pointSegmentDistance2(cx, cy, ax, ay, bx, by), pointSegmentDistance2(dx, dy, ax, ay, bx, by)),
+                    std::min(pointSegmentDistance2(ax, ay, cx, cy, dx, dy), pointSegmentDistance2(bx, by, cx, cy, dx, dy)));
+}
+
+} // namespace
+
+/**
+ * @brief 从三维点构建
+ */
+Profile2D Profile2D::fromPoints(const std::vector<Point3D>& points, ProfilePlane plane) {
+    Profile2D profile;
+    profile.reserve(points.size());
+    for (const auto& p : points) {
+        profile.append(p.x, plane == ProfilePlane::XY ? p.y : p.z);
+    }
+    return profile;
+}
+
+/**
+ * @brief 转换为三维点
+ */
+std::vector<Point3D> Profile2D::toPoints(ProfilePlane plane, double elevation) const {
+    std::vector<Point3D> points;
+    points.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        int id = static_cast<int>(i) + 1;
+        if (plane == ProfilePlane::XY) {
+            points.push_back(Point3D(id, xs[i], ys[i], elevation));
+        } else {
+            points.push_back(Point3D(id, xs[i], elevation, ys[i]));
+        }
+    }
+    return points;
+}
+
+/**
+ * @brief 有向面积（鞋带公式，以首点为原点减小抵消误差）
+ */
+double Profile2D::signedArea() const {
+    const size_t n = size();
+    if (n < 3) {
+        return 0.0;
+    }
+    double area = 0.0;
+    for (size_t i = 1; i + 1 < n; ++i) {
+        area += (xs[i] - xs[0]) * (ys[i + 1] - ys[0]) - (xs[i + 1] - xs[0]) * (ys[i] - ys[0]);
+    }
+    return 0.5 * area;
+}
+
+/**
+ * @brief 周长
+ */
+double Profile2D::perimeter() const {
+    const size_t n = size();
+    double length = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = i + 1 < n ? i + 1 : 0;
+        length += std::sqrt(distance2(xs[i], ys[i], xs[j], ys[j]));
+    }
+    return length;
+}
+
+/**
+ * @brief 反转顶点顺序（保持首点不变）
+ */
+void Profile2D::reverse() {
+    if (size() > 2) {
+        std::reverse(xs.begin() + 1, xs.end());
+        std::reverse(ys.begin() + 1, ys.end());
+    }
+}
+
+/**
+ * @brief 统一方向
+ */
+bool Profile2D::normalizeOrientation(bool counter_clockwise) {
+    double area = signedArea();
+    if (area == 0.0 || (area > 0.0) == counter_clockwise) {
+        return false;
+    }
+    reverse();
+    return true;
+}
+
+/**
+ * @brief 去除重合点与共线点
+ *
+ * 重合点与上一个保留点比较，漂移不会累积；共线点交给Douglas–Peucker，
+ * 逐点按相邻点判断会把密集采样的圆弧逐步吃掉，而DP保证每个被去除的点
+ * 到最终边的距离都不超过容差。最后检查首点是否与首尾两个邻点共线
+ */
+size_t Profile2D::removeDegenerate(double tolerance) {
+    const size_t n = size();
+    const double tolerance2 = tolerance * tolerance;
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (kept > 0 && distance2(xs[kept - 1], ys[kept - 1], xs[i], ys[i]) <= tolerance2) {
+            continue;
+        }
+        xs[kept] = xs[i];
+        ys[kept] = ys[i];
+        ++kept;
+    }
+    while (kept > 1 && distance2(xs[kept - 1], ys[kept - 1], xs[0], ys[0]) <= tolerance2) {
+        --kept;
+    }
+    xs.resize(kept);
+    ys.resize(kept);
+
+    Profile2D reduced = simplified(tolerance);
+    xs.swap(reduced.xs);
+    ys.swap(reduced.ys);
+    kept = size();
+    if (kept > 3 && pointSegmentDistance2(xs[0], ys[0], xs[kept - 1], ys[kept - 1], xs[1], ys[1]) <= tolerance2) {
+        xs.erase(xs.begin());
+        ys.erase(ys.begin());
+    }
+    return n - size();
+}
+
+/**
+ * @brief Douglas–Peucker简化
+ *
+ * 闭合轮廓以首点和离首点最远的顶点为两个锚点，分成两条折线分别递归细分（显式栈）；
+ * 两条折线都退化为直线时补上离锚点连线最远的顶点
+ */
+Profile2D Profile2D::simplified(double tolerance) const {
+    const size_t n = size();
+    if (n <= 3) {
+        return *this;
+    }
+    size_t far = 0;
+    double far_distance = -1.0;
+    for (size_t i = 1; i < n; ++i) {
+        double d = distance2(xs[0], ys[0], xs[i], ys[i]);
+        if (d > far_distance) {
+            far_distance = d;
+            far = i;
+        }
+    }
+
+    const double tolerance2 = tolerance * tolerance;
+    std::vector<char> keep(n, 0);
+    keep[0] = 1;
+    keep[far] = 1;
+    size_t kept = 2;
+    size_t best = 0;
+    double best_distance = -1.0;
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.push_back(std::make_pair(size_t(0), far));
+    stack.push_back(std::make_pair(far, n));
+    while (!stack.empty()) {
+        size_t a = stack.back().first;
+        size_t b = stack.back().second;
+        stack.pop_back();
+        size_t bb = b < n ? b : 0;
+        size_t split = a;
+        double max_distance = -1.0;
+        for (size_t i = a + 1; i < b; ++i) {
+            double d = pointSegmentDistance2(xs[i], ys[i], xs[a], ys[a], xs[bb], ys[bb]);
+            if (d > max_distance) {
+                max_distance = d;
+                split = i;
+            }
+        }
+        if (split == a) {
+            continue;
+        }
+        if (max_distance > tolerance2) {
+            keep[split] = 1;
+            ++kept;
+            stack.push_back(std::make_pair(a, split));
+            stack.push_back(std::make_pair(split, b));
+        } else if (kept == 2 && max_distance > best_distance) {
+            best_distance = max_distance;
+            best = split;
+        }
+    }
+    if (kept == 2 && best != 0) {
+        keep[best] = 1;
+    }
+
+    Profile2D result;
+    for (size_t i = 0; i < n; ++i) {
+        if (keep[i]) {
+            result.append(xs[i], ys[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 自相交检查
+ *
+ * 边按x区间下端排序后扫描：活动边表只保留x区间上端不小于当前边下端的边，
+ * 对y区间也重叠的边对求线段距离。相邻边只检查公共顶点处是否折返
+ * （一条边的另一端点落在另一条边上）
+ */
+bool Profile2D::selfIntersects(double tolerance) const {
+    const size_t n = size();
+    if (n < 3) {
+        return false;
+    }
+    const double tolerance2 = tolerance * tolerance;
+    std::vector<double> low_x(n), high_x(n), low_y(n), high_y(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = i + 1 < n ? i + 1 : 0;
+        low_x[i] = std::min(xs[i], xs[j]);
+        high_x[i] = std::max(xs[i], xs[j]);
+        low_y[i] = std::min(ys[i], ys[j]);
+        high_y[i] = std::max(ys[i], ys[j]);
+    }
+    std::vector<int> order(n);
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = static_cast<int>(i);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return low_x[a] < low_x[b]; });
+
+    std::vector<int> active;
+    for (int e : order) {
+        size_t kept = 0;
+        for (int a : active) {
+            if (high_x[a] >= low_x[e] - tolerance) {
+                active[kept++] = a;
+            }
+        }
+        active.resize(kept);
+
+        size_t e0 = static_cast<size_t>(e);
+        size_t e1 = e0 + 1 < n ? e0 + 1 : 0;
+        for (int a : active) {
+            if (high_y[a] < low_y[e] - tolerance || low_y[a] > high_y[e] + tolerance) {
+                continue;
+            }
+            size_t a0 = static_cast<size_t>(a);
+            size_t a1 = a0 + 1 < n ? a0 + 1 : 0;
+            if (a1 == e0 || e1 == a0) {
+                // 相邻边：shared为公共顶点，p、q为两条边的另一端点
+                size_t shared = a1 == e0 ? e0 : a0;
+                size_t p = a1 == e0 ? a0 : e0;
+                size_t q = a1 == e0 ? e1 : a1;
+                if (a1 == e0 && e1 == a0) {
+                    return true; // 仅两个顶点的往返
+                }
+                if (pointSegmentDistance2(xs[q], ys[q], xs[shared], ys[shared], xs[p], ys[p]) <= tolerance2 ||
+                    pointSegmentDistance2(xs[p], ys[p], xs[shared], ys[shared], xs[q], ys[q]) <= tolerance2) {
+                    return true;
+                }
+                continue;
+            }
+            if (segmentDistance2(xs[a0], ys[a0], xs[a1], ys[a1], xs[e0], ys[e0], xs[e1], ys[e1]) <= tolerance2) {
+                return true;
+            }
+        }
+        active.push_back(e);
+    }
+    return false;
+}
+
+/**
+ * @brief 偏置
+ *
+ * 边i（顶点i→i+1）的外法向按轮廓方向确定，顶点处两条偏置线的交点为
+ * v + d·(n₁ + n₂)/(1 + n₁·n₂)，斜接长度为 |d|·√(2/(1 + n₁·n₂))。
+ * 偏置方向上的凸角（扩大时的凸角、收缩时的凹角）斜接过长时改为两点倒角
+ */
+Profile2D Profile2D::offset(double distance, double miter_limit) const {
+    const size_t n = size();
+    if (n < 3 || distance == 0.0) {
+        return *this;
+    }
+    const double side = signedArea() >= 0.0 ? 1.0 : -1.0;
+    std::vector<double> nx(n), ny(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = i + 1 < n ? i + 1 : 0;
+        double dx = xs[j] - xs[i];
+        double dy = ys[j] - ys[i];
+        double length = std::sqrt(dx * dx + dy * dy);
+        nx[i] = length > 0.0 ? side * dy / length : 0.0;
+        ny[i] = length > 0.0 ? -side * dx / length : 0.0;
+    }
+
+    Profile2D result;
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t prev = i > 0 ? i - 1 : n - 1;
+        double cos_angle = nx[prev] * nx[i] + ny[prev] * ny[i];
+        // 按轮廓方向归一后的转向，正值为凸角
+        double turn = side * (nx[prev] * ny[i] - ny[prev] * nx[i]);
+        bool spike = turn * distance > 0.0;
+        if (1.0 + cos_angle < 1e-12 || (spike && 2.0 > miter_limit * miter_limit * (1.0 + cos_angle))) {
+            result.append(xs[i] + distance * nx[prev], ys[i] + distance * ny[prev]);
+            result.append(xs[i] + distance * nx[i], ys[i] + distance * ny[i]);
+            continue;
+        }
+        double scale = distance / (1.0 + cos_angle);
+        result.append(xs[i] + scale * (nx[prev] + nx[i]), ys[i] + scale * (ny[prev] + ny[i]));
+    }
+    return result;
+}
+
+/**
+ * @brief 顶点倒角
+ */
+Profile2D Profile2D::chamfered(double distance, const std::vector<size_t>& corners) const {
+    return blendCorners(distance, 1, false, corners);
+}
+
+/**
+ * @brief 顶点圆角
+ */
+Profile2D Profile2D::filleted(double radius, int segments, const std::vector<size_t>& corners) const {
+    return blendCorners(radius, std::max(segments, 1), true, corners);
+}
+
+/**
+ * @brief 顶点倒角/圆角的公共实现
+ *
+ * 先求各选中顶点沿相邻边的切点距离（倒角为size，圆角为 r·tan(φ/2)），
+ * 逐边检查两端切点距离之和不超过边长，再输出切点与圆弧点。
+ * 圆心位于前一条边切点沿转向一侧法向偏移r处，圆弧从前一切点转过φ到后一切点
+ */
+Profile2D Profile2D::blendCorners(double amount, int segments, bool fillet, const std::vector<size_t>& corners) const {
+    const size_t n = size();
+    if (n < 3 || amount <= 0.0) {
+        return *this;
+    }
+    std::vector<char> selected(n, corners.empty() ? 1 : 0);
+    for (size_t c : corners) {
+        if (c < n) {
+            selected[c] = 1;
+        }
+    }
+
+    // 边单位方向与长度
+    std::vector<double> ux(n), uy(n), length(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = i + 1 < n ? i + 1 : 0;
+        double dx = xs[j] - xs[i];
+        double dy = ys[j] - ys[i];
+        length[i] = std::sqrt(dx * dx + dy * dy);
+        ux[i] = length[i] > 0.0 ? dx / length[i] : 0.0;
+        uy[i] = length[i] > 0.0 ? dy / length[i] : 0.0;
+    }
+
+    // 各顶点的转角与切点距离
+    std::vector<double> turn(n, 0.0), trim(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        if (!selected[i]) {
+            continue;
+        }
+        size_t prev = i > 0 ? i - 1 : n - 1;
+        turn[i] = std::atan2(ux[prev] * uy[i] - uy[prev] * ux[i], ux[prev] * ux[i] + uy[prev] * uy[i]);
+        if (std::fabs(turn[i]) < 1e-9) {
+            selected[i] = 0; // 共线顶点无需处理
+            continue;
+        }
+        trim[i] = fillet ? amount * std::tan(0.5 * std::fabs(turn[i])) : amount;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = i + 1 < n ? i + 1 : 0;
+        if (trim[i] + trim[j] > length[i] * (1.0 + 1e-12)) {
+            throw std::invalid_argument(fillet ? "圆角半径超过相邻边长度" : "倒角距离超过相邻边长度");
+        }
+    }
+
+    Profile2D result;
+    result.reserve(n + (fillet ? static_cast<size_t>(segments) : 1) * n);
+    for (size_t i = 0; i < n; ++i) {
+        if (!selected[i]) {
+            result.append(xs[i], ys[i]);
+            continue;
+        }
+        size_t prev = i > 0 ? i - 1 : n - 1;
+        double start_x = xs[i] - trim[i] * ux[prev];
+        double start_y = ys[i] - trim[i] * uy[prev];
+        if (!fillet) {
+            result.append(start_x, start_y);
+            result.append(xs[i] + trim[i] * ux[i], ys[i] + trim[i] * uy[i]);
+            continue;
+        }
+        double side = turn[i] > 0.0 ? 1.0 : -1.0;
+        double cx = start_x - side * amount * uy[prev];
+        double cy = start_y + side * amount * ux[prev];
+        double start_angle = std::atan2(start_y - cy, start_x - cx);
+        for (int k = 0; k <= segments; ++k) {
+            double angle = start_angle + turn[i] * k / segments;
+            result.append(cx + amount * std::cos(angle), cy + amount * std::sin(angle));
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 清理轮廓
+ */
+size_t Profile2D::clean(double tolerance) {
+    size_t removed = removeDegenerate(tolerance);
+    if (size() < 3) {
+        throw std::invalid_argument("轮廓有效顶点不足3个");
+    }
+    if (std::fabs(signedArea()) <= tolerance * perimeter()) {
+        throw std::invalid_argument("轮廓面积为零");
+    }
+    if (selfIntersects(tolerance)) {
+        throw std::invalid_argument("轮廓自相交");
+    }
+    normalizeOrientation(true);
+    return removed;
+}
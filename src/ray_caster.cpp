@@ -0,0 +1,249 @@
+#include "ray_caster.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief 射线的无缝求交预计算数据（坐标轴置换与剪切系数）
+ */
+struct RayPrecomp {
+    int kx, ky, kz;
+    double sx, sy, sz;
+    bool valid;
+};
+
+RayPrecomp precompute(const double* dir) {
+    RayPrecomp r;
+    double ax = std::fabs(dir[0]);
+    double ay = std::fabs(dir[1]);
+    double az = std::fabs(dir[2]);
+    r.kz = ax > ay ? (ax > az ? 0 : 2) : (ay > az ? 1 : 2);
+    r.kx = (r.kz + 1) % 3;
+    r.ky = (r.kx + 1) % 3;
+    r.valid = dir[r.kz] != 0.0;
+    if (!r.valid) {
+        r.sx = r.sy = r.sz = 0.0;
+        return r;
+    }
+    if (dir[r.kz] < 0.0) {
+        std::swap(r.kx, r.ky);
+    }
+    r.sx = dir[r.kx] / dir[r.kz];
+    r.sy = dir[r.ky] / dir[r.kz];
+    r.sz = 1.0 / dir[r.kz];
+    return r;
+}
+
+/**
+ * @brief 无缝射线-三角形求交（Woop等）
+ */
+bool intersectTriangle(const RayPrecomp& r, const double* org, const double* tri,
+                       double tmin, double tmax, double& t, double& u, double& v) {
+    double a[3] = {tri[0] - org[0], tri[1] - org[1], tri[2] - org[2]};
+    double b[3] = {tri[3] - org[0], tri[4] - org[1], tri[5] - org[2]};
+    double c[3] = {tri[6] - org[0], tri[7] - org[1], tri[8] - org[2]};
+    
+    double ax = a[r.kx] - r.sx * a[r.kz];
+    double ay = a[r.ky] - r.sy * a[r.kz];
+    double bx = b[r.kx] - r.sx * b[r.kz];
+    double by = b[r.ky] - r.sy * b[r.kz];
+    double cx = c[r.kx] - r.sx * c[r.kz];
+    double cy = c[r.ky] - r.sy * c[r.kz];
+    
+    double wu = cx * by - cy * bx;
+    double wv = ax * cy - ay * cx;
+    double ww = bx * ay - by * ax;
+    if ((wu < 0.0 || wv < 0.0 || ww < 0.0) && (wu > 0.0 || wv > 0.0 || ww > 0.0)) {
+        return false;
+    }
+    double det = wu + wv + ww;
+    if (det == 0.0) {
+        return false;
+    }
+    
+    double tz = wu * (r.sz * a[r.kz]) + wv * (r.sz * b[r.kz]) + ww * (r.sz * c[r.kz]);
+    double inv_det = 1.0 / det;
+    double hit_t = tz * inv_det;
+    if (hit_t < tmin || hit_t > tmax) {
+        return false;
+    }
+    t = hit_t;
+    u = wv * inv_det;
+    v = ww * inv_det;
+    return true;
+}
+
+/**
+ * @brief 射线包（SoA布局，便于编译器对通道循环向量化）
+ */
+template <int N>
+struct RayPacket {
+    double org[3][N];
+    double inv_dir[3][N];
+    double tmin[N];
+    double tmax[N];
+    RayPrecomp pre[N];
+    bool active[N];
+};
+
+/**
+ * @brief 射线包遍历BVH
+ */
+template <int N>
+void traversePacket(const TriangleBVH& bvh, const Ray* rays, RayHit* hits, int lanes, RayQueryMode mode) {
+    RayPacket<N> packet;
+    int active_count = 0;
+    for (int i = 0; i < N; ++i) {
+        const Ray& ray = rays[i < lanes ? i : 0];
+        for (int k = 0; k < 3; ++k) {
+            packet.org[k][i] = ray.origin[k];
+            packet.inv_dir[k][i] = 1.0 / ray.direction[k];
+        }
+        packet.pre[i] = precompute(ray.direction);
+        packet.tmin[i] = ray.tmin;
+        packet.tmax[i] = ray.tmax;
+        packet.active[i] = i < lanes && packet.pre[i].valid && ray.tmin <= ray.tmax;
+        if (packet.active[i]) ++active_count;
+        if (i < lanes) hits[i] = RayHit();
+    }
+    const auto& nodes = bvh.nodes();
+    if (active_count == 0 || nodes.empty()) {
+        return;
+    }
+    
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty() && active_count > 0) {
+        const BVHNode& node = nodes[stack.back()];
+        stack.pop_back();
+        
+        // 包内所有射线同时做slab测试
+        bool lane_hit[N];
+        bool any = false;
+        for (int i = 0; i < N; ++i) {
+            double t0 = packet.tmin[i];
+            double t1 = packet.tmax[i];
+            for (int k = 0; k < 3; ++k) {
+                double near_t = (node.bounds_min[k] - packet.org[k][i]) * packet.inv_dir[k][i];
+                double far_t = (node.bounds_max[k] - packet.org[k][i]) * packet.inv_dir[k][i];
+                if (near_t > far_t) std::swap(near_t, far_t);
+                t0 = near_t > t0 ? near_t : t0;
+                t1 = far_t < t1 ? far_t : t1;
+            }
+            lane_hit[i] = packet.active[i] && t0 <= t1 * (1.0 + 1e-12);
+            any = any || lane_hit[i];
+        }
+        if (!any) continue;
+        
+        if (node.count == 0) {
+            // 按首条命中射线方向决定远近子节点顺序，先压入远端
+            int lead = 0;
+            while (!lane_hit[lead]) ++lead;
+            const BVHNode& left = nodes[node.first];
+            const BVHNode& right = nodes[node.first + 1];
+            double d = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                double dir_k = 1.0 / packet.inv_dir[k][lead];
+                d += dir_k * ((right.bounds_min[k] + right.bounds_max[k]) - (left.bounds_min[k] + left.bounds_max[k]));
+            }
+            if (d >= 0.0) {
+                stack.push_back(node.first + 1);
+                stack.push_back(node.first);
+            } else {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+            }
+            continue;
+        }
+        
+        for (int tri = node.first; tri < node.first + node.count; ++tri) {
+            const double* positions = bvh.triangle(tri);
+            for (int i = 0; i < N; ++i) {
+                if (!lane_hit[i] || !packet.active[i]) continue;
+                double org[3] = {packet.org[0][i], packet.org[1][i], packet.org[2][i]};
+                double t, u, v;
+                if (!intersectTriangle(packet.pre[i], org, positions, packet.tmin[i], packet.tmax[i], t, u, v)) {
+                    continue;
+                }
+                hits[i].t = t;
+                hits[i].u = u;
+                hits[i].v = v;
+                hits[i].triangle = tri;
+                hits[i].face = bvh.triangleFace(tri);
+                if (mode == RayQueryMode::Any) {
+                    packet.active[i] = false;
+                    --active_count;
+                } else {
+                    packet.tmax[i] = t;
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 从模型管理器构建
+ * 
+ * @param manager 模型管理器
+ */
+RayCaster::RayCaster(const ModelManager& manager)
+    : bvh_ptr(std::make_shared<TriangleBVH>(manager)) {
+}
+
+/**
+ * @brief 复用已构建的BVH
+ * 
+ * @param bvh 三角形BVH
+ */
+RayCaster::RayCaster(std::shared_ptr<const TriangleBVH> bvh)
+    : bvh_ptr(bvh) {
+}
+
+/**
+ * @brief 单条射线求交
+ * 
+ * @param ray 射线
+ * @param mode 查询模式
+ * @return RayHit 求交结果
+ */
+RayHit RayCaster::intersect(const Ray& ray, RayQueryMode mode) const {
+    RayHit hit;
+    traversePacket<1>(*bvh_ptr, &ray, &hit, 1, mode);
+    return hit;
+}
+
+/**
+ * @brief 批量射线求交
+ * 
+ * @param rays 射线集合
+ * @param hits 输出求交结果
+ * @param mode 查询模式
+ * @param packet_width 射线包宽度（4或8）
+ */
+void RayCaster::intersect(const std::vector<Ray>& rays, std::vector<RayHit>& hits,
+                          RayQueryMode mode, int packet_width) const {
+    hits.resize(rays.size());
+    if (rays.empty()) {
+        return;
+    }
+    size_t width = packet_width <= 4 ? 4 : 8;
+    size_t packet_count = (rays.size() + width - 1) / width;
+    const TriangleBVH& tree = *bvh_ptr;
+    ParallelUtils::parallelFor(packet_count, 64, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            size_t first = p * width;
+            int lanes = static_cast<int>(std::min(width, rays.size() - first));
+            if (width == 4) {
+                traversePacket<4>(tree, &rays[first], &hits[first], lanes, mode);
+            } else {
+                traversePacket<8>(tree, &rays[first], &hits[first], lanes, mode);
+            }
+        }
+    });
+}
@@ -0,0 +1,380 @@
+#include "rigid_registration.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+const int kPacked = 21; // 6×6对称矩阵上三角分量数
+
+/**
+ * @brief 法方程累加器：上三角按行打包的AᵀA、Aᵀb与偏差统计
+ */
+struct NormalEquations {
+    double ata[kPacked];
+    double atb[6];
+    double squared_sum;
+    double max_squared;
+    size_t count;
+
+    NormalEquations() : squared_sum(0.0), max_squared(0.0), count(0) {
+        std::fill(ata, ata + kPacked, 0.0);
+        std::fill(atb, atb + 6, 0.0);
+    }
+
+    void merge(const NormalEquations& other) {
+        for (int i = 0; i < kPacked; ++i) ata[i] += other.ata[i];
+        for (int i = 0; i < 6; ++i) atb[i] += other.atb[i];
+        squared_sum += other.squared_sum;
+        max_squared = std::max(max_squared, other.max_squared);
+        count += other.count;
+    }
+};
+
+/**
+ * @brief 对加正则项后的对称正定矩阵做Cholesky分解并求解 A·x = b
+ *
+ * 点集在某方向上无法约束（如平面可沿面内滑动）时矩阵奇异，
+ * 按对角线均值加微小正则项使该方向增量趋于零
+ *
+ * @return bool 分解是否成功
+ */
+bool solveSymmetric6(const double* packed, const double* b, double* x) {
+    double a[6][6];
+    int k = 0;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = i; j < 6; ++j) {
+            a[i][j] = a[j][i] = packed[k++];
+        }
+    }
+    double trace = 0.0;
+    for (int i = 0; i < 6; ++i) trace += a[i][i];
+    if (!(trace > 0.0)) return false;
+    double lambda = trace * 1e-12;
+    for (int i = 0; i < 6; ++i) a[i][i] += lambda;
+
+    double l[6][6] = {};
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            double sum = a[i][j];
+            for (int m = 0; m < j; ++m) sum -= l[i][m] * l[j][m];
+            if (i == j) {
+                if (sum <= 0.0) return false;
+                l[i][i] = std::sqrt(sum);
+            } else {
+                l[i][j] = sum / l[j][j];
+            }
+        }
+    }
+    double y[6];
+    for (int i = 0; i < 6; ++i) {
+        double sum = b[i];
+        for (int m = 0; m < i; ++m) sum -= l[i][m] * y[m];
+        y[i] = sum / l[i][i];
+    }
+    for (int i = 5; i >= 0; --i) {
+        double sum = y[i];
+        for (int m = i + 1; m < 6; ++m) sum -= l[m][i] * x[m];
+        x[i] = sum / l[i][i];
+    }
+    return true;
+}
+
+/**
+ * @brief 计算BVH顺序中每个三角形的单位法向，退化三角形为零向量
+ */
+std::vector<double> triangleNormals(const TriangleBVH& bvh) {
+    std::vector<double> normals(3 * bvh.triangleCount(), 0.0);
+    ParallelUtils::parallelFor(bvh.triangleCount(), 4096, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            const double* p = bvh.triangle(t);
+            double ux = p[3] - p[0], uy = p[4] - p[1], uz = p[5] - p[2];
+            double vx = p[6] - p[0], vy = p[7] - p[1], vz = p[8] - p[2];
+            double nx = uy * vz - uz * vy;
+            double ny = uz * vx - ux * vz;
+            double nz = ux * vy - uy * vx;
+            double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if (length > 0.0) {
+                normals[3 * t] = nx / length;
+                normals[3 * t + 1] = ny / length;
+                normals[3 * t + 2] = nz / length;
+            }
+        }
+    });
+    return normals;
+}
+
+/**
+ * @brief 将21位整数的各位间隔两位展开，用于拼接Morton码
+ */
+inline uint64_t spreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | (v << 32)) & 0x1f00000000ffffULL;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+    v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+/**
+ * @brief 按Morton码排列扫描点的处理顺序
+ *
+ * 扫描点常以任意顺序给出，空间相邻的点连续查询可复用缓存中的BVH节点与三角形
+ */
+std::vector<size_t> spatialOrder(const double* xs, const double* ys, const double* zs, size_t count) {
+    double lo[3] = {xs[0], ys[0], zs[0]};
+    double hi[3] = {xs[0], ys[0], zs[0]};
+    for (size_t i = 1; i < count; ++i) {
+        const double p[3] = {xs[i], ys[i], zs[i]};
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], p[k]);
+            hi[k] = std::max(hi[k], p[k]);
+        }
+    }
+    double scale[3];
+    for (int k = 0; k < 3; ++k) {
+        scale[k] = hi[k] > lo[k] ? 2097151.0 / (hi[k] - lo[k]) : 0.0;
+    }
+
+    std::vector<std::pair<uint64_t, size_t>> keys(count);
+    ParallelUtils::parallelFor(count, 8192, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t code = spreadBits(static_cast<uint64_t>((xs[i] - lo[0]) * scale[0])) |
+                            (spreadBits(static_cast<uint64_t>((ys[i] - lo[1]) * scale[1])) << 1) |
+                            (spreadBits(static_cast<uint64_t>((zs[i] - lo[2]) * scale[2])) << 2);
+            keys[i] = std::make_pair(code, i);
+        }
+    });
+    std::sort(keys.begin(), keys.end());
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = keys[i].second;
+    }
+    return order;
+}
+
+} // namespace
+
+/**
+ * @brief 复合变换：先应用other再应用本变换
+ */
+RigidTransform RigidTransform::compose(const RigidTransform& other) const {
+    RigidTransform result;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            result.rotation[3 * i + j] = rotation[3 * i] * other.rotation[j] +
+                                         rotation[3 * i + 1] * other.rotation[3 + j] +
+                                         rotation[3 * i + 2] * other.rotation[6 + j];
+        }
+    }
+    apply(other.translation, result.translation);
+    return result;
+}
+
+/**
+ * @brief 逆变换：R' = Rᵀ，t' = −Rᵀ·t
+ */
+RigidTransform RigidTransform::inverse() const {
+    RigidTransform result;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            result.rotation[3 * i + j] = rotation[3 * j + i];
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        result.translation[i] = -(result.rotation[3 * i] * translation[0] +
+                                  result.rotation[3 * i + 1] * translation[1] +
+                                  result.rotation[3 * i + 2] * translation[2]);
+    }
+    return result;
+}
+
+/**
+ * @brief 由旋转向量与平移构造刚体变换
+ *
+ * @param omega 旋转向量（方向为转轴，长度为角度）
+ * @param t 平移
+ */
+RigidTransform RigidTransform::fromRotationVector(const double* omega, const double* t) {
+    RigidTransform result;
+    double angle = std::sqrt(omega[0] * omega[0] + omega[1] * omega[1] + omega[2] * omega[2]);
+    if (angle > 0.0) {
+        double kx = omega[0] / angle, ky = omega[1] / angle, kz = omega[2] / angle;
+        double c = std::cos(angle), s = std::sin(angle), v = 1.0 - c;
+        result.rotation[0] = c + kx * kx * v;
+        result.rotation[1] = kx * ky * v - kz * s;
+        result.rotation[2] = kx * kz * v + ky * s;
+        result.rotation[3] = ky * kx * v + kz * s;
+        result.rotation[4] = c + ky * ky * v;
+        result.rotation[5] = ky * kz * v - kx * s;
+        result.rotation[6] = kz * kx * v - ky * s;
+        result.rotation[7] = kz * ky * v + kx * s;
+        result.rotation[8] = c + kz * kz * v;
+    }
+    result.translation[0] = t[0];
+    result.translation[1] = t[1];
+    result.translation[2] = t[2];
+    return result;
+}
+
+/**
+ * @brief 旋转矩阵的对数映射
+ *
+ * 一般情况由反对称部分求轴，角度由atan2(sinθ, cosθ)求得以免acos在0与π附近失准；角度接近π时反对称部分趋于零，
+ * 改由对称部分 (R + Rᵀ) / 2 = cosθ·I + (1 − cosθ)·k·kᵀ 的最大对角元所在列求轴
+ *
+ * @param omega 输出旋转向量
+ */
+void RigidTransform::rotationVector(double* omega) const {
+    const double* r = rotation;
+    double cosine = std::max(-1.0, std::min(1.0, 0.5 * (r[0] + r[4] + r[8] - 1.0)));
+    double skew[3] = {r[7] - r[5], r[2] - r[6], r[3] - r[1]};
+    double sine = 0.5 * std::sqrt(skew[0] * skew[0] + skew[1] * skew[1] + skew[2] * skew[2]);
+    double angle = std::atan2(sine, cosine);
+    if (angle < 1e-6) {
+        for (int k = 0; k < 3; ++k) omega[k] = 0.5 * skew[k];
+        return;
+    }
+    if (sine > 1e-6) {
+        double scale = angle / (2.0 * sine);
+        for (int k = 0; k < 3; ++k) omega[k] = scale * skew[k];
+        return;
+    }
+    int i = 0;
+    if (r[4] > r[0]) i = 1;
+    if (r[8] > r[3 * i + i]) i = 2;
+    double axis[3];
+    for (int k = 0; k < 3; ++k) {
+        axis[k] = 0.5 * (r[3 * k + i] + r[3 * i + k]) - (k == i ? cosine : 0.0);
+    }
+    double length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    // 符号由残余的反对称部分确定
+    if (axis[0] * skew[0] + axis[1] * skew[1] + axis[2] * skew[2] < 0.0) length = -length;
+    for (int k = 0; k < 3; ++k) omega[k] = angle * axis[k] / length;
+}
+
+/**
+ * @brief 将扫描点对齐到名义模型
+ *
+ * 每次迭代先在当前变换下建立对应并累加法方程，
+ * 因此收敛时报告的偏差统计对应最终变换
+ */
+RegistrationResult RigidRegistration::alignPointToPlane(const TriangleBVH& target, const double* xs,
+                                                        const double* ys, const double* zs, size_t count,
+                                                        const RegistrationOptions& options,
+                                                        const RigidTransform& initial) {
+    RegistrationResult result;
+    result.transform = initial;
+    if (count == 0 || target.triangleCount() == 0) {
+        return result;
+    }
+
+    const std::vector<double> normals = triangleNormals(target);
+    const std::vector<size_t> order = spatialOrder(xs, ys, zs, count);
+    const double max_distance = options.max_correspondence_distance;
+    const unsigned workers = ParallelUtils::threadCount();
+    bool step_converged = false;
+    // 上一次迭代各点到曲面的距离：点移动量为d时新距离不超过旧距离+d，用作最近点查询的搜索上界
+    std::vector<double> last_distance(count, max_distance);
+    RigidTransform previous = result.transform;
+
+    for (;;) {
+        const RigidTransform current = result.transform;
+        std::vector<NormalEquations> partial(workers);
+        ParallelUtils::parallelForWithWorker(count, 2048, [&](size_t begin, size_t end, unsigned worker) {
+            NormalEquations local;
+            ClosestPointResult hit;
+            for (size_t j = begin; j < end; ++j) {
+                size_t i = order[j];
+                double p[3] = {xs[i], ys[i], zs[i]};
+                double old[3];
+                previous.apply(p, old);
+                current.apply(p, p);
+                double bound = max_distance;
+                if (last_distance[i] < max_distance) {
+                    double dx = p[0] - old[0], dy = p[1] - old[1], dz = p[2] - old[2];
+                    bound = std::min(max_distance, last_distance[i] * (1.0 + 1e-9) + 1e-12 +
+                                                       std::sqrt(dx * dx + dy * dy + dz * dz));
+                }
+                if (!target.closestPoint(p[0], p[1], p[2], bound, hit)) {
+                    last_distance[i] = max_distance;
+                    continue;
+                }
+                last_distance[i] = hit.distance;
+                const double* n = &normals[3 * hit.triangle];
+                if (n[0] == 0.0 && n[1] == 0.0 && n[2] == 0.0) continue;
+
+                double d = (p[0] - hit.point[0]) * n[0] + (p[1] - hit.point[1]) * n[1] +
+                           (p[2] - hit.point[2]) * n[2];
+                // 残差对(ω, δt)的雅可比：[p×n, n]
+                double a[6] = {p[1] * n[2] - p[2] * n[1],
+                               p[2] * n[0] - p[0] * n[2],
+                               p[0] * n[1] - p[1] * n[0],
+                               n[0], n[1], n[2]};
+                int k = 0;
+                for (int r = 0; r < 6; ++r) {
+                    for (int c = r; c < 6; ++c) {
+                        local.ata[k++] += a[r] * a[c];
+                    }
+                    local.atb[r] -= a[r] * d;
+                }
+                double squared = hit.distance * hit.distance;
+                local.squared_sum += squared;
+                local.max_squared = std::max(local.max_squared, squared);
+                ++local.count;
+            }
+            partial[worker].merge(local);
+        });
+
+        NormalEquations total;
+        for (const auto& p : partial) {
+            total.merge(p);
+        }
+        result.correspondences = total.count;
+        result.rms = total.count ? std::sqrt(total.squared_sum / total.count) : 0.0;
+        result.max_deviation = std::sqrt(total.max_squared);
+
+        if (step_converged) {
+            result.converged = true;
+            break;
+        }
+        if (total.count < 6 || result.iterations >= options.max_iterations) {
+            break;
+        }
+
+        double x[6];
+        if (!solveSymmetric6(total.ata, total.atb, x)) {
+            break;
+        }
+        RigidTransform step = RigidTransform::fromRotationVector(x, x + 3);
+        previous = current;
+        result.transform = step.compose(current);
+        ++result.iterations;
+
+        double rotation_step = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+        double translation_step = std::sqrt(x[3] * x[3] + x[4] * x[4] + x[5] * x[5]);
+        step_converged = rotation_step < options.rotation_tolerance &&
+                         translation_step < options.translation_tolerance;
+    }
+    return result;
+}
+
+/**
+ * @brief 将源模型的顶点对齐到名义模型
+ */
+RegistrationResult RigidRegistration::alignPointToPlane(const ModelManager& target, const ModelManager& source,
+                                                        const RegistrationOptions& options,
+                                                        const RigidTransform& initial) {
+    TriangleBVH bvh(target);
+    const auto& vertices = source.getVertices();
+    std::vector<double> xs(vertices.size()), ys(vertices.size()), zs(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        xs[i] = vertices[i]->x;
+        ys[i] = vertices[i]->y;
+        zs[i] = vertices[i]->z;
+    }
+    return alignPointToPlane(bvh, xs.data(), ys.data(), zs.data(), vertices.size(), options, initial);
+}
@@ -0,0 +1,429 @@
+#include "shared_model_region.h"
+#include "detail/posix_platform.h"
+#include "mesh_topology.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t kRegionVersion = 1;
+
+/**
+ * @brief 描述字段：由写者在序列锁保护下更新，读者以原子方式逐字段读取
+ */
+enum DescriptorField {
+    kTopologyVersion,
+    kGeometryVersion,
+    kVertexCount,
+    kFaceCount,
+    kIndexCount,
+    kEdgeCount,
+    kOffsetXs,
+    kOffsetYs,
+    kOffsetZs,
+    kOffsetIds,
+    kOffsetFaceOffsets,
+    kOffsetFaceVertices,
+    kOffsetEdgeVertices,
+    kFieldCount
+};
+
+size_t alignUp(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+} // namespace
+
+/**
+ * @brief 区域头部，位于映射起始处
+ */
+struct SharedModelRegion::Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t mapped_bytes;
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> fields[kFieldCount];
+};
+
+namespace {
+
+/**
+ * @brief 计算各数据段偏移
+ * 
+ * @return size_t 所需映射总字节数
+ */
+size_t computeLayout(size_t header_bytes, size_t n, size_t f, size_t k, size_t e, uint64_t* offsets) {
+    size_t cursor = alignUp(header_bytes);
+    offsets[0] = cursor; cursor = alignUp(cursor + n * sizeof(double));   // xs
+    offsets[1] = cursor; cursor = alignUp(cursor + n * sizeof(double));   // ys
+    offsets[2] = cursor; cursor = alignUp(cursor + n * sizeof(double));   // zs
+    offsets[3] = cursor; cursor = alignUp(cursor + n * sizeof(int32_t));  // 顶点ID
+    offsets[4] = cursor; cursor = alignUp(cursor + (f + 1) * sizeof(uint32_t)); // 面偏移
+    offsets[5] = cursor; cursor = alignUp(cursor + k * sizeof(uint32_t)); // 面顶点索引
+    offsets[6] = cursor; cursor = alignUp(cursor + 2 * e * sizeof(uint32_t)); // 边端点
+    return cursor;
+}
+
+} // namespace
+
+SharedModelRegion::SharedModelRegion() : base(nullptr), mapped_bytes(0), writer(false) {}
+
+SharedModelRegion::~SharedModelRegion() {
+    close();
+}
+
+SharedModelRegion::Header* SharedModelRegion::header() const {
+    return static_cast<Header*>(base);
+}
+
+/**
+ * @brief 创建命名区域并以写者身份映射
+ * 
+ * @param name 共享内存名称
+ * @param capacity 数据区容量（字节）
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool SharedModelRegion::create(const std::string& name, size_t capacity, std::string* error) {
+    close();
+#if CAD_HAVE_POSIX_IPC
+    size_t bytes = alignUp(sizeof(Header)) + alignUp(capacity);
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0) {
+        if (error) *error = std::string("无法创建共享内存: ") + std::strerror(errno);
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        if (error) *error = std::string("无法设置共享内存大小: ") + std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        if (error) *error = std::string("无法映射共享内存: ") + std::strerror(errno);
+        ::shm_unlink(name.c_str());
+        return false;
+    }
+    
+    Header* h = new (mapping) Header();
+    if (!h->sequence.is_lock_free()) {
+        // 跨进程的序列锁要求64位原子操作无锁
+        if (error) *error = "当前平台不支持无锁64位原子操作";
+        ::munmap(mapping, bytes);
+        ::shm_unlink(name.c_str());
+        return false;
+    }
+    std::memcpy(h->magic, "CADS", 4);
+    h->version = kRegionVersion;
+    h->mapped_bytes = bytes;
+    h->sequence.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < kFieldCount; ++i) {
+        h->fields[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    region_name = name;
+    base = mapping;
+    mapped_bytes = bytes;
+    writer = true;
+    return true;
+#else
+    (void)name;
+    (void)capacity;
+    if (error) *error = "当前平台不支持共享内存";
+    return false;
+#endif
+}
+
+/**
+ * @brief 以只读方式映射已存在的区域
+ * 
+ * @param name 共享内存名称
+ * @param error 可选的错误信息输出
+ * @return bool 是否成功
+ */
+bool SharedModelRegion::attach(const std::string& name, std::string* error) {
+    close();
+#if CAD_HAVE_POSIX_IPC
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        if (error) *error = "无法打开共享内存: " + name;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        if (error) *error = "共享内存区域不完整: " + name;
+        ::close(fd);
+        return false;
+    }
+    size_t bytes = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        if (error) *error = "无法映射共享内存: " + name;
+        return false;
+    }
+    const Header* h = static_cast<const Header*>(mapping);
+    if (std::memcmp(h->magic, "CADS", 4) != 0 || h->version != kRegionVersion || h->mapped_bytes != bytes) {
+        if (error) *error = "不是受支持的共享模型区域: " + name;
+        ::munmap(mapping, bytes);
+        return false;
+    }
+    region_name = name;
+    base = mapping;
+    mapped_bytes = bytes;
+    writer = false;
+    return true;
+#else
+    (void)name;
+    if (error) *error = "当前平台不支持共享内存";
+    return false;
+#endif
+}
+
+/**
+ * @brief 解除映射
+ */
+void SharedModelRegion::close() {
+#if CAD_HAVE_POSIX_IPC
+    if (base) {
+        ::munmap(base, mapped_bytes);
+    }
+#endif
+    base = nullptr;
+    mapped_bytes = 0;
+    writer = false;
+}
+
+/**
+ * @brief 删除共享内存对象名称
+ * 
+ * @return bool 是否成功
+ */
+bool SharedModelRegion::unlink() {
+#if CAD_HAVE_POSIX_IPC
+    return !region_name.empty() && ::shm_unlink(region_name.c_str()) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 发布模型所需的数据区容量
+ * 
+ * @param manager 模型管理器
+ * @return size_t 字节数
+ */
+size_t SharedModelRegion::requiredBytes(const ModelManager& manager) {
+    auto topology = manager.getMeshTopology();
+    uint64_t offsets[7];
+    return computeLayout(0, manager.getVertices().size(), topology->faceCount(),
+                         topology->face_vertices.size(), topology->edgeCount(), offsets);
+}
+
+/**
+ * @brief 发布模型
+ * 
+ * @param manager 模型管理器
+ * @return bool 是否成功
+ */
+bool SharedModelRegion::publish(const ModelManager& manager) {
+    if (!base || !writer) {
+        return false;
+    }
+    const auto& vertices = manager.getVertices();
+    auto topology = manager.getMeshTopology();
+    size_t n = vertices.size();
+    size_t f = topology->faceCount();
+    size_t k = topology->face_vertices.size();
+    size_t e = topology->edgeCount();
+    uint64_t offsets[7];
+    if (computeLayout(sizeof(Header), n, f, k, e, offsets) > mapped_bytes) {
+        return false;
+    }
+    
+    Header* h = header();
+    char* data = static_cast<char*>(base);
+    uint64_t sequence = h->sequence.load(std::memory_order_relaxed);
+    h->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    double* xs = reinterpret_cast<double*>(data + offsets[0]);
+    double* ys = reinterpret_cast<double*>(data + offsets[1]);
+    double* zs = reinterpret_cast<double*>(data + offsets[2]);
+    int32_t* ids = reinterpret_cast<int32_t*>(data + offsets[3]);
+    for (size_t i = 0; i < n; ++i) {
+        xs[i] = vertices[i]->x;
+        ys[i] = vertices[i]->y;
+        zs[i] = vertices[i]->z;
+        ids[i] = vertices[i]->id;
+    }
+    uint32_t* face_offsets = reinterpret_cast<uint32_t*>(data + offsets[4]);
+    for (size_t i = 0; i <= f; ++i) {
+        face_offsets[i] = static_cast<uint32_t>(topology->face_offsets[i]);
+    }
+    uint32_t* face_vertices = reinterpret_cast<uint32_t*>(data + offsets[5]);
+    for (size_t i = 0; i < k; ++i) {
+        face_vertices[i] = static_cast<uint32_t>(topology->face_vertices[i]);
+    }
+    uint32_t* edge_vertices = reinterpret_cast<uint32_t*>(data + offsets[6]);
+    for (size_t i = 0; i < 2 * e; ++i) {
+        edge_vertices[i] = static_cast<uint32_t>(topology->edge_vertices[i]);
+    }
+    
+    uint64_t fields[kFieldCount] = {
+        manager.getTopologyVersion(), manager.getGeometryVersion(), n, f, k, e,
+        offsets[0], offsets[1], offsets[2], offsets[3], offsets[4], offsets[5], offsets[6]
+    };
+    for (int i = 0; i < kFieldCount; ++i) {
+        h->fields[i].store(fields[i], std::memory_order_relaxed);
+    }
+    h->sequence.store(sequence + 2, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief 当前序列号
+ */
+uint64_t SharedModelRegion::sequence() const {
+    return base ? header()->sequence.load(std::memory_order_acquire) : 0;
+}
+
+/**
+ * @brief 开始一次读取
+ * 
+ * @param snapshot 输出快照
+ * @return bool 是否读到可用快照
+ */
+bool SharedModelRegion::beginRead(Snapshot& snapshot) const {
+    if (!base) {
+        return false;
+    }
+    const Header* h = header();
+    uint64_t sequence = h->sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1)) {
+        return false;
+    }
+    uint64_t fields[kFieldCount];
+    for (int i = 0; i < kFieldCount; ++i) {
+        fields[i] = h->fields[i].load(std::memory_order_relaxed);
+    }
+    
+    // 偏移来自共享内存，使用前校验不越界
+    uint64_t expected[7];
+    size_t bytes = computeLayout(sizeof(Header), fields[kVertexCount], fields[kFaceCount],
+                                 fields[kIndexCount], fields[kEdgeCount], expected);
+    if (bytes > mapped_bytes || fields[kVertexCount] > mapped_bytes || fields[kIndexCount] > mapped_bytes) {
+        return false;
+    }
+    for (int i = 0; i < 7; ++i) {
+        if (fields[kOffsetXs + i] != expected[i]) {
+            return false;
+        }
+    }
+    
+    const char* data = static_cast<const char*>(base);
+    snapshot.sequence = sequence;
+    snapshot.topology_version = fields[kTopologyVersion];
+    snapshot.geometry_version = fields[kGeometryVersion];
+    snapshot.vertex_count = static_cast<size_t>(fields[kVertexCount]);
+    snapshot.face_count = static_cast<size_t>(fields[kFaceCount]);
+    snapshot.index_count = static_cast<size_t>(fields[kIndexCount]);
+    snapshot.edge_count = static_cast<size_t>(fields[kEdgeCount]);
+    snapshot.xs = reinterpret_cast<const double*>(data + fields[kOffsetXs]);
+    snapshot.ys = reinterpret_cast<const double*>(data + fields[kOffsetYs]);
+    snapshot.zs = reinterpret_cast<const double*>(data + fields[kOffsetZs]);
+    snapshot.vertex_ids = reinterpret_cast<const int32_t*>(data + fields[kOffsetIds]);
+    snapshot.face_offsets = reinterpret_cast<const uint32_t*>(data + fields[kOffsetFaceOffsets]);
+    snapshot.face_vertices = reinterpret_cast<const uint32_t*>(data + fields[kOffsetFaceVertices]);
+    snapshot.edge_vertices = reinterpret_cast<const uint32_t*>(data + fields[kOffsetEdgeVertices]);
+    return true;
+}
+
+/**
+ * @brief 确认快照在读取期间未被改写
+ * 
+ * @param snapshot 快照
+ * @return bool 快照是否仍然一致
+ */
+bool SharedModelRegion::validate(const Snapshot& snapshot) const {
+    if (!base) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return header()->sequence.load(std::memory_order_relaxed) == snapshot.sequence;
+}
+
+/**
+ * @brief 读取一致版本的模型副本
+ * 
+ * 先将共享数据复制到本地缓冲区并确认版本一致，再校验面偏移与索引，
+ * 全部通过后才写入模型，失败时模型保持不变。顶点与ModelIO::parseBinary相同
+ * 从nextVertexId()起依次编号，不会与模型中已有顶点合并
+ * 
+ * @param manager 模型管理器
+ * @param max_retries 最大重试次数
+ * @return bool 是否成功
+ */
+bool SharedModelRegion::readModel(ModelManager& manager, int max_retries) const {
+    std::vector<double> xs, ys, zs;
+    std::vector<uint32_t> face_offsets, face_vertices;
+    
+    bool consistent = false;
+    for (int attempt = 0; attempt <= max_retries && !consistent; ++attempt) {
+        Snapshot snapshot;
+        if (!beginRead(snapshot)) {
+            if (sequence() == 0) {
+                return false;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        xs.assign(snapshot.xs, snapshot.xs + snapshot.vertex_count);
+        ys.assign(snapshot.ys, snapshot.ys + snapshot.vertex_count);
+        zs.assign(snapshot.zs, snapshot.zs + snapshot.vertex_count);
+        face_offsets.assign(snapshot.face_offsets, snapshot.face_offsets + snapshot.face_count + 1);
+        face_vertices.assign(snapshot.face_vertices, snapshot.face_vertices + snapshot.index_count);
+        consistent = validate(snapshot);
+    }
+    if (!consistent) {
+        return false;
+    }
+    
+    // 版本一致后校验结构，再写入模型
+    for (size_t f = 0; f + 1 < face_offsets.size(); ++f) {
+        if (face_offsets[f + 1] < face_offsets[f] || face_offsets[f + 1] > face_vertices.size()) {
+            return false;
+        }
+    }
+    for (uint32_t index : face_vertices) {
+        if (index >= xs.size()) {
+            return false;
+        }
+    }
+    
+    int vertex_base = manager.nextVertexId();
+    manager.reserveVertices(manager.getVertices().size() + xs.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        manager.addVertex(vertex_base + static_cast<int>(i), xs[i], ys[i], zs[i]);
+    }
+    int face_id = manager.nextFaceId();
+    manager.reserveFaces(manager.getFaces().size() + (face_offsets.empty() ? 0 : face_offsets.size() - 1));
+    std::vector<int> loop;
+    for (size_t f = 0; f + 1 < face_offsets.size(); ++f) {
+        loop.clear();
+        for (uint32_t c = face_offsets[f]; c < face_offsets[f + 1]; ++c) {
+            loop.push_back(vertex_base + static_cast<int>(face_vertices[c]));
+        }
+        if (loop.size() >= 3) {
+            manager.addFaceFromVertices(face_id++, loop);
+        }
+    }
+    return true;
+}
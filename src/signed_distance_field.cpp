@@ -0,0 +1,268 @@
+#include "signed_distance_field.h"
+#include "triangle_bvh.h"
+#include "winding_number.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace {
+
+const int kBlockVolume = SignedDistanceField::kBlockSize * SignedDistanceField::kBlockSize *
+                         SignedDistanceField::kBlockSize;
+
+/**
+ * @brief 程函方程 |∇d| = 1 的Godunov迎风更新
+ */
+double solveEikonal(double a, double b, double c, double h) {
+    double v[3] = {a, b, c};
+    std::sort(v, v + 3);
+    double d = v[0] + h;
+    if (d <= v[1]) return d;
+    d = 0.5 * (v[0] + v[1] + std::sqrt(2.0 * h * h - (v[0] - v[1]) * (v[0] - v[1])));
+    if (d <= v[2]) return d;
+    double s = v[0] + v[1] + v[2];
+    double q = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    double disc = s * s - 3.0 * (q - h * h);
+    return (s + std::sqrt(std::max(0.0, disc))) / 3.0;
+}
+
+} // namespace
+
+/**
+ * @brief 构建距离场
+ * 
+ * @param manager 模型管理器
+ * @param cell_size 网格间距
+ * @param band_cells 窄带半宽（网格数）
+ */
+SignedDistanceField::SignedDistanceField(const ModelManager& manager, double cell_size, int band_cells)
+    : cell(cell_size), band(cell_size * std::max(1, band_cells)) {
+    auto bvh = std::make_shared<TriangleBVH>(manager);
+    WindingNumber winding(bvh);
+    
+    double lo[3] = {0.0, 0.0, 0.0};
+    double hi[3] = {0.0, 0.0, 0.0};
+    bvh->getBounds(lo, hi);
+    for (int a = 0; a < 3; ++a) {
+        origin[a] = lo[a] - band - cell;
+        dims[a] = static_cast<int>(std::ceil((hi[a] - lo[a] + 2.0 * (band + cell)) / cell)) + 1;
+        block_dims[a] = (dims[a] + kBlockSize - 1) / kBlockSize;
+    }
+    size_t block_count = static_cast<size_t>(block_dims[0]) * block_dims[1] * block_dims[2];
+    block_offsets.assign(block_count, -1);
+    block_inside.assign(block_count, 0);
+    
+    // 标记窄带覆盖的块
+    std::vector<char> marked(block_count, 0);
+    for (size_t t = 0; t < bvh->triangleCount(); ++t) {
+        const double* p = bvh->triangle(t);
+        int range[3][2];
+        for (int a = 0; a < 3; ++a) {
+            double tmin = std::min(p[a], std::min(p[3 + a], p[6 + a])) - band;
+            double tmax = std::max(p[a], std::max(p[3 + a], p[6 + a])) + band;
+            range[a][0] = std::max(0, static_cast<int>(std::floor((tmin - origin[a]) / cell))) / kBlockSize;
+            range[a][1] = std::min(dims[a] - 1, static_cast<int>(std::ceil((tmax - origin[a]) / cell))) / kBlockSize;
+        }
+        for (int bz = range[2][0]; bz <= range[2][1]; ++bz) {
+            for (int by = range[1][0]; by <= range[1][1]; ++by) {
+                for (int bx = range[0][0]; bx <= range[0][1]; ++bx) {
+                    marked[(static_cast<size_t>(bz) * block_dims[1] + by) * block_dims[0] + bx] = 1;
+                }
+            }
+        }
+    }
+    std::vector<int> allocated;
+    for (size_t b = 0; b < block_count; ++b) {
+        if (marked[b]) {
+            block_offsets[b] = static_cast<int32_t>(allocated.size() * kBlockVolume);
+            allocated.push_back(static_cast<int>(b));
+        }
+    }
+    const float unknown = std::numeric_limits<float>::max();
+    values.assign(allocated.size() * kBlockVolume, unknown);
+    
+    // 窄带节点：BVH最近点求距离，绕数定符号（多线程，按块划分）
+    ParallelUtils::parallelFor(allocated.size(), 4, [&](size_t begin, size_t end) {
+        ClosestPointResult closest;
+        for (size_t n = begin; n < end; ++n) {
+            int b = allocated[n];
+            int bx = b % block_dims[0];
+            int by = (b / block_dims[0]) % block_dims[1];
+            int bz = b / (block_dims[0] * block_dims[1]);
+            float* block = &values[block_offsets[b]];
+            for (int lz = 0; lz < kBlockSize; ++lz) {
+                for (int ly = 0; ly < kBlockSize; ++ly) {
+                    for (int lx = 0; lx < kBlockSize; ++lx) {
+                        double x = origin[0] + (bx * kBlockSize + lx) * cell;
+                        double y = origin[1] + (by * kBlockSize + ly) * cell;
+                        double z = origin[2] + (bz * kBlockSize + lz) * cell;
+                        if (!bvh->closestPoint(x, y, z, band, closest)) continue;
+                        double d = closest.distance;
+                        if (d > 1e-12 * cell && winding.isInside(x, y, z)) d = -d;
+                        block[(lz * kBlockSize + ly) * kBlockSize + lx] = static_cast<float>(d);
+                    }
+                }
+            }
+        }
+    });
+    
+    // 未分配块整体位于窄带之外，取块中心的内外状态
+    ParallelUtils::parallelFor(block_count, 256, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            if (block_offsets[b] >= 0) continue;
+            int bx = static_cast<int>(b % block_dims[0]);
+            int by = static_cast<int>((b / block_dims[0]) % block_dims[1]);
+            int bz = static_cast<int>(b / (static_cast<size_t>(block_dims[0]) * block_dims[1]));
+            double half = 0.5 * (kBlockSize - 1) * cell;
+            block_inside[b] = winding.isInside(origin[0] + bx * kBlockSize * cell + half,
+                                               origin[1] + by * kBlockSize * cell + half,
+                                               origin[2] + bz * kBlockSize * cell + half) ? 1 : 0;
+        }
+    });
+    
+    // 快速扫描：对窄带未覆盖的节点按8个方向交替扫描求解无符号距离
+    std::vector<char> frozen(values.size());
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < values.size(); ++i) {
+        frozen[i] = values[i] != unknown;
+        if (!frozen[i]) pending.push_back(i);
+    }
+    if (!pending.empty()) {
+        auto magnitude = [&](int i, int j, int k) -> double {
+            if (i < 0 || j < 0 || k < 0 || i >= dims[0] || j >= dims[1] || k >= dims[2]) {
+                return 1e30;
+            }
+            int32_t offset = block_offsets[blockOf(i, j, k)];
+            if (offset < 0) return 1e30;
+            float v = values[offset + ((k % kBlockSize) * kBlockSize + (j % kBlockSize)) * kBlockSize + (i % kBlockSize)];
+            return v == unknown ? 1e30 : std::fabs(v);
+        };
+        // 块级快速扫描：块按扫描方向排序，块内节点同向遍历
+        std::vector<int> order(allocated.size());
+        for (int round = 0; round < 2; ++round) {
+            for (int dir = 0; dir < 8; ++dir) {
+                int sx = (dir & 1) ? -1 : 1;
+                int sy = (dir & 2) ? -1 : 1;
+                int sz = (dir & 4) ? -1 : 1;
+                for (size_t n = 0; n < order.size(); ++n) order[n] = static_cast<int>(n);
+                std::sort(order.begin(), order.end(), [&](int lhs, int rhs) {
+                    int a_block = allocated[lhs];
+                    int b_block = allocated[rhs];
+                    int az = a_block / (block_dims[0] * block_dims[1]);
+                    int bz = b_block / (block_dims[0] * block_dims[1]);
+                    if (az != bz) return sz > 0 ? az < bz : az > bz;
+                    int ay = (a_block / block_dims[0]) % block_dims[1];
+                    int by = (b_block / block_dims[0]) % block_dims[1];
+                    if (ay != by) return sy > 0 ? ay < by : ay > by;
+                    int ax = a_block % block_dims[0];
+                    int bx = b_block % block_dims[0];
+                    return sx > 0 ? ax < bx : ax > bx;
+                });
+                for (int n : order) {
+                    int b = allocated[n];
+                    int base_i = (b % block_dims[0]) * kBlockSize;
+                    int base_j = ((b / block_dims[0]) % block_dims[1]) * kBlockSize;
+                    int base_k = (b / (block_dims[0] * block_dims[1])) * kBlockSize;
+                    for (int lz = 0; lz < kBlockSize; ++lz) {
+                        int k = base_k + (sz > 0 ? lz : kBlockSize - 1 - lz);
+                        for (int ly = 0; ly < kBlockSize; ++ly) {
+                            int j = base_j + (sy > 0 ? ly : kBlockSize - 1 - ly);
+                            for (int lx = 0; lx < kBlockSize; ++lx) {
+                                int i = base_i + (sx > 0 ? lx : kBlockSize - 1 - lx);
+                                size_t index = static_cast<size_t>(n) * kBlockVolume +
+                                               ((k - base_k) * kBlockSize + (j - base_j)) * kBlockSize + (i - base_i);
+                                if (frozen[index]) continue;
+                                double xa = std::min(magnitude(i - 1, j, k), magnitude(i + 1, j, k));
+                                double ya = std::min(magnitude(i, j - 1, k), magnitude(i, j + 1, k));
+                                double za = std::min(magnitude(i, j, k - 1), magnitude(i, j, k + 1));
+                                double nearest = std::min(xa, std::min(ya, za));
+                                if (nearest >= 1e30) continue;
+                                double d = solveEikonal(std::min(xa, 1e30), std::min(ya, 1e30), std::min(za, 1e30), cell);
+                                if (d < magnitude(i, j, k)) values[index] = static_cast<float>(d);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        
+        // 扫描得到的是无符号距离，符号由绕数确定
+        ParallelUtils::parallelFor(pending.size(), 256, [&](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p) {
+                size_t index = pending[p];
+                size_t block = index / kBlockVolume;
+                int local = static_cast<int>(index % kBlockVolume);
+                int b = allocated[block];
+                int i = (b % block_dims[0]) * kBlockSize + local % kBlockSize;
+                int j = ((b / block_dims[0]) % block_dims[1]) * kBlockSize + (local / kBlockSize) % kBlockSize;
+                int k = (b / (block_dims[0] * block_dims[1])) * kBlockSize + local / (kBlockSize * kBlockSize);
+                float magnitude_value = values[index] == unknown ? static_cast<float>(band) : values[index];
+                bool inside = winding.isInside(origin[0] + i * cell, origin[1] + j * cell, origin[2] + k * cell);
+                values[index] = inside ? -magnitude_value : magnitude_value;
+            }
+        });
+    }
+}
+
+/**
+ * @brief 获取网格节点的有向距离
+ * 
+ * @param i x方向节点索引
+ * @param j y方向节点索引
+ * @param k z方向节点索引
+ * @return double 有向距离
+ */
+double SignedDistanceField::value(int i, int j, int k) const {
+    if (i < 0 || j < 0 || k < 0 || i >= dims[0] || j >= dims[1] || k >= dims[2]) {
+        return band;
+    }
+    int b = blockOf(i, j, k);
+    int32_t offset = block_offsets[b];
+    if (offset < 0) {
+        return block_inside[b] ? -band : band;
+    }
+    return values[offset + ((k % kBlockSize) * kBlockSize + (j % kBlockSize)) * kBlockSize + (i % kBlockSize)];
+}
+
+/**
+ * @brief 三线性插值查询任意点的有向距离
+ * 
+ * @param x x坐标
+ * @param y y坐标
+ * @param z z坐标
+ * @return double 有向距离
+ */
+double SignedDistanceField::sample(double x, double y, double z) const {
+    double f[3] = {(x - origin[0]) / cell, (y - origin[1]) / cell, (z - origin[2]) / cell};
+    int idx[3];
+    double t[3];
+    for (int a = 0; a < 3; ++a) {
+        double clamped = std::max(0.0, std::min(f[a], static_cast<double>(dims[a] - 1)));
+        idx[a] = std::min(static_cast<int>(clamped), dims[a] - 2);
+        t[a] = clamped - idx[a];
+    }
+    double c000 = value(idx[0], idx[1], idx[2]);
+    double c100 = value(idx[0] + 1, idx[1], idx[2]);
+    double c010 = value(idx[0], idx[1] + 1, idx[2]);
+    double c110 = value(idx[0] + 1, idx[1] + 1, idx[2]);
+    double c001 = value(idx[0], idx[1], idx[2] + 1);
+    double c101 = value(idx[0] + 1, idx[1], idx[2] + 1);
+    double c011 = value(idx[0], idx[1] + 1, idx[2] + 1);
+    double c111 = value(idx[0] + 1, idx[1] + 1, idx[2] + 1);
+    double c00 = c000 + (c100 - c000) * t[0];
+    double c10 = c010 + (c110 - c010) * t[0];
+    double c01 = c001 + (c101 - c001) * t[0];
+    double c11 = c011 + (c111 - c011) * t[0];
+    double c0 = c00 + (c10 - c00) * t[1];
+    double c1 = c01 + (c11 - c01) * t[1];
+    return c0 + (c1 - c0) * t[2];
+}
+
+/**
+ * @brief 距离场占用的内存字节数
+ */
+size_t SignedDistanceField::memoryBytes() const {
+    return values.size() * sizeof(float) + block_offsets.size() * sizeof(int32_t) + block_inside.size();
+}
@@ -0,0 +1,353 @@
+#include "slicer.h"
+#include "detail/hash_mix.h"
+#include "mesh_topology.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+const size_t kTriangleChunks = 64; // 分桶时三角形的固定分块数（与线程数无关，结果确定）
+
+inline uint64_t edgeKey(int a, int b) {
+    uint32_t lo = static_cast<uint32_t>(std::min(a, b));
+    uint32_t hi = static_cast<uint32_t>(std::max(a, b));
+    return (static_cast<uint64_t>(lo) << 32) | hi;
+}
+
+} // namespace
+
+/**
+ * @brief 从模型构建
+ *
+ * 法向归一化后取与法向最不平行的坐标轴构造正交基，z向分层时u、v即为x、y轴
+ */
+Slicer::Slicer(const ModelManager& manager, double nx, double ny, double nz) {
+    double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+    if (!(length > 0.0)) {
+        nx = ny = 0.0;
+        nz = length = 1.0;
+    }
+    normal[0] = nx / length;
+    normal[1] = ny / length;
+    normal[2] = nz / length;
+    if (std::fabs(normal[2]) >= std::fabs(normal[0]) && std::fabs(normal[2]) >= std::fabs(normal[1])) {
+        // v = n × x̂，u = v × n；n = ẑ 时 u = x̂，v = ŷ
+        axis_v[0] = 0.0;
+        axis_v[1] = normal[2];
+        axis_v[2] = -normal[1];
+    } else {
+        // v = ẑ × n
+        axis_v[0] = -normal[1];
+        axis_v[1] = normal[0];
+        axis_v[2] = 0.0;
+    }
+    double lv = std::sqrt(axis_v[0] * axis_v[0] + axis_v[1] * axis_v[1] + axis_v[2] * axis_v[2]);
+    for (int k = 0; k < 3; ++k) {
+        axis_v[k] /= lv;
+    }
+    axis_u[0] = axis_v[1] * normal[2] - axis_v[2] * normal[1];
+    axis_u[1] = axis_v[2] * normal[0] - axis_v[0] * normal[2];
+    axis_u[2] = axis_v[0] * normal[1] - axis_v[1] * normal[0];
+
+    const auto& vertices = manager.getVertices();
+    vertex_height.resize(vertices.size());
+    vertex_u.resize(vertices.size());
+    vertex_v.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Point3D& p = *vertices[i];
+        vertex_height[i] = normal[0] * p.x + normal[1] * p.y + normal[2] * p.z;
+        vertex_u[i] = axis_u[0] * p.x + axis_u[1] * p.y + axis_u[2] * p.z;
+        vertex_v[i] = axis_v[0] * p.x + axis_v[1] * p.y + axis_v[2] * p.z;
+    }
+
+    auto topology = manager.getMeshTopology();
+    triangle_vertices = topology->triangle_vertices;
+    const size_t count = triangle_vertices.size() / 3;
+    triangle_low.resize(count);
+    triangle_high.resize(count);
+    for (size_t t = 0; t < count; ++t) {
+        double h0 = vertex_height[triangle_vertices[3 * t]];
+        double h1 = vertex_height[triangle_vertices[3 * t + 1]];
+        double h2 = vertex_height[triangle_vertices[3 * t + 2]];
+        triangle_low[t] = std::min(h0, std::min(h1, h2));
+        triangle_high[t] = std::max(h0, std::max(h1, h2));
+    }
+}
+
+/**
+ * @brief 模型沿法向的高度范围
+ */
+bool Slicer::heightRange(double& low, double& high) const {
+    if (triangle_low.empty()) {
+        return false;
+    }
+    low = *std::min_element(triangle_low.begin(), triangle_low.end());
+    high = *std::max_element(triangle_high.begin(), triangle_high.end());
+    return true;
+}
+
+/**
+ * @brief 获取截平面坐标基
+ */
+void Slicer::basis(double* u, double* v, double* n) const {
+    for (int k = 0; k < 3; ++k) {
+        u[k] = axis_u[k];
+        v[k] = axis_v[k];
+        n[k] = normal[k];
+    }
+}
+
+/**
+ * @brief 单个截平面
+ */
+Slice Slicer::slice(double offset) const {
+    return slice(std::vector<double>(1, offset)).front();
+}
+
+/**
+ * @brief 多个平行截平面
+ *
+ * 截平面位置排序后，每个三角形跨越的截平面为满足 low < L ≤ high 的连续一段，
+ * 由两次二分查找得到。三角形按固定分块计数、前缀和后并行填入各截平面的桶，
+ * 再在截平面间并行生成线段并串接轮廓
+ */
+std::vector<Slice> Slicer::slice(const std::vector<double>& offsets) const {
+    const size_t slice_count = offsets.size();
+    std::vector<Slice> results(slice_count);
+    for (size_t i = 0; i < slice_count; ++i) {
+        results[i].offset = offsets[i];
+    }
+    const size_t count = triangle_low.size();
+    if (slice_count == 0 || count == 0) {
+        return results;
+    }
+    std::vector<size_t> order(slice_count);
+    for (size_t i = 0; i < slice_count; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return offsets[a] < offsets[b]; });
+    std::vector<double> levels(slice_count);
+    for (size_t i = 0; i < slice_count; ++i) {
+        levels[i] = offsets[order[i]];
+    }
+
+    // 分块计数：counts[c·S + k]为第c块中跨越第k个截平面的三角形数
+    const size_t chunk_size = (count + kTriangleChunks - 1) / kTriangleChunks;
+    const size_t chunks = (count + chunk_size - 1) / chunk_size;
+    std::vector<size_t> counts(chunks * slice_count, 0);
+    auto span = [&](size_t t, size_t& first, size_t& last) {
+        first = std::upper_bound(levels.begin(), levels.end(), triangle_low[t]) - levels.begin();
+        last = std::upper_bound(levels.begin() + first, levels.end(), triangle_high[t]) - levels.begin();
+    };
+    ParallelUtils::parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            size_t* row = &counts[c * slice_count];
+            for (size_t t = c * chunk_size; t < std::min(count, (c + 1) * chunk_size); ++t) {
+                size_t first, last;
+                span(t, first, last);
+                for (size_t k = first; k < last; ++k) {
+                    ++row[k];
+                }
+            }
+        }
+    });
+    std::vector<size_t> bucket_offsets(slice_count + 1, 0);
+    size_t total = 0;
+    for (size_t k = 0; k < slice_count; ++k) {
+        bucket_offsets[k] = total;
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t n = counts[c * slice_count + k];
+            counts[c * slice_count + k] = total;
+            total += n;
+        }
+    }
+    bucket_offsets[slice_count] = total;
+    std::vector<int> buckets(total);
+    ParallelUtils::parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            size_t* cursor = &counts[c * slice_count];
+            for (size_t t = c * chunk_size; t < std::min(count, (c + 1) * chunk_size); ++t) {
+                size_t first, last;
+                span(t, first, last);
+                for (size_t k = first; k < last; ++k) {
+                    buckets[cursor[k]++] = static_cast<int>(t);
+                }
+            }
+        }
+    });
+
+    struct Scratch {
+        std::vector<Segment> segments;
+        std::vector<uint32_t> table;
+        std::vector<char> flags;
+    };
+    std::vector<Scratch> scratch(ParallelUtils::threadCount());
+    ParallelUtils::parallelForWithWorker(slice_count, 1, [&](size_t begin, size_t end, unsigned worker) {
+        Scratch& local = scratch[worker];
+        for (size_t k = begin; k < end; ++k) {
+            local.segments.clear();
+            for (size_t i = bucket_offsets[k]; i < bucket_offsets[k + 1]; ++i) {
+                buildSegments(buckets[i], levels[k], local.segments);
+            }
+            chain(local.segments, local.table, local.flags, results[order[k]].contours);
+        }
+    });
+    return results;
+}
+
+/**
+ * @brief 等间距分层
+ */
+std::vector<Slice> Slicer::sliceUniform(size_t count) const {
+    double low, high;
+    if (count == 0 || !heightRange(low, high)) {
+        return std::vector<Slice>();
+    }
+    std::vector<double> offsets(count);
+    double step = (high - low) / count;
+    for (size_t i = 0; i < count; ++i) {
+        offsets[i] = low + (i + 0.5) * step;
+    }
+    return slice(offsets);
+}
+
+/**
+ * @brief 轮廓有向面积（鞋带公式）
+ */
+double Slicer::signedArea(const SliceContour& contour) {
+    const size_t n = contour.size();
+    if (n < 3) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+        sum += (contour.x[j] - contour.x[i]) * (contour.y[j] + contour.y[i]);
+    }
+    return 0.5 * sum;
+}
+
+/**
+ * @brief 由跨越截平面的三角形生成一条有向线段
+ *
+ * 沿三角形顶点顺序，从“上方→下方”的边指向“下方→上方”的边。面方向一致朝外时，
+ * 从法向正方向看实体外轮廓为逆时针。交点按边的小索引端点插值，保证相邻三角形结果一致
+ */
+void Slicer::buildSegments(int triangle, double offset, std::vector<Segment>& segments) const {
+    const int* ids = &triangle_vertices[3 * triangle];
+    bool above[3];
+    for (int i = 0; i < 3; ++i) {
+        above[i] = vertex_height[ids[i]] >= offset;
+    }
+    Segment segment;
+    bool has_start = false;
+    bool has_end = false;
+    for (int i = 0; i < 3; ++i) {
+        int j = (i + 1) % 3;
+        if (above[i] == above[j]) {
+            continue;
+        }
+        int lo = std::min(ids[i], ids[j]);
+        int hi = std::max(ids[i], ids[j]);
+        double f = (offset - vertex_height[lo]) / (vertex_height[hi] - vertex_height[lo]);
+        double x = vertex_u[lo] + f * (vertex_u[hi] - vertex_u[lo]);
+        double y = vertex_v[lo] + f * (vertex_v[hi] - vertex_v[lo]);
+        if (above[i]) {
+            segment.start_key = edgeKey(lo, hi);
+            segment.start[0] = x;
+            segment.start[1] = y;
+            has_start = true;
+        } else {
+            segment.end_key = edgeKey(lo, hi);
+            segment.end[0] = x;
+            segment.end[1] = y;
+            has_end = true;
+        }
+    }
+    if (has_start && has_end) {
+        segments.push_back(segment);
+    }
+}
+
+/**
+ * @brief 将线段首尾相接串成轮廓
+ *
+ * 以起点键建立开放寻址哈希表；先标记有前驱的线段，从无前驱的线段出发得到开放折线，
+ * 剩余未访问的线段构成闭合环。同一条边作为多个线段起点（非流形）时只登记第一个
+ */
+void Slicer::chain(std::vector<Segment>& segments, std::vector<uint32_t>& table, std::vector<char>& flags,
+                   std::vector<SliceContour>& contours) const {
+    const size_t n = segments.size();
+    if (n == 0) {
+        return;
+    }
+    size_t capacity = 16;
+    while (capacity < 2 * n) {
+        capacity <<= 1;
+    }
+    const size_t mask = capacity - 1;
+    table.assign(capacity, 0);
+    for (size_t s = 0; s < n; ++s) {
+        for (size_t slot = detail::mix(segments[s].start_key) & mask;; slot = (slot + 1) & mask) {
+            if (table[slot] == 0) {
+                table[slot] = static_cast<uint32_t>(s + 1);
+                break;
+            }
+            if (segments[table[slot] - 1].start_key == segments[s].start_key) {
+                break;
+            }
+        }
+    }
+    auto find = [&](uint64_t key) -> long {
+        for (size_t slot = detail::mix(key) & mask;; slot = (slot + 1) & mask) {
+            if (table[slot] == 0) {
+                return -1;
+            }
+            if (segments[table[slot] - 1].start_key == key) {
+                return static_cast<long>(table[slot]) - 1;
+            }
+        }
+    };
+
+    const char kVisited = 1;
+    const char kHasPredecessor = 2;
+    flags.assign(n, 0);
+    for (size_t s = 0; s < n; ++s) {
+        long next = find(segments[s].end_key);
+        if (next >= 0) {
+            flags[next] |= kHasPredecessor;
+        }
+    }
+    auto walk = [&](size_t first) {
+        SliceContour contour;
+        size_t current = first;
+        for (;;) {
+            flags[current] |= kVisited;
+            contour.x.push_back(segments[current].start[0]);
+            contour.y.push_back(segments[current].start[1]);
+            long next = find(segments[current].end_key);
+            if (next == static_cast<long>(first)) {
+                contour.closed = true;
+                break;
+            }
+            if (next < 0 || (flags[next] & kVisited)) {
+                contour.x.push_back(segments[current].end[0]);
+                contour.y.push_back(segments[current].end[1]);
+                break;
+            }
+            current = static_cast<size_t>(next);
+        }
+        contours.push_back(std::move(contour));
+    };
+    for (size_t s = 0; s < n; ++s) {
+        if (!(flags[s] & kHasPredecessor)) {
+            walk(s);
+        }
+    }
+    for (size_t s = 0; s < n; ++s) {
+        if (!(flags[s] & kVisited)) {
+            walk(s);
+        }
+    }
+}
@@ -0,0 +1,336 @@
+#include "surface_sampler.h"
+#include "detail/hash_mix.h"
+#include "mesh_topology.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+
+const size_t kSampleBlock = 4096;   // 均匀采样的分块大小（决定随机数流的划分）
+const int kTileCells = 4;           // 泊松圆盘采样瓦片边长（单元数），瓦片边长约2.3r
+const int kHalo = 2;                // 冲突检查需要的相邻单元层数（r/单元边长向上取整）
+const int kTileSpan = kTileCells + 2 * kHalo;
+const int kMaxCellCoordinate = (1 << 21) - 1;
+
+/**
+ * @brief splitmix64随机数发生器
+ */
+struct SplitMix64 {
+    uint64_t state;
+
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t x = state;
+        state += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+} // namespace
+
+/**
+ * @brief 从模型构建
+ *
+ * 按三角形计算面积并构建别名表，三角形存为顶点a与两条边向量，采样时只需两次乘加
+ */
+SurfaceSampler::SurfaceSampler(const ModelManager& manager)
+    : total_area(0.0) {
+    auto topology = manager.getMeshTopology();
+    const auto& vertices = manager.getVertices();
+    size_t triangle_count = topology->triangleCount();
+    triangle_frames.resize(9 * triangle_count);
+    triangle_faces = topology->triangle_faces;
+    std::vector<double> areas(triangle_count);
+    for (size_t t = 0; t < triangle_count; ++t) {
+        const Point3D& a = *vertices[topology->triangle_vertices[3 * t]];
+        const Point3D& b = *vertices[topology->triangle_vertices[3 * t + 1]];
+        const Point3D& c = *vertices[topology->triangle_vertices[3 * t + 2]];
+        double* frame = &triangle_frames[9 * t];
+        frame[0] = a.x;
+        frame[1] = a.y;
+        frame[2] = a.z;
+        frame[3] = b.x - a.x;
+        frame[4] = b.y - a.y;
+        frame[5] = b.z - a.z;
+        frame[6] = c.x - a.x;
+        frame[7] = c.y - a.y;
+        frame[8] = c.z - a.z;
+        double nx = frame[4] * frame[8] - frame[5] * frame[7];
+        double ny = frame[5] * frame[6] - frame[3] * frame[8];
+        double nz = frame[3] * frame[7] - frame[4] * frame[6];
+        areas[t] = 0.5 * std::sqrt(nx * nx + ny * ny + nz * nz);
+        total_area += areas[t];
+    }
+    buildAliasTable(areas);
+}
+
+/**
+ * @brief 构建别名表（Vose算法）
+ */
+void SurfaceSampler::buildAliasTable(const std::vector<double>& areas) {
+    size_t n = areas.size();
+    alias_table.resize(n);
+    if (n == 0 || !(total_area > 0.0)) {
+        for (size_t i = 0; i < n; ++i) {
+            alias_table[i].threshold = 0xffffffffu;
+            alias_table[i].alias = static_cast<uint32_t>(i);
+        }
+        return;
+    }
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = areas[i] * n / total_area;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+    auto setEntry = [this](uint32_t column, double probability, uint32_t alias) {
+        double threshold = std::min(1.0, probability) * 4294967296.0;
+        alias_table[column].threshold = threshold >= 4294967295.0 ? 0xffffffffu : static_cast<uint32_t>(threshold);
+        alias_table[column].alias = alias;
+    };
+    while (!small.empty() && !large.empty()) {
+        uint32_t s = small.back();
+        small.pop_back();
+        uint32_t l = large.back();
+        setEntry(s, scaled[s], l);
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // 剩余列的概率因舍入误差应为1
+    for (uint32_t i : large) setEntry(i, 1.0, i);
+    for (uint32_t i : small) setEntry(i, 1.0, i);
+}
+
+/**
+ * @brief 生成样本序列中第first_block块起的count个样本
+ *
+ * 第b块的随机数流由(seed, b)决定，因此分批生成与一次性生成得到相同的序列
+ */
+void SurfaceSampler::generate(uint64_t seed, size_t first_block, size_t count, double* xs, double* ys, double* zs,
+                              int* faces) const {
+    const uint64_t columns = alias_table.size();
+    size_t blocks = (count + kSampleBlock - 1) / kSampleBlock;
+    ParallelUtils::parallelFor(blocks, 1, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block) {
+            SplitMix64 rng(detail::mix(seed ^ detail::mix(first_block + block)));
+            size_t first = block * kSampleBlock;
+            size_t last = std::min(count, first + kSampleBlock);
+            for (size_t i = first; i < last; ++i) {
+                // 高32位选列，低32位与保留概率比较
+                uint64_t r = rng.next();
+                uint32_t column = static_cast<uint32_t>(((r >> 32) * columns) >> 32);
+                const AliasEntry& entry = alias_table[column];
+                uint32_t t = static_cast<uint32_t>(r) < entry.threshold ? column : entry.alias;
+
+                double s = std::sqrt(rng.uniform());
+                double v = rng.uniform();
+                double wb = s * (1.0 - v);
+                double wc = s * v;
+                const double* frame = &triangle_frames[9 * static_cast<size_t>(t)];
+                xs[i] = frame[0] + wb * frame[3] + wc * frame[6];
+                ys[i] = frame[1] + wb * frame[4] + wc * frame[7];
+                zs[i] = frame[2] + wb * frame[5] + wc * frame[8];
+                if (faces) {
+                    faces[i] = triangle_faces[t];
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief 面积加权均匀采样
+ */
+void SurfaceSampler::sampleUniform(size_t count, uint64_t seed, double* xs, double* ys, double* zs, int* faces) const {
+    if (alias_table.empty()) {
+        return;
+    }
+    generate(seed, 0, count, xs, ys, zs, faces);
+}
+
+/**
+ * @brief 面积加权均匀采样，追加到点云
+ *
+ * 分批生成再追加，内存只占一批样本；样本序列与一次性生成相同
+ */
+void SurfaceSampler::sampleUniform(size_t count, uint64_t seed, PointCloud& cloud) const {
+    if (alias_table.empty()) {
+        return;
+    }
+    size_t batch = std::max<size_t>(1, ParallelUtils::threadCount()) * 64 * kSampleBlock;
+    std::vector<double> xs(std::min(batch, count)), ys(xs.size()), zs(xs.size());
+    cloud.reserve(cloud.size() + count);
+    for (size_t done = 0; done < count; done += batch) {
+        size_t n = std::min(batch, count - done);
+        generate(seed, done / kSampleBlock, n, xs.data(), ys.data(), zs.data(), nullptr);
+        cloud.append(xs.data(), ys.data(), zs.data(), n);
+    }
+}
+
+/**
+ * @brief 泊松圆盘采样
+ */
+SurfaceSamples SurfaceSampler::samplePoissonDisk(double radius, uint64_t seed, double candidate_factor) const {
+    SurfaceSamples samples;
+    if (alias_table.empty() || !(radius > 0.0) || !(total_area > 0.0)) {
+        return samples;
+    }
+    size_t candidate_count = static_cast<size_t>(std::ceil(candidate_factor * total_area / (radius * radius)));
+    candidate_count = std::min<size_t>(std::max<size_t>(candidate_count, 1), 0xffffffffu);
+    std::vector<double> xs(candidate_count), ys(candidate_count), zs(candidate_count);
+    std::vector<int> faces(candidate_count);
+    sampleUniform(candidate_count, seed, xs.data(), ys.data(), zs.data(), faces.data());
+
+    // 网格单元边长r/√3，单元对角线不超过r，每个单元至多容纳一个接受点；瓦片按键哈希索引
+    double lo[3] = {xs[0], ys[0], zs[0]};
+    for (size_t i = 1; i < candidate_count; ++i) {
+        lo[0] = std::min(lo[0], xs[i]);
+        lo[1] = std::min(lo[1], ys[i]);
+        lo[2] = std::min(lo[2], zs[i]);
+    }
+    const double cell = radius / std::sqrt(3.0);
+    const double r2 = radius * radius;
+    std::vector<int> cells(3 * candidate_count);
+    for (size_t i = 0; i < candidate_count; ++i) {
+        const double p[3] = {xs[i], ys[i], zs[i]};
+        for (int k = 0; k < 3; ++k) {
+            double c = (p[k] - lo[k]) / cell;
+            if (c > kMaxCellCoordinate - kHalo) {
+                return samples; // 半径相对模型尺寸过小
+            }
+            cells[3 * i + k] = static_cast<int>(c);
+        }
+    }
+
+    // 按（颜色，瓦片，候选序号）排序
+    std::vector<std::pair<uint64_t, uint32_t>> order(candidate_count);
+    for (size_t i = 0; i < candidate_count; ++i) {
+        uint64_t tx = cells[3 * i] / kTileCells;
+        uint64_t ty = cells[3 * i + 1] / kTileCells;
+        uint64_t tz = cells[3 * i + 2] / kTileCells;
+        uint64_t color = (tx & 1) | ((ty & 1) << 1) | ((tz & 1) << 2);
+        order[i] = std::make_pair((color << 60) | (tz << 40) | (ty << 20) | tx, static_cast<uint32_t>(i));
+    }
+    std::sort(order.begin(), order.end());
+
+    // 瓦片范围
+    std::vector<size_t> tile_starts;
+    for (size_t i = 0; i < candidate_count; ++i) {
+        if (i == 0 || order[i].first != order[i - 1].first) {
+            tile_starts.push_back(i);
+        }
+    }
+    tile_starts.push_back(candidate_count);
+    size_t tile_count = tile_starts.size() - 1;
+
+    // 哈希网格以瓦片为桶：瓦片坐标→瓦片序号，桶内为该瓦片已接受的候选点
+    const uint64_t kTileMask = (1ULL << 60) - 1;
+    std::unordered_map<uint64_t, size_t> tile_lookup;
+    tile_lookup.reserve(2 * tile_count);
+    for (size_t tile = 0; tile < tile_count; ++tile) {
+        tile_lookup[order[tile_starts[tile]].first & kTileMask] = tile;
+    }
+    std::vector<std::vector<uint32_t>> tile_accepted(tile_count);
+    size_t accepted_total = 0;
+    size_t color_begin = 0;
+    while (color_begin < tile_count) {
+        uint64_t color = order[tile_starts[color_begin]].first >> 60;
+        size_t color_end = color_begin;
+        while (color_end < tile_count && (order[tile_starts[color_end]].first >> 60) == color) {
+            ++color_end;
+        }
+
+        // 相邻瓦片颜色必然不同：它们或已处理完毕，或尚未开始，读取其接受列表不会与本轮写入冲突
+        ParallelUtils::parallelFor(color_end - color_begin, 1, [&](size_t begin, size_t end) {
+            std::vector<int64_t> local(kTileSpan * kTileSpan * kTileSpan);
+            for (size_t tile = color_begin + begin; tile < color_begin + end; ++tile) {
+                const uint32_t first = order[tile_starts[tile]].second;
+                int tile_coord[3], base[3];
+                for (int k = 0; k < 3; ++k) {
+                    tile_coord[k] = cells[3 * first + k] / kTileCells;
+                    base[k] = tile_coord[k] * kTileCells - kHalo;
+                }
+                // 相邻瓦片中位于外围单元的已接受点写入局部稠密数组
+                std::fill(local.begin(), local.end(), -1);
+                for (int tk = tile_coord[2] - 1; tk <= tile_coord[2] + 1; ++tk) {
+                    for (int tj = tile_coord[1] - 1; tj <= tile_coord[1] + 1; ++tj) {
+                        for (int ti = tile_coord[0] - 1; ti <= tile_coord[0] + 1; ++ti) {
+                            if (ti < 0 || tj < 0 || tk < 0) continue;
+                            uint64_t key = (static_cast<uint64_t>(tk) << 40) | (static_cast<uint64_t>(tj) << 20) |
+                                           static_cast<uint64_t>(ti);
+                            auto it = tile_lookup.find(key);
+                            if (it == tile_lookup.end() || it->second == tile) continue;
+                            for (uint32_t other : tile_accepted[it->second]) {
+                                int li = cells[3 * other] - base[0];
+                                int lj = cells[3 * other + 1] - base[1];
+                                int lk = cells[3 * other + 2] - base[2];
+                                if (li < 0 || lj < 0 || lk < 0 || li >= kTileSpan || lj >= kTileSpan || lk >= kTileSpan) {
+                                    continue;
+                                }
+                                local[(lk * kTileSpan + lj) * kTileSpan + li] = other;
+                            }
+                        }
+                    }
+                }
+
+                std::vector<uint32_t>& accepted = tile_accepted[tile];
+                for (size_t s = tile_starts[tile]; s < tile_starts[tile + 1]; ++s) {
+                    uint32_t candidate = order[s].second;
+                    int li = cells[3 * candidate] - base[0];
+                    int lj = cells[3 * candidate + 1] - base[1];
+                    int lk = cells[3 * candidate + 2] - base[2];
+                    if (local[(lk * kTileSpan + lj) * kTileSpan + li] >= 0) continue;
+                    bool conflict = false;
+                    for (int dk = -kHalo; dk <= kHalo && !conflict; ++dk) {
+                        for (int dj = -kHalo; dj <= kHalo && !conflict; ++dj) {
+                            for (int di = -kHalo; di <= kHalo; ++di) {
+                                int64_t other = local[((lk + dk) * kTileSpan + lj + dj) * kTileSpan + li + di];
+                                if (other < 0) continue;
+                                double dx = xs[other] - xs[candidate];
+                                double dy = ys[other] - ys[candidate];
+                                double dz = zs[other] - zs[candidate];
+                                if (dx * dx + dy * dy + dz * dz < r2) {
+                                    conflict = true;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                    if (!conflict) {
+                        local[(lk * kTileSpan + lj) * kTileSpan + li] = candidate;
+                        accepted.push_back(candidate);
+                    }
+                }
+            }
+        });
+
+        for (size_t tile = color_begin; tile < color_end; ++tile) {
+            accepted_total += tile_accepted[tile].size();
+        }
+        color_begin = color_end;
+    }
+
+    samples.x.reserve(accepted_total);
+    samples.y.reserve(accepted_total);
+    samples.z.reserve(accepted_total);
+    samples.faces.reserve(accepted_total);
+    for (const auto& accepted : tile_accepted) {
+        for (uint32_t candidate : accepted) {
+            samples.x.push_back(xs[candidate]);
+            samples.y.push_back(ys[candidate]);
+            samples.z.push_back(zs[candidate]);
+            samples.faces.push_back(faces[candidate]);
+        }
+    }
+    return samples;
+}
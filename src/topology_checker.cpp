@@ -1,5 +1,6 @@
 #include "topology_checker.h"
 #include "geometry_algorithm.h"
+#include "mesh_topology.h"
 #include <string>
 #include <iostream>
 #include <unordered_set>
@@ -76,46 +77,61 @@ std::vector<int> TopologyChecker::detectDuplicateFaces(const ModelManager& manag
 /**
  * @brief 检测面法向不一致
  * 
+ * 面的绕向由边顺序给出（与MeshTopology的面顶点环一致）。拓扑统一方向时记录了每个面
+ * 是否需要翻转，同一连通分量内翻转状态与多数面不同的面即绕向与相邻面不一致
+ * （两者数量相同时报告被翻转的一方）。只读取拓扑结构，可在多线程中并发调用
+ * 
  * @param manager 模型管理器
- * @return std::vector<int> 法向不一致面的ID列表
+ * @return std::vector<int> 法向不一致面的ID列表（按面序号从1编号）
  */
 std::vector<int> TopologyChecker::detectNormalInconsistencies(const ModelManager& manager) {
     std::vector<int> inconsistent_faces;
-    
-    const auto& faces = manager.getFaces();
-    if (faces.empty()) {
+    if (manager.getFaces().empty()) {
         return inconsistent_faces;
     }
     
-    // 计算第一个面的法向量作为参考
-    const auto& first_face = faces[0];
-    if (!first_face || first_face->edge_ids.empty()) {
-        return inconsistent_faces;
+    auto topology = manager.getMeshTopology();
+    const MeshTopology& topo = *topology;
+    size_t face_count = topo.faceCount();
+    int component_count = 0;
+    for (int c : topo.face_components) {
+        component_count = std::max(component_count, c + 1);
     }
-    
-    double* ref_normal = GeometryAlgorithm::calculateFaceNormal(*first_face, manager);
-    
-    // 检测其他面的法向量是否与参考一致
-    for (size_t i = 1; i < faces.size(); ++i) {
-        const auto& face = faces[i];
-        if (!face || face->edge_ids.empty()) continue;
-        
-        double* current_normal = GeometryAlgorithm::calculateFaceNormal(*face, manager);
-        
-        // 计算点积，判断方向是否一致
-        double dot_product = ref_normal[0] * current_normal[0] + 
-                            ref_normal[1] * current_normal[1] + 
-                            ref_normal[2] * current_normal[2];
-        
-        if (dot_product < 0) {
-            // 法向不一致
-            inconsistent_faces.push_back(static_cast<int>(i + 1)); // 这里简化处理，实际应该使用面的ID
+    std::vector<int> flipped_count(component_count, 0);
+    std::vector<int> face_total(component_count, 0);
+    for (size_t f = 0; f < face_count; ++f) {
+        int c = topo.face_components[f];
+        if (c < 0) continue;
+        ++face_total[c];
+        flipped_count[c] += topo.face_flipped[f] ? 1 : 0;
+    }
+    for (size_t f = 0; f < face_count; ++f) {
+        int c = topo.face_components[f];
+        if (c < 0) continue;
+        // 多数面的翻转状态：翻转的面超过一半时多数为翻转
+        bool majority_flipped = 2 * flipped_count[c] > face_total[c];
+        if ((topo.face_flipped[f] != 0) != majority_flipped) {
+            inconsistent_faces.push_back(static_cast<int>(f + 1));
         }
     }
     
     return inconsistent_faces;
 }
 
+/**
+ * @brief 执行全部拓扑检测并返回报告
+ * 
+ * @param manager 模型管理器
+ * @return TopologyReport 检测报告
+ */
+TopologyReport TopologyChecker::checkTopology(const ModelManager& manager) {
+    TopologyReport report;
+    report.duplicate_edges = detectDuplicateEdges(manager);
+    report.duplicate_faces = detectDuplicateFaces(manager);
+    report.inconsistent_normals = detectNormalInconsistencies(manager);
+    return report;
+}
+
 /**
  * @brief 检测所有拓扑错误
  * 
@@ -123,44 +139,38 @@ std::vector<int> TopologyChecker::detectNormalInconsistencies(const ModelManager
  * @return bool 是否存在拓扑错误
  */
 bool TopologyChecker::detectAllTopologyErrors(const ModelManager& manager) {
-    bool has_errors = false;
+    TopologyReport report = checkTopology(manager);
     
     // 检测边重复
-    auto duplicate_edges = detectDuplicateEdges(manager);
-    if (!duplicate_edges.empty()) {
-        has_errors = true;
+    if (!report.duplicate_edges.empty()) {
         std::cout << "检测到重复边：";
-        for (int edge_id : duplicate_edges) {
+        for (int edge_id : report.duplicate_edges) {
             std::cout << edge_id << " ";
         }
         std::cout << std::endl;
     }
     
     // 检测面重复
-    auto duplicate_faces = detectDuplicateFaces(manager);
-    if (!duplicate_faces.empty()) {
-        has_errors = true;
+    if (!report.duplicate_faces.empty()) {
         std::cout << "检测到重复面：";
-        for (int face_id : duplicate_faces) {
+        for (int face_id : report.duplicate_faces) {
             std::cout << face_id << " ";
         }
         std::cout << std::endl;
     }
     
     // 检测面法向不一致
-    auto inconsistent_faces = detectNormalInconsistencies(manager);
-    if (!inconsistent_faces.empty()) {
-        has_errors = true;
+    if (!report.inconsistent_normals.empty()) {
         std::cout << "检测到法向不一致的面：";
-        for (int face_id : inconsistent_faces) {
+        for (int face_id : report.inconsistent_normals) {
             std::cout << face_id << " ";
         }
         std::cout << std::endl;
     }
     
-    if (!has_errors) {
+    if (!report.hasErrors()) {
         std::cout << "未检测到拓扑错误！" << std::endl;
     }
     
-    return has_errors;
+    return report.hasErrors();
 }
@@ -0,0 +1,397 @@
+#include "triangle_bvh.h"
+#include "mesh_topology.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const int kBinCount = 16;     // SAH分箱数
+const int kMaxLeafSize = 4;   // 叶节点最大三角形数
+const int kQueryStackSize = 64; // 最近点查询的栈上遍历栈容量，超出部分溢出到堆
+
+struct Bounds {
+    double lo[3];
+    double hi[3];
+    
+    Bounds() {
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::numeric_limits<double>::max();
+            hi[k] = -std::numeric_limits<double>::max();
+        }
+    }
+    
+    void extend(const double* p) {
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], p[k]);
+            hi[k] = std::max(hi[k], p[k]);
+        }
+    }
+    
+    void extend(const Bounds& b) {
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], b.lo[k]);
+            hi[k] = std::max(hi[k], b.hi[k]);
+        }
+    }
+    
+    double halfArea() const {
+        double dx = hi[0] - lo[0];
+        double dy = hi[1] - lo[1];
+        double dz = hi[2] - lo[2];
+        if (dx < 0.0 || dy < 0.0 || dz < 0.0) return 0.0;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+struct BuildTask {
+    int node;
+    int begin;
+    int end;
+};
+
+} // namespace
+
+/**
+ * @brief 从模型管理器构建
+ * 
+ * @param manager 模型管理器
+ */
+TriangleBVH::TriangleBVH(const ModelManager& manager) {
+    auto topology = manager.getMeshTopology();
+    const auto& vertices = manager.getVertices();
+    size_t count = topology->triangleCount();
+    
+    std::vector<double> positions(count * 9);
+    for (size_t t = 0; t < count; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const Point3D& p = *vertices[topology->triangle_vertices[3 * t + k]];
+            positions[9 * t + 3 * k] = p.x;
+            positions[9 * t + 3 * k + 1] = p.y;
+            positions[9 * t + 3 * k + 2] = p.z;
+        }
+    }
+    build(positions, topology->triangle_faces);
+}
+
+/**
+ * @brief 从三角形坐标构建
+ * 
+ * @param positions 三角形顶点坐标，每个三角形9个分量
+ * @param faces 每个三角形所属面索引
+ */
+TriangleBVH::TriangleBVH(const std::vector<double>& positions, const std::vector<int>& faces) {
+    build(positions, faces);
+}
+
+/**
+ * @brief 获取整体包围盒
+ * 
+ * @param bounds_min 输出最小点
+ * @param bounds_max 输出最大点
+ * @return bool 是否非空
+ */
+bool TriangleBVH::getBounds(double bounds_min[3], double bounds_max[3]) const {
+    if (node_list.empty()) {
+        return false;
+    }
+    for (int k = 0; k < 3; ++k) {
+        bounds_min[k] = node_list[0].bounds_min[k];
+        bounds_max[k] = node_list[0].bounds_max[k];
+    }
+    return true;
+}
+
+/**
+ * @brief 分箱SAH自顶向下构建
+ * 
+ * @param positions 三角形顶点坐标
+ * @param faces 三角形所属面索引
+ */
+void TriangleBVH::build(const std::vector<double>& positions, const std::vector<int>& faces) {
+    int count = static_cast<int>(faces.size());
+    if (count == 0) {
+        return;
+    }
+    
+    std::vector<Bounds> tri_bounds(count);
+    std::vector<double> centroids(count * 3);
+    for (int t = 0; t < count; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            tri_bounds[t].extend(&positions[9 * t + 3 * k]);
+        }
+        for (int k = 0; k < 3; ++k) {
+            centroids[3 * t + k] = 0.5 * (tri_bounds[t].lo[k] + tri_bounds[t].hi[k]);
+        }
+    }
+    
+    std::vector<int> order(count);
+    for (int t = 0; t < count; ++t) {
+        order[t] = t;
+    }
+    
+    node_list.reserve(2 * count);
+    node_list.push_back(BVHNode());
+    std::vector<BuildTask> stack;
+    BuildTask root = {0, 0, count};
+    stack.push_back(root);
+    
+    while (!stack.empty()) {
+        BuildTask task = stack.back();
+        stack.pop_back();
+        
+        Bounds bounds;
+        Bounds centroid_bounds;
+        for (int i = task.begin; i < task.end; ++i) {
+            bounds.extend(tri_bounds[order[i]]);
+            centroid_bounds.extend(&centroids[3 * order[i]]);
+        }
+        BVHNode& node = node_list[task.node];
+        for (int k = 0; k < 3; ++k) {
+            node.bounds_min[k] = bounds.lo[k];
+            node.bounds_max[k] = bounds.hi[k];
+        }
+        
+        int n = task.end - task.begin;
+        int axis = 0;
+        double extent[3];
+        for (int k = 0; k < 3; ++k) {
+            extent[k] = centroid_bounds.hi[k] - centroid_bounds.lo[k];
+        }
+        if (extent[1] > extent[axis]) axis = 1;
+        if (extent[2] > extent[axis]) axis = 2;
+        
+        if (n <= kMaxLeafSize || extent[axis] <= 0.0) {
+            node.first = task.begin;
+            node.count = n;
+            continue;
+        }
+        
+        // 沿最长轴分箱，评估SAH代价
+        Bounds bin_bounds[kBinCount];
+        int bin_counts[kBinCount] = {0};
+        double scale = kBinCount / extent[axis];
+        for (int i = task.begin; i < task.end; ++i) {
+            int t = order[i];
+            int bin = static_cast<int>((centroids[3 * t + axis] - centroid_bounds.lo[axis]) * scale);
+            bin = std::min(kBinCount - 1, std::max(0, bin));
+            bin_bounds[bin].extend(tri_bounds[t]);
+            ++bin_counts[bin];
+        }
+        double right_area[kBinCount];
+        int right_count[kBinCount];
+        Bounds accum;
+        int accum_count = 0;
+        for (int b = kBinCount - 1; b > 0; --b) {
+            accum.extend(bin_bounds[b]);
+            accum_count += bin_counts[b];
+            right_area[b] = accum.halfArea();
+            right_count[b] = accum_count;
+        }
+        int best_split = -1;
+        double best_cost = std::numeric_limits<double>::max();
+        accum = Bounds();
+        accum_count = 0;
+        for (int b = 1; b < kBinCount; ++b) {
+            accum.extend(bin_bounds[b - 1]);
+            accum_count += bin_counts[b - 1];
+            if (accum_count == 0 || right_count[b] == 0) continue;
+            double cost = accum.halfArea() * accum_count + right_area[b] * right_count[b];
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_split = b;
+            }
+        }
+        
+        int mid;
+        if (best_split > 0) {
+            int* first = &order[0] + task.begin;
+            int* last = &order[0] + task.end;
+            mid = static_cast<int>(std::partition(first, last, [&](int t) {
+                int bin = static_cast<int>((centroids[3 * t + axis] - centroid_bounds.lo[axis]) * scale);
+                return std::min(kBinCount - 1, bin) < best_split;
+            }) - &order[0]);
+        } else {
+            mid = task.begin + n / 2;
+        }
+        if (mid <= task.begin || mid >= task.end) {
+            mid = task.begin + n / 2;
+            std::nth_element(order.begin() + task.begin, order.begin() + mid, order.begin() + task.end,
+                             [&](int a, int b) { return centroids[3 * a + axis] < centroids[3 * b + axis]; });
+        }
+        
+        int left = static_cast<int>(node_list.size());
+        node_list[task.node].first = left;
+        node_list[task.node].count = 0;
+        node_list.push_back(BVHNode());
+        node_list.push_back(BVHNode());
+        BuildTask left_task = {left, task.begin, mid};
+        BuildTask right_task = {left + 1, mid, task.end};
+        stack.push_back(right_task);
+        stack.push_back(left_task);
+    }
+    
+    triangle_positions.resize(positions.size());
+    triangle_faces.resize(count);
+    for (int i = 0; i < count; ++i) {
+        std::copy(positions.begin() + 9 * order[i], positions.begin() + 9 * order[i] + 9,
+                  triangle_positions.begin() + 9 * i);
+        triangle_faces[i] = faces[order[i]];
+    }
+}
+
+/**
+ * @brief 计算点到三角形的最近点（按Voronoi区域分类）
+ * 
+ * @param p 查询点
+ * @param tri 三角形9个顶点坐标分量
+ * @param closest 输出最近点
+ * @return double 距离平方
+ */
+double TriangleBVH::closestPointOnTriangle(const double* p, const double* tri, double* closest) {
+    const double* a = tri;
+    const double* b = tri + 3;
+    const double* c = tri + 6;
+    double ab[3], ac[3], ap[3];
+    for (int k = 0; k < 3; ++k) {
+        ab[k] = b[k] - a[k];
+        ac[k] = c[k] - a[k];
+        ap[k] = p[k] - a[k];
+    }
+    auto dot = [](const double* u, const double* v) { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; };
+    auto finish = [&](double u, double v, double w) {
+        double d2 = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            closest[k] = u * a[k] + v * b[k] + w * c[k];
+            double diff = p[k] - closest[k];
+            d2 += diff * diff;
+        }
+        return d2;
+    };
+    
+    double d1 = dot(ab, ap);
+    double d2 = dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0) return finish(1.0, 0.0, 0.0);
+    
+    double bp[3] = {p[0] - b[0], p[1] - b[1], p[2] - b[2]};
+    double d3 = dot(ab, bp);
+    double d4 = dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3) return finish(0.0, 1.0, 0.0);
+    
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        double v = d1 / (d1 - d3);
+        return finish(1.0 - v, v, 0.0);
+    }
+    
+    double cp[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+    double d5 = dot(ab, cp);
+    double d6 = dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6) return finish(0.0, 0.0, 1.0);
+    
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        double w = d2 / (d2 - d6);
+        return finish(1.0 - w, 0.0, w);
+    }
+    
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+        double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        return finish(0.0, 1.0 - w, w);
+    }
+    
+    double denom = va + vb + vc;
+    if (denom == 0.0) {
+        return finish(1.0, 0.0, 0.0);
+    }
+    double v = vb / denom;
+    double w = vc / denom;
+    return finish(1.0 - v - w, v, w);
+}
+
+/**
+ * @brief 最近点查询
+ * 
+ * @param x 查询点x坐标
+ * @param y 查询点y坐标
+ * @param z 查询点z坐标
+ * @param max_distance 最大搜索距离
+ * @param result 输出查询结果
+ * @return bool 在最大搜索距离内是否找到
+ */
+bool TriangleBVH::closestPoint(double x, double y, double z, double max_distance, ClosestPointResult& result) const {
+    result = ClosestPointResult();
+    if (node_list.empty()) {
+        return false;
+    }
+    
+    double q[3] = {x, y, z};
+    double best = max_distance * max_distance;
+    auto boxDistance2 = [&q](const BVHNode& node) {
+        double d2 = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            double d = std::max(node.bounds_min[k] - q[k], std::max(0.0, q[k] - node.bounds_max[k]));
+            d2 += d * d;
+        }
+        return d2;
+    };
+    
+    // 遍历栈放在栈上避免每次查询分配堆内存；极深的树才使用溢出栈，
+    // 溢出部分总是后入栈，先于栈上部分弹出，保持后进先出顺序
+    std::pair<double, int> stack[kQueryStackSize];
+    int stack_size = 0;
+    std::vector<std::pair<double, int>> overflow;
+    auto push = [&](double d2, int node) {
+        if (stack_size < kQueryStackSize) {
+            stack[stack_size++] = std::make_pair(d2, node);
+        } else {
+            overflow.push_back(std::make_pair(d2, node));
+        }
+    };
+    push(boxDistance2(node_list[0]), 0);
+    while (stack_size > 0 || !overflow.empty()) {
+        std::pair<double, int> entry;
+        if (!overflow.empty()) {
+            entry = overflow.back();
+            overflow.pop_back();
+        } else {
+            entry = stack[--stack_size];
+        }
+        if (entry.first > best) continue;
+        const BVHNode& node = node_list[entry.second];
+        
+        if (node.count > 0) {
+            double point[3];
+            for (int t = node.first; t < node.first + node.count; ++t) {
+                double d2 = closestPointOnTriangle(q, triangle(t), point);
+                if (d2 <= best) {
+                    best = d2;
+                    result.point[0] = point[0];
+                    result.point[1] = point[1];
+                    result.point[2] = point[2];
+                    result.triangle = t;
+                    result.face = triangle_faces[t];
+                }
+            }
+            continue;
+        }
+        
+        // 近的子节点后入栈以便先出栈
+        double dl = boxDistance2(node_list[node.first]);
+        double dr = boxDistance2(node_list[node.first + 1]);
+        if (dl <= dr) {
+            if (dr <= best) push(dr, node.first + 1);
+            if (dl <= best) push(dl, node.first);
+        } else {
+            if (dl <= best) push(dl, node.first);
+            if (dr <= best) push(dr, node.first + 1);
+        }
+    }
+    
+    if (result.triangle < 0) {
+        return false;
+    }
+    result.distance = std::sqrt(best);
+    return true;
+}
@@ -0,0 +1,223 @@
+#include "voxelizer.h"
+#include "mesh_topology.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief 用平面 p[axis] >= value（keep_greater）或 <= value 裁剪凸多边形
+ */
+void clipPolygon(const std::vector<double>& in, std::vector<double>& out, int axis, double value, bool keep_greater) {
+    out.clear();
+    size_t n = in.size() / 3;
+    for (size_t i = 0; i < n; ++i) {
+        const double* a = &in[3 * i];
+        const double* b = &in[3 * ((i + 1) % n)];
+        double da = keep_greater ? a[axis] - value : value - a[axis];
+        double db = keep_greater ? b[axis] - value : value - b[axis];
+        if (da >= 0.0) {
+            out.insert(out.end(), a, a + 3);
+        }
+        if ((da >= 0.0) != (db >= 0.0)) {
+            double t = da / (da - db);
+            for (int k = 0; k < 3; ++k) {
+                out.push_back(a[k] + t * (b[k] - a[k]));
+            }
+        }
+    }
+}
+
+/**
+ * @brief 设置一行中[x0, x1]范围内的位
+ */
+void setBitRange(uint64_t* row, int x0, int x1) {
+    for (int x = x0; x <= x1;) {
+        int word = x >> 6;
+        int bit = x & 63;
+        int last = std::min(x1, (word << 6) + 63);
+        int span = last - x + 1;
+        uint64_t mask = span == 64 ? ~0ULL : (((1ULL << span) - 1) << bit);
+        row[word] |= mask;
+        x = last + 1;
+    }
+}
+
+/**
+ * @brief 左上填充规则：点恰好落在边上时只归属于共享该边的一个三角形
+ */
+bool edgeCovers(double ay, double az, double by, double bz, double py, double pz) {
+    double w = (by - ay) * (pz - az) - (bz - az) * (py - ay);
+    if (w != 0.0) return w > 0.0;
+    double ey = by - ay;
+    double ez = bz - az;
+    return ez < 0.0 || (ez == 0.0 && ey > 0.0);
+}
+
+} // namespace
+
+/**
+ * @brief 统计被占据的体素数
+ */
+size_t VoxelGrid::count() const {
+    size_t total = 0;
+    for (uint64_t word : bits) {
+        uint64_t v = word;
+        while (v) {
+            v &= v - 1;
+            ++total;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief 体素化模型
+ * 
+ * @param manager 模型管理器
+ * @param resolution 最长边方向的体素数
+ * @param fill 填充方式
+ * @return VoxelGrid 体素网格
+ */
+VoxelGrid Voxelizer::voxelize(const ModelManager& manager, int resolution, VoxelFill fill) {
+    VoxelGrid grid;
+    auto topology = manager.getMeshTopology();
+    const auto& vertices = manager.getVertices();
+    size_t triangle_count = topology->triangleCount();
+    if (triangle_count == 0 || resolution <= 0) {
+        return grid;
+    }
+    
+    std::vector<double> tris(triangle_count * 9);
+    double lo[3] = {1e300, 1e300, 1e300};
+    double hi[3] = {-1e300, -1e300, -1e300};
+    for (size_t t = 0; t < triangle_count; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const Point3D& p = *vertices[topology->triangle_vertices[3 * t + k]];
+            double c[3] = {p.x, p.y, p.z};
+            for (int a = 0; a < 3; ++a) {
+                tris[9 * t + 3 * k + a] = c[a];
+                lo[a] = std::min(lo[a], c[a]);
+                hi[a] = std::max(hi[a], c[a]);
+            }
+        }
+    }
+    
+    double extent = std::max(hi[0] - lo[0], std::max(hi[1] - lo[1], hi[2] - lo[2]));
+    grid.voxel_size = extent > 0.0 ? extent / resolution : 1.0;
+    int dims[3];
+    for (int a = 0; a < 3; ++a) {
+        dims[a] = static_cast<int>(std::ceil((hi[a] - lo[a]) / grid.voxel_size)) + 2;
+        grid.origin[a] = lo[a] - grid.voxel_size;
+    }
+    grid.nx = dims[0];
+    grid.ny = dims[1];
+    grid.nz = dims[2];
+    grid.words_per_row = (grid.nx + 63) / 64;
+    grid.bits.assign(static_cast<size_t>(grid.words_per_row) * grid.ny * grid.nz, 0);
+    
+    // 按z层分桶
+    const double inv = 1.0 / grid.voxel_size;
+    std::vector<std::vector<int>> slices(grid.nz);
+    for (size_t t = 0; t < triangle_count; ++t) {
+        double zmin = std::min(tris[9 * t + 2], std::min(tris[9 * t + 5], tris[9 * t + 8]));
+        double zmax = std::max(tris[9 * t + 2], std::max(tris[9 * t + 5], tris[9 * t + 8]));
+        int z0 = std::max(0, static_cast<int>(std::floor((zmin - grid.origin[2]) * inv)));
+        int z1 = std::min(grid.nz - 1, static_cast<int>(std::floor((zmax - grid.origin[2]) * inv)));
+        for (int z = z0; z <= z1; ++z) {
+            slices[z].push_back(static_cast<int>(t));
+        }
+    }
+    
+    ParallelUtils::parallelFor(static_cast<size_t>(grid.nz), 4, [&](size_t begin, size_t end) {
+        std::vector<double> poly, slab, row_poly, tmp;
+        std::vector<std::vector<double>> crossings(grid.ny);
+        for (size_t z = begin; z < end; ++z) {
+            double z0 = grid.origin[2] + z * grid.voxel_size;
+            double z1 = z0 + grid.voxel_size;
+            uint64_t* slice_bits = &grid.bits[z * grid.ny * grid.words_per_row];
+            
+            // 保守表面光栅化：三角形与(y, z)行体相交部分的x范围即为被穿过的体素
+            for (int t : slices[z]) {
+                poly.assign(tris.begin() + 9 * t, tris.begin() + 9 * t + 9);
+                clipPolygon(poly, tmp, 2, z0, true);
+                clipPolygon(tmp, slab, 2, z1, false);
+                if (slab.empty()) continue;
+                double ymin = 1e300, ymax = -1e300;
+                for (size_t i = 1; i < slab.size(); i += 3) {
+                    ymin = std::min(ymin, slab[i]);
+                    ymax = std::max(ymax, slab[i]);
+                }
+                int y0 = std::max(0, static_cast<int>(std::floor((ymin - grid.origin[1]) * inv)));
+                int y1 = std::min(grid.ny - 1, static_cast<int>(std::floor((ymax - grid.origin[1]) * inv)));
+                for (int y = y0; y <= y1; ++y) {
+                    double ya = grid.origin[1] + y * grid.voxel_size;
+                    clipPolygon(slab, tmp, 1, ya, true);
+                    clipPolygon(tmp, row_poly, 1, ya + grid.voxel_size, false);
+                    if (row_poly.empty()) continue;
+                    double xmin = 1e300, xmax = -1e300;
+                    for (size_t i = 0; i < row_poly.size(); i += 3) {
+                        xmin = std::min(xmin, row_poly[i]);
+                        xmax = std::max(xmax, row_poly[i]);
+                    }
+                    int x0 = std::max(0, static_cast<int>(std::floor((xmin - grid.origin[0]) * inv)));
+                    int x1 = std::min(grid.nx - 1, static_cast<int>(std::floor((xmax - grid.origin[0]) * inv)));
+                    setBitRange(slice_bits + static_cast<size_t>(y) * grid.words_per_row, x0, x1);
+                }
+            }
+            
+            if (fill != VoxelFill::Solid) continue;
+            
+            // 扫描线奇偶填充：沿x方向的射线穿过体素中心行
+            double zc = z0 + 0.5 * grid.voxel_size;
+            for (auto& list : crossings) list.clear();
+            for (int t : slices[z]) {
+                const double* p = &tris[9 * t];
+                double a[2] = {p[1], p[2]};
+                double b[2] = {p[4], p[5]};
+                double c[2] = {p[7], p[8]};
+                double area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+                if (area == 0.0) continue;
+                const double* px[3] = {p, p + 3, p + 6};
+                if (area < 0.0) {
+                    std::swap(b[0], c[0]);
+                    std::swap(b[1], c[1]);
+                    std::swap(px[1], px[2]);
+                    area = -area;
+                }
+                double ymin = std::min(a[0], std::min(b[0], c[0]));
+                double ymax = std::max(a[0], std::max(b[0], c[0]));
+                int y0 = std::max(0, static_cast<int>(std::ceil((ymin - grid.origin[1]) * inv - 0.5)));
+                int y1 = std::min(grid.ny - 1, static_cast<int>(std::floor((ymax - grid.origin[1]) * inv - 0.5)));
+                for (int y = y0; y <= y1; ++y) {
+                    double yc = grid.origin[1] + (y + 0.5) * grid.voxel_size;
+                    if (!edgeCovers(a[0], a[1], b[0], b[1], yc, zc) ||
+                        !edgeCovers(b[0], b[1], c[0], c[1], yc, zc) ||
+                        !edgeCovers(c[0], c[1], a[0], a[1], yc, zc)) {
+                        continue;
+                    }
+                    double wa = (b[0] - yc) * (c[1] - zc) - (b[1] - zc) * (c[0] - yc);
+                    double wb = (c[0] - yc) * (a[1] - zc) - (c[1] - zc) * (a[0] - yc);
+                    double wc = area - wa - wb;
+                    double x = (wa * px[0][0] + wb * px[1][0] + wc * px[2][0]) / area;
+                    crossings[y].push_back(x);
+                }
+            }
+            for (int y = 0; y < grid.ny; ++y) {
+                auto& list = crossings[y];
+                if (list.size() < 2) continue;
+                std::sort(list.begin(), list.end());
+                for (size_t i = 0; i + 1 < list.size(); i += 2) {
+                    int x0 = std::max(0, static_cast<int>(std::ceil((list[i] - grid.origin[0]) * inv - 0.5)));
+                    int x1 = std::min(grid.nx - 1, static_cast<int>(std::floor((list[i + 1] - grid.origin[0]) * inv - 0.5)));
+                    if (x0 <= x1) {
+                        setBitRange(slice_bits + static_cast<size_t>(y) * grid.words_per_row, x0, x1);
+                    }
+                }
+            }
+        }
+    });
+    
+    return grid;
+}
@@ -0,0 +1,202 @@
+#include "winding_number.h"
+#include "parallel_utils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int kDipoleStride = 7;
+const int kQueryStackSize = 64; // 单点查询的栈上遍历栈容量，超出部分溢出到堆
+const double kInvFourPi = 1.0 / (4.0 * M_PI);
+
+/**
+ * @brief 三角形对查询点张成的有向立体角（Van Oosterom-Strackee公式）
+ */
+double solidAngle(const double* tri, const double* q) {
+    double a[3] = {tri[0] - q[0], tri[1] - q[1], tri[2] - q[2]};
+    double b[3] = {tri[3] - q[0], tri[4] - q[1], tri[5] - q[2]};
+    double c[3] = {tri[6] - q[0], tri[7] - q[1], tri[8] - q[2]};
+    double la = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+    double lb = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+    double lc = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+    double det = a[0] * (b[1] * c[2] - b[2] * c[1]) -
+                 a[1] * (b[0] * c[2] - b[2] * c[0]) +
+                 a[2] * (b[0] * c[1] - b[1] * c[0]);
+    double denom = la * lb * lc +
+                   (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]) * lc +
+                   (a[0] * c[0] + a[1] * c[1] + a[2] * c[2]) * lb +
+                   (b[0] * c[0] + b[1] * c[1] + b[2] * c[2]) * la;
+    return 2.0 * std::atan2(det, denom);
+}
+
+} // namespace
+
+/**
+ * @brief 从模型管理器构建
+ * 
+ * @param manager 模型管理器
+ * @param accuracy 远场判定系数β
+ */
+WindingNumber::WindingNumber(const ModelManager& manager, double accuracy)
+    : bvh_ptr(std::make_shared<TriangleBVH>(manager)), beta(accuracy) {
+    precompute();
+}
+
+/**
+ * @brief 复用已构建的BVH
+ * 
+ * @param bvh 三角形BVH
+ * @param accuracy 远场判定系数β
+ */
+WindingNumber::WindingNumber(std::shared_ptr<const TriangleBVH> bvh, double accuracy)
+    : bvh_ptr(bvh), beta(accuracy) {
+    precompute();
+}
+
+/**
+ * @brief 自底向上计算每个节点的偶极子
+ * 
+ * 子节点索引总大于父节点，逆序遍历即可保证子节点先于父节点完成
+ */
+void WindingNumber::precompute() {
+    const TriangleBVH& tree = *bvh_ptr;
+    const auto& nodes = tree.nodes();
+    dipoles.assign(nodes.size() * kDipoleStride, 0.0);
+    std::vector<double> areas(nodes.size(), 0.0);
+    
+    for (size_t i = nodes.size(); i-- > 0;) {
+        const BVHNode& node = nodes[i];
+        double* d = &dipoles[i * kDipoleStride];
+        
+        if (node.count > 0) {
+            for (int t = node.first; t < node.first + node.count; ++t) {
+                const double* p = tree.triangle(t);
+                double e1[3] = {p[3] - p[0], p[4] - p[1], p[5] - p[2]};
+                double e2[3] = {p[6] - p[0], p[7] - p[1], p[8] - p[2]};
+                double n[3] = {0.5 * (e1[1] * e2[2] - e1[2] * e2[1]),
+                               0.5 * (e1[2] * e2[0] - e1[0] * e2[2]),
+                               0.5 * (e1[0] * e2[1] - e1[1] * e2[0])};
+                double area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                for (int k = 0; k < 3; ++k) {
+                    d[k] += area * (p[k] + p[3 + k] + p[6 + k]) / 3.0;
+                    d[3 + k] += n[k];
+                }
+                areas[i] += area;
+            }
+        } else {
+            for (int child = node.first; child <= node.first + 1; ++child) {
+                const double* cd = &dipoles[child * kDipoleStride];
+                for (int k = 0; k < 3; ++k) {
+                    d[k] += areas[child] * cd[k];
+                    d[3 + k] += cd[3 + k];
+                }
+                areas[i] += areas[child];
+            }
+        }
+        
+        // 中心取面积加权质心；半径取包围盒离中心最远角点的距离
+        double r2 = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            d[k] = areas[i] > 0.0 ? d[k] / areas[i] : 0.5 * (node.bounds_min[k] + node.bounds_max[k]);
+            double span = std::max(d[k] - node.bounds_min[k], node.bounds_max[k] - d[k]);
+            r2 += span * span;
+        }
+        d[6] = std::sqrt(r2);
+    }
+}
+
+/**
+ * @brief 计算单点绕数
+ * 
+ * @param x x坐标
+ * @param y y坐标
+ * @param z z坐标
+ * @return double 绕数
+ */
+double WindingNumber::evaluate(double x, double y, double z) const {
+    const TriangleBVH& tree = *bvh_ptr;
+    const auto& nodes = tree.nodes();
+    if (nodes.empty()) {
+        return 0.0;
+    }
+    
+    double q[3] = {x, y, z};
+    double sum = 0.0;
+    // 遍历栈放在栈上避免每次查询分配堆内存；极深的树才使用溢出栈，
+    // 溢出部分总是后入栈，先于栈上部分弹出
+    int stack[kQueryStackSize];
+    int stack_size = 0;
+    std::vector<int> overflow;
+    auto push = [&](int node) {
+        if (stack_size < kQueryStackSize) {
+            stack[stack_size++] = node;
+        } else {
+            overflow.push_back(node);
+        }
+    };
+    push(0);
+    while (stack_size > 0 || !overflow.empty()) {
+        int index;
+        if (!overflow.empty()) {
+            index = overflow.back();
+            overflow.pop_back();
+        } else {
+            index = stack[--stack_size];
+        }
+        const BVHNode& node = nodes[index];
+        const double* d = &dipoles[index * kDipoleStride];
+        double r[3] = {d[0] - q[0], d[1] - q[1], d[2] - q[2]};
+        double dist2 = r[0] * r[0] + r[1] * r[1] + r[2] * r[2];
+        
+        if (dist2 > beta * beta * d[6] * d[6]) {
+            // 远场：偶极子近似
+            double dist = std::sqrt(dist2);
+            sum += (r[0] * d[3] + r[1] * d[4] + r[2] * d[5]) / (dist2 * dist) * kInvFourPi;
+        } else if (node.count > 0) {
+            // 近场叶节点：逐三角形精确计算
+            for (int t = node.first; t < node.first + node.count; ++t) {
+                sum += solidAngle(tree.triangle(t), q) * kInvFourPi;
+            }
+        } else {
+            push(node.first);
+            push(node.first + 1);
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief 批量计算绕数（多线程）
+ * 
+ * @param xs 查询点x坐标数组
+ * @param ys 查询点y坐标数组
+ * @param zs 查询点z坐标数组
+ * @param count 查询点数量
+ * @param winding 输出绕数数组
+ */
+void WindingNumber::evaluate(const double* xs, const double* ys, const double* zs, size_t count, double* winding) const {
+    ParallelUtils::parallelFor(count, 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            winding[i] = evaluate(xs[i], ys[i], zs[i]);
+        }
+    });
+}
+
+/**
+ * @brief 批量内外分类（多线程）
+ * 
+ * @param xs 查询点x坐标数组
+ * @param ys 查询点y坐标数组
+ * @param zs 查询点z坐标数组
+ * @param count 查询点数量
+ * @param inside 输出分类结果
+ */
+void WindingNumber::classify(const double* xs, const double* ys, const double* zs, size_t count,
+                             std::vector<char>& inside) const {
+    inside.resize(count);
+    ParallelUtils::parallelFor(count, 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            inside[i] = evaluate(xs[i], ys[i], zs[i]) >= 0.5 ? 1 : 0;
+        }
+    });
+}